@@ -0,0 +1,195 @@
+/***************************************************************************************************
+ * Copyright (c) 2024 - 2024 Codeplay Software Ltd. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+// Host cost of dynamic layout algebra evaluated directly and through cute/layout_cache.hpp.
+// Each case cycles through a few distinct problem sizes, as repeated conversions of kernel
+// arguments do, so the cached variants run on hits after the first pass.
+
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+#include <cute/tensor.hpp>
+#include <cute/layout_cache.hpp>
+
+#include "cutlass/util/command_line.h"
+
+using namespace cute;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Command line options parsing
+struct Options {
+
+  bool help;
+
+  int iterations, sizes;
+
+  Options(): help(false), iterations(1000000), sizes(4) { }
+
+  // Parses the command line
+  void parse(int argc, char const **args) {
+    cutlass::CommandLine cmd(argc, args);
+
+    if (cmd.check_cmd_line_flag("help")) {
+      help = true;
+      return;
+    }
+
+    cmd.get_cmd_line_argument("iterations", iterations, 1000000);
+    cmd.get_cmd_line_argument("sizes", sizes, 4);
+  }
+
+  /// Prints the usage statement.
+  std::ostream & print_usage(std::ostream &out) const {
+
+    out << "Layout cache benchmark\n\n"
+        << "Options:\n\n"
+        << "  --help                      If specified, displays this usage statement\n\n"
+        << "  --iterations=<int>          Evaluations per case\n"
+        << "  --sizes=<int>               Distinct problem sizes cycled through by each case\n\n";
+
+    return out;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// Keeps the evaluated layout alive without further work on it
+template <class T>
+static void do_not_optimize(T const &t) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(t) : "memory");
+#else
+  static T volatile *sink;
+  sink = const_cast<T volatile *>(&t);
+#endif
+}
+
+// Returns the mean time in ns of fn(m) over the problem sizes m = 64, 128, ...
+template <class Fn>
+static double time_ns(Options const &options, Fn const &fn) {
+
+  auto start = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < options.iterations; ++i) {
+    int m = 64 * (1 + i % options.sizes);
+    do_not_optimize(fn(m));
+  }
+
+  auto stop = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(stop - start).count() / options.iterations;
+}
+
+// Times a layout function of m directly and through memoize_layout
+template <class MakeArgs, class Fn>
+static void run(Options const &options, char const *name, MakeArgs const &make_args, Fn const &fn) {
+
+  double direct = time_ns(options, [&](int m) {
+    return apply(make_args(m), [&](auto const&... a) { return fn(a...); });
+  });
+
+  layout_cache_clear();
+  double cached = time_ns(options, [&](int m) {
+    return apply(make_args(m), [&](auto const&... a) { return memoize_layout(fn, a...); });
+  });
+
+  std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << direct << std::setw(10) << cached
+            << std::setw(10) << direct / cached << "\n";
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+int main(int argc, const char** argv)
+{
+  Options options;
+
+  options.parse(argc, argv);
+
+  if (options.help) {
+    options.print_usage(std::cout) << std::endl;
+    return 0;
+  }
+
+  std::cout << std::left << std::setw(28) << "case" << std::right
+            << std::setw(10) << "direct" << std::setw(10) << "cached" << std::setw(10) << "speedup"
+            << "  (ns per evaluation)\n";
+
+  // Operand layouts of a GEMM with dynamic extents and packed strides
+  auto mk  = [](int m) { return make_layout(make_shape(m, 512), make_stride(1, m)); };
+  auto mkl = [](int m) { return make_layout(make_shape(m, 512, 3), make_stride(1, m, m * 512)); };
+
+  run(options, "coalesce", [&](int m) { return make_tuple(mk(m)); },
+      [](auto const&... a) { return coalesce(a...); });
+
+  run(options, "complement", [&](int m) { return make_tuple(make_layout(4, m), m * 64); },
+      [](auto const&... a) { return complement(a...); });
+
+  run(options, "right_inverse", [&](int m) {
+        return make_tuple(make_layout(make_shape(m, 12), make_stride(Int<12>{}, Int<1>{}))); },
+      [](auto const&... a) { return right_inverse(a...); });
+
+  run(options, "left_inverse", [&](int m) {
+        return make_tuple(make_layout(make_shape(m, 12), make_stride(Int<12>{}, Int<1>{}))); },
+      [](auto const&... a) { return left_inverse(a...); });
+
+  run(options, "logical_divide", [&](int m) { return make_tuple(mk(m), make_shape(Int<128>{}, Int<64>{})); },
+      [](auto const&... a) { return logical_divide(a...); });
+
+  run(options, "logical_divide rank-3", [&](int m) {
+        return make_tuple(mkl(m), make_shape(Int<128>{}, Int<64>{}, Int<1>{})); },
+      [](auto const&... a) { return logical_divide(a...); });
+
+  run(options, "logical_divide dynamic", [&](int m) {
+        return make_tuple(mk(m), make_shape(m / 4, 16)); },
+      [](auto const&... a) { return logical_divide(a...); });
+
+  run(options, "logical_product", [&](int m) {
+        return make_tuple(make_layout(make_shape(Int<4>{}, Int<8>{})), make_layout(make_shape(m, 3))); },
+      [](auto const&... a) { return logical_product(a...); });
+
+  run(options, "composition rank-2", [&](int m) {
+        return make_tuple(mk(m), make_layout(make_shape(Int<8>{}, 3), make_stride(Int<4>{}, Int<1>{}))); },
+      [](auto const&... a) { return composition(a...); });
+
+  run(options, "composition dynamic", [&](int m) {
+        return make_tuple(mk(m), make_layout(make_shape(m / 4, 8), make_stride(4, m))); },
+      [](auto const&... a) { return composition(a...); });
+
+  run(options, "composition rank-3", [&](int m) {
+        return make_tuple(mkl(m), make_layout(make_shape(m, 6, 2), make_stride(3, m * 3, m * 18))); },
+      [](auto const&... a) { return composition(a...); });
+
+  return 0;
+}
@@ -37,6 +37,7 @@
 #include <cute/tensor.hpp>
 #include <cute/tensor_predicate.hpp>
 
+#include <cute/arch/copy_cpu.hpp>
 #include <cute/atom/copy_atom.hpp>
 
 namespace cute
@@ -115,6 +116,32 @@ copy(CopyPolicy                   const& copy_policy,
   return copy(copy_policy, src, dst);
 }
 
+template <class SrcEngine, class SrcLayout,
+          class IdxEngine, class IdxLayout,
+          class DstEngine, class DstLayout>
+CUTE_HOST_DEVICE
+void
+copy_gather(Tensor<SrcEngine, SrcLayout> const& src,
+            Tensor<IdxEngine, IdxLayout> const& indices,
+            Tensor<DstEngine, DstLayout>     && dst)
+{
+  return copy_gather(src, indices, dst);
+}
+
+template <class CopyPolicy,
+          class SrcEngine, class SrcLayout,
+          class IdxEngine, class IdxLayout,
+          class DstEngine, class DstLayout>
+CUTE_HOST_DEVICE
+void
+copy_gather(CopyPolicy                   const& copy_policy,
+            Tensor<SrcEngine, SrcLayout> const& src,
+            Tensor<IdxEngine, IdxLayout> const& indices,
+            Tensor<DstEngine, DstLayout>     && dst)
+{
+  return copy_gather(copy_policy, src, indices, dst);
+}
+
 //
 // copy_if -- Predicated Copy
 //
@@ -334,6 +361,140 @@ copy(Copy_Atom<AutoVectorizingCopyWithAssumedAlignment<MaxVecBits>, Args...> con
   return copy(AutoVectorizingCopyWithAssumedAlignment<MaxVecBits>{}, src, dst);
 }
 
+//
+// copy -- CPU_AutoVectorizingCopy
+//
+
+namespace detail {
+
+// Iterators whose tensors the host copy kernels may address directly
+template <class Iterator>
+struct is_cpu_copy_iterator : false_type {};
+
+template <class T>
+struct is_cpu_copy_iterator<T*> : true_type {};
+
+template <class P>
+struct is_cpu_copy_iterator<gmem_ptr<P>> : is_cpu_copy_iterator<P> {};
+
+template <class P>
+struct is_cpu_copy_iterator<rmem_ptr<P>> : is_cpu_copy_iterator<P> {};
+
+// Flat tuples of integral elements
+template <class FlatTuple, class Seq = make_int_sequence<tuple_size<FlatTuple>::value>>
+struct is_integral_flat_tuple;
+
+template <class FlatTuple, int... I>
+struct is_integral_flat_tuple<FlatTuple, int_sequence<I...>>
+  : bool_constant<(true && ... && is_integral<tuple_element_t<I,FlatTuple>>::value)> {};
+
+// Tensors that the host copy kernels accept: directly addressable, integral strides, and value types
+//   that are the same trivially copyable type
+template <class SrcEngine, class SrcLayout, class DstEngine, class DstLayout>
+static constexpr bool is_cpu_copyable_v =
+  is_same<remove_cv_t<typename SrcEngine::value_type>, remove_cv_t<typename DstEngine::value_type>>::value &&
+  is_trivially_copyable<remove_cv_t<typename DstEngine::value_type>>::value &&
+  not is_volatile_v<typename SrcEngine::element_type> && not is_volatile_v<typename DstEngine::element_type> &&
+  is_cpu_copy_iterator<typename SrcEngine::iterator>::value &&
+  is_cpu_copy_iterator<typename DstEngine::iterator>::value &&
+  is_integral_flat_tuple<decltype(flatten_to_tuple(declval<SrcLayout>().stride()))>::value &&
+  is_integral_flat_tuple<decltype(flatten_to_tuple(declval<DstLayout>().stride()))>::value;
+
+} // end namespace detail
+
+template <size_t NonTemporalBytes,
+          class SrcEngine, class SrcLayout,
+          class DstEngine, class DstLayout>
+CUTE_HOST_DEVICE
+void
+copy(CPU_AutoVectorizingCopy<NonTemporalBytes> const&,
+     Tensor<SrcEngine, SrcLayout>              const& src,
+     Tensor<DstEngine, DstLayout>                   & dst)
+{
+#if !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+  using SrcShape = decltype(flatten_to_tuple(src.shape()));
+  using DstShape = decltype(flatten_to_tuple(dst.shape()));
+  constexpr int R = tuple_size<SrcShape>::value;
+  if constexpr (detail::is_cpu_copyable_v<SrcEngine, SrcLayout, DstEngine, DstLayout> &&
+                R == tuple_size<DstShape>::value) {
+    auto src_shape  = flatten_to_tuple(src.shape());
+    auto dst_shape  = flatten_to_tuple(dst.shape());
+    auto src_stride = flatten_to_tuple(src.stride());
+    auto dst_stride = flatten_to_tuple(dst.stride());
+    array<int64_t,R> shape, src_s, dst_s;
+    bool congruent = true;
+    for_each(make_int_sequence<R>{}, [&](auto i) {
+      shape[i] = int64_t(get<i>(src_shape));
+      src_s[i] = int64_t(get<i>(src_stride));
+      dst_s[i] = int64_t(get<i>(dst_stride));
+      congruent = congruent && shape[i] == int64_t(get<i>(dst_shape));
+    });
+    // Copies between tensors of different shapes follow the copy algorithm's logical 1-D order
+    if (congruent) {
+      using T = remove_cv_t<typename DstEngine::value_type>;
+      bool streaming = size_t(size(dst)) * sizeof(T) >= NonTemporalBytes;
+      return detail::cpu_copy_strided(static_cast<T const*>(raw_pointer_cast(src.data())),
+                                      static_cast<T      *>(raw_pointer_cast(dst.data())),
+                                      shape, src_s, dst_s, streaming);
+    }
+  }
+#endif
+  return copy(AutoVectorizingCopy{}, src, dst);
+}
+
+//
+// copy_gather -- Indexed Copy
+//   dst(i) = src(indices(i))
+//
+
+template <class SrcEngine, class SrcLayout,
+          class IdxEngine, class IdxLayout,
+          class DstEngine, class DstLayout>
+CUTE_HOST_DEVICE
+void
+copy_gather(Tensor<SrcEngine, SrcLayout> const& src,
+            Tensor<IdxEngine, IdxLayout> const& indices,
+            Tensor<DstEngine, DstLayout>      & dst)
+{
+  CUTE_UNROLL
+  for (int i = 0; i < size(dst); ++i) {
+    dst(i) = src(indices(i));
+  }
+}
+
+template <size_t NonTemporalBytes,
+          class SrcEngine, class SrcLayout,
+          class IdxEngine, class IdxLayout,
+          class DstEngine, class DstLayout>
+CUTE_HOST_DEVICE
+void
+copy_gather(CPU_AutoVectorizingCopy<NonTemporalBytes> const&,
+            Tensor<SrcEngine, SrcLayout>              const& src,
+            Tensor<IdxEngine, IdxLayout>              const& indices,
+            Tensor<DstEngine, DstLayout>                   & dst)
+{
+#if !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+  // Rank-1 source, indices, and destination are gathered by the host kernels
+  if constexpr (detail::is_cpu_copyable_v<SrcEngine, SrcLayout, DstEngine, DstLayout> &&
+                detail::is_cpu_copy_iterator<typename IdxEngine::iterator>::value &&
+                is_integral<typename IdxEngine::value_type>::value &&
+                tuple_size<decltype(flatten_to_tuple(src.stride()))>::value == 1 &&
+                tuple_size<decltype(flatten_to_tuple(indices.stride()))>::value == 1 &&
+                tuple_size<decltype(flatten_to_tuple(dst.stride()))>::value == 1 &&
+                detail::is_integral_flat_tuple<decltype(flatten_to_tuple(indices.stride()))>::value) {
+    using T = remove_cv_t<typename DstEngine::value_type>;
+    return detail::cpu_copy_indexed(static_cast<T const*>(raw_pointer_cast(src.data())),
+                                    int64_t(get<0>(flatten_to_tuple(src.stride()))),
+                                    raw_pointer_cast(indices.data()),
+                                    int64_t(get<0>(flatten_to_tuple(indices.stride()))),
+                                    static_cast<T*>(raw_pointer_cast(dst.data())),
+                                    int64_t(get<0>(flatten_to_tuple(dst.stride()))),
+                                    int64_t(size(dst)));
+  }
+#endif
+  return copy_gather(src, indices, dst);
+}
+
 #if defined(CUTE_COPY_ATOM_TMA_SM90_ENABLED)
 template <class... CT_Args,
           class SrcEngine, class SrcLayout,
@@ -625,19 +625,67 @@ flatten(T const& t)
 
 namespace detail {
 
-template <class FlatTuple, class TargetProfile>
+// Number of leaves of a hierarchical tuple, rank(flatten(T)) without constructing flatten(T)
+template <class T>
+CUTE_HOST_DEVICE constexpr
+int
+leaf_count();
+
+template <class T, int... I>
+CUTE_HOST_DEVICE constexpr
+int
+leaf_count(seq<I...>)
+{
+  return (0 + ... + leaf_count<tuple_element_t<I,T>>());
+}
+
+template <class T>
+CUTE_HOST_DEVICE constexpr
+int
+leaf_count()
+{
+  if constexpr (is_tuple<T>::value) {
+    return leaf_count<T>(tuple_seq<T>{});
+  } else {
+    return 1;
+  }
+
+  CUTE_GCC_UNREACHABLE;
+}
+
+// Number of leaves of the modes J... of T: with J... = 0,...,I-1 this is the leaf offset of mode I
+template <class T, int... J>
+CUTE_HOST_DEVICE constexpr
+int
+leaf_offset(seq<J...>)
+{
+  return (0 + ... + leaf_count<tuple_element_t<J,T>>());
+}
+
+// Unflatten the flat elements starting at Offset into the profile of target_profile.
+//   Each leaf is taken from flat_tuple directly, rather than peeled from a shrinking remainder.
+template <int Offset, class FlatTuple, class TargetProfile>
+CUTE_HOST_DEVICE constexpr
+auto
+unflatten_impl(FlatTuple const& flat_tuple, TargetProfile const& target_profile);
+
+template <int Offset, class FlatTuple, class TargetProfile, int... I>
+CUTE_HOST_DEVICE constexpr
+auto
+unflatten_impl(FlatTuple const& flat_tuple, TargetProfile const& target_profile, seq<I...>)
+{
+  return cute::make_tuple(unflatten_impl<Offset + leaf_offset<TargetProfile>(make_seq<I>{})>(flat_tuple, get<I>(target_profile))...);
+}
+
+template <int Offset, class FlatTuple, class TargetProfile>
 CUTE_HOST_DEVICE constexpr
 auto
 unflatten_impl(FlatTuple const& flat_tuple, TargetProfile const& target_profile)
 {
   if constexpr (is_tuple<TargetProfile>::value) {
-    return fold(target_profile, cute::make_tuple(cute::make_tuple(), flat_tuple), [](auto const& v, auto const& t) {
-      auto [result, remaining_tuple] = v;
-      auto [sub_result, sub_tuple] = unflatten_impl(remaining_tuple, t);
-      return cute::make_tuple(append(result, sub_result), sub_tuple);
-    });
+    return unflatten_impl<Offset>(flat_tuple, target_profile, tuple_seq<TargetProfile>{});
   } else {
-    return cute::make_tuple(get<0>(flat_tuple), take<1, decltype(rank(flat_tuple))::value>(flat_tuple));
+    return get<Offset>(flat_tuple);
   }
 
   CUTE_GCC_UNREACHABLE;
@@ -655,9 +703,9 @@ CUTE_HOST_DEVICE constexpr
 auto
 unflatten(FlatTuple const& flat_tuple, TargetProfile const& target_profile)
 {
-  auto [unflatten_tuple, flat_remainder] = detail::unflatten_impl(flat_tuple, target_profile);
-  CUTE_STATIC_ASSERT_V(rank(flat_remainder) == Int<0>{});
-  return unflatten_tuple;
+  static_assert(detail::leaf_count<TargetProfile>() == tuple_size<FlatTuple>::value,
+                "Mismatched rank of flat_tuple and target_profile.");
+  return detail::unflatten_impl<0>(flat_tuple, target_profile);
 }
 
 //
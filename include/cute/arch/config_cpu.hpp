@@ -0,0 +1,78 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+// Config
+//
+// ISA selection for the host implementations of CuTe operations, e.g. the host MMA atoms in
+// <cute/arch/mma_cpu.hpp> and the host copy policy in <cute/arch/copy_cpu.hpp>. Each of those is
+// written as a scalar loop that the host compiler may vectorize on its own, with explicit SIMD paths
+// selected by the ISA macros of the host compiler (e.g. -mavx2 -mfma, -mavx512f, -mavx512bf16,
+// -mavxvnni, -march=armv8.6-a). None of these are defined in device compilation passes.
+#if !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+#  if defined(__SSE2__) || defined(_M_X64)
+#    define CUTE_ARCH_CPU_SSE2_ENABLED
+#  endif
+#  if defined(__AVX2__) && defined(__FMA__)
+#    define CUTE_ARCH_CPU_AVX2_ENABLED
+#  endif
+#  if defined(__AVX512F__)
+#    define CUTE_ARCH_CPU_AVX512_ENABLED
+#  endif
+#  if defined(__AVX512BF16__) && defined(__AVX512VL__)
+#    define CUTE_ARCH_CPU_AVX512_BF16_ENABLED
+#  endif
+#  if defined(__AVX512VNNI__) && defined(__AVX512VL__)
+#    define CUTE_ARCH_CPU_AVX512_VNNI_ENABLED
+#  elif defined(__AVXVNNI__)
+#    define CUTE_ARCH_CPU_AVX_VNNI_ENABLED
+#  endif
+#  if defined(__ARM_NEON)
+#    define CUTE_ARCH_CPU_NEON_ENABLED
+#  endif
+#  if defined(__ARM_NEON) && defined(__ARM_FEATURE_BF16_VECTOR_ARITHMETIC)
+#    define CUTE_ARCH_CPU_NEON_BF16_ENABLED
+#  endif
+#  if defined(__ARM_NEON) && defined(__ARM_FEATURE_MATMUL_INT8)
+#    define CUTE_ARCH_CPU_NEON_I8MM_ENABLED
+#  endif
+#endif
+
+#if defined(CUTE_ARCH_CPU_AVX2_ENABLED) || defined(CUTE_ARCH_CPU_AVX512_ENABLED) || \
+    defined(CUTE_ARCH_CPU_AVX_VNNI_ENABLED)
+#  include <immintrin.h>
+#elif defined(CUTE_ARCH_CPU_SSE2_ENABLED)
+#  include <emmintrin.h>
+#endif
+
+#if defined(CUTE_ARCH_CPU_NEON_ENABLED)
+#  include <arm_neon.h>
+#endif
@@ -0,0 +1,332 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/config.hpp>
+#include <cute/arch/config_cpu.hpp>
+
+#include <cute/container/array.hpp>
+#include <cute/util/type_traits.hpp>
+
+#if !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+#  include <cstring>
+#endif
+
+namespace cute
+{
+
+//
+// Host copy policy
+//
+// Copies between host tensors of the same shape and value type with runtime SIMD kernels rather than
+// the element loop of the copy algorithm: contiguous runs are copied with memcpy, strided rows with
+// SIMD gathers/scatters, and transposes are blocked so that both tensors are accessed a cache line at
+// a time. Destinations of at least NonTemporalBytes that are contiguous are written with streaming
+// (non-temporal) stores to avoid evicting the working set. Any other copy, and any copy in a device
+// compilation pass, is an AutoVectorizingCopy.
+//
+
+template <size_t NonTemporalBytes = (size_t(4) << 20)>
+struct CPU_AutoVectorizingCopy
+{
+  static constexpr size_t non_temporal_bytes = NonTemporalBytes;
+};
+
+#if !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+
+namespace detail {
+
+// Copy of a contiguous range of bytes, optionally with streaming stores
+inline void
+cpu_copy_bytes(void const* src, void* dst, size_t bytes, bool streaming)
+{
+#if defined(CUTE_ARCH_CPU_SSE2_ENABLED)
+  if (streaming && bytes >= 1024) {
+    char const* s = static_cast<char const*>(src);
+    char      * d = static_cast<char      *>(dst);
+    // Peel to the first cache line of the destination
+    size_t head = (64 - (reinterpret_cast<uintptr_t>(d) & 63)) & 63;
+    std::memcpy(d, s, head);
+    s += head; d += head; bytes -= head;
+    for (; bytes >= 64; s += 64, d += 64, bytes -= 64) {
+#if defined(CUTE_ARCH_CPU_AVX512_ENABLED)
+      _mm512_stream_si512(reinterpret_cast<__m512i*>(d), _mm512_loadu_si512(s));
+#elif defined(CUTE_ARCH_CPU_AVX2_ENABLED)
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(d     ), _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s     )));
+      _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), _mm256_loadu_si256(reinterpret_cast<__m256i const*>(s + 32)));
+#else
+      CUTE_UNROLL
+      for (int i = 0; i < 64; i += 16) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(d + i), _mm_loadu_si128(reinterpret_cast<__m128i const*>(s + i)));
+      }
+#endif
+    }
+    // Order the streaming stores before any later store of this thread
+    _mm_sfence();
+    std::memcpy(d, s, bytes);
+    return;
+  }
+#endif
+  std::memcpy(dst, src, bytes);
+}
+
+// Lane offsets {0, stride, 2*stride, ...} of a SIMD gather/scatter fit in 32b
+template <int Lanes>
+inline bool
+cpu_lane_offsets_fit(int64_t stride)
+{
+  return stride > -(int64_t(1) << 31) / Lanes && stride < (int64_t(1) << 31) / Lanes;
+}
+
+// Gather of n 4B/8B elements with element stride src_stride into a contiguous row.
+//   Returns the number of elements copied, a multiple of the SIMD width.
+template <class T>
+inline int64_t
+cpu_gather_row(T const* src, int64_t src_stride, T* dst, int64_t n)
+{
+  int64_t i = 0;
+  if constexpr (sizeof(T) == 4) {
+#if defined(CUTE_ARCH_CPU_AVX512_ENABLED)
+    if (cpu_lane_offsets_fit<16>(src_stride)) {
+      __m512i offset = _mm512_mullo_epi32(_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15),
+                                          _mm512_set1_epi32(int(src_stride)));
+      for (; i + 16 <= n; i += 16) {
+        _mm512_storeu_si512(dst + i, _mm512_i32gather_epi32(offset, src + i * src_stride, 4));
+      }
+    }
+#elif defined(CUTE_ARCH_CPU_AVX2_ENABLED)
+    if (cpu_lane_offsets_fit<8>(src_stride)) {
+      __m256i offset = _mm256_mullo_epi32(_mm256_setr_epi32(0,1,2,3,4,5,6,7),
+                                          _mm256_set1_epi32(int(src_stride)));
+      for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_i32gather_epi32(reinterpret_cast<int const*>(src + i * src_stride), offset, 4));
+      }
+    }
+#endif
+  } else
+  if constexpr (sizeof(T) == 8) {
+#if defined(CUTE_ARCH_CPU_AVX512_ENABLED)
+    __m512i offset = _mm512_setr_epi64(0,              src_stride,     2 * src_stride, 3 * src_stride,
+                                       4 * src_stride, 5 * src_stride, 6 * src_stride, 7 * src_stride);
+    for (; i + 8 <= n; i += 8) {
+      _mm512_storeu_si512(dst + i, _mm512_i64gather_epi64(offset, src + i * src_stride, 8));
+    }
+#elif defined(CUTE_ARCH_CPU_AVX2_ENABLED)
+    __m256i offset = _mm256_setr_epi64x(0, src_stride, 2 * src_stride, 3 * src_stride);
+    for (; i + 4 <= n; i += 4) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                          _mm256_i64gather_epi64(reinterpret_cast<long long const*>(src + i * src_stride), offset, 8));
+    }
+#endif
+  }
+  return i;
+}
+
+// Scatter of n 4B/8B elements of a contiguous row with element stride dst_stride.
+//   Returns the number of elements copied, a multiple of the SIMD width.
+template <class T>
+inline int64_t
+cpu_scatter_row(T const* src, T* dst, int64_t dst_stride, int64_t n)
+{
+  int64_t i = 0;
+#if defined(CUTE_ARCH_CPU_AVX512_ENABLED)
+  if constexpr (sizeof(T) == 4) {
+    if (cpu_lane_offsets_fit<16>(dst_stride)) {
+      __m512i offset = _mm512_mullo_epi32(_mm512_setr_epi32(0,1,2,3,4,5,6,7,8,9,10,11,12,13,14,15),
+                                          _mm512_set1_epi32(int(dst_stride)));
+      for (; i + 16 <= n; i += 16) {
+        _mm512_i32scatter_epi32(dst + i * dst_stride, offset, _mm512_loadu_si512(src + i), 4);
+      }
+    }
+  } else
+  if constexpr (sizeof(T) == 8) {
+    __m512i offset = _mm512_setr_epi64(0,              dst_stride,     2 * dst_stride, 3 * dst_stride,
+                                       4 * dst_stride, 5 * dst_stride, 6 * dst_stride, 7 * dst_stride);
+    for (; i + 8 <= n; i += 8) {
+      _mm512_i64scatter_epi64(dst + i * dst_stride, offset, _mm512_loadu_si512(src + i), 8);
+    }
+  }
+#endif
+  return i;
+}
+
+// Copy of a row of n elements with element strides src_stride and dst_stride
+template <class T>
+inline void
+cpu_copy_row(T const* src, int64_t src_stride, T* dst, int64_t dst_stride, int64_t n, bool streaming)
+{
+  if (src_stride == 1 && dst_stride == 1) {
+    return cpu_copy_bytes(src, dst, size_t(n) * sizeof(T), streaming);
+  }
+  int64_t i = 0;
+  if (dst_stride == 1) {
+    i = cpu_gather_row(src, src_stride, dst, n);
+  } else
+  if (src_stride == 1) {
+    i = cpu_scatter_row(src, dst, dst_stride, n);
+  }
+  for (; i < n; ++i) {
+    dst[i * dst_stride] = src[i * src_stride];
+  }
+}
+
+// Copy of a rank-R strided tensor of trivially copyable T with the given extents and element strides
+template <class T, size_t R>
+inline void
+cpu_copy_strided(T const* src, T* dst,
+                 array<int64_t,R> const& shape,
+                 array<int64_t,R> const& src_stride,
+                 array<int64_t,R> const& dst_stride,
+                 bool streaming)
+{
+  // Drop unit modes and merge modes that are contiguous in both tensors
+  int64_t e[R], s[R], d[R];
+  int r = 0;
+  for (size_t i = 0; i < R; ++i) {
+    if (shape[i] == 0) { return; }
+    if (shape[i] == 1) { continue; }
+    if (r > 0 && e[r-1] * s[r-1] == src_stride[i] && e[r-1] * d[r-1] == dst_stride[i]) {
+      e[r-1] *= shape[i];
+    } else {
+      e[r] = shape[i]; s[r] = src_stride[i]; d[r] = dst_stride[i];
+      ++r;
+    }
+  }
+  if (r == 0) {
+    *dst = *src;
+    return;
+  }
+
+  // Rows are copied along the pivot mode, preferring a contiguous destination and then a contiguous source
+  int p = 0;
+  for (int i = r-1; i >= 0; --i) { if (s[i] == 1) { p = i; } }
+  for (int i = r-1; i >= 0; --i) { if (d[i] == 1) { p = i; } }
+  // Rows that read a strided source are blocked with a mode of contiguous source (a transpose)
+  int q = -1;
+  if (s[p] != 1) {
+    for (int i = r-1; i >= 0; --i) { if (i != p && s[i] == 1) { q = i; } }
+  }
+
+  // Odometer over the remaining modes
+  int     outer[R];
+  int64_t idx[R];
+  int m = 0;
+  int64_t count = 1;
+  for (int i = 0; i < r; ++i) {
+    if (i != p && i != q) { outer[m] = i; idx[m] = 0; ++m; count *= e[i]; }
+  }
+
+  constexpr int64_t BlockP = 64;
+  constexpr int64_t BlockQ = (64 / sizeof(T)) > 0 ? (64 / sizeof(T)) : 1;
+
+  int64_t src_offset = 0;
+  int64_t dst_offset = 0;
+  for (int64_t c = 0; c < count; ++c) {
+    if (q < 0) {
+      cpu_copy_row(src + src_offset, s[p], dst + dst_offset, d[p], e[p], streaming);
+    } else {
+      for (int64_t pb = 0; pb < e[p]; pb += BlockP) {
+        int64_t np = e[p] - pb < BlockP ? e[p] - pb : BlockP;
+        for (int64_t qb = 0; qb < e[q]; qb += BlockQ) {
+          int64_t nq = e[q] - qb < BlockQ ? e[q] - qb : BlockQ;
+          for (int64_t j = qb; j < qb + nq; ++j) {
+            cpu_copy_row(src + src_offset + j * s[q] + pb * s[p], s[p],
+                         dst + dst_offset + j * d[q] + pb * d[p], d[p], np, false);
+          }
+        }
+      }
+    }
+    // Advance the odometer
+    for (int k = 0; k < m; ++k) {
+      int i = outer[k];
+      src_offset += s[i];
+      dst_offset += d[i];
+      if (++idx[k] < e[i]) { break; }
+      src_offset -= e[i] * s[i];
+      dst_offset -= e[i] * d[i];
+      idx[k] = 0;
+    }
+  }
+}
+
+// Indexed gather dst[i * dst_stride] = src[index[i * index_stride] * src_stride] of n elements
+template <class T, class Index>
+inline void
+cpu_copy_indexed(T const* src, int64_t src_stride,
+                 Index const* index, int64_t index_stride,
+                 T* dst, int64_t dst_stride, int64_t n)
+{
+  int64_t i = 0;
+#if defined(CUTE_ARCH_CPU_AVX2_ENABLED)
+  // SIMD gathers of 4B/8B elements from a contiguous source by contiguous 32b/64b signed indices
+  if (src_stride == 1 && index_stride == 1 && dst_stride == 1) {
+    using I = remove_cv_t<Index>;
+    if constexpr (sizeof(T) == 4 && is_same<I, int32_t>::value) {
+      for (; i + 8 <= n; i += 8) {
+        __m256i offset = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(index + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_i32gather_epi32(reinterpret_cast<int const*>(src), offset, 4));
+      }
+    } else
+    if constexpr (sizeof(T) == 4 && is_same<I, int64_t>::value) {
+      for (; i + 4 <= n; i += 4) {
+        __m256i offset = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(index + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_i64gather_epi32(reinterpret_cast<int const*>(src), offset, 4));
+      }
+    } else
+    if constexpr (sizeof(T) == 8 && is_same<I, int32_t>::value) {
+      for (; i + 4 <= n; i += 4) {
+        __m128i offset = _mm_loadu_si128(reinterpret_cast<__m128i const*>(index + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_i32gather_epi64(reinterpret_cast<long long const*>(src), offset, 8));
+      }
+    } else
+    if constexpr (sizeof(T) == 8 && is_same<I, int64_t>::value) {
+      for (; i + 4 <= n; i += 4) {
+        __m256i offset = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(index + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            _mm256_i64gather_epi64(reinterpret_cast<long long const*>(src), offset, 8));
+      }
+    }
+  }
+#endif
+  for (; i < n; ++i) {
+    dst[i * dst_stride] = src[int64_t(index[i * index_stride]) * src_stride];
+  }
+}
+
+} // end namespace detail
+
+#endif // !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+
+} // end namespace cute
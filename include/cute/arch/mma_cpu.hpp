@@ -0,0 +1,287 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/config.hpp>
+#include <cute/arch/config_cpu.hpp>
+#include <cute/arch/mma.hpp>
+
+#include <cute/container/array.hpp>
+#include <cute/numeric/numeric_types.hpp>
+
+namespace cute
+{
+
+//
+// Host MMA operations
+//
+// These operations are executed by a single host "thread". Their registers are short vectors of
+// values rather than 32b registers: each C/D register holds one column of the accumulator tile, the A
+// register holds one column of A, and the B register holds one row of B. The vectors are accessed with
+// unaligned loads and stores, so they may be recast from any register-backed fragment.
+//
+
+// 8x8x1 FP32 outer product: D[:,n] = A[:] * B[n] + C[:,n]
+struct CPU_8x8x1_F32F32F32F32
+{
+  using DRegisters = array<float,8>[8];
+  using ARegisters = array<float,8>[1];
+  using BRegisters = array<float,8>[1];
+  using CRegisters = array<float,8>[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(array<float,8>      & d0, array<float,8>      & d1, array<float,8>      & d2, array<float,8>      & d3,
+      array<float,8>      & d4, array<float,8>      & d5, array<float,8>      & d6, array<float,8>      & d7,
+      array<float,8> const& a,
+      array<float,8> const& b,
+      array<float,8> const& c0, array<float,8> const& c1, array<float,8> const& c2, array<float,8> const& c3,
+      array<float,8> const& c4, array<float,8> const& c5, array<float,8> const& c6, array<float,8> const& c7)
+  {
+    array<float,8>      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    array<float,8> const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+#if defined(CUTE_ARCH_CPU_AVX2_ENABLED)
+    __m256 va = _mm256_loadu_ps(a.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m256 vc = _mm256_loadu_ps(c[n]->data());
+      _mm256_storeu_ps(d[n]->data(), _mm256_fmadd_ps(va, _mm256_set1_ps(b[n]), vc));
+    }
+#elif defined(CUTE_ARCH_CPU_NEON_ENABLED)
+    float32x4_t va0 = vld1q_f32(a.data());
+    float32x4_t va1 = vld1q_f32(a.data() + 4);
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      float32x4_t vc0 = vld1q_f32(c[n]->data());
+      float32x4_t vc1 = vld1q_f32(c[n]->data() + 4);
+      vst1q_f32(d[n]->data(),     vfmaq_n_f32(vc0, va0, b[n]));
+      vst1q_f32(d[n]->data() + 4, vfmaq_n_f32(vc1, va1, b[n]));
+    }
+#else
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      CUTE_UNROLL
+      for (int m = 0; m < 8; ++m) {
+        (*d[n])[m] = a[m] * b[n] + (*c[n])[m];
+      }
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 16x8x1 FP32 outer product: D[:,n] = A[:] * B[n] + C[:,n]
+// One accumulator column fills a 512b register, which suits AVX-512.
+struct CPU_16x8x1_F32F32F32F32
+{
+  using DRegisters = array<float,16>[8];
+  using ARegisters = array<float,16>[1];
+  using BRegisters = array<float,8>[1];
+  using CRegisters = array<float,16>[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(array<float,16>      & d0, array<float,16>      & d1, array<float,16>      & d2, array<float,16>      & d3,
+      array<float,16>      & d4, array<float,16>      & d5, array<float,16>      & d6, array<float,16>      & d7,
+      array<float,16> const& a,
+      array<float,8>  const& b,
+      array<float,16> const& c0, array<float,16> const& c1, array<float,16> const& c2, array<float,16> const& c3,
+      array<float,16> const& c4, array<float,16> const& c5, array<float,16> const& c6, array<float,16> const& c7)
+  {
+    array<float,16>      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    array<float,16> const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+#if defined(CUTE_ARCH_CPU_AVX512_ENABLED)
+    __m512 va = _mm512_loadu_ps(a.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m512 vc = _mm512_loadu_ps(c[n]->data());
+      _mm512_storeu_ps(d[n]->data(), _mm512_fmadd_ps(va, _mm512_set1_ps(b[n]), vc));
+    }
+#elif defined(CUTE_ARCH_CPU_AVX2_ENABLED)
+    __m256 va0 = _mm256_loadu_ps(a.data());
+    __m256 va1 = _mm256_loadu_ps(a.data() + 8);
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m256 vb  = _mm256_set1_ps(b[n]);
+      __m256 vc0 = _mm256_loadu_ps(c[n]->data());
+      __m256 vc1 = _mm256_loadu_ps(c[n]->data() + 8);
+      _mm256_storeu_ps(d[n]->data(),     _mm256_fmadd_ps(va0, vb, vc0));
+      _mm256_storeu_ps(d[n]->data() + 8, _mm256_fmadd_ps(va1, vb, vc1));
+    }
+#elif defined(CUTE_ARCH_CPU_NEON_ENABLED)
+    float32x4_t va[4];
+    CUTE_UNROLL
+    for (int i = 0; i < 4; ++i) {
+      va[i] = vld1q_f32(a.data() + 4 * i);
+    }
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      CUTE_UNROLL
+      for (int i = 0; i < 4; ++i) {
+        float32x4_t vc = vld1q_f32(c[n]->data() + 4 * i);
+        vst1q_f32(d[n]->data() + 4 * i, vfmaq_n_f32(vc, va[i], b[n]));
+      }
+    }
+#else
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      CUTE_UNROLL
+      for (int m = 0; m < 16; ++m) {
+        (*d[n])[m] = a[m] * b[n] + (*c[n])[m];
+      }
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 8x8x2 BF16 dot product with FP32 accumulation: D[m,n] = A[m,0:2] . B[n,0:2] + C[m,n]
+// The A and B registers hold (k,m) and (k,n) pairs with k fastest, the operand order of VDPBF16PS/BFDOT.
+struct CPU_8x8x2_F32BF16BF16F32
+{
+  using DRegisters = array<float,8>[8];
+  using ARegisters = array<bfloat16_t,16>[1];
+  using BRegisters = array<bfloat16_t,16>[1];
+  using CRegisters = array<float,8>[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(array<float,8>      & d0, array<float,8>      & d1, array<float,8>      & d2, array<float,8>      & d3,
+      array<float,8>      & d4, array<float,8>      & d5, array<float,8>      & d6, array<float,8>      & d7,
+      array<bfloat16_t,16> const& a,
+      array<bfloat16_t,16> const& b,
+      array<float,8> const& c0, array<float,8> const& c1, array<float,8> const& c2, array<float,8> const& c3,
+      array<float,8> const& c4, array<float,8> const& c5, array<float,8> const& c6, array<float,8> const& c7)
+  {
+    array<float,8>      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    array<float,8> const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+#if defined(CUTE_ARCH_CPU_AVX512_BF16_ENABLED)
+    __m256bh va = (__m256bh) _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a.data()));
+    uint32_t const* b_pairs = reinterpret_cast<uint32_t const*>(b.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m256 vc = _mm256_loadu_ps(c[n]->data());
+      __m256bh vb = (__m256bh) _mm256_set1_epi32(static_cast<int>(b_pairs[n]));
+      _mm256_storeu_ps(d[n]->data(), _mm256_dpbf16_ps(vc, va, vb));
+    }
+#elif defined(CUTE_ARCH_CPU_NEON_BF16_ENABLED)
+    uint16_t const* a_raw   = reinterpret_cast<uint16_t const*>(a.data());
+    uint32_t const* b_pairs = reinterpret_cast<uint32_t const*>(b.data());
+    bfloat16x8_t va0 = vreinterpretq_bf16_u16(vld1q_u16(a_raw));
+    bfloat16x8_t va1 = vreinterpretq_bf16_u16(vld1q_u16(a_raw + 8));
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      bfloat16x8_t vb = vreinterpretq_bf16_u32(vdupq_n_u32(b_pairs[n]));
+      float32x4_t vc0 = vld1q_f32(c[n]->data());
+      float32x4_t vc1 = vld1q_f32(c[n]->data() + 4);
+      vst1q_f32(d[n]->data(),     vbfdotq_f32(vc0, va0, vb));
+      vst1q_f32(d[n]->data() + 4, vbfdotq_f32(vc1, va1, vb));
+    }
+#else
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      float b0 = static_cast<float>(b[2*n+0]);
+      float b1 = static_cast<float>(b[2*n+1]);
+      CUTE_UNROLL
+      for (int m = 0; m < 8; ++m) {
+        (*d[n])[m] = static_cast<float>(a[2*m+0]) * b0 + static_cast<float>(a[2*m+1]) * b1 + (*c[n])[m];
+      }
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+// 8x8x4 U8*S8 dot product with S32 accumulation: D[m,n] = A[m,0:4] . B[n,0:4] + C[m,n]
+// The A and B registers hold (k,m) and (k,n) quads with k fastest, the operand order of VPDPBUSD/USDOT.
+struct CPU_8x8x4_S32U8S8S32
+{
+  using DRegisters = array<int32_t,8>[8];
+  using ARegisters = array<uint8_t,32>[1];
+  using BRegisters = array<int8_t,32>[1];
+  using CRegisters = array<int32_t,8>[8];
+
+  CUTE_HOST_DEVICE static void
+  fma(array<int32_t,8>      & d0, array<int32_t,8>      & d1, array<int32_t,8>      & d2, array<int32_t,8>      & d3,
+      array<int32_t,8>      & d4, array<int32_t,8>      & d5, array<int32_t,8>      & d6, array<int32_t,8>      & d7,
+      array<uint8_t,32> const& a,
+      array<int8_t,32>  const& b,
+      array<int32_t,8> const& c0, array<int32_t,8> const& c1, array<int32_t,8> const& c2, array<int32_t,8> const& c3,
+      array<int32_t,8> const& c4, array<int32_t,8> const& c5, array<int32_t,8> const& c6, array<int32_t,8> const& c7)
+  {
+    array<int32_t,8>      * d[8] = {&d0, &d1, &d2, &d3, &d4, &d5, &d6, &d7};
+    array<int32_t,8> const* c[8] = {&c0, &c1, &c2, &c3, &c4, &c5, &c6, &c7};
+#if defined(CUTE_ARCH_CPU_AVX512_VNNI_ENABLED) || defined(CUTE_ARCH_CPU_AVX_VNNI_ENABLED)
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a.data()));
+    int32_t const* b_quads = reinterpret_cast<int32_t const*>(b.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      __m256i vc = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(c[n]->data()));
+      __m256i vb = _mm256_set1_epi32(b_quads[n]);
+#if defined(CUTE_ARCH_CPU_AVX512_VNNI_ENABLED)
+      __m256i vd = _mm256_dpbusd_epi32(vc, va, vb);
+#else
+      __m256i vd = _mm256_dpbusd_avx_epi32(vc, va, vb);
+#endif
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(d[n]->data()), vd);
+    }
+#elif defined(CUTE_ARCH_CPU_NEON_I8MM_ENABLED)
+    uint8x16_t va0 = vld1q_u8(a.data());
+    uint8x16_t va1 = vld1q_u8(a.data() + 16);
+    int32_t const* b_quads = reinterpret_cast<int32_t const*>(b.data());
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      int8x16_t vb  = vreinterpretq_s8_s32(vdupq_n_s32(b_quads[n]));
+      int32x4_t vc0 = vld1q_s32(c[n]->data());
+      int32x4_t vc1 = vld1q_s32(c[n]->data() + 4);
+      vst1q_s32(d[n]->data(),     vusdotq_s32(vc0, va0, vb));
+      vst1q_s32(d[n]->data() + 4, vusdotq_s32(vc1, va1, vb));
+    }
+#else
+    CUTE_UNROLL
+    for (int n = 0; n < 8; ++n) {
+      CUTE_UNROLL
+      for (int m = 0; m < 8; ++m) {
+        int32_t acc = (*c[n])[m];
+        CUTE_UNROLL
+        for (int k = 0; k < 4; ++k) {
+          acc += int32_t(a[4*m+k]) * int32_t(b[4*n+k]);
+        }
+        (*d[n])[m] = acc;
+      }
+    }
+#endif
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // end namespace cute
@@ -0,0 +1,122 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/arch/mma_cpu.hpp>
+
+#include <cute/atom/mma_traits.hpp>
+#include <cute/layout.hpp>
+
+namespace cute
+{
+
+//
+// Host MMA traits
+//
+// A single host thread owns the whole atom. The value orders below group the values of each operand
+// into the vector registers of the corresponding CPU_* operation.
+//
+
+template <>
+struct MMA_Traits<CPU_8x8x1_F32F32F32F32>
+{
+  using ValTypeD = float;
+  using ValTypeA = float;
+  using ValTypeB = float;
+  using ValTypeC = float;
+
+  using Shape_MNK = Shape<_8,_8,_1>;
+  using ThrID   = Layout<_1>;
+  using ALayout = Layout<Shape<_1,_8>>;
+  using BLayout = Layout<Shape<_1,_8>>;
+  using CLayout = Layout<Shape<_1,_64>>;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <>
+struct MMA_Traits<CPU_16x8x1_F32F32F32F32>
+{
+  using ValTypeD = float;
+  using ValTypeA = float;
+  using ValTypeB = float;
+  using ValTypeC = float;
+
+  using Shape_MNK = Shape<_16,_8,_1>;
+  using ThrID   = Layout<_1>;
+  using ALayout = Layout<Shape<_1,_16>>;
+  using BLayout = Layout<Shape<_1,_8>>;
+  using CLayout = Layout<Shape<_1,_128>>;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <>
+struct MMA_Traits<CPU_8x8x2_F32BF16BF16F32>
+{
+  using ValTypeD = float;
+  using ValTypeA = bfloat16_t;
+  using ValTypeB = bfloat16_t;
+  using ValTypeC = float;
+
+  using Shape_MNK = Shape<_8,_8,_2>;
+  using ThrID   = Layout<_1>;
+  // (T1,(K2,M8)) -> (M8,K2)
+  using ALayout = Layout<Shape <_1,Shape <_2,_8>>,
+                         Stride<_0,Stride<_8,_1>>>;
+  // (T1,(K2,N8)) -> (N8,K2)
+  using BLayout = Layout<Shape <_1,Shape <_2,_8>>,
+                         Stride<_0,Stride<_8,_1>>>;
+  using CLayout = Layout<Shape<_1,_64>>;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <>
+struct MMA_Traits<CPU_8x8x4_S32U8S8S32>
+{
+  using ValTypeD = int32_t;
+  using ValTypeA = uint8_t;
+  using ValTypeB = int8_t;
+  using ValTypeC = int32_t;
+
+  using Shape_MNK = Shape<_8,_8,_4>;
+  using ThrID   = Layout<_1>;
+  // (T1,(K4,M8)) -> (M8,K4)
+  using ALayout = Layout<Shape <_1,Shape <_4,_8>>,
+                         Stride<_0,Stride<_8,_1>>>;
+  // (T1,(K4,N8)) -> (N8,K4)
+  using BLayout = Layout<Shape <_1,Shape <_4,_8>>,
+                         Stride<_0,Stride<_8,_1>>>;
+  using CLayout = Layout<Shape<_1,_64>>;
+};
+
+} // namespace cute
@@ -100,6 +100,11 @@ template <size_t N, class T>
 CUTE_HOST_DEVICE constexpr T getv(EBO<N, T, true> const&)
 { return {}; }
 
+// The type of element N, deduced from the unique base class EBO<N,T> of a tuple.
+//   Unevaluated only: this is how tuple_element avoids a recursive search of T...
+template <size_t N, class T, bool B>
+CUTE_HOST_DEVICE constexpr T ebo_type(EBO<N, T, B> const&);
+
 // Specialization for types T that are not empty;
 // the "dynamic tuple leaf."  Valid T here include int,
 // any other integral or floating-point type,
@@ -243,6 +248,10 @@ auto has_tuple_size(...) -> false_type;
 template <class T>
 struct is_tuple : decltype(detail::has_tuple_size((T*)0)) {};
 
+// Shortcut for the most common case, which avoids the overload resolution above
+template <class... T>
+struct is_tuple<tuple<T...>> : true_type {};
+
 //
 // make_tuple (value-based implementation)
 //
@@ -541,20 +550,15 @@ tuple_cat(Tuples const&... ts)
 
 namespace detail {
 
-template <size_t I, class TupleA, class TupleB>
+// Element-wise comparison of the common prefix of a and b, which is true if TupleA is not longer than TupleB
+//   A single right fold rather than one recursive instantiation per element
+template <class TupleA, class TupleB, size_t... I>
 CUTE_HOST_DEVICE constexpr
 auto
-equal_impl(TupleA const& a, TupleB const& b)
+equal_impl(TupleA const& a, TupleB const& b, index_sequence<I...>)
 {
-  if constexpr (I == tuple_size<TupleA>::value) {
-    return cute::true_type{};   // Terminal: TupleA is exhausted
-  } else if constexpr (I == tuple_size<TupleB>::value) {
-    return cute::false_type{};  // Terminal: TupleA is not exhausted, TupleB is exhausted
-  } else {
-    return (get<I>(a) == get<I>(b)) && equal_impl<I+1>(a,b);
-  }
-
-  CUTE_GCC_UNREACHABLE;
+  using Terminal = conditional_t<(tuple_size<TupleA>::value <= tuple_size<TupleB>::value), true_type, false_type>;
+  return ((get<I>(a) == get<I>(b)) && ... && Terminal{});
 }
 
 } // end namespace detail
@@ -565,7 +569,9 @@ CUTE_HOST_DEVICE constexpr
 auto
 operator==(TupleT const& t, TupleU const& u)
 {
-  return detail::equal_impl<0>(t, u);
+  constexpr size_t N = tuple_size<TupleT>::value < tuple_size<TupleU>::value ? tuple_size<TupleT>::value
+                                                                           : tuple_size<TupleU>::value;
+  return detail::equal_impl(t, u, make_index_sequence<N>{});
 }
 
 template <class TupleT, class TupleU,
@@ -666,8 +672,9 @@ struct tuple_size<cute::tuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, cute::tuple<T...>>
-    : CUTE_STL_NAMESPACE::tuple_element<I, CUTE_STL_NAMESPACE::tuple<T...>>
-{};
+{
+  using type = decltype(cute::detail::ebo_type<I>(cute::declval<cute::tuple<T...> const&>()));
+};
 
 template <class... T>
 struct tuple_size<const cute::tuple<T...>>
@@ -676,8 +683,9 @@ struct tuple_size<const cute::tuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, const cute::tuple<T...>>
-    : CUTE_STL_NAMESPACE::tuple_element<I, const CUTE_STL_NAMESPACE::tuple<T...>>
-{};
+{
+  using type = decltype(cute::detail::ebo_type<I>(cute::declval<cute::tuple<T...> const&>())) const;
+};
 
 } // end namespace CUTE_STL_NAMESPACE
 
@@ -704,8 +712,9 @@ struct tuple_size<cute::tuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, cute::tuple<T...>>
-    : CUTE_STL_NAMESPACE::tuple_element<I, CUTE_STL_NAMESPACE::tuple<T...>>
-{};
+{
+  using type = decltype(cute::detail::ebo_type<I>(cute::declval<cute::tuple<T...> const&>()));
+};
 
 template <class... T>
 struct tuple_size<const cute::tuple<T...>>
@@ -714,8 +723,9 @@ struct tuple_size<const cute::tuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, const cute::tuple<T...>>
-    : CUTE_STL_NAMESPACE::tuple_element<I, const CUTE_STL_NAMESPACE::tuple<T...>>
-{};
+{
+  using type = decltype(cute::detail::ebo_type<I>(cute::declval<cute::tuple<T...> const&>())) const;
+};
 
 } // end namepsace std
 #endif // CUTE_STL_NAMESPACE_IS_CUDA_STD
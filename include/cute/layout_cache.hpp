@@ -0,0 +1,328 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+#pragma once
+
+#include <cute/config.hpp>
+
+#include <cute/layout.hpp>
+#include <cute/layout_composed.hpp>
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+//
+// Host layout-algebra cache
+//
+// Layout algebra on static layouts is evaluated by the compiler. On layouts with dynamic shapes or
+// strides the same functions are evaluated at runtime on every call, e.g. every time a kernel's
+// arguments are converted on the host. memoize_layout() caches those evaluations per host thread,
+// keyed by the runtime values of the dynamic integers of their arguments: the static parts of the
+// arguments are part of the C++ type of the cache and never enter the key.
+//
+// Each cache is a small direct-mapped table, so a hit costs a hash of the key, one key comparison and
+// a copy of the result: 4-25 ns on a current x86 host, growing with the size of key and result. That is more than most layout functions cost
+// to evaluate directly -- coalesce, complement, the inverses, logical_product, and logical_divide and
+// composition of rank-2 layouts take 2-5 ns -- so the cache only pays off for evaluations well above
+// 10 ns, such as composition of rank-3 dynamic layouts (80-200 ns). benchmarks/cute/bench_layout_cache.cpp
+// measures both for common cases; the cached_* wrappers below only use the cache where it wins.
+//
+// freeze() evaluates a layout at every coordinate into a flat index table for hot host loops.
+//
+
+#ifndef CUTE_LAYOUT_CACHE_SLOTS
+// Number of entries of each cache, a power of two. An entry is evicted by a miss on its slot.
+#  define CUTE_LAYOUT_CACHE_SLOTS 64
+#endif
+
+namespace cute
+{
+
+// Per-thread counters of all layout caches
+struct LayoutCacheStats
+{
+  size_t hits   = 0;
+  size_t misses = 0;
+};
+
+namespace detail {
+
+static_assert((CUTE_LAYOUT_CACHE_SLOTS & (CUTE_LAYOUT_CACHE_SLOTS - 1)) == 0,
+              "CUTE_LAYOUT_CACHE_SLOTS must be a power of two.");
+
+inline LayoutCacheStats&
+layout_cache_stats()
+{
+  static thread_local LayoutCacheStats stats;
+  return stats;
+}
+
+// Entries of all caches of a thread are valid only for the current generation
+inline uint64_t&
+layout_cache_generation()
+{
+  static thread_local uint64_t generation = 1;
+  return generation;
+}
+
+// Number of dynamic integers of a layout-algebra argument
+template <class T>
+constexpr size_t
+layout_key_size();
+
+template <class T, int... I>
+constexpr size_t
+layout_key_size_tuple(int_sequence<I...>)
+{
+  return (size_t(0) + ... + layout_key_size<tuple_element_t<I,T>>());
+}
+
+template <class T>
+constexpr size_t
+layout_key_size()
+{
+  if constexpr (is_layout<T>::value && not is_composed_layout<T>::value) {
+    return layout_key_size<remove_cvref_t<decltype(declval<T>().shape())>>() +
+           layout_key_size<remove_cvref_t<decltype(declval<T>().stride())>>();
+  } else
+  if constexpr (is_tuple<T>::value) {
+    return layout_key_size_tuple<T>(make_int_sequence<tuple_size<T>::value>{});
+  } else {
+    static_assert(is_static<T>::value || is_integral<T>::value,
+                  "Layout cache arguments are Layouts, IntTuples, and tuples of those.");
+    return is_static<T>::value ? 0 : 1;
+  }
+}
+
+// Append the dynamic integers of a layout-algebra argument to a key
+template <class T>
+void
+append_layout_key(int64_t*& key, T const& t)
+{
+  if constexpr (is_layout<T>::value && not is_composed_layout<T>::value) {
+    append_layout_key(key, t.shape());
+    append_layout_key(key, t.stride());
+  } else
+  if constexpr (is_tuple<T>::value) {
+    for_each(t, [&](auto const& a) { append_layout_key(key, a); });
+  } else
+  if constexpr (not is_static<T>::value) {
+    *key++ = int64_t(t);
+  }
+}
+
+// Slot of a key in a direct-mapped cache
+template <size_t N>
+size_t
+layout_key_slot(std::array<int64_t,N> const& key)
+{
+  uint64_t h = 0;
+  for (int64_t k : key) {
+    h = (h ^ uint64_t(k)) * 0x9e3779b97f4a7c15ull;
+  }
+  // Mix the high bits into the low bits, which select the slot
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return size_t(h) & (CUTE_LAYOUT_CACHE_SLOTS - 1);
+}
+
+// The cache of one function on one set of argument types
+template <class Fn, class... Args>
+struct LayoutCache
+{
+  static constexpr size_t N = (size_t(0) + ... + layout_key_size<Args>());
+  using Key    = std::array<int64_t,N>;
+  using Result = decltype(declval<Fn const&>()(declval<Args const&>()...));
+
+  struct Entry
+  {
+    Key      key    = {};
+    Result   result = {};
+    uint64_t generation = 0;    // Empty until set to a generation of the thread
+  };
+
+  Entry entries[CUTE_LAYOUT_CACHE_SLOTS];
+
+  static LayoutCache&
+  get()
+  {
+    static thread_local LayoutCache cache;
+    return cache;
+  }
+};
+
+} // end namespace detail
+
+// Counters of the layout caches of the calling thread
+inline LayoutCacheStats&
+layout_cache_stats()
+{
+  return detail::layout_cache_stats();
+}
+
+// Clear all layout caches of the calling thread
+inline void
+layout_cache_clear()
+{
+  ++detail::layout_cache_generation();
+}
+
+//
+// memoize_layout -- evaluate fn(args...) once per distinct value of the dynamic integers of args
+//   fn is a stateless function object, e.g. a lambda without captures. Each type of fn has its own cache.
+//   Only worthwhile where fn(args...) costs well over 10 ns, see above.
+//
+
+template <class Fn, class... Args>
+auto
+memoize_layout(Fn const& fn, Args const&... args)
+{
+  static_assert(is_empty<Fn>::value, "Expected a stateless function object.");
+  using Cache = detail::LayoutCache<Fn, Args...>;
+
+  if constexpr (Cache::N == 0) {
+    // Fully static arguments are evaluated by the compiler
+    return fn(args...);
+  } else {
+    typename Cache::Key key;
+    int64_t* k = key.data();
+    (detail::append_layout_key(k, args), ...);
+
+    uint64_t generation = detail::layout_cache_generation();
+    auto& entry = Cache::get().entries[detail::layout_key_slot(key)];
+    if (entry.generation == generation && entry.key == key) {
+      ++layout_cache_stats().hits;
+      return entry.result;
+    }
+    ++layout_cache_stats().misses;
+    entry.result     = fn(args...);
+    entry.key        = key;
+    entry.generation = generation;
+    return entry.result;
+  }
+}
+
+//
+// Memoized layout algebra
+//   Composition and logical_divide of rank-3 and higher dynamic layouts take 80-200 ns and 15-20 ns,
+//   more than a cache hit. On lower ranks they are cheaper than a cache lookup and these wrappers
+//   evaluate them directly. The other layout functions always are, so none are wrapped.
+//
+
+namespace detail {
+
+template <class Layout>
+constexpr bool layout_cache_pays_off = decltype(rank(declval<Layout const&>()))::value >= 3;
+
+} // end namespace detail
+
+template <class LayoutA, class... Args>
+auto
+cached_composition(LayoutA const& a, Args const&... args)
+{
+  if constexpr (detail::layout_cache_pays_off<LayoutA>) {
+    return memoize_layout([](auto const&... x) { return composition(x...); }, a, args...);
+  } else {
+    return composition(a, args...);
+  }
+}
+
+template <class LayoutA, class... Args>
+auto
+cached_logical_divide(LayoutA const& a, Args const&... args)
+{
+  if constexpr (detail::layout_cache_pays_off<LayoutA>) {
+    return memoize_layout([](auto const&... x) { return logical_divide(x...); }, a, args...);
+  } else {
+    return logical_divide(a, args...);
+  }
+}
+
+//
+// FrozenLayout -- a layout evaluated at every 1-D coordinate
+//   frozen(i) == layout(i) for all 0 <= i < size(layout)
+//
+
+template <class Layout, class Index = int64_t>
+struct FrozenLayout
+{
+  Layout             layout;
+  std::vector<Index> table;
+
+  Index operator()(int64_t i) const { return table[i]; }
+
+  Index const* data() const { return table.data(); }
+
+  int64_t size() const { return int64_t(table.size()); }
+};
+
+template <class Index = int64_t, class Layout>
+FrozenLayout<Layout, Index>
+freeze(Layout const& layout)
+{
+  FrozenLayout<Layout, Index> frozen{layout, std::vector<Index>(size_t(size(layout)))};
+  Index* table = frozen.table.data();
+  int64_t n = int64_t(frozen.table.size());
+
+  if constexpr (is_layout<Layout>::value && not is_composed_layout<Layout>::value) {
+    assert(n == 0 || int64_t(cosize(layout)) - 1 <= int64_t(std::numeric_limits<Index>::max()));
+    // Odometer over the flattened modes, avoiding the divisions of idx2crd
+    auto flat_shape  = flatten_to_tuple(layout.shape());
+    auto flat_stride = flatten_to_tuple(layout.stride());
+    constexpr int R = tuple_size<decltype(flat_shape)>::value;
+    int64_t shape[R], stride[R], crd[R];
+    for_each(make_int_sequence<R>{}, [&](auto m) {
+      shape[m]  = int64_t(get<m>(flat_shape));
+      stride[m] = int64_t(get<m>(flat_stride));
+      crd[m]    = 0;
+    });
+    int64_t offset = 0;
+    for (int64_t i = 0; i < n; ++i) {
+      table[i] = Index(offset);
+      for (int m = 0; m < R; ++m) {
+        offset += stride[m];
+        if (++crd[m] < shape[m]) { break; }
+        offset -= shape[m] * stride[m];
+        crd[m] = 0;
+      }
+    }
+  } else {
+    for (int64_t i = 0; i < n; ++i) {
+      table[i] = Index(layout(i));
+    }
+  }
+  return frozen;
+}
+
+} // end namespace cute
@@ -556,7 +556,7 @@ struct tuple_size<cute::ArithmeticTuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, cute::ArithmeticTuple<T...>>
-  : CUTE_STL_NAMESPACE::tuple_element<I, CUTE_STL_NAMESPACE::tuple<T...>>
+  : CUTE_STL_NAMESPACE::tuple_element<I, cute::tuple<T...>>
 {};
 
 template <class... T>
@@ -566,7 +566,7 @@ struct tuple_size<const cute::ArithmeticTuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, const cute::ArithmeticTuple<T...>>
-  : CUTE_STL_NAMESPACE::tuple_element<I, const CUTE_STL_NAMESPACE::tuple<T...>>
+  : CUTE_STL_NAMESPACE::tuple_element<I, const cute::tuple<T...>>
 {};
 
 } // end namespace CUTE_STL_NAMESPACE
@@ -590,7 +590,7 @@ struct tuple_size<cute::ArithmeticTuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, cute::ArithmeticTuple<T...>>
-  : CUTE_STL_NAMESPACE::tuple_element<I, CUTE_STL_NAMESPACE::tuple<T...>>
+  : CUTE_STL_NAMESPACE::tuple_element<I, cute::tuple<T...>>
 {};
 
 template <class... T>
@@ -600,7 +600,7 @@ struct tuple_size<const cute::ArithmeticTuple<T...>>
 
 template <size_t I, class... T>
 struct tuple_element<I, const cute::ArithmeticTuple<T...>>
-  : CUTE_STL_NAMESPACE::tuple_element<I, const CUTE_STL_NAMESPACE::tuple<T...>>
+  : CUTE_STL_NAMESPACE::tuple_element<I, const cute::tuple<T...>>
 {};
 
 } // end namespace std
@@ -97,6 +97,11 @@ struct Sm90 {
   static int const kMinComputeCapability = 90; 
 };
 
+/// Host execution of device kernels (see cutlass/util/host_launch.h)
+struct Cpu {
+  static int const kMinComputeCapability = 0;
+};
+
 #if defined(CUTLASS_ENABLE_SYCL)
 struct IntelPVC {
   static int const kMinComputeCapability = 0;
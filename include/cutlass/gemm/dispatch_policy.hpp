@@ -146,6 +146,14 @@ struct MainloopSm80CpAsync {
   using ClusterShape = Shape<_1,_1,_1>;
 };
 
+// Host execution: operands are loaded straight from gmem into registers, with predicated gmem loads
+struct MainloopCpu {
+  constexpr static int Stages = 1;
+  using ArchTag = arch::Cpu;
+  using Schedule = KernelMultistage;
+  using ClusterShape = Shape<_1,_1,_1>;
+};
+
 // n-buffer in smem (cp.async), pipelined with Hopper GMMA, with predicated gmem loads, warp specialized dynamic schedule
 template<
   int Stages_,
@@ -52,6 +52,47 @@ static const int NumThreadsPerQuadPair = NumThreadsPerQuad * 2;
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+#if !defined(__CUDA_ARCH__) && !defined(__SYCL_DEVICE_ONLY__)
+
+namespace cutlass::detail {
+
+// Coordinates of the device thread that the calling host thread is executing.
+//
+// Host launchers (see cutlass/util/host_launch.h) set these before invoking a kernel on the host.
+// Outside of such a launch every index and dimension is zero.
+struct HostLaunchIndex {
+  uint thread_idx[3] = {0, 0, 0};
+  uint block_idx[3] = {0, 0, 0};
+  uint block_dim[3] = {0, 0, 0};
+  uint grid_dim[3] = {0, 0, 0};
+
+  // Set when a block whose threads are executed one after another reaches a barrier
+  bool serialized_barrier = false;
+
+  uint block_size() const {
+    return block_dim[0] * block_dim[1] * block_dim[2];
+  }
+};
+
+inline HostLaunchIndex& host_launch_index() {
+  static thread_local HostLaunchIndex index;
+  return index;
+}
+
+// Barriers cannot be honored for blocks of more than one host-executed thread
+inline void host_launch_barrier() {
+  HostLaunchIndex& index = host_launch_index();
+  if (index.block_size() > 1) {
+    index.serialized_barrier = true;
+  }
+}
+
+} // namespace cutlass::detail
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 // Generalization of CUDA's threadIdx, blockIdx, and gridDim.
 
 CUTLASS_HOST_DEVICE uint ThreadIdxX() {
@@ -60,7 +101,7 @@ CUTLASS_HOST_DEVICE uint ThreadIdxX() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::local_id::x();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().thread_idx[0];
 #endif
 }
 
@@ -70,7 +111,7 @@ CUTLASS_HOST_DEVICE uint ThreadIdxY() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::local_id::y();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().thread_idx[1];
 #endif
 }
 
@@ -80,7 +121,7 @@ CUTLASS_HOST_DEVICE uint ThreadIdxZ() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::local_id::z();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().thread_idx[2];
 #endif
 }
 
@@ -90,7 +131,7 @@ CUTLASS_HOST_DEVICE uint BlockIdxX() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::work_group_id::x();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().block_idx[0];
 #endif
 }
 
@@ -100,7 +141,7 @@ CUTLASS_HOST_DEVICE uint BlockIdxY() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::work_group_id::y();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().block_idx[1];
 #endif
 }
 
@@ -110,7 +151,7 @@ CUTLASS_HOST_DEVICE uint BlockIdxZ() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::work_group_id::z();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().block_idx[2];
 #endif
 }
 
@@ -120,7 +161,7 @@ CUTLASS_HOST_DEVICE uint BlockDimX() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::local_range::x();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().block_dim[0];
 #endif
 }
 
@@ -130,7 +171,7 @@ CUTLASS_HOST_DEVICE uint BlockDimY() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::local_range::y();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().block_dim[1];
 #endif
 }
 
@@ -140,7 +181,7 @@ CUTLASS_HOST_DEVICE uint BlockDimZ() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::local_range::z();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().block_dim[2];
 #endif
 }
 
@@ -150,7 +191,7 @@ CUTLASS_HOST_DEVICE uint GridDimX() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::work_group_range::x();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().grid_dim[0];
 #endif
 }
 
@@ -160,7 +201,7 @@ CUTLASS_HOST_DEVICE uint GridDimY() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::work_group_range::y();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().grid_dim[1];
 #endif
 }
 
@@ -170,7 +211,7 @@ CUTLASS_HOST_DEVICE uint GridDimZ() {
 #elif defined(__SYCL_DEVICE_ONLY__)
   return syclcompat::work_group_range::z();
 #else
-  return 0;
+  return cutlass::detail::host_launch_index().grid_dim[2];
 #endif
 }
 
@@ -187,6 +228,8 @@ CUTLASS_DEVICE void syncthreads() {
   __syncthreads();
 #elif defined(__SYCL_DEVICE_ONLY__)
   syclcompat::wg_barrier();
+#else
+  cutlass::detail::host_launch_barrier();
 #endif
 }
 
@@ -198,7 +241,8 @@ CUTLASS_DEVICE int syncthreads_and(int cond) {
   sycl::group_barrier(group);
   return sycl::all_of_group(group, cond);
 #else
-  return 0;
+  cutlass::detail::host_launch_barrier();
+  return cond;
 #endif
 }
 
@@ -207,6 +251,8 @@ CUTLASS_DEVICE void syncwarp() {
   __syncwarp();
 #elif defined(__SYCL_DEVICE_ONLY__)
   sycl::group_barrier(syclcompat::get_nd_item<1>().get_sub_group());
+#else
+  cutlass::detail::host_launch_barrier();
 #endif
 }
 
@@ -390,11 +390,19 @@ class EmitGemmInstance:
   >;
 """
 
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "Operation_${operation_name}"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  manifest.append(new ${gemm_kind}<Operation_${operation_name}>("${operation_name}"));
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -480,11 +488,19 @@ class EmitSparseGemmInstance:
   >;
 """
 
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "Operation_${operation_name}"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  manifest.append(new ${gemm_kind}<Operation_${operation_name}>("${operation_name}"));
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -608,13 +624,19 @@ struct ${operation_name}${operation_suffix} :
   public ${operation_name}_base { };
 """
 
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  manifest.append(new ${gemm_kind}<
-      cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>
-    >("${operation_name}"));
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -759,15 +781,19 @@ struct ${operation_name} :
   public ${operation_name}_base { };
 
 """
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  {
-    using GemmKernel = cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>;
-    manifest.append(
-      new ${gemm_kind}<GemmKernel>("${operation_name}"));
-  }
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -902,13 +928,19 @@ class EmitGemmPlanarComplexInstance:
     public Operation_${operation_name} { };
 """
 
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  manifest.append(new ${gemm_kind}<
-    cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>
-  >("${operation_name}"));
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -988,13 +1020,19 @@ class EmitGemmPlanarComplexArrayInstance:
   struct ${operation_name} : public Operation_${operation_name} { };
 """
 
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  manifest.append(new ${gemm_kind}<
-    cutlass::gemm::device::GemmUniversalAdapter<${operation_name}>
-  >("${operation_name}"));
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -1091,13 +1129,19 @@ struct ${operation_name}${operation_suffix} :
   public ${operation_name}_base { };
 """
 
+  # Device-level type wrapped by the library operation
+  def operator_template(self):
+    return "cutlass::gemm::device::GemmGrouped<${operation_name}>"
+
   #
   def instance_template(self):
     return """
 ${compile_guard_start}
-  manifest.append(new ${gemm_kind}<
-    cutlass::gemm::device::GemmGrouped<${operation_name}>
-  >("${operation_name}"));
+using Operator_${operation_name} = ${operator};
+
+static Operation *construct_${operation_name}() {
+  return new ${gemm_kind}<Operator_${operation_name}>("${operation_name}");
+}
 ${compile_guard_end}
 """
 
@@ -1199,6 +1243,27 @@ class EmitGemmConfigurationLibrary:
       GemmKind.Grouped: 'GemmGroupedOperation'
     }
 
+    # Kinds whose operations report OperationKind::kGemm with a plain GemmDescription. Operations of
+    # other kinds are not described by records; they are constructed when their section is materialized.
+    self.record_kinds = {
+      GemmKind.Gemm, GemmKind.Universal, GemmKind.Universal3x,
+      GemmKind.PlanarComplex, GemmKind.PlanarComplexArray, GemmKind.Grouped
+    }
+
+    self.constructed_kind_ids = {
+      GemmKind.Sparse: 'OperationKind::kSparseGemm'
+    }
+
+    self.gemm_kind_ids = {
+      GemmKind.Gemm: 'GemmKind::kGemm',
+      GemmKind.Sparse: 'GemmKind::kSparse',
+      GemmKind.Universal: 'GemmKind::kUniversal',
+      GemmKind.Universal3x: 'GemmKind::kUniversal',
+      GemmKind.PlanarComplex: 'GemmKind::kPlanarComplex',
+      GemmKind.PlanarComplexArray: 'GemmKind::kPlanarComplexArray',
+      GemmKind.Grouped: 'GemmKind::kGrouped'
+    }
+
     self.wmma_guard_start = "#if defined(CUTLASS_ARCH_WMMA_SM${sm_number}_ENABLED)"
 
     self.separator = """
@@ -1212,7 +1277,7 @@ class EmitGemmConfigurationLibrary:
 */
 """
 
-    self.initialize_function_template = """
+    self.namespace_template = """
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -1220,10 +1285,62 @@ namespace cutlass {
 namespace library {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
+"""
+    self.initialize_function_template = """
+///////////////////////////////////////////////////////////////////////////////////////////////////
 
 void initialize_${configuration_name}(Manifest &manifest) {
 
 """
+    self.append_template = """${compile_guard_start}
+  manifest.append(construct_${operation_name}());
+${compile_guard_end}"""
+
+    # Operations of kinds without records, appended when their section is materialized
+    self.constructed_function_template = """
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+static void initialize_${constructed_kind}_${configuration_name}(Manifest &manifest) {
+"""
+
+    # Generator-known fields of each operation, registered without constructing the operation. The
+    # stage and warp counts are those the operation reports, which the generator may leave to the kernel.
+    self.register_function_template = """
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+void register_${configuration_name}(Manifest &manifest) {
+${compile_guard_start}
+${register_sections}${compile_guard_end}"""
+    self.register_records_template = """  static GemmOperationRecord const records[] = {
+${records}
+  };
+
+  manifest.register_section(${min_cc}, "${configuration_name}", records, sizeof(records) / sizeof(records[0]));
+"""
+    self.register_constructed_template = """  manifest.register_section(${operation_kind}, ${min_cc}, "${configuration_name}",
+    initialize_${constructed_kind}_${configuration_name});
+"""
+    self.record_template = """    {
+      "${operation_name}",
+      ${gemm_kind},
+      {${threadblock_shape}}, ${stages},
+      {${warp_count}},
+      {${cluster_shape}}, {${instruction_shape}},
+      NumericTypeMap<${element_accumulator}>::kId,
+      OpcodeClassMap<${opcode_class}>::kId,
+      MathOperationMap<${math_operation}>::kId,
+      ${min_compute}, ${max_compute},
+      NumericTypeMap<${element_a}>::kId, LayoutMap<${layout_a}>::kId, ${align_a}, ComplexTransformMap<${transform_a}>::kId,
+      NumericTypeMap<${element_b}>::kId, LayoutMap<${layout_b}>::kId, ${align_b}, ComplexTransformMap<${transform_b}>::kId,
+      NumericTypeMap<${element_c}>::kId, LayoutMap<${layout_c}>::kId, ${align_c},
+      NumericTypeMap<${element_d}>::kId, LayoutMap<${layout_d}>::kId, ${align_d},
+      NumericTypeMap<${element_epilogue}>::kId,
+      construct_${operation_name}
+    }"""
     self.epilogue_template = """
 
 }
@@ -1279,12 +1396,67 @@ void initialize_${configuration_name}(Manifest &manifest) {
       'configuration_name': self.configuration_name,
       'operation_name': operation.procedural_name(),
       'gemm_kind': self.gemm_kind_wrappers[operation.gemm_kind],
-      'compile_guard_start': SubstituteTemplate(self.wmma_guard_start, {'sm_number': str(operation.arch)}) \
-        if operation.tile_description.math_instruction.opcode_class == OpcodeClass.WmmaTensorOp else "",
-      'compile_guard_end': "#endif" \
-        if operation.tile_description.math_instruction.opcode_class == OpcodeClass.WmmaTensorOp else ""
+      'operator': self.operator_type(operation),
+      'compile_guard_start': self.compile_guard_start(operation),
+      'compile_guard_end': self.compile_guard_end(operation)
       }))
 
+  def compile_guard_start(self, operation):
+    if operation.tile_description.math_instruction.opcode_class == OpcodeClass.WmmaTensorOp:
+      return SubstituteTemplate(self.wmma_guard_start, {'sm_number': str(operation.arch)})
+    return ""
+
+  def compile_guard_end(self, operation):
+    if operation.tile_description.math_instruction.opcode_class == OpcodeClass.WmmaTensorOp:
+      return "#endif"
+    return ""
+
+  def operator_type(self, operation):
+    return SubstituteTemplate(self.instance_emitter[operation.gemm_kind]().operator_template(), {
+      'operation_name': operation.procedural_name()
+      })
+
+  def emit_record(self, operation):
+    tile = operation.tile_description
+
+    # Read from the type as the wrappers do: 3.x kernels may resolve the stage count ("auto") and
+    # the warp counts themselves
+    operator = 'Operator_' + operation.procedural_name()
+    warp_count = operator + ('::WarpCount' if operation.is_3x else '::GemmKernel::WarpCount')
+
+    values = {
+      'operation_name': operation.procedural_name(),
+      'gemm_kind': self.gemm_kind_ids[operation.gemm_kind],
+      'threadblock_shape': ', '.join(str(x) for x in tile.threadblock_shape),
+      'stages': operator + '::kStages',
+      'warp_count': ', '.join(warp_count + '::' + dim for dim in ('kM', 'kN', 'kK')),
+      'cluster_shape': ', '.join(str(x) for x in tile.cluster_shape),
+      'instruction_shape': ', '.join(str(x) for x in tile.math_instruction.instruction_shape),
+      'element_accumulator': DataTypeTag[operation.accumulator_type()],
+      'opcode_class': OpcodeClassTag[tile.math_instruction.opcode_class],
+      'math_operation': MathOperationTag[tile.math_instruction.math_operation],
+      'min_compute': str(tile.minimum_compute_capability),
+      'max_compute': str(tile.maximum_compute_capability),
+      'element_epilogue': DataTypeTag[operation.element_epilogue],
+    }
+    for name, tensor in (('a', operation.A), ('b', operation.B), ('c', operation.C), ('d', operation.D)):
+      values['element_' + name] = DataTypeTag[tensor.element]
+      values['layout_' + name] = LayoutTag[tensor.layout]
+      values['align_' + name] = str(tensor.alignment)
+
+    # The wrappers describe C and D by the alignment of the epilogue, which 2.x kernels with built-in
+    # epilogue functors derive from the vector length of their output tile iterator
+    alignment_c = operation.C.alignment
+    element_c_size = DataTypeSize[operation.C.element]
+    if operation.gemm_kind in (GemmKind.Gemm, GemmKind.Sparse, GemmKind.Universal, GemmKind.Grouped) and \
+        isinstance(operation.epilogue_functor, enum.Enum) and element_c_size > 0:
+      alignment_c = min(operation.C.alignment * element_c_size, 128) // element_c_size
+    values['align_c'] = str(alignment_c)
+    values['align_d'] = str(alignment_c)
+    values['transform_a'] = ComplexTransformTag[operation.A.complex_transform]
+    values['transform_b'] = ComplexTransformTag[operation.B.complex_transform]
+    return SubstituteTemplate(self.record_template, values)
+
   def __exit__(self, exception_type, exception_value, traceback):
 
     # Write includes
@@ -1298,13 +1470,61 @@ void initialize_${configuration_name}(Manifest &manifest) {
     for instance_definition in self.instance_definitions:
       self.configuration_file.write(instance_definition)
 
+    self.configuration_file.write(self.namespace_template)
+
+    # Write functions constructing each wrapper object
+    for instance_wrapper in self.instance_wrappers:
+      self.configuration_file.write(instance_wrapper)
+
     # Add wrapper objects within initialize() function
     self.configuration_file.write(SubstituteTemplate(self.initialize_function_template, {
       'configuration_name': self.configuration_name
       }))
 
-    for instance_wrapper in self.instance_wrappers:
-      self.configuration_file.write(instance_wrapper)
+    for operation in self.operations:
+      self.configuration_file.write(SubstituteTemplate(self.append_template, {
+        'operation_name': operation.procedural_name(),
+        'compile_guard_start': self.compile_guard_start(operation),
+        'compile_guard_end': self.compile_guard_end(operation)
+        }))
+
+    recorded = [operation for operation in self.operations if operation.gemm_kind in self.record_kinds]
+    constructed = collections.OrderedDict()
+    for operation in self.operations:
+      if operation.gemm_kind not in self.record_kinds:
+        constructed.setdefault(operation.gemm_kind, []).append(operation)
+
+    for gemm_kind, operations in constructed.items():
+      self.configuration_file.write(SubstituteTemplate(self.constructed_function_template, {
+        'configuration_name': self.configuration_name,
+        'constructed_kind': GemmKindNames[gemm_kind]
+        }))
+      for operation in operations:
+        self.configuration_file.write(SubstituteTemplate(self.append_template, {
+          'operation_name': operation.procedural_name(),
+          'compile_guard_start': self.compile_guard_start(operation),
+          'compile_guard_end': self.compile_guard_end(operation)
+          }))
+
+    # Operations of one configuration share their opcode class and therefore their compile guard
+    section_values = {
+      'configuration_name': self.configuration_name,
+      'min_cc': str(self.operations[0].arch)
+    }
+
+    register_sections = ""
+    if recorded:
+      register_sections += SubstituteTemplate(self.register_records_template, dict(section_values,
+        records = ',\n'.join(self.emit_record(operation) for operation in recorded)))
+    for gemm_kind in constructed:
+      register_sections += SubstituteTemplate(self.register_constructed_template, dict(section_values,
+        operation_kind = self.constructed_kind_ids[gemm_kind],
+        constructed_kind = GemmKindNames[gemm_kind]))
+
+    self.configuration_file.write(SubstituteTemplate(self.register_function_template, dict(section_values,
+      register_sections = register_sections,
+      compile_guard_start = self.compile_guard_start(self.operations[0]),
+      compile_guard_end = self.compile_guard_end(self.operations[0]))))
 
     self.configuration_file.write(self.epilogue_template)
     self.configuration_file.close()
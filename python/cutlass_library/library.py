@@ -609,6 +609,17 @@ OperationKindNames = {
   , OperationKind.Conv3d: 'conv3d'
 }
 
+#
+OperationKindTag = {
+  OperationKind.Gemm: 'cutlass::library::OperationKind::kGemm'
+  , OperationKind.RankK: 'cutlass::library::OperationKind::kRankK'
+  , OperationKind.Rank2K: 'cutlass::library::OperationKind::kRank2K'
+  , OperationKind.Trmm: 'cutlass::library::OperationKind::kTrmm'
+  , OperationKind.Symm: 'cutlass::library::OperationKind::kSymm'
+  , OperationKind.Conv2d: 'cutlass::library::OperationKind::kConv2d'
+  , OperationKind.Conv3d: 'cutlass::library::OperationKind::kConv3d'
+}
+
 #
 class Target(enum.Enum):
   library = enum_auto()
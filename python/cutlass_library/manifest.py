@@ -36,6 +36,7 @@ and building code
 """
 
 import enum
+import hashlib
 import logging
 import os.path
 import shutil
@@ -205,13 +206,26 @@ class EmitOperationKindLibrary:
   Those functions are defined in subdirectories.
   The mapping from OperationKind to emitter handles the details
   of what happens in each of those subdirectories.
+
+  Each subclass file additionally defines a C entry point,
+
+  extern "C" void cutlass_library_register_sections_{library_tag}_sm{min_cc}_{subclass_name}_{operation_kind}(Manifest *manifest);
+
+  which registers the subclass with the manifest without constructing any
+  operation (see Manifest::register_section). GEMM subclasses register the
+  static record table of each configuration, and an initializer for sparse
+  GEMMs, which records do not describe; other kinds register the subclass
+  initializer. The initializer has internal linkage and the entry
+  point carries a tag of the library's kernel set, so a library opened by
+  Manifest::load_library() cannot have them interposed by another library.
   """
 
-  def __init__(self, generated_path, min_cc, kind, args):
+  def __init__(self, generated_path, min_cc, kind, args, library_tag = ''):
     self.generated_path = generated_path
     self.min_cc = min_cc
     self.kind = kind
     self.args = args
+    self.library_tag = library_tag
     self.emitters = {
       OperationKind.Gemm: EmitGemmConfigurationLibrary,
       OperationKind.Conv2d: EmitConv2dConfigurationLibrary,
@@ -243,11 +257,45 @@ namespace library {
 // Entry point to construct operations
 //
 void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Manifest &manifest) {
+"""
+    self.section_template = """
+
+namespace {
+
+//
+// Constructs the operations of this subclass
+//
+void initialize_section(Manifest &manifest) {
+"""
+    self.section_entry_template = """
+} // namespace
+
+//
+// Entry point to construct operations
+//
+void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Manifest &manifest) {
+  initialize_section(manifest);
+}
 """
     self.configuration_prototype_template = "void initialize_${configuration_name}(Manifest &manifest);\n"
     self.configuration_template = "  initialize_${configuration_name}(manifest);\n"
+    self.record_prototype_template = "void register_${configuration_name}(Manifest &manifest);\n"
+    self.record_template = "  register_${configuration_name}(*manifest);\n"
     self.subclass_call_template = "  initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(manifest);\n"
     self.subclass_prototype_template = "void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Manifest &manifest);\n"
+    self.register_template = """
+//
+// Entry point to register operations without constructing them
+//
+extern "C" void cutlass_library_register_sections_${library_tag}_sm${min_cc}_${subclass_name}_${operation_name}(Manifest *manifest) {
+${register_calls}}
+"""
+    self.register_section_template = """  manifest->register_section(
+    ${operation_kind},
+    ${min_cc},
+    "sm${min_cc}_${subclass_name}_${operation_name}",
+    initialize_section);
+"""
     self.epilogue_template ="""}
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -357,15 +405,31 @@ void initialize_all_sm${min_cc}_${subclass_name}_${operation_name}_operations(Ma
         'subclass_name': subclass_name,
         'operation_name': OperationKindNames[self.kind]
       }
-      subclass_file.write(SubstituteTemplate(self.entry_template, subclass_cfg))
+      configurations = self.subclass_configurations[subclass_name]
 
-      for configuration in self.subclass_configurations[subclass_name]:
+      # GEMM configurations register static tables of operation records
+      if self.kind == OperationKind.Gemm:
+        for configuration in configurations:
+          subclass_file.write(SubstituteTemplate(self.record_prototype_template, {'configuration_name': configuration}))
+        register_calls = "".join(
+          SubstituteTemplate(self.record_template, {'configuration_name': configuration}) for configuration in configurations)
+      else:
+        register_calls = SubstituteTemplate(self.register_section_template, dict(subclass_cfg,
+          operation_kind = OperationKindTag[self.kind]))
+
+      subclass_file.write(self.section_template)
+
+      for configuration in configurations:
         subclass_file.write(
           SubstituteTemplate(self.configuration_template, {
             'configuration_name': configuration
           }))
 
-      subclass_file.write(self.epilogue_template)
+      subclass_file.write("}\n")
+      subclass_file.write(SubstituteTemplate(self.section_entry_template, subclass_cfg))
+      subclass_file.write(SubstituteTemplate(self.register_template, dict(subclass_cfg,
+        library_tag = self.library_tag, register_calls = register_calls)))
+      subclass_file.write(self.epilogue_template[2:])
       subclass_file.close()
 
       # Write the call to initialize_all for this subclass to the top-level file
@@ -396,14 +460,26 @@ class EmitInterfaceLibrary:
 
   That function first prepares the manifest, and then
   calls all of the functions declared in this file.
+
+  The file also defines
+
+  extern "C" void cutlass_library_register_sections(Manifest *manifest);
+
+  which registers every {min_cc x subclass} group with the manifest without
+  constructing any operation. It calls a register_all() with internal linkage
+  and the library-tagged entry points of EmitOperationKindLibrary, so that
+  Manifest::load_library() registers the sections of the opened library.
   """
 
-  def __init__(self, generated_path, operation_count, args):
+  def __init__(self, generated_path, operation_count, args, library_tag = ''):
     self.generated_path = generated_path
     self.args = args
+    self.library_tag = library_tag
 
     self.prototypes = []
     self.fn_calls = []
+    self.section_prototypes = []
+    self.section_calls = []
     self.operation_count = str(operation_count)
 
     self.top_level_hdr_template = '''
@@ -433,12 +509,24 @@ ${fn_calls}
 \t\t\tmanifest.reserve(${operation_count});\n
 ${fn_calls}
 \t\t}
+'''
+
+    self.top_level_register = '''
+${section_prototypes}
+
+\t\tstatic void register_all(Manifest &manifest) {
+${section_calls}
+\t\t}
 '''
 
     self.top_level_suffix = '''
 \t} // namespace library
 } // namespace cutlass
 
+extern "C" void cutlass_library_register_sections(cutlass::library::Manifest *manifest) {
+\tcutlass::library::register_all(*manifest);
+}
+
 '''
 
   #
@@ -468,6 +556,19 @@ ${fn_calls}
       "\t\t\tinitialize_all_${operation_kind}_operations(manifest);",
       {'operation_kind': operation_name}))
 
+  #
+  def emit_section(self, operation_name, min_cc, subclass_name):
+    section_cfg = {'operation_kind': operation_name, 'min_cc': str(min_cc), 'subclass_name': subclass_name,
+      'library_tag': self.library_tag}
+
+    self.section_prototypes.append(SubstituteTemplate(
+      "\t\textern \"C\" void cutlass_library_register_sections_${library_tag}_sm${min_cc}_${subclass_name}_${operation_kind}(Manifest *manifest);",
+      section_cfg))
+
+    self.section_calls.append(SubstituteTemplate(
+      "\t\t\tcutlass_library_register_sections_${library_tag}_sm${min_cc}_${subclass_name}_${operation_kind}(&manifest);",
+      section_cfg))
+
   #
   def __exit__(self, exception_type, exception_value, traceback):
     _LOGGER.debug("*** EmitInterfaceLibrary::__exit__")
@@ -478,6 +579,11 @@ ${fn_calls}
     self.top_level_file.write(SubstituteTemplate(self.top_level_initialize,
                               {'operation_count': self.operation_count, 'fn_calls':"\n".join(self.fn_calls)}))
 
+    # Write out register_all method
+    self.top_level_file.write(SubstituteTemplate(self.top_level_register,
+                              {'section_prototypes': "\n".join(self.section_prototypes),
+                               'section_calls': "\n".join(self.section_calls)}))
+
     self.top_level_file.write(self.top_level_suffix)
     self.top_level_file.close()
 
@@ -788,11 +894,21 @@ class Manifest:
 
     os.mkdir(generated_path)
 
-    with interface_emitters[target](generated_path, self.operation_count, self.args) as iface_emitter:
+    # Generated entry points that differ between kernel libraries carry this tag, so that the
+    # symbols of a library opened by Manifest::load_library() are not interposed
+    library_tag = hashlib.sha1("\n".join(sorted(self.selected_kernels)).encode()).hexdigest()[:16]
+
+    with interface_emitters[target](generated_path, self.operation_count, self.args, library_tag) as iface_emitter:
       top_level_path = iface_emitter.top_level_path
       for operation_kind in self.operations.keys():
         iface_emitter.emit(OperationKindNames[operation_kind])
 
+        # One lazily materialized section per {min_cc x subclass}, matching EmitOperationKindLibrary
+        for min_cc, configurations in sorted(self.operations[operation_kind].items()):
+          subclasses = set(operations[0].extended_name() for operations in configurations.values())
+          for subclass in sorted(subclasses):
+            iface_emitter.emit_section(OperationKindNames[operation_kind], min_cc, subclass)
+
     source_files = {}
     for kind in self.operations.keys():
       source_files[kind] = {}
@@ -801,7 +917,7 @@ class Manifest:
 
     for operation_kind, ops in self.operations.items():
       for min_cc, configurations in sorted(ops.items()):
-        with operation_emitters[target](generated_path, min_cc, operation_kind, self.args) as operation_kind_emitter:
+        with operation_emitters[target](generated_path, min_cc, operation_kind, self.args, library_tag) as operation_kind_emitter:
           for configuration_name, operations in configurations.items():
             _LOGGER.info(f"Emitting {configuration_name} with {len(operations)} operation{'' if len(operations) == 1 else 's'}.")
             operation_kind_emitter.emit(configuration_name, operations)
@@ -0,0 +1,279 @@
+#################################################################################################
+#
+# Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+# SPDX-License-Identifier: BSD-3-Clause
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# 3. Neither the name of the copyright holder nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+# FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+# DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+# SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+# CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+# OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+#################################################################################################
+
+"""
+Compile-time benchmarks of the CuTe headers.
+
+Each benchmark is a translation unit that is compiled front-end only (-fsyntax-only):
+
+  * one translation unit per header that only includes the header, which measures its parse cost,
+  * the stress tests in cute/, which instantiate the tuple, int_tuple, and layout metaprogramming
+    in the mix that CuTe collectives do, and
+  * unit tests of the repository, which show what a change saves in translation units that are
+    actually built. These need the GoogleTest headers on the include path.
+
+For each benchmark the script reports the wall time, the compiler's own front-end and template
+instantiation times, the number of template instantiations, and the peak memory of the compiler.
+The compiler's timings are taken from -ftime-report (GCC) or -ftime-trace (Clang); instantiation
+counts are only reported by Clang. GCC also reports the memory allocated by its garbage collector,
+which unlike the timings is deterministic and so the better measure of small changes.
+
+Results may be saved as JSON and compared against a previous run:
+
+  python compile_time.py --compiler g++ -I include -I /usr/local/cuda/include --save baseline.json
+  python compile_time.py --compiler g++ -I include -I /usr/local/cuda/include --baseline baseline.json --tolerance 5
+
+The CUTLASS headers need the CUDA toolkit headers, or with -D CUTLASS_ENABLE_SYCL a SYCL compiler
+such as icpx and --flags="-std=c++17 -fsycl".
+"""
+
+import argparse
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+import tempfile
+import time
+
+# Headers whose parse cost is tracked on their own
+HEADERS = [
+  "cute/config.hpp",
+  "cute/container/tuple.hpp",
+  "cute/int_tuple.hpp",
+  "cute/algorithm/tuple_algorithms.hpp",
+  "cute/layout.hpp",
+  "cute/tensor.hpp",   # Includes the atoms and algorithms
+]
+
+# Unit tests, relative to the repository root, compiled as they are in the build
+UNITS = [
+  "test/unit/cute/core/composition.cpp",
+  "test/unit/cute/core/logical_divide.cpp",
+  "test/unit/gemm/device/cpu_gemm_f32_f32_f32.cpp",
+]
+
+# Include directories of the unit tests, relative to the repository root
+UNIT_INCLUDES = ["test/unit/common", "tools/util/include"]
+
+# -ftime-report phases (GCC) that make up the front end
+GCC_FRONTEND_PHASES = ["phase setup", "phase parsing", "phase lang. deferred", "phase opt and generate"]
+
+
+def is_clang(compiler):
+  """Returns true if the compiler identifies as Clang"""
+  try:
+    out = subprocess.run([compiler, "--version"], capture_output=True, text=True).stdout
+  except OSError:
+    return False
+  return "clang" in out.lower()
+
+
+def parse_gcc_time_report(report):
+  """Returns (frontend seconds, template instantiation seconds, GC megabytes) from GCC's -ftime-report"""
+  # e.g. " phase parsing                      :   0.50 ( 40%)   0.10 ( 50%)   0.61 ( 41%)    40M ( 50%)"
+  pattern = re.compile(r"^\s*(.+?)\s*:\s*([\d.]+)\s*\(\s*\d+%\)\s*([\d.]+)\s*\(\s*\d+%\)\s*([\d.]+)")
+  # e.g. " TOTAL                              :   4.71          1.52          6.32          365M"
+  total = re.compile(r"^\s*TOTAL\s*:.*?(\d+)([kMG])\s*$")
+  wall = {}
+  ggc = None
+  for line in report.splitlines():
+    match = pattern.match(line)
+    if match:
+      wall[match.group(1)] = float(match.group(4))
+    match = total.match(line)
+    if match:
+      ggc = float(match.group(1)) * {"k": 1.0 / 1024, "M": 1.0, "G": 1024.0}[match.group(2)]
+  frontend = sum(wall.get(phase, 0.0) for phase in GCC_FRONTEND_PHASES) if wall else None
+  instantiation = wall.get("template instantiation")
+  return frontend, instantiation, ggc
+
+
+def parse_clang_time_trace(path):
+  """Returns (frontend seconds, template instantiation seconds, instantiations) from Clang's -ftime-trace"""
+  with open(path) as trace_file:
+    events = json.load(trace_file).get("traceEvents", [])
+  totals = {}
+  instantiations = 0
+  for event in events:
+    name = event.get("name", "")
+    if name.startswith("Total "):
+      totals[name[len("Total "):]] = event.get("dur", 0) * 1e-6
+    elif name in ("InstantiateClass", "InstantiateFunction"):
+      instantiations += 1
+  instantiation = totals.get("InstantiateClass", 0.0) + totals.get("InstantiateFunction", 0.0)
+  return totals.get("Frontend"), instantiation, instantiations
+
+
+def compile_once(compiler, clang, source, flags, workdir):
+  """Compiles source front-end only and returns a dict of measurements"""
+  cmd = [compiler, "-fsyntax-only"] + flags
+  trace = None
+  if clang:
+    trace = os.path.join(workdir, os.path.basename(source) + ".json")
+    cmd += ["-ftime-trace=" + trace, "-ftime-trace-granularity=0"]
+  else:
+    cmd += ["-ftime-report"]
+  cmd.append(source)
+
+  with tempfile.TemporaryFile(mode="w+") as stderr:
+    start = time.perf_counter()
+    process = subprocess.Popen(cmd, stdout=subprocess.DEVNULL, stderr=stderr)
+    _, status, usage = os.wait4(process.pid, 0)
+    wall = time.perf_counter() - start
+    process.returncode = os.waitstatus_to_exitcode(status)
+    stderr.seek(0)
+    report = stderr.read()
+
+  if process.returncode != 0:
+    raise RuntimeError("Failed to compile {}:\n{}\n{}".format(source, " ".join(cmd), report))
+
+  result = {"wall": wall, "frontend": None, "instantiation": None, "instantiations": None,
+            "ggc_mb": None, "max_rss_mb": usage.ru_maxrss / 1024.0}
+  if clang:
+    result["frontend"], result["instantiation"], result["instantiations"] = parse_clang_time_trace(trace)
+  else:
+    result["frontend"], result["instantiation"], result["ggc_mb"] = parse_gcc_time_report(report)
+  return result
+
+
+def benchmark(compiler, clang, sources, flags, repeat, workdir):
+  """Returns the per-source measurements with the fastest wall time of repeat compilations"""
+  results = {}
+  for name, source in sources:
+    runs = [compile_once(compiler, clang, source, flags, workdir) for _ in range(repeat)]
+    results[name] = min(runs, key=lambda run: run["wall"])
+    print(format_row(name, results[name]), flush=True)
+  return results
+
+
+def format_value(value, fmt):
+  return "-" if value is None else fmt.format(value)
+
+
+def change(result, baseline):
+  """Returns the percent change from baseline: of GC memory if both have it, otherwise of wall time"""
+  key = "ggc_mb" if result.get("ggc_mb") and baseline.get("ggc_mb") else "wall"
+  return 100.0 * (result[key] / baseline[key] - 1.0)
+
+
+def format_row(name, result, baseline=None):
+  row = "{:<48} {:>8} {:>9} {:>9} {:>9} {:>8} {:>8}".format(
+    name,
+    format_value(result["wall"], "{:.2f}"),
+    format_value(result["frontend"], "{:.2f}"),
+    format_value(result["instantiation"], "{:.2f}"),
+    format_value(result["instantiations"], "{:d}"),
+    format_value(result.get("ggc_mb"), "{:.0f}"),
+    format_value(result["max_rss_mb"], "{:.0f}"))
+  if baseline is not None:
+    row += " {:>+8.1f}%".format(change(result, baseline))
+  return row
+
+
+def repository_root():
+  return os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
+
+
+def collect_sources(args, workdir):
+  """Returns the (name, path) of the per-header, stress-test, and unit-test translation units"""
+  sources = []
+  for header in args.headers:
+    path = os.path.join(workdir, "include_" + re.sub(r"[^\w]", "_", header) + ".cpp")
+    with open(path, "w") as tu:
+      tu.write("#include <{}>\n".format(header))
+    sources.append((header, path))
+  here = os.path.dirname(os.path.abspath(__file__))
+  for path in sorted(glob.glob(os.path.join(here, "cute", "*.cpp"))):
+    sources.append(("cute/" + os.path.basename(path), path))
+  for unit in args.units:
+    sources.append((unit, os.path.join(repository_root(), unit)))
+  if args.filter:
+    sources = [(name, path) for name, path in sources if re.search(args.filter, name)]
+  return sources
+
+
+def main():
+  parser = argparse.ArgumentParser(description="Compile-time benchmarks of the CuTe headers")
+  parser.add_argument("--compiler", default=os.environ.get("CXX", "c++"), help="C++ compiler")
+  parser.add_argument("-I", dest="includes", action="append", default=[], help="Include directory")
+  parser.add_argument("-D", dest="defines", action="append", default=[], help="Preprocessor definition")
+  parser.add_argument("--flags", default="-std=c++17", help="Additional compiler flags")
+  parser.add_argument("--headers", nargs="*", default=HEADERS, help="Headers to benchmark on their own")
+  parser.add_argument("--units", nargs="*", default=UNITS,
+                      help="Unit tests to benchmark, relative to the repository root")
+  parser.add_argument("--filter", default=None, help="Regular expression of the benchmarks to run")
+  parser.add_argument("--repeat", type=int, default=3, help="Compilations per benchmark; the fastest is reported")
+  parser.add_argument("--save", default=None, help="Write the results to this JSON file")
+  parser.add_argument("--baseline", default=None, help="Compare against the results in this JSON file")
+  parser.add_argument("--tolerance", type=float, default=None,
+                      help="Fail if a benchmark exceeds the baseline by more than this percentage "
+                           "(GC memory with GCC, wall time otherwise)")
+  args = parser.parse_args()
+
+  includes = args.includes + [os.path.join(repository_root(), path) for path in UNIT_INCLUDES if args.units]
+  flags = args.flags.split() + ["-I" + path for path in includes] + ["-D" + define for define in args.defines]
+  clang = is_clang(args.compiler)
+
+  baseline = None
+  if args.baseline:
+    with open(args.baseline) as baseline_file:
+      baseline = json.load(baseline_file)["results"]
+
+  with tempfile.TemporaryDirectory() as workdir:
+    sources = collect_sources(args, workdir)
+    print("{:<48} {:>8} {:>9} {:>9} {:>9} {:>8} {:>8}".format(
+      "benchmark", "wall(s)", "front(s)", "inst(s)", "inst(#)", "ggc(MB)", "rss(MB)"))
+    results = benchmark(args.compiler, clang, sources, flags, args.repeat, workdir)
+
+  if args.save:
+    with open(args.save, "w") as save_file:
+      json.dump({"compiler": args.compiler, "flags": flags, "results": results}, save_file, indent=2)
+
+  regressions = []
+  if baseline is not None:
+    print("\nCompared to {}:".format(args.baseline))
+    for name, result in results.items():
+      if name in baseline:
+        print(format_row(name, result, baseline[name]))
+        if args.tolerance is not None and change(result, baseline[name]) > args.tolerance:
+          regressions.append(name)
+
+  if regressions:
+    print("\nCompile time regressed by more than {}%: {}".format(args.tolerance, ", ".join(regressions)))
+    return 1
+  return 0
+
+
+if __name__ == "__main__":
+  sys.exit(main())
@@ -0,0 +1,76 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+// Compile-time benchmark: int_tuple arithmetic and layout algebra on static and dynamic layouts,
+//   in the mix that the partitioning of a CuTe collective instantiates.
+
+#include <cute/tensor.hpp>
+
+using namespace cute;
+
+template <int N>
+int
+bench_layout()
+{
+  using M = Int<64 * (N % 3 + 1)>;
+  using K = Int<32 * (N % 2 + 1)>;
+
+  // Static: a swizzled smem layout tiled to a CTA tile and divided by a thread layout
+  auto smem_atom = composition(Swizzle<2,3,3>{}, Layout<Shape<_8,_32>, Stride<_32,_1>>{});
+  auto smem = tile_to_shape(smem_atom, make_shape(M{}, K{}, Int<N % 4 + 2>{}));
+  auto thr  = Layout<Shape<_16,_8>, Stride<_8,_1>>{};
+  auto val  = Layout<Shape<_1,_8>>{};
+  auto tv   = raked_product(thr, val);
+  auto part = zipped_divide(make_layout(make_shape(M{}, K{})), product_each(shape(tv)));
+  auto inv  = right_inverse(coalesce(tv));
+  auto cmp  = complement(Layout<Shape<_4,_8>, Stride<_1,_16>>{}, Int<N * 128 + 512>{});
+
+  // Dynamic: a problem-size dependent gmem layout tiled by the CTA tile
+  auto gmem = make_layout(make_shape(N * 100, N * 37, 3), make_stride(1, N * 100, N * 3700));
+  auto tiled = zipped_divide(gmem, make_shape(M{}, K{}));
+  auto crd = idx2crd(N * 71, shape(gmem));
+  auto idx = crd2idx(crd, shape(gmem), stride(gmem));
+
+  return int(size(smem)) + int(cosize(part)) + int(size(inv)) + int(size(cmp))
+       + int(size<1>(tiled)) + int(idx) + int(elem_less(crd, shape(gmem)));
+}
+
+template <int... N>
+int
+bench(int_sequence<N...>)
+{
+  return (0 + ... + bench_layout<N + 1>());
+}
+
+int main()
+{
+  return bench(make_int_sequence<8>{});
+}
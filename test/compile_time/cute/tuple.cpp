@@ -0,0 +1,85 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+// Compile-time benchmark: construction, access, and comparison of wide cute::tuples.
+
+#include <cute/container/tuple.hpp>
+#include <cute/numeric/integral_constant.hpp>
+
+using namespace cute;
+
+// (_N, 1, _N+2, 3, ...): alternating static and dynamic elements
+template <int N, int I>
+auto
+make_wide_element()
+{
+  if constexpr (I % 2 == 0) {
+    return C<N+I>{};
+  } else {
+    return I;
+  }
+}
+
+template <int N, int... I>
+auto
+make_wide_tuple(int_sequence<I...>)
+{
+  return cute::make_tuple(make_wide_element<N,I>()...);
+}
+
+template <class T, int... I>
+int
+access(T const& t, int_sequence<I...>)
+{
+  static_assert((true && ... && is_same<remove_cvref_t<decltype(get<I>(t))>, tuple_element_t<I,T>>::value));
+  return (0 + ... + int(get<I>(t)));
+}
+
+template <int N>
+int
+bench_tuple()
+{
+  auto t = make_wide_tuple<N>(make_int_sequence<32>{});
+  auto u = cute::tuple_cat(t, t, t);
+  return access(t, make_int_sequence<32>{}) + access(u, make_int_sequence<96>{}) + int(u == u) + int(t != t);
+}
+
+template <int... N>
+int
+bench(int_sequence<N...>)
+{
+  return (0 + ... + bench_tuple<N * 128>());
+}
+
+int main()
+{
+  return bench(make_int_sequence<8>{});
+}
@@ -0,0 +1,74 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+// Compile-time benchmark: transform, fold, flatten, and search over hierarchical tuples.
+
+#include <cute/int_tuple.hpp>
+#include <cute/algorithm/tuple_algorithms.hpp>
+
+using namespace cute;
+
+// ((_N,1),(_N+2,3),...): nested static and dynamic elements
+template <int N, int... I>
+auto
+make_nested_tuple(int_sequence<I...>)
+{
+  return cute::make_tuple(cute::make_tuple(C<N+2*I>{}, 2*I+1)...);
+}
+
+template <int N>
+int
+bench_tuple_algorithms()
+{
+  auto t = make_nested_tuple<N>(make_int_sequence<16>{});
+  auto flat = flatten(t);
+  auto twice = transform_leaf(t, [](auto a) { return a + a; });
+  auto total = fold(flat, Int<0>{}, [](auto v, auto a) { return v + a; });
+  auto first = fold_first(flat, [](auto v, auto a) { return v * a; });
+  auto pos = find_if(flat, [](auto a) { return is_constant<N+6, decltype(a)>{}; });
+  auto any = any_of(flat, [](auto a) { return is_static<decltype(a)>{}; });
+  auto rev = reverse(flat);
+  auto zipped = zip(t);
+  return int(total) + int(first) + int(pos) + int(any) + int(get<3>(rev)) + int(get<0>(get<1>(zipped)))
+       + int(get<5>(flatten(twice))) + int(unflatten(flat, t) == t);
+}
+
+template <int... N>
+int
+bench(int_sequence<N...>)
+{
+  return (0 + ... + bench_tuple_algorithms<N * 64>());
+}
+
+int main()
+{
+  return bench(make_int_sequence<6>{});
+}
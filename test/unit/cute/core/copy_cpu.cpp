@@ -0,0 +1,171 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <cute/tensor.hpp>
+#include <cute/algorithm/copy.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// Copies src to dst with the host copy policy and compares every element to the copy algorithm's
+// default element-wise result.
+template <class T, size_t NonTemporalBytes = (size_t(4) << 20), class SrcLayout, class DstLayout>
+void
+test_cpu_copy(SrcLayout const& src_layout, DstLayout const& dst_layout)
+{
+  using namespace cute;
+
+  std::vector<T> src(cosize(src_layout));
+  std::vector<T> dst(cosize(dst_layout), T(-1));
+  std::vector<T> ref(cosize(dst_layout), T(-1));
+  for (size_t i = 0; i < src.size(); ++i) { src[i] = T(i % 251); }
+
+  Tensor s = make_tensor(src.data(), src_layout);
+  copy(CPU_AutoVectorizingCopy<NonTemporalBytes>{}, s, make_tensor(dst.data(), dst_layout));
+  copy_if(TrivialPredTensor{}, s, make_tensor(ref.data(), dst_layout));
+
+  for (size_t i = 0; i < dst.size(); ++i) {
+    EXPECT_EQ(dst[i], ref[i]) << "i = " << i;
+  }
+}
+
+template <class T>
+void
+test_cpu_copy_all()
+{
+  using namespace cute;
+
+  // Contiguous, with and without streaming stores
+  test_cpu_copy<T>(make_layout(make_shape(1000, 37)), make_layout(make_shape(1000, 37)));
+  test_cpu_copy<T, 0>(make_layout(make_shape(1000, 37)), make_layout(make_shape(1000, 37)));
+  test_cpu_copy<T, 0>(make_layout(Shape<_64,_64>{}), make_layout(Shape<_64,_64>{}));
+  // Transpose
+  test_cpu_copy<T>(make_layout(make_shape(123, 77), LayoutRight{}), make_layout(make_shape(123, 77)));
+  // NCHW <=> NHWC repack of a (C,W,H,N) tensor
+  auto chwn = make_shape(19, 14, 13, 3);
+  test_cpu_copy<T>(make_layout(chwn, make_stride(14*13, 1, 14, 19*14*13)), make_layout(chwn));
+  test_cpu_copy<T>(make_layout(chwn), make_layout(chwn, make_stride(14*13, 1, 14, 19*14*13)));
+  // Strided source and strided destination
+  test_cpu_copy<T>(make_layout(make_shape(100, 9), make_stride(3, 401)), make_layout(make_shape(100, 9)));
+  test_cpu_copy<T>(make_layout(make_shape(100, 9)), make_layout(make_shape(100, 9), make_stride(5, 512)));
+  test_cpu_copy<T>(make_layout(make_shape(100, 9), make_stride(3, 401)),
+                   make_layout(make_shape(100, 9), make_stride(5, 512)));
+  // Hierarchical shapes and unit modes
+  test_cpu_copy<T>(make_layout(make_shape(make_shape(8, 5), 1, 7), make_stride(make_stride(7, 56), 1000, 1)),
+                   make_layout(make_shape(make_shape(8, 5), 1, 7)));
+  // Shapes that differ fall back to the copy algorithm
+  test_cpu_copy<T>(make_layout(make_shape(12, 10)), make_layout(make_shape(120)));
+}
+
+} // end namespace
+
+TEST(CuTe_core, Copy_CPU_1B) { test_cpu_copy_all<uint8_t>();  }
+TEST(CuTe_core, Copy_CPU_2B) { test_cpu_copy_all<uint16_t>(); }
+TEST(CuTe_core, Copy_CPU_4B) { test_cpu_copy_all<float>();    }
+TEST(CuTe_core, Copy_CPU_8B) { test_cpu_copy_all<double>();   }
+
+TEST(CuTe_core, Copy_CPU_Static)
+{
+  using namespace cute;
+
+  float a[32], b[32];
+  for (int i = 0; i < 32; ++i) { a[i] = float(i); }
+  Tensor src = make_tensor(&a[0], Layout<Shape<_4,_8>>{});
+  Tensor dst = make_tensor(&b[0], Layout<Shape<_4,_8>, Stride<_8,_1>>{});
+  copy(CPU_AutoVectorizingCopy<>{}, src, dst);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      EXPECT_EQ(b[i*8+j], a[i+4*j]);
+    }
+  }
+
+  // Register-backed tensors
+  Tensor frg = make_tensor<float>(Shape<_4,_8>{});
+  copy(CPU_AutoVectorizingCopy<>{}, src, frg);
+  for (int i = 0; i < 32; ++i) {
+    EXPECT_EQ(frg(i), a[i]);
+  }
+}
+
+TEST(CuTe_core, Copy_CPU_Gather)
+{
+  using namespace cute;
+
+  int n = 1001;
+  std::vector<float>   src_f(3 * n);
+  std::vector<double>  src_d(3 * n);
+  std::vector<int32_t> idx32(n);
+  std::vector<int64_t> idx64(n);
+  for (int i = 0; i < 3 * n; ++i) { src_f[i] = float(i); src_d[i] = double(-i); }
+  for (int i = 0; i < n; ++i) { idx32[i] = (i * 37) % (3 * n); idx64[i] = (i * 53) % n; }
+
+  auto check = [&](auto const& src, auto const& idx, auto const& dst, int src_stride, int idx_stride) {
+    for (int i = 0; i < size(dst); ++i) {
+      EXPECT_EQ(dst(i), src[int64_t(idx[i * idx_stride]) * src_stride]) << "i = " << i;
+    }
+  };
+
+  {
+    std::vector<float> dst(n);
+    Tensor d = make_tensor(dst.data(), make_shape(n));
+    copy_gather(CPU_AutoVectorizingCopy<>{}, make_tensor(src_f.data(), make_shape(3 * n)),
+                make_tensor(idx32.data(), make_shape(n)), d);
+    check(src_f, idx32, d, 1, 1);
+    copy_gather(CPU_AutoVectorizingCopy<>{}, make_tensor(src_f.data(), make_shape(3 * n)),
+                make_tensor(idx64.data(), make_shape(n)), d);
+    check(src_f, idx64, d, 1, 1);
+    // Strided source
+    copy_gather(CPU_AutoVectorizingCopy<>{}, make_tensor(src_f.data(), make_shape(n), make_stride(3)),
+                make_tensor(idx64.data(), make_shape(n)), d);
+    check(src_f, idx64, d, 3, 1);
+  }
+  {
+    std::vector<double> dst(n);
+    Tensor d = make_tensor(dst.data(), make_shape(n));
+    copy_gather(CPU_AutoVectorizingCopy<>{}, make_tensor(src_d.data(), make_shape(3 * n)),
+                make_tensor(idx32.data(), make_shape(n)), d);
+    check(src_d, idx32, d, 1, 1);
+    copy_gather(CPU_AutoVectorizingCopy<>{}, make_tensor(src_d.data(), make_shape(3 * n)),
+                make_tensor(idx64.data(), make_shape(n)), d);
+    check(src_d, idx64, d, 1, 1);
+    // Strided indices and a rank-2 destination, which use the element-wise gather
+    Tensor d2 = make_tensor(dst.data(), make_shape(7, 71));
+    copy_gather(CPU_AutoVectorizingCopy<>{}, make_tensor(src_d.data(), make_shape(3 * n)),
+                make_tensor(idx32.data(), make_shape(7, 71), make_stride(2, 14)), d2);
+    for (int i = 0; i < size(d2); ++i) {
+      EXPECT_EQ(d2(i), src_d[idx32[(i % 7) * 2 + (i / 7) * 14]]);
+    }
+  }
+}
@@ -0,0 +1,115 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <cute/tensor.hpp>
+#include <cute/layout_cache.hpp>
+
+TEST(CuTe_core, LayoutCache_Algebra)
+{
+  using namespace cute;
+
+  layout_cache_clear();
+  LayoutCacheStats before = layout_cache_stats();
+
+  for (int m : {64, 96, 64, 96}) {
+    auto layout = make_layout(make_shape(m, 12, 3), make_stride(1, m, m * 12));
+    auto tiler  = make_shape(Int<16>{}, 4, Int<1>{});
+
+    EXPECT_EQ(cached_logical_divide(layout, tiler), logical_divide(layout, tiler));
+    auto tile = make_layout(make_shape(m, 6, 2), make_stride(2, m * 2, m * 12));
+    EXPECT_EQ(cached_composition(layout, tile), composition(layout, tile));
+
+    auto row = make_layout(make_shape(m, 12), make_stride(Int<12>{}, Int<1>{}));
+    auto memoized_coalesce = [](auto const& a) { return coalesce(a); };
+    EXPECT_EQ(memoize_layout(memoized_coalesce, row), coalesce(row));
+  }
+
+  // Each of the 3 functions is evaluated once per distinct m
+  LayoutCacheStats after = layout_cache_stats();
+  EXPECT_EQ(after.misses - before.misses, 6u);
+  EXPECT_EQ(after.hits   - before.hits,   6u);
+
+  // Rank-2 layouts are cheaper to evaluate than to look up and bypass the cache
+  auto layout = make_layout(make_shape(64, 12), make_stride(1, 64));
+  EXPECT_EQ(cached_logical_divide(layout, make_shape(Int<16>{}, 4)), logical_divide(layout, make_shape(Int<16>{}, 4)));
+  EXPECT_EQ(cached_composition(layout, make_layout(8, 2)), composition(layout, make_layout(8, 2)));
+
+  // Fully static arguments bypass the cache
+  EXPECT_EQ(cached_composition(Layout<Shape<_4,_8,_2>>{}, Layout<_16>{}), composition(Layout<Shape<_4,_8,_2>>{}, Layout<_16>{}));
+
+  EXPECT_EQ(layout_cache_stats().misses, after.misses);
+  EXPECT_EQ(layout_cache_stats().hits,   after.hits);
+
+  layout_cache_clear();
+  cached_composition(make_layout(make_shape(64, 12, 3), make_stride(1, 64, 768)), make_layout(8, 2));
+  EXPECT_EQ(layout_cache_stats().misses, after.misses + 1);
+}
+
+TEST(CuTe_core, LayoutCache_Eviction)
+{
+  using namespace cute;
+
+  layout_cache_clear();
+  LayoutCacheStats before = layout_cache_stats();
+
+  // More distinct keys than slots: colliding keys evict each other, results stay exact
+  auto fn = [](auto const& a, auto const& b) { return composition(a, b); };
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int m = 1; m <= 4 * CUTE_LAYOUT_CACHE_SLOTS; ++m) {
+      auto layout = make_layout(make_shape(m, 8, 2), make_stride(1, m, m * 8));
+      auto tile   = make_layout(make_shape(m, 4), make_stride(1, m * 2));
+      EXPECT_EQ(memoize_layout(fn, layout, tile), composition(layout, tile));
+    }
+  }
+
+  LayoutCacheStats after = layout_cache_stats();
+  EXPECT_EQ(after.hits + after.misses - before.hits - before.misses, size_t(8 * CUTE_LAYOUT_CACHE_SLOTS));
+  EXPECT_GE(after.misses - before.misses, size_t(4 * CUTE_LAYOUT_CACHE_SLOTS));
+}
+
+TEST(CuTe_core, LayoutCache_Freeze)
+{
+  using namespace cute;
+
+  auto layout = make_layout(make_shape(make_shape(3, 4), 5, 1), make_stride(make_stride(7, 40), 1, 1000));
+  auto frozen = freeze(layout);
+  ASSERT_EQ(frozen.size(), int64_t(size(layout)));
+  for (int i = 0; i < size(layout); ++i) {
+    EXPECT_EQ(frozen(i), layout(i));
+  }
+
+  auto frozen32 = freeze<int32_t>(composition(Swizzle<2,0,3>{}, Layout<Shape<_8,_4>>{}));
+  for (int i = 0; i < 32; ++i) {
+    EXPECT_EQ(frozen32.data()[i], int32_t(composition(Swizzle<2,0,3>{}, Layout<Shape<_8,_4>>{})(i)));
+  }
+}
@@ -0,0 +1,118 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+
+#include "cutlass_unit_test.h"
+
+#include <cute/tensor.hpp>
+#include <cute/atom/mma_atom.hpp>
+
+#include <vector>
+
+namespace {
+
+// Runs D = A * B^T + C over a static (M,N,K) problem with a single host thread and compares the
+// result to a scalar reference.
+template <class MMA_Op, class Accum, class M, class N, class K, class TA, class TB>
+void
+test_cpu_mma(M m, N n, K k, TA a_scale, TB b_scale)
+{
+  using namespace cute;
+  using TC = Accum;
+
+  std::vector<TA> A(size(m) * size(k));
+  std::vector<TB> B(size(n) * size(k));
+  std::vector<TC> C(size(m) * size(n));
+  for (size_t i = 0; i < A.size(); ++i) { A[i] = TA(int(i % 7) - 2) * a_scale; }
+  for (size_t i = 0; i < B.size(); ++i) { B[i] = TB(int(i % 5) - 2) * b_scale; }
+  for (size_t i = 0; i < C.size(); ++i) { C[i] = TC(int(i % 3)); }
+
+  Tensor gA = make_tensor(A.data(), make_layout(make_shape(m, k), LayoutLeft{}));
+  Tensor gB = make_tensor(B.data(), make_layout(make_shape(n, k), LayoutLeft{}));
+  Tensor gC = make_tensor(C.data(), make_layout(make_shape(m, n), LayoutLeft{}));
+
+  std::vector<TC> ref(C);
+  for (int j = 0; j < size(n); ++j) {
+    for (int i = 0; i < size(m); ++i) {
+      TC acc = ref[i + j * size(m)];
+      for (int l = 0; l < size(k); ++l) {
+        acc += TC(gA(i,l)) * TC(gB(j,l));
+      }
+      ref[i + j * size(m)] = acc;
+    }
+  }
+
+  TiledMMA tiled_mma = make_tiled_mma(MMA_Op{});
+  auto thr_mma = tiled_mma.get_slice(0);
+
+  Tensor tCgA = thr_mma.partition_A(gA);
+  Tensor tCgB = thr_mma.partition_B(gB);
+  Tensor tCgC = thr_mma.partition_C(gC);
+
+  Tensor tCrA = thr_mma.make_fragment_A(tCgA);
+  Tensor tCrB = thr_mma.make_fragment_B(tCgB);
+  Tensor tCrC = thr_mma.make_fragment_C(tCgC);
+
+  copy(tCgA, tCrA);
+  copy(tCgB, tCrB);
+  copy(tCgC, tCrC);
+  gemm(tiled_mma, tCrC, tCrA, tCrB, tCrC);
+  copy(tCrC, tCgC);
+
+  for (size_t i = 0; i < C.size(); ++i) {
+    EXPECT_EQ(C[i], ref[i]) << "index " << i;
+  }
+}
+
+} // end namespace
+
+TEST(CuTe_core, MMA_CPU_8x8x1_F32)
+{
+  using namespace cute;
+  test_cpu_mma<CPU_8x8x1_F32F32F32F32, float>(_32{}, _16{}, _8{}, 1.0f, 0.5f);
+}
+
+TEST(CuTe_core, MMA_CPU_16x8x1_F32)
+{
+  using namespace cute;
+  test_cpu_mma<CPU_16x8x1_F32F32F32F32, float>(_32{}, _24{}, _4{}, 0.25f, 1.0f);
+}
+
+TEST(CuTe_core, MMA_CPU_8x8x2_BF16)
+{
+  using namespace cute;
+  test_cpu_mma<CPU_8x8x2_F32BF16BF16F32, float>(_16{}, _16{}, _8{}, bfloat16_t(1.0f), bfloat16_t(0.5f));
+}
+
+TEST(CuTe_core, MMA_CPU_8x8x4_U8S8)
+{
+  using namespace cute;
+  test_cpu_mma<CPU_8x8x4_S32U8S8S32, int32_t>(_16{}, _8{}, _16{}, uint8_t(3), int8_t(-7));
+}
@@ -0,0 +1,237 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for host execution of GemmUniversal with the MainloopCpu collective
+*/
+
+#include <cstdint>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cute/tensor.hpp"
+#include "cute/atom/mma_atom.hpp"
+
+#include "cutlass/gemm/gemm.h"
+#include "cutlass/gemm/dispatch_policy.hpp"
+#include "cutlass/gemm/collective/collective_mma.hpp"
+#include "cutlass/gemm/kernel/gemm_universal.hpp"
+#include "cutlass/epilogue/collective/default_epilogue.hpp"
+#include "cutlass/epilogue/thread/linear_combination.h"
+#include "cutlass/util/host_launch.h"
+
+#include "../../common/cutlass_unit_test.h"
+
+using namespace cute;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Packed (rows, cols, batch) stride with a static unit stride in either mode
+template <class Stride>
+Stride packed_stride(int rows, int cols) {
+  Stride stride{};
+  if constexpr (is_static<decltype(get<0>(stride))>::value) {
+    get<1>(stride) = rows;
+  }
+  else {
+    get<0>(stride) = cols;
+  }
+  get<2>(stride) = int64_t(rows) * cols;
+  return stride;
+}
+
+template <class TiledMma, class TileShape, class LayoutA, class LayoutB>
+bool test_cpu_gemm(int m, int n, int k, int l, float alpha, float beta, int max_threads = 0) {
+
+  using StrideA = cutlass::gemm::TagToStrideA_t<LayoutA>;
+  using StrideB = cutlass::gemm::TagToStrideB_t<LayoutB>;
+  using StrideC = cutlass::gemm::TagToStrideC_t<cutlass::layout::ColumnMajor>;
+
+  using CollectiveMainloop = cutlass::gemm::collective::CollectiveMma<
+    cutlass::gemm::MainloopCpu,
+    TileShape,
+    float, StrideA,
+    float, StrideB,
+    TiledMma,
+    void, void, void, cute::identity,
+    void, void, void, cute::identity>;
+
+  using CollectiveEpilogue = cutlass::epilogue::collective::DefaultEpilogue<
+    StrideC,
+    StrideC,
+    cutlass::epilogue::thread::LinearCombination<float, 1, float, float>,
+    cutlass::gemm::EpilogueDefault>;
+
+  using GemmKernel = cutlass::gemm::kernel::GemmUniversal<
+    Shape<int,int,int,int>,
+    CollectiveMainloop,
+    CollectiveEpilogue>;
+
+  auto stride_A = packed_stride<StrideA>(m, k);
+  auto stride_B = packed_stride<StrideB>(n, k);
+  auto stride_C = packed_stride<StrideC>(m, n);
+
+  std::vector<float> A(size_t(m) * k * l);
+  std::vector<float> B(size_t(n) * k * l);
+  std::vector<float> C(size_t(m) * n * l);
+  std::vector<float> D(size_t(m) * n * l, -1.0f);
+
+  // Small integers keep every partial sum exact
+  for (size_t i = 0; i < A.size(); ++i) { A[i] = float(int(i % 7) - 3); }
+  for (size_t i = 0; i < B.size(); ++i) { B[i] = float(int(i % 5) - 2); }
+  for (size_t i = 0; i < C.size(); ++i) { C[i] = float(int(i % 3) - 1); }
+
+  typename GemmKernel::Arguments args{
+    cutlass::gemm::GemmUniversalMode::kBatched,
+    {m, n, k, l},
+    {A.data(), stride_A, B.data(), stride_B},
+    {{alpha, beta}, C.data(), stride_C, D.data(), stride_C}
+  };
+
+  if (!GemmKernel::can_implement(args)) {
+    return false;
+  }
+
+  auto params = GemmKernel::to_underlying_arguments(args, nullptr);
+  if (cutlass::host_kernel_launch<GemmKernel>(params, max_threads) != cutlass::Status::kSuccess) {
+    return false;
+  }
+
+  Tensor mA = make_tensor(A.data(), make_shape(m, k, l), stride_A);
+  Tensor mB = make_tensor(B.data(), make_shape(n, k, l), stride_B);
+  Tensor mC = make_tensor(C.data(), make_shape(m, n, l), stride_C);
+  Tensor mD = make_tensor(D.data(), make_shape(m, n, l), stride_C);
+
+  for (int b = 0; b < l; ++b) {
+    for (int j = 0; j < n; ++j) {
+      for (int i = 0; i < m; ++i) {
+        float acc = 0;
+        for (int p = 0; p < k; ++p) {
+          acc += mA(i, p, b) * mB(j, p, b);
+        }
+        float expected = alpha * acc + beta * mC(i, j, b);
+        if (mD(i, j, b) != expected) {
+          ADD_FAILURE() << "D(" << i << "," << j << "," << b << ") = " << mD(i, j, b)
+                        << ", expected " << expected;
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+// Records the coordinates reported by the index shims
+struct IndexKernel {
+  struct Params {
+    int *out;
+  };
+
+  using SharedStorage = int;
+
+  void operator()(Params const &params, char *smem) {
+    int block = int(BlockIdxX() + GridDimX() * (BlockIdxY() + GridDimY() * BlockIdxZ()));
+    int thread = int(ThreadIdxX() + BlockDimX() * ThreadIdxY());
+    int threads = int(BlockDimX() * BlockDimY());
+    params.out[block * threads + thread] = block * 1000 + thread;
+
+    // Every thread of the block sees the same shared memory
+    if (thread == 0) {
+      *reinterpret_cast<int *>(smem) = 0;
+    }
+    *reinterpret_cast<int *>(smem) += 1;
+    if (thread == threads - 1 && *reinterpret_cast<int *>(smem) != threads) {
+      params.out[block * threads + thread] = -1;
+    }
+  }
+};
+
+struct BarrierKernel {
+  struct Params { };
+
+  void operator()(Params const &, char *) {
+    syncthreads();
+  }
+};
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(CPU_Device_Gemm_f32n_f32t_f32n_f32, 64x32x8_outer_product) {
+  using TiledMma = decltype(make_tiled_mma(CPU_16x8x1_F32F32F32F32{}));
+  using Tile = Shape<_64,_32,_8>;
+  EXPECT_TRUE((test_cpu_gemm<TiledMma, Tile, cutlass::layout::ColumnMajor, cutlass::layout::RowMajor>(
+    256, 128, 64, 1, 1.0f, 0.0f)));
+  EXPECT_TRUE((test_cpu_gemm<TiledMma, Tile, cutlass::layout::ColumnMajor, cutlass::layout::RowMajor>(
+    100, 70, 37, 2, 2.0f, 1.0f)));
+}
+
+TEST(CPU_Device_Gemm_f32t_f32n_f32n_f32, 32x32x8_outer_product) {
+  using TiledMma = decltype(make_tiled_mma(CPU_8x8x1_F32F32F32F32{}));
+  using Tile = Shape<_32,_32,_8>;
+  EXPECT_TRUE((test_cpu_gemm<TiledMma, Tile, cutlass::layout::RowMajor, cutlass::layout::ColumnMajor>(
+    65, 33, 17, 3, 1.0f, -1.0f)));
+  EXPECT_TRUE((test_cpu_gemm<TiledMma, Tile, cutlass::layout::RowMajor, cutlass::layout::ColumnMajor>(
+    65, 33, 17, 3, 1.0f, -1.0f, 1)));
+}
+
+TEST(CPU_Device_Gemm_f32n_f32n_f32n_f32, 16x16x4_universal_fma_4x4_threads) {
+  using TiledMma = decltype(make_tiled_mma(UniversalFMA<float>{}, Layout<Shape<_4,_4,_1>>{}));
+  using Tile = Shape<_16,_16,_4>;
+  EXPECT_TRUE((test_cpu_gemm<TiledMma, Tile, cutlass::layout::ColumnMajor, cutlass::layout::ColumnMajor>(
+    50, 23, 9, 1, 1.0f, 1.0f)));
+}
+
+TEST(CPU_Device_Launch, index_shims) {
+  dim3 grid(3, 2, 2);
+  dim3 block(4, 2, 1);
+  std::vector<int> out(3 * 2 * 2 * 4 * 2, -2);
+  IndexKernel::Params params{out.data()};
+  EXPECT_EQ(cutlass::host_kernel_launch<IndexKernel>(grid, block, sizeof(int), params), cutlass::Status::kSuccess);
+  for (int i = 0; i < int(out.size()); ++i) {
+    EXPECT_EQ(out[i], (i / 8) * 1000 + i % 8);
+  }
+
+  // Outside of a launch the shims report zero
+  EXPECT_EQ(ThreadIdxX(), 0u);
+  EXPECT_EQ(BlockIdxX(), 0u);
+  EXPECT_EQ(GridDimX(), 0u);
+}
+
+TEST(CPU_Device_Launch, serialized_barrier) {
+  BarrierKernel::Params params;
+  EXPECT_EQ(cutlass::host_kernel_launch<BarrierKernel>(dim3(2, 1, 1), dim3(1, 1, 1), 0, params), cutlass::Status::kSuccess);
+  EXPECT_EQ(cutlass::host_kernel_launch<BarrierKernel>(dim3(2, 1, 1), dim3(2, 1, 1), 0, params), cutlass::Status::kErrorNotSupported);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
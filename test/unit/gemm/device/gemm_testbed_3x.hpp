@@ -50,6 +50,7 @@
 #include "cutlass/util/reference/host/tensor_compare.h"
 #include "cutlass/util/reference/host/tensor_norm.h"
 #include "cutlass/util/reference/host/gett.hpp"
+#include "cutlass/util/reference_cache.h"
 #include "cutlass/epilogue/collective/default_epilogue.hpp"
 #include "cutlass/epilogue/fusion/operations.hpp"
 #include "cutlass/complex.h"
@@ -258,6 +259,22 @@ static constexpr bool is_row_or_col_major(){
   return ((stride_0 == 1) || (stride_1 == 1)) && (depth == 1);
 }
 
+// Hashes the extent and host contents of a tensor into a reference cache key
+template <typename Element, typename Layout>
+void hash_reference_tensor(
+  cutlass::ReferenceCacheHasher &hasher,
+  cutlass::HostTensor<Element, Layout> &tensor) {
+
+  hasher.update_value(tensor.extent());
+  hasher.update_block(tensor.host_data(), tensor.size());
+}
+
+// Describes the host storage of a reference output tensor
+template <typename Element, typename Layout>
+cutlass::ReferenceCacheBuffer reference_cache_buffer(cutlass::HostTensor<Element, Layout> &tensor) {
+  return cutlass::ReferenceCacheBuffer::block(tensor.host_data(), tensor.size());
+}
+
 
 //
 // Default MMA input Operands : A , B
@@ -398,6 +415,16 @@ struct HostCollectiveMainloop {
     return mainloop_params;
   }
 
+  /// Hashes everything the host reference reads from the mainloop operands
+  void hash_reference_inputs(cutlass::ReferenceCacheHasher &hasher) {
+    hasher.update_type<ElementA>().update_type<StrideA>();
+    hasher.update_type<ElementB>().update_type<StrideB>();
+    hasher.update_type<ElementAccumulator>();
+    hasher.update_value(TransformA).update_value(TransformB);
+    hash_reference_tensor(hasher, tensor_A);
+    hash_reference_tensor(hasher, tensor_B);
+  }
+
   void print_tensors(std::ofstream& file) {
     file << "A =\n" << tensor_A.host_view()
          << "\nB =\n" << tensor_B.host_view();
@@ -601,6 +628,21 @@ struct HostCollectiveDefaultEpilogue {
     return passed;
   }
 
+  /// Hashes everything the host reference reads from the epilogue operands
+  void hash_reference_inputs(cutlass::ReferenceCacheHasher &hasher) {
+    hasher.update_type<ElementC>().update_type<StrideC>();
+    hasher.update_type<ElementD>().update_type<StrideD>();
+    hasher.update_type<ElementCompute>().update_type<ElementScalar>();
+    hasher.update_value(alpha).update_value(beta);
+    hash_reference_tensor(hasher, tensor_C);
+    hash_reference_tensor(hasher, reference_D);
+  }
+
+  /// Host tensors written by the host reference
+  std::vector<cutlass::ReferenceCacheBuffer> reference_outputs() {
+    return {reference_cache_buffer(reference_D)};
+  }
+
   void print_tensors(std::ofstream& file) {
     file
     << "\nC =\n" << tensor_C.host_view()
@@ -992,6 +1034,51 @@ struct HostCollectiveEpilogue {
     return passed;
   }
 
+  /// Hashes everything the host reference reads from the epilogue operands
+  void hash_reference_inputs(cutlass::ReferenceCacheHasher &hasher) {
+    hasher.update_type<ElementC>().update_type<StrideC>();
+    hasher.update_type<ElementD>().update_type<StrideD>();
+    hasher.update_type<FusionOp>().update_type<LayoutTagAux>();
+    hasher.update_value(disable_vector_beta);
+    hash_reference_tensor(hasher, alpha);
+    hash_reference_tensor(hasher, beta);
+    hash_reference_tensor(hasher, scale_A);
+    hash_reference_tensor(hasher, scale_B);
+    hash_reference_tensor(hasher, scale_C);
+    hash_reference_tensor(hasher, scale_D);
+    hash_reference_tensor(hasher, scale_Aux);
+    hash_reference_tensor(hasher, bias);
+    hash_reference_tensor(hasher, tensor_C);
+    if constexpr (IsAuxInEnabled) {
+      hash_reference_tensor(hasher, tensor_Aux);
+    }
+
+    // Initial state of the reference outputs, some of which are accumulated into
+    hash_reference_tensor(hasher, reference_D);
+    hash_reference_tensor(hasher, reference_dbias);
+    hash_reference_tensor(hasher, reference_Aux);
+    hash_reference_tensor(hasher, reference_abs_max_D);
+    hash_reference_tensor(hasher, reference_abs_max_Aux);
+  }
+
+  /// Host tensors written by the host reference
+  std::vector<cutlass::ReferenceCacheBuffer> reference_outputs() {
+    std::vector<cutlass::ReferenceCacheBuffer> outputs{reference_cache_buffer(reference_D)};
+    if constexpr (IsDeBiasEnabled) {
+      outputs.push_back(reference_cache_buffer(reference_dbias));
+    }
+    if constexpr (IsAuxOutEnabled) {
+      outputs.push_back(reference_cache_buffer(reference_Aux));
+    }
+    if constexpr (IsAbsMaxEnabledD) {
+      outputs.push_back(reference_cache_buffer(reference_abs_max_D));
+    }
+    if constexpr (IsAbsMaxEnabledAux) {
+      outputs.push_back(reference_cache_buffer(reference_abs_max_Aux));
+    }
+    return outputs;
+  }
+
   void print_tensors(std::ofstream& file) {
     auto coord_0 = cutlass::make_Coord(0);
     if constexpr (IsScaleFactorEnabled) {
@@ -1339,8 +1426,22 @@ struct TestbedImpl {
 
     auto mainloop_params = collective_mma_inputs.to_host_args(problem_size);
     auto epilogue_params = collective_epilogue.to_host_args(problem_size);
-    
-    cutlass::reference::host::Gemm3x(mainloop_params, epilogue_params);
+
+    // The reference depends only on the problem and its data, so it is shared by every kernel
+    // variant through the reference cache (enabled by CUTLASS_REFERENCE_CACHE_DIR)
+    cutlass::ReferenceCacheHasher hasher;
+    hasher.update("gemm3x");
+    hasher.update_value(int64_t(cute::size<0>(problem_shape_MNKL)));
+    hasher.update_value(int64_t(cute::size<1>(problem_shape_MNKL)));
+    hasher.update_value(int64_t(cute::size<2>(problem_shape_MNKL)));
+    hasher.update_value(int64_t(cute::size<3>(problem_shape_MNKL)));
+    collective_mma_inputs.hash_reference_inputs(hasher);
+    collective_epilogue.hash_reference_inputs(hasher);
+
+    cutlass::ReferenceCache::global().load_or_compute(
+      hasher.digest(),
+      collective_epilogue.reference_outputs(),
+      [&] { cutlass::reference::host::Gemm3x(mainloop_params, epilogue_params); });
 
     bool passed = compare_reference(problem_shape_MNKL, alpha, beta);
     return passed;
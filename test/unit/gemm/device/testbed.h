@@ -48,6 +48,7 @@
 #include "cutlass/util/reference/host/tensor_compare.h"
 #include "cutlass/util/reference/host/tensor_norm.h"
 #include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference_cache.h"
 
 #include "testbed_utils.h"
 #include "testbed_universal.h"
@@ -267,26 +268,44 @@ struct Testbed {
         ElementAccumulator, typename Gemm::Operator>
         reference_gemm;
 
-    reference_gemm(
-      problem_size,
-      alpha, 
-      tensor_A.host_ref(), 
-      tensor_B.host_ref(), 
-      beta, 
-      reference_D.host_ref(), 
-      ElementAccumulator(0)
-    );
-
-    if (Relu) {
-      for (int i = 0; i < problem_size.m(); ++i) {
-        for (int j = 0; j < problem_size.n(); ++j) {
-           reference_D.at(cutlass::MatrixCoord(i, j)) = 
-                  ((ElementCompute)reference_D.at(cutlass::MatrixCoord(i, j)) < (ElementCompute)0)
-                  ? (typename Gemm::ElementC)0
-                  : reference_D.at(cutlass::MatrixCoord(i, j));
+    // The reference depends only on the problem and its data, so it is shared by every kernel
+    // variant through the reference cache (enabled by CUTLASS_REFERENCE_CACHE_DIR)
+    cutlass::ReferenceCacheHasher hasher;
+    hasher.update("gemm");
+    hasher.update_type<decltype(reference_gemm)>();
+    hasher.update_value(problem_size);
+    hasher.update_value(alpha).update_value(beta).update_value(Relu);
+    hasher.update_value(tensor_A.stride()).update_block(tensor_A.host_data(), tensor_A.size());
+    hasher.update_value(tensor_B.stride()).update_block(tensor_B.host_data(), tensor_B.size());
+    hasher.update_value(reference_D.stride()).update_block(reference_D.host_data(), reference_D.size());
+
+    auto compute_reference = [&] {
+      reference_gemm(
+        problem_size,
+        alpha, 
+        tensor_A.host_ref(), 
+        tensor_B.host_ref(), 
+        beta, 
+        reference_D.host_ref(), 
+        ElementAccumulator(0)
+      );
+
+      if (Relu) {
+        for (int i = 0; i < problem_size.m(); ++i) {
+          for (int j = 0; j < problem_size.n(); ++j) {
+             reference_D.at(cutlass::MatrixCoord(i, j)) = 
+                    ((ElementCompute)reference_D.at(cutlass::MatrixCoord(i, j)) < (ElementCompute)0)
+                    ? (typename Gemm::ElementC)0
+                    : reference_D.at(cutlass::MatrixCoord(i, j));
+          }
         }
       }
-    }
+    };
+
+    cutlass::ReferenceCache::global().load_or_compute(
+      hasher.digest(),
+      {cutlass::ReferenceCacheBuffer::block(reference_D.host_data(), reference_D.size())},
+      compute_reference);
 
     return compare_reference(problem_size, alpha, beta);
   }
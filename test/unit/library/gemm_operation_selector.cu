@@ -0,0 +1,224 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for problem-shape-aware GEMM operation selection
+*/
+
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/gemm_operation_selector.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::library;
+
+/// Operation that only carries a description
+class TiledOperation : public Operation {
+public:
+
+  GemmDescription desc;
+
+  TiledOperation(
+    char const *name,
+    int tile_m,
+    int tile_n,
+    int alignment = 8,
+    OpcodeClassID opcode_class = OpcodeClassID::kTensorOp,
+    int minimum_compute_capability = 80) {
+
+    desc.name = name;
+    desc.provider = Provider::kCUTLASS;
+    desc.kind = OperationKind::kGemm;
+    desc.A = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kRowMajor, alignment);
+    desc.B = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, alignment);
+    desc.C = TensorDescription(NumericTypeID::kF32, LayoutTypeID::kRowMajor, 4);
+    desc.D = desc.C;
+    desc.tile_description.threadblock_shape = cutlass::gemm::GemmCoord(tile_m, tile_n, 32);
+    desc.tile_description.math_instruction.element_accumulator = NumericTypeID::kF32;
+    desc.tile_description.math_instruction.opcode_class = opcode_class;
+    desc.tile_description.minimum_compute_capability = minimum_compute_capability;
+    desc.tile_description.maximum_compute_capability = 1024;
+  }
+
+  OperationDescription const &description() const override { return desc; }
+
+  cutlass::Status can_implement(void const *, void const *) const override { return cutlass::Status::kSuccess; }
+
+  uint64_t get_host_workspace_size(void const *) const override { return 0; }
+
+  uint64_t get_device_workspace_size(void const *, void const *) const override { return 0; }
+
+  cutlass::Status initialize(void const *, void *, void *, cudaStream_t) const override {
+    return cutlass::Status::kSuccess;
+  }
+
+  cutlass::Status run(void const *, void *, void *, cudaStream_t) const override { return cutlass::Status::kSuccess; }
+};
+
+/// Operation registered under a preference key
+struct Registration {
+  GemmPreferenceKey preference_key;
+  Operation const *operation;
+};
+
+/// Builds a functional map holding the registrations in order
+GemmOperationFunctionalMap make_operation_map(std::vector<Registration> const &registrations) {
+  std::vector<GemmOperationFunctionalMap::Entry> entries;
+  for (Registration const &registration : registrations) {
+    entries.push_back({GemmFunctionalKey(Provider::kCUTLASS), registration.preference_key, registration.operation});
+  }
+
+  GemmOperationFunctionalMap map;
+  map.build(entries);
+  return map;
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(GemmOperationSelector, bucket_extents) {
+
+  using cutlass::library::GemmSelectionProblem;
+  using cutlass::library::gemm_selection_bucket;
+
+  // Multiples of 8 up to 64, then eight steps per power-of-two octave
+  int const extents[][2] = {
+    {1, 8}, {8, 8}, {9, 16}, {64, 64}, {65, 72}, {128, 128}, {129, 144},
+    {1000, 1024}, {1025, 1152}, {4097, 4608}
+  };
+
+  for (auto const &extent : extents) {
+    GemmSelectionProblem bucket = gemm_selection_bucket(GemmSelectionProblem(extent[0], 1, 1, 1));
+    EXPECT_EQ(bucket.m, extent[1]) << "extent: " << extent[0];
+  }
+
+  // Buckets cover their extents and are fixed points
+  for (int extent = 1; extent <= 5000; ++extent) {
+    int bucket = gemm_selection_bucket(GemmSelectionProblem(extent, 1, 1, 1)).m;
+    EXPECT_GE(bucket, extent);
+    EXPECT_EQ(gemm_selection_bucket(GemmSelectionProblem(bucket, 1, 1, 1)).m, bucket);
+  }
+}
+
+TEST(GemmOperationSelector, problems_of_a_bucket_share_a_decision) {
+
+  using namespace cutlass::library;
+
+  TiledOperation small("small", 64, 64);
+  TiledOperation large("large", 256, 128);
+
+  GemmOperationFunctionalMap map = make_operation_map({
+    {GemmPreferenceKey(80, 8), &small}, {GemmPreferenceKey(80, 8), &large}});
+  GemmOperationVectorMap const &operations = map.begin()->second;
+
+  GemmPreferenceKey preference(80, 8);
+  GemmOperationSelector selector;
+
+  // Small problems favor small tiles, large problems large tiles
+  EXPECT_EQ(selector.select(operations, preference, GemmSelectionProblem(128, 128, 128), 108), &small);
+  EXPECT_EQ(selector.select(operations, preference, GemmSelectionProblem(8192, 8192, 8192), 108), &large);
+
+  for (int m = 1; m <= 2048; m += 7) {
+    GemmSelectionProblem problem(m, 3000, 512);
+    GemmSelectionProblem bucket = gemm_selection_bucket(problem);
+    EXPECT_EQ(selector.select(operations, preference, problem, 108),
+              GemmOperationSelector::select_uncached(operations, preference, bucket, 108)) << "m: " << m;
+  }
+}
+
+TEST(GemmOperationSelector, selection_order) {
+
+  using namespace cutlass::library;
+
+  TiledOperation sm80_tensorop("sm80_tensorop", 128, 128);
+  TiledOperation sm80_tied("sm80_tied", 128, 128);
+  TiledOperation sm90_simt("sm90_simt", 128, 128, 8, OpcodeClassID::kSimt, 90);
+  TiledOperation sm100_aligned("sm100_aligned", 128, 128, 16, OpcodeClassID::kTensorOp, 100);
+
+  GemmOperationFunctionalMap map = make_operation_map({
+    {GemmPreferenceKey(80, 8), &sm80_tensorop},
+    {GemmPreferenceKey(80, 8), &sm80_tied},
+    {GemmPreferenceKey(90, 8), &sm90_simt},
+    {GemmPreferenceKey(100, 16), &sm100_aligned}});
+  GemmOperationVectorMap const &operations = map.begin()->second;
+
+  GemmSelectionProblem problem(1024, 1024, 1024);
+
+  // The highest compute capability offering an eligible operation wins, even at a higher cost
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, GemmPreferenceKey(90, 8), problem, 108), &sm90_simt);
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, GemmPreferenceKey(100, 16), problem, 108), &sm100_aligned);
+
+  // Operations registered above the device, or requiring more alignment than the problem offers,
+  // are skipped; ties among the remaining keep the manifest order
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, GemmPreferenceKey(80, 8), problem, 108), &sm80_tensorop);
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, GemmPreferenceKey(100, 8), problem, 108), &sm90_simt);
+
+  // No eligible operation
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, GemmPreferenceKey(75, 8), problem, 108), nullptr);
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, GemmPreferenceKey(80, 4), problem, 108), nullptr);
+}
+
+TEST(GemmOperationSelector, full_table_evicts) {
+
+  using namespace cutlass::library;
+
+  TiledOperation small("small", 64, 64);
+  TiledOperation large("large", 256, 128);
+
+  GemmOperationFunctionalMap map = make_operation_map({
+    {GemmPreferenceKey(80, 8), &small}, {GemmPreferenceKey(80, 8), &large}});
+  GemmOperationVectorMap const &operations = map.begin()->second;
+
+  GemmPreferenceKey preference(80, 8);
+  GemmSelectionProblem problem(128, 128, 128);
+  GemmOperationSelector selector;
+
+  // Decisions for distinct SM counts overfill the table
+  int const kSmCounts = GemmOperationSelector::kCapacity * 4;
+  for (int sm_count = 1; sm_count <= kSmCounts; ++sm_count) {
+    ASSERT_EQ(selector.select(operations, preference, problem, sm_count),
+              GemmOperationSelector::select_uncached(operations, preference, problem, sm_count));
+  }
+
+  // A new decision is still memoized: it is returned after its operation becomes ineligible
+  int const kSmCount = kSmCounts + 1;
+  EXPECT_EQ(selector.select(operations, preference, problem, kSmCount), &small);
+  small.desc.tile_description.minimum_compute_capability = 90;
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, preference, problem, kSmCount), &large);
+  EXPECT_EQ(selector.select(operations, preference, problem, kSmCount), &small);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
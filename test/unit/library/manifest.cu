@@ -0,0 +1,237 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for sections of generated operations registered with the manifest
+*/
+
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/manifest.h"
+#include "cutlass/library/operation_table.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/// Number of CountedOperation objects constructed
+static int constructed_operations = 0;
+
+/// Operation counting its constructions, described like the record of the same name
+class CountedOperation : public Operation {
+public:
+
+  GemmDescription desc;
+
+  explicit CountedOperation(char const *name, int alignment) {
+    ++constructed_operations;
+    desc.name = name;
+    desc.provider = Provider::kCUTLASS;
+    desc.kind = OperationKind::kGemm;
+    desc.gemm_kind = GemmKind::kUniversal;
+    desc.A = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kRowMajor, alignment);
+    desc.B = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, alignment);
+    desc.C = TensorDescription(NumericTypeID::kF32, LayoutTypeID::kRowMajor, 4);
+    desc.D = desc.C;
+    desc.element_epilogue = NumericTypeID::kF32;
+    desc.tile_description.threadblock_shape = cutlass::gemm::GemmCoord(128, 128, 32);
+    desc.tile_description.threadblock_stages = 3;
+    desc.tile_description.math_instruction.element_accumulator = NumericTypeID::kF32;
+    desc.tile_description.math_instruction.opcode_class = OpcodeClassID::kTensorOp;
+    desc.tile_description.minimum_compute_capability = 80;
+    desc.tile_description.maximum_compute_capability = 1024;
+  }
+
+  OperationDescription const &description() const override { return desc; }
+
+  cutlass::Status can_implement(void const *, void const *) const override { return cutlass::Status::kSuccess; }
+
+  uint64_t get_host_workspace_size(void const *) const override { return 16; }
+
+  uint64_t get_device_workspace_size(void const *, void const *) const override { return 0; }
+
+  cutlass::Status initialize(void const *, void *, void *, cudaStream_t) const override {
+    return cutlass::Status::kSuccess;
+  }
+
+  cutlass::Status run(void const *, void *, void *, cudaStream_t) const override { return cutlass::Status::kSuccess; }
+};
+
+static Operation *construct_align8() {
+  return new CountedOperation("gemm_align8", 8);
+}
+
+static Operation *construct_align4() {
+  return new CountedOperation("gemm_align4", 4);
+}
+
+/// Record as emitted by the generator, with the stage and warp counts the operation reports
+#define TEST_GEMM_RECORD(NAME, ALIGNMENT, CONSTRUCT)                                                \
+  {                                                                                                \
+    NAME,                                                                                          \
+    GemmKind::kUniversal,                                                                          \
+    {128, 128, 32}, 3, {2, 2, 1}, {1, 1, 1}, {16, 8, 16},                                          \
+    NumericTypeID::kF32,                                                                           \
+    OpcodeClassID::kTensorOp,                                                                      \
+    MathOperationID::kMultiplyAdd,                                                                 \
+    80, 1024,                                                                                      \
+    NumericTypeID::kF16, LayoutTypeID::kRowMajor, ALIGNMENT, ComplexTransform::kNone,              \
+    NumericTypeID::kF16, LayoutTypeID::kColumnMajor, ALIGNMENT, ComplexTransform::kNone,           \
+    NumericTypeID::kF32, LayoutTypeID::kRowMajor, 4,                                               \
+    NumericTypeID::kF32, LayoutTypeID::kRowMajor, 4,                                               \
+    NumericTypeID::kF32,                                                                           \
+    CONSTRUCT                                                                                      \
+  }
+
+static GemmOperationRecord const records[] = {
+  TEST_GEMM_RECORD("gemm_align8", 8, construct_align8),
+  TEST_GEMM_RECORD("gemm_align4", 4, construct_align4)
+};
+
+#undef TEST_GEMM_RECORD
+
+/// Section initializer appending one operation eagerly
+static void initialize_section(Manifest &manifest) {
+  manifest.append(new CountedOperation("gemm_eager", 8));
+}
+
+} // namespace library
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(Manifest, records_describe_operations_without_constructing_them) {
+
+  using namespace cutlass::library;
+
+  test::library::constructed_operations = 0;
+
+  Manifest manifest;
+  manifest.register_section(80, "sm80_records", test::library::records, 2);
+
+  ASSERT_EQ(manifest.sections().size(), size_t(1));
+  EXPECT_EQ(manifest.sections().front().record_count, size_t(2));
+  EXPECT_FALSE(manifest.sections().front().materialized);
+
+  EXPECT_EQ(manifest.materialize(80), size_t(2));
+  EXPECT_EQ(test::library::constructed_operations, 0);
+
+  // The operation table is built from the records alone
+  OperationTable table;
+  table.append(manifest);
+  EXPECT_EQ(test::library::constructed_operations, 0);
+
+  GemmFunctionalKey key(
+    Provider::kCUTLASS, GemmKind::kUniversal,
+    NumericTypeID::kF32, NumericTypeID::kF32,
+    NumericTypeID::kF16, LayoutTypeID::kRowMajor, ComplexTransform::kNone,
+    NumericTypeID::kF16, LayoutTypeID::kColumnMajor, ComplexTransform::kNone,
+    NumericTypeID::kF32, LayoutTypeID::kRowMajor,
+    NumericTypeID::kF32, LayoutTypeID::kRowMajor);
+
+  auto operators_it = table.gemm_operations.find(key);
+  ASSERT_TRUE(operators_it != table.gemm_operations.end());
+
+  auto preference_it = operators_it->second.find(GemmPreferenceKey(80, 8));
+  ASSERT_TRUE(preference_it != operators_it->second.end());
+  ASSERT_EQ(preference_it->second.size(), size_t(1));
+
+  Operation const *operation = preference_it->second.front();
+  GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+
+  EXPECT_STREQ(desc.name, "gemm_align8");
+  EXPECT_EQ(desc.A.alignment, 8);
+  EXPECT_EQ(desc.tile_description.threadblock_stages, 3);
+  EXPECT_EQ(desc.tile_description.threadblock_shape, cutlass::gemm::GemmCoord(128, 128, 32));
+  EXPECT_EQ(test::library::constructed_operations, 0);
+
+  // First use constructs only the operation found
+  EXPECT_EQ(operation->get_host_workspace_size(nullptr), uint64_t(16));
+  EXPECT_EQ(test::library::constructed_operations, 1);
+
+  EXPECT_EQ(operation->can_implement(nullptr, nullptr), cutlass::Status::kSuccess);
+  EXPECT_EQ(test::library::constructed_operations, 1);
+
+  // The description does not change once the operation is constructed
+  EXPECT_EQ(&operation->description(), &desc);
+  EXPECT_EQ(desc.tile_description.threadblock_stages, 3);
+  EXPECT_EQ(desc.tile_description.warp_count, cutlass::gemm::GemmCoord(2, 2, 1));
+}
+
+TEST(Manifest, materialize_respects_compute_capability) {
+
+  using namespace cutlass::library;
+
+  test::library::constructed_operations = 0;
+
+  Manifest manifest;
+  manifest.register_section(90, "sm90_records", test::library::records, 2);
+  manifest.register_section(OperationKind::kGemm, 80, "sm80_eager", test::library::initialize_section);
+
+  // Sections with initializers construct their operations when materialized
+  EXPECT_EQ(manifest.materialize(80), size_t(1));
+  EXPECT_EQ(test::library::constructed_operations, 1);
+  EXPECT_FALSE(manifest.sections().at(0).materialized);
+  EXPECT_TRUE(manifest.sections().at(1).materialized);
+
+  EXPECT_EQ(manifest.materialize(OperationKind::kConv2d, 90), size_t(0));
+  EXPECT_EQ(manifest.materialize_all(), size_t(2));
+  EXPECT_EQ(manifest.materialize_all(), size_t(0));
+  EXPECT_EQ(test::library::constructed_operations, 1);
+
+  EXPECT_EQ(manifest.operations().size(), size_t(3));
+}
+
+TEST(Manifest, sparse_sections_are_constructed_by_kind) {
+
+  using namespace cutlass::library;
+
+  test::library::constructed_operations = 0;
+
+  // Sparse GEMMs are not described by records; the generator registers an initializer of kind
+  // kSparseGemm next to the records of the configuration
+  Manifest manifest;
+  manifest.register_section(80, "sm80_records", test::library::records, 2);
+  manifest.register_section(OperationKind::kSparseGemm, 80, "sm80_records", test::library::initialize_section);
+
+  EXPECT_EQ(manifest.materialize(OperationKind::kGemm, 80), size_t(2));
+  EXPECT_EQ(test::library::constructed_operations, 0);
+  EXPECT_FALSE(manifest.sections().at(1).materialized);
+
+  EXPECT_EQ(manifest.materialize(OperationKind::kSparseGemm, 80), size_t(1));
+  EXPECT_EQ(test::library::constructed_operations, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
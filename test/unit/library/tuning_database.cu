@@ -0,0 +1,293 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the tuning database and its use by GEMM operation selection
+*/
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/library/gemm_operation_selector.h"
+#include "cutlass/library/tuning_database.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace library {
+
+using namespace cutlass::library;
+
+/// Operation that only carries a description
+class DescribedOperation : public Operation {
+public:
+
+  GemmDescription desc;
+
+  explicit DescribedOperation(char const *name) {
+    desc.name = name;
+    desc.provider = Provider::kCUTLASS;
+    desc.kind = OperationKind::kGemm;
+    desc.A = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kRowMajor, 8);
+    desc.B = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, 8);
+    desc.C = TensorDescription(NumericTypeID::kF32, LayoutTypeID::kRowMajor, 4);
+    desc.D = desc.C;
+    desc.tile_description.threadblock_shape = cutlass::gemm::GemmCoord(128, 128, 32);
+    desc.tile_description.math_instruction.element_accumulator = NumericTypeID::kF32;
+    desc.tile_description.math_instruction.opcode_class = OpcodeClassID::kTensorOp;
+    desc.tile_description.minimum_compute_capability = 80;
+    desc.tile_description.maximum_compute_capability = 1024;
+  }
+
+  OperationDescription const &description() const override { return desc; }
+
+  cutlass::Status can_implement(void const *, void const *) const override { return cutlass::Status::kSuccess; }
+
+  uint64_t get_host_workspace_size(void const *) const override { return 0; }
+
+  uint64_t get_device_workspace_size(void const *, void const *) const override { return 0; }
+
+  cutlass::Status initialize(void const *, void *, void *, cudaStream_t) const override {
+    return cutlass::Status::kSuccess;
+  }
+
+  cutlass::Status run(void const *, void *, void *, cudaStream_t) const override { return cutlass::Status::kSuccess; }
+};
+
+/// Preference map registering operations for SM80 and an alignment of 8
+inline GemmOperationFunctionalMap make_operation_map(std::vector<Operation const *> const &operations) {
+  std::vector<GemmOperationFunctionalMap::Entry> entries;
+  for (Operation const *operation : operations) {
+    entries.push_back({GemmFunctionalKey(Provider::kCUTLASS), GemmPreferenceKey(80, 8), operation});
+  }
+
+  GemmOperationFunctionalMap map;
+  map.build(entries);
+  return map;
+}
+
+/// Signature of the problems computed by DescribedOperation on an SM80 device
+inline TuningSignature described_signature() {
+  DescribedOperation op("signature");
+  return TuningSignature::gemm(op.desc, 80);
+}
+
+} // namespace library
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TuningDatabase, save_load_round_trip) {
+
+  using namespace cutlass::library;
+
+  TuningSignature signature = test::library::described_signature();
+
+  TuningDatabase db;
+  db.insert(TuningRecord(signature, GemmSelectionProblem(1024, 512, 256, 1), "gemm_a", 0.25));
+  db.insert(TuningRecord(signature, GemmSelectionProblem(17, 4096, 64, 8), "gemm_b", 1.5));
+  db.insert(TuningRecord(signature, GemmSelectionProblem(17, 4096, 64, 8), "gemm_c", 1.0));
+
+  TuningSignature other = signature;
+  other.compute_capability = 90;
+  db.insert(TuningRecord(other, GemmSelectionProblem(1024, 512, 256, 1), "gemm_a", 0.125));
+
+  // The faster record of one problem is kept
+  ASSERT_EQ(db.size(), size_t(3));
+
+  std::string path = std::string(CUTLASS_TARGET_NAME) + "_round_trip.tdb";
+  ASSERT_EQ(db.save(path), cutlass::Status::kSuccess);
+
+  TuningDatabase loaded;
+  EXPECT_EQ(loaded.load(path), cutlass::Status::kSuccess);
+  std::remove(path.c_str());
+
+  ASSERT_EQ(loaded.size(), db.size());
+  for (size_t i = 0; i < db.size(); ++i) {
+    TuningRecord const &expected = db.records().at(i);
+    TuningRecord const &actual = loaded.records().at(i);
+    EXPECT_TRUE(actual.signature == expected.signature);
+    EXPECT_TRUE(actual.problem == expected.problem);
+    EXPECT_EQ(actual.operation_name, expected.operation_name);
+    EXPECT_EQ(actual.runtime, expected.runtime);
+  }
+}
+
+TEST(TuningDatabase, load_rejects_missing_file) {
+
+  cutlass::library::TuningDatabase db;
+  EXPECT_NE(db.load("cutlass_test_unit_library_missing.tdb"), cutlass::Status::kSuccess);
+  EXPECT_TRUE(db.empty());
+}
+
+TEST(TuningDatabase, load_rejects_sections_past_end_of_file) {
+
+  using namespace cutlass::library;
+
+  TuningDatabase db;
+  db.insert(TuningRecord(test::library::described_signature(), GemmSelectionProblem(64, 64, 64, 1), "gemm_a", 1.0));
+
+  std::string path = std::string(CUTLASS_TARGET_NAME) + "_corrupt.tdb";
+
+  // Byte offsets of the record count and the string table size within the file header
+  struct Field {
+    std::streamoff offset;
+    uint64_t value;
+    int bytes;
+  };
+
+  Field const fields[] = {
+    {12, 0xffffffffull, 4},
+    {24, 0xffffffffffffull, 8},
+    {16, 0xffffffffffffull, 8}
+  };
+
+  for (Field const &field : fields) {
+    ASSERT_EQ(db.save(path), cutlass::Status::kSuccess);
+    {
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(field.offset);
+      file.write(reinterpret_cast<char const *>(&field.value), field.bytes);
+    }
+
+    TuningDatabase loaded;
+    EXPECT_EQ(loaded.load(path), cutlass::Status::kErrorInvalidProblem);
+    EXPECT_TRUE(loaded.empty());
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST(TuningDatabase, exact_record_preferred_over_nearest) {
+
+  using namespace cutlass::library;
+
+  test::library::DescribedOperation op_a("gemm_a");
+  test::library::DescribedOperation op_b("gemm_b");
+
+  GemmOperationFunctionalMap map = test::library::make_operation_map({&op_a, &op_b});
+  GemmOperationVectorMap const &operations = map.begin()->second;
+
+  GemmPreferenceKey preference(80, 8);
+  TuningSignature signature = test::library::described_signature();
+
+  // Two problems of the same selection bucket, tuned to different operations
+  GemmSelectionProblem problem_a(1000, 1000, 1000, 1);
+  GemmSelectionProblem problem_b(1010, 1000, 1000, 1);
+  ASSERT_TRUE(gemm_selection_bucket(problem_a) == gemm_selection_bucket(problem_b));
+
+  TuningDatabase db;
+  db.insert(TuningRecord(signature, problem_a, "gemm_a", 1.0));
+  db.insert(TuningRecord(signature, problem_b, "gemm_b", 1.0));
+
+  EXPECT_EQ(db.find_gemm_operation(operations, preference, problem_a), &op_a);
+  EXPECT_EQ(db.find_gemm_operation(operations, preference, problem_b), &op_b);
+
+  // A problem without a record uses the nearest one within the distance bound
+  EXPECT_EQ(db.find_gemm_operation(operations, preference, GemmSelectionProblem(1012, 1000, 1000, 1)), &op_b);
+  EXPECT_EQ(db.find_gemm_operation(operations, preference, GemmSelectionProblem(990, 1000, 1000, 1)), &op_a);
+  EXPECT_EQ(db.find_gemm_operation(operations, preference, GemmSelectionProblem(1000, 1000, 1000, 64)), nullptr);
+
+  // Memoized selections are keyed by the exact extents, in either order of first use
+  GemmOperationSelector &selector = GemmOperationSelector::get();
+  EXPECT_EQ(selector.select(operations, preference, problem_b, 108, &db), &op_b);
+  EXPECT_EQ(selector.select(operations, preference, problem_a, 108, &db), &op_a);
+  EXPECT_EQ(selector.select(operations, preference, problem_b, 108, &db), &op_b);
+  EXPECT_EQ(GemmOperationSelector::select_uncached(operations, preference, problem_a, 108, &db), &op_a);
+}
+
+TEST(TuningDatabase, untuned_problem_uses_cost_model) {
+
+  using namespace cutlass::library;
+
+  test::library::DescribedOperation op_a("gemm_a");
+
+  GemmOperationFunctionalMap map = test::library::make_operation_map({&op_a});
+  GemmOperationVectorMap const &operations = map.begin()->second;
+
+  GemmPreferenceKey preference(80, 8);
+
+  TuningDatabase db;
+  db.insert(TuningRecord(test::library::described_signature(), GemmSelectionProblem(64, 64, 64, 1), "gemm_missing", 1.0));
+
+  GemmSelectionProblem problem(4096, 4096, 4096, 1);
+  EXPECT_EQ(db.find_gemm_operation(operations, preference, problem), nullptr);
+  EXPECT_EQ(GemmOperationSelector::get().select(operations, preference, problem, 108, &db), &op_a);
+}
+
+TEST(TuningDatabase, selection_follows_database_changes) {
+
+  using namespace cutlass::library;
+
+  test::library::DescribedOperation op_a("gemm_a");
+  test::library::DescribedOperation op_b("gemm_b");
+
+  GemmOperationFunctionalMap map = test::library::make_operation_map({&op_a, &op_b});
+  GemmOperationVectorMap const &operations = map.begin()->second;
+
+  GemmPreferenceKey preference(80, 8);
+  TuningSignature signature = test::library::described_signature();
+  GemmSelectionProblem problem(2000, 2000, 2000, 1);
+
+  TuningDatabase db;
+  db.insert(TuningRecord(signature, GemmSelectionProblem(2048, 2000, 2000, 1), "gemm_b", 1.0));
+
+  GemmOperationSelector &selector = GemmOperationSelector::get();
+  EXPECT_EQ(selector.select(operations, preference, problem, 108, &db), &op_b);
+
+  // Each change invalidates the memoized decisions made from the previous contents
+  uint64_t generation = db.generation();
+  EXPECT_TRUE(db.insert(TuningRecord(signature, problem, "gemm_a", 1.0)));
+  EXPECT_NE(db.generation(), generation);
+  EXPECT_EQ(selector.select(operations, preference, problem, 108, &db), &op_a);
+
+  generation = db.generation();
+  EXPECT_FALSE(db.insert(TuningRecord(signature, problem, "gemm_b", 2.0)));
+  EXPECT_EQ(db.generation(), generation);
+
+  GemmSelectionProblem distant(4000, 2000, 2000, 1);
+  EXPECT_EQ(selector.select(operations, preference, distant, 108, &db), &op_b);
+  db.set_max_distance(0.5);
+  EXPECT_NE(db.generation(), generation);
+  EXPECT_EQ(selector.select(operations, preference, distant, 108, &db),
+            GemmOperationSelector::select_uncached(operations, preference, distant, 108));
+
+  // A database at the address of a destroyed one starts a new generation
+  TuningDatabase other;
+  EXPECT_NE(other.generation(), db.generation());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the memory bound and ordering of the host verification queue
+*/
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/profiler/host_verification_queue.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using cutlass::profiler::Disposition;
+using cutlass::profiler::HostVerificationQueue;
+
+namespace {
+
+/// Returns a job that blocks until the gate opens
+HostVerificationQueue::JobFactory gated_job(std::shared_future<void> gate, Disposition disposition) {
+  return [gate, disposition] {
+    return HostVerificationQueue::Job([gate, disposition] {
+      gate.wait();
+      return disposition;
+    });
+  };
+}
+
+/// Submits a job from another thread and records when its factory is invoked
+struct PendingSubmit {
+
+  std::atomic<bool> admitted{false};
+  std::thread thread;
+  std::shared_future<Disposition> result;
+
+  void start(HostVerificationQueue &queue, size_t bytes) {
+    thread = std::thread([this, &queue, bytes] {
+      result = queue.submit(bytes, [this] {
+        admitted = true;
+        return HostVerificationQueue::Job([] { return Disposition::kPassed; });
+      });
+    });
+  }
+};
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostVerificationQueue, memory_bound) {
+
+  HostVerificationQueue queue(2, 100);
+
+  std::promise<void> gate;
+  std::shared_future<Disposition> first = queue.submit(60, gated_job(gate.get_future().share(), Disposition::kPassed));
+
+  // 60 + 60 exceeds the bound while the first job holds its snapshots
+  PendingSubmit second;
+  second.start(queue, 60);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(second.admitted);
+
+  gate.set_value();
+  second.thread.join();
+
+  EXPECT_TRUE(second.admitted);
+  EXPECT_EQ(first.get(), Disposition::kPassed);
+  EXPECT_EQ(second.result.get(), Disposition::kPassed);
+}
+
+TEST(HostVerificationQueue, within_bound_not_blocked) {
+
+  HostVerificationQueue queue(1, 100);
+
+  std::promise<void> gate;
+  std::shared_future<void> opened = gate.get_future().share();
+  std::shared_future<Disposition> first = queue.submit(40, gated_job(opened, Disposition::kPassed));
+
+  // 40 + 60 fits the bound, so the submit returns while the first job is still running
+  std::shared_future<Disposition> second = queue.submit(60, gated_job(opened, Disposition::kFailed));
+
+  gate.set_value();
+
+  EXPECT_EQ(first.get(), Disposition::kPassed);
+  EXPECT_EQ(second.get(), Disposition::kFailed);
+}
+
+TEST(HostVerificationQueue, oversized_job) {
+
+  HostVerificationQueue queue(2, 100);
+
+  // A job larger than the bound is admitted when nothing else is in flight
+  std::promise<void> gate;
+  std::shared_future<Disposition> oversized = queue.submit(500, gated_job(gate.get_future().share(), Disposition::kIncorrect));
+
+  // Any further job waits until the oversized one has finished
+  PendingSubmit small;
+  small.start(queue, 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_FALSE(small.admitted);
+
+  gate.set_value();
+  small.thread.join();
+
+  EXPECT_TRUE(small.admitted);
+  EXPECT_EQ(oversized.get(), Disposition::kIncorrect);
+  EXPECT_EQ(small.result.get(), Disposition::kPassed);
+}
+
+TEST(HostVerificationQueue, ordering) {
+
+  std::vector<int> order;
+  std::vector<std::shared_future<Disposition>> results;
+
+  Disposition const dispositions[] = {
+    Disposition::kPassed, Disposition::kFailed, Disposition::kIncorrect, Disposition::kNotVerified
+  };
+
+  {
+    HostVerificationQueue queue(1, 1000);
+
+    for (int idx = 0; idx < 16; ++idx) {
+      Disposition disposition = dispositions[idx % 4];
+      results.push_back(queue.submit(10, [&order, idx, disposition] {
+        return HostVerificationQueue::Job([&order, idx, disposition] {
+          order.push_back(idx);
+          return disposition;
+        });
+      }));
+    }
+
+    // The destructor drains the queue
+  }
+
+  ASSERT_EQ(order.size(), 16);
+  for (int idx = 0; idx < 16; ++idx) {
+    EXPECT_EQ(order[idx], idx);
+    EXPECT_EQ(results[idx].get(), dispositions[idx % 4]);
+  }
+}
+
+TEST(HostVerificationQueue, exception) {
+
+  HostVerificationQueue queue(1, 100);
+
+  std::shared_future<Disposition> result = queue.submit(50, [] {
+    return HostVerificationQueue::Job([]() -> Disposition { throw std::runtime_error("job"); });
+  });
+
+  EXPECT_THROW(result.get(), std::runtime_error);
+
+  // A failing factory releases its share of the bound
+  EXPECT_THROW(queue.submit(100, []() -> HostVerificationQueue::Job { throw std::runtime_error("factory"); }),
+    std::runtime_error);
+
+  std::shared_future<Disposition> next = queue.submit(100, [] {
+    return HostVerificationQueue::Job([] { return Disposition::kPassed; });
+  });
+
+  EXPECT_EQ(next.get(), Disposition::kPassed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
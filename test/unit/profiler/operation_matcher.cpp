@@ -0,0 +1,264 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for problem enumeration and the operation index of the profiler
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/util/command_line.h"
+#include "cutlass/profiler/operation_matcher.h"
+#include "cutlass/profiler/operation_profiler.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using namespace cutlass::profiler;
+
+/// Problem space over the given command line arguments, with tensors A and B and the tile
+/// description arguments of every operation profiler
+ProblemSpace make_problem_space(std::vector<std::string> const &arguments) {
+
+  // Problem spaces refer to their argument descriptions
+  static ArgumentDescriptionVector const schema{
+    {ArgumentTypeID::kInteger, {"m", "problem-size::m"}, "M dimension"},
+    {ArgumentTypeID::kInteger, {"n", "problem-size::n"}, "N dimension"},
+    {ArgumentTypeID::kTensor, {"A"}, "Tensor storing the A operand"},
+    {ArgumentTypeID::kTensor, {"B"}, "Tensor storing the B operand"},
+    {ArgumentTypeID::kEnumerated, {"op_class", "opcode-class"}, "Class of math instruction"},
+    {ArgumentTypeID::kEnumerated, {"accum", "accumulator-type"}, "Math instruction accumulator data type"},
+    {ArgumentTypeID::kInteger, {"cta_m", "threadblock-shape::m"}, "Threadblock shape in the M dimension"},
+    {ArgumentTypeID::kInteger, {"cta_n", "threadblock-shape::n"}, "Threadblock shape in the N dimension"},
+    {ArgumentTypeID::kInteger, {"cta_k", "threadblock-shape::k"}, "Threadblock shape in the K dimension"},
+    {ArgumentTypeID::kInteger, {"cluster_m", "cluster-shape::m"}, "Cluster shape in the M dimension"},
+    {ArgumentTypeID::kInteger, {"cluster_n", "cluster-shape::n"}, "Cluster shape in the N dimension"},
+    {ArgumentTypeID::kInteger, {"cluster_k", "cluster-shape::k"}, "Cluster shape in the K dimension"},
+    {ArgumentTypeID::kInteger, {"stages", "threadblock-stages"}, "Number of stages"},
+    {ArgumentTypeID::kInteger, {"warps_m", "warp-count::m"}, "Number of warps along the M dimension"},
+    {ArgumentTypeID::kInteger, {"warps_n", "warp-count::n"}, "Number of warps along the N dimension"},
+    {ArgumentTypeID::kInteger, {"warps_k", "warp-count::k"}, "Number of warps along the K dimension"},
+    {ArgumentTypeID::kInteger, {"inst_m", "instruction-shape::m"}, "Math instruction shape in the M dimension"},
+    {ArgumentTypeID::kInteger, {"inst_n", "instruction-shape::n"}, "Math instruction shape in the N dimension"},
+    {ArgumentTypeID::kInteger, {"inst_k", "instruction-shape::k"}, "Math instruction shape in the K dimension"}
+  };
+
+  std::vector<char const *> argv{"test"};
+  for (std::string const &argument : arguments) {
+    argv.push_back(argument.c_str());
+  }
+
+  cutlass::CommandLine cmdline(int(argv.size()), argv.data());
+  return ProblemSpace(schema, cmdline);
+}
+
+/// Prints the values of a problem
+std::string to_string(ProblemSpace::Problem const &problem) {
+  std::stringstream ss;
+  for (auto const &value : problem) {
+    value->print(ss);
+    ss << "; ";
+  }
+  return ss.str();
+}
+
+/// Operation that only carries a description
+class DescribedOperation : public cutlass::library::Operation {
+public:
+
+  cutlass::library::GemmDescription desc;
+
+  cutlass::library::OperationDescription const &description() const override { return desc; }
+
+  cutlass::Status can_implement(void const *, void const *) const override { return cutlass::Status::kSuccess; }
+
+  uint64_t get_host_workspace_size(void const *) const override { return 0; }
+
+  uint64_t get_device_workspace_size(void const *, void const *) const override { return 0; }
+
+  cutlass::Status initialize(void const *, void *, void *, cudaStream_t) const override {
+    return cutlass::Status::kSuccess;
+  }
+
+  cutlass::Status run(void const *, void *, void *, cudaStream_t) const override { return cutlass::Status::kSuccess; }
+};
+
+/// Operations covering each combination of the tile and tensor values used below
+std::vector<DescribedOperation> make_operations() {
+
+  using namespace cutlass::library;
+
+  std::vector<DescribedOperation> operations;
+
+  for (int cta_m : {64, 128}) {
+    for (OpcodeClassID opcode_class : {OpcodeClassID::kTensorOp, OpcodeClassID::kSimt}) {
+      for (NumericTypeID accum : {NumericTypeID::kF32, NumericTypeID::kF16}) {
+        for (NumericTypeID element_A : {NumericTypeID::kF16, NumericTypeID::kF32}) {
+          for (LayoutTypeID layout_A : {LayoutTypeID::kRowMajor, LayoutTypeID::kColumnMajor}) {
+
+            DescribedOperation op;
+            op.desc.kind = OperationKind::kGemm;
+            op.desc.A = TensorDescription(element_A, layout_A, 8);
+            op.desc.B = TensorDescription(NumericTypeID::kF16, LayoutTypeID::kColumnMajor, 8);
+            op.desc.tile_description.threadblock_shape = cutlass::gemm::GemmCoord(cta_m, 128, 32);
+            op.desc.tile_description.threadblock_stages = 3;
+            op.desc.tile_description.warp_count = cutlass::gemm::GemmCoord(2, 2, 1);
+            op.desc.tile_description.math_instruction.opcode_class = opcode_class;
+            op.desc.tile_description.math_instruction.element_accumulator = accum;
+
+            // Duplicates share a bucket of the index
+            operations.push_back(op);
+            operations.push_back(op);
+          }
+        }
+      }
+    }
+  }
+
+  return operations;
+}
+
+/// Matches every problem of a space against the operations, with and without the index. Returns
+/// the fraction of (operation, problem) pairs that match.
+double TestMatcherAgreesWithSatisfies(std::vector<std::string> const &arguments) {
+
+  ProblemSpace problem_space = make_problem_space(arguments);
+
+  std::vector<DescribedOperation> storage = make_operations();
+  OperationMatcher::OperationVector operations;
+  for (DescribedOperation const &op : storage) {
+    operations.push_back(&op);
+  }
+
+  OperationMatcher matcher(
+    problem_space,
+    operations,
+    {"A", "B"},
+    [](cutlass::library::OperationDescription const &op_desc) {
+      auto const &gemm_desc = static_cast<cutlass::library::GemmDescription const &>(op_desc);
+      return std::vector<cutlass::library::TensorDescription>{gemm_desc.A, gemm_desc.B};
+    });
+
+  EXPECT_EQ(matcher.bucket_count(), storage.size() / 2);
+
+  size_t problem_count = 0;
+  size_t matched_count = 0;
+
+  for (ProblemSpace::Iterator problem_it = problem_space.begin(), end = problem_space.end();
+       problem_it != end; ++problem_it) {
+
+    ProblemSpace::Problem problem = problem_it.at();
+
+    OperationMatcher::OperationVector expected;
+    for (cutlass::library::Operation const *op : operations) {
+      auto const &desc = static_cast<cutlass::library::GemmDescription const &>(op->description());
+      if (OperationProfiler::satisfies(desc, problem_space, problem) &&
+          tensor_description_satisfies(desc.A, "A", problem_space, problem) &&
+          tensor_description_satisfies(desc.B, "B", problem_space, problem)) {
+        expected.push_back(op);
+      }
+    }
+
+    EXPECT_EQ(matcher.match(problem), expected) << to_string(problem);
+
+    ++problem_count;
+    matched_count += expected.size();
+  }
+
+  EXPECT_EQ(problem_count, problem_space.size());
+
+  return double(matched_count) / double(problem_count * operations.size());
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ProblemSpace, iterator_seek_matches_sequential_iteration) {
+
+  using namespace cutlass::profiler;
+
+  ProblemSpace problem_space = make_problem_space({
+    "--m=1:5", "--n=16,32,64", "--A=f16:row,f32:column", "--cta_m=64,128", "--op_class=tensorop,simt"});
+
+  ASSERT_EQ(problem_space.size(), size_t(5 * 3 * 2 * 2 * 2));
+
+  size_t index = 0;
+  for (ProblemSpace::Iterator problem_it = problem_space.begin(), end = problem_space.end();
+       problem_it != end; ++problem_it, ++index) {
+
+    ProblemSpace::Iterator seek_it(problem_space, index);
+    EXPECT_EQ(to_string(seek_it.at()), to_string(problem_it.at())) << "index: " << index;
+
+    // Continuing from a sought position visits the same problems
+    if (index + 1 < problem_space.size()) {
+      ++seek_it;
+      EXPECT_EQ(to_string(seek_it.at()), to_string(ProblemSpace::Iterator(problem_space, index + 1).at()));
+    }
+  }
+
+  EXPECT_EQ(index, problem_space.size());
+
+  // Seeking past the last problem yields the end iterator
+  EXPECT_TRUE(ProblemSpace::Iterator(problem_space, problem_space.size()) == problem_space.end());
+  EXPECT_TRUE(ProblemSpace::Iterator(problem_space, problem_space.size() + 7) == problem_space.end());
+}
+
+TEST(OperationMatcher, unset_constraints) {
+  EXPECT_EQ(TestMatcherAgreesWithSatisfies({"--m=128"}), 1.0);
+}
+
+TEST(OperationMatcher, unknown_tensor_constraints) {
+  double matched = TestMatcherAgreesWithSatisfies({"--A=*:row,f16:*,*:*,*", "--B=*:column,*"});
+  EXPECT_GT(matched, 0.0);
+  EXPECT_LT(matched, 1.0);
+}
+
+TEST(OperationMatcher, mismatched_tensor_constraints) {
+  double matched = TestMatcherAgreesWithSatisfies({
+    "--A=f16:row,f32:column,f64:row,f16:column", "--B=f16:column,f16:row,f32:column"});
+  EXPECT_GT(matched, 0.0);
+  EXPECT_LT(matched, 1.0);
+}
+
+TEST(OperationMatcher, tile_constraints) {
+  double matched = TestMatcherAgreesWithSatisfies({
+    "--cta_m=64,128,256", "--op_class=tensorop,simt", "--accum=f32,f16", "--stages=3,4", "--warps_m=2",
+    "--A=f16:row,*:column"});
+  EXPECT_GT(matched, 0.0);
+  EXPECT_LT(matched, 1.0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,176 @@
+/***************************************************************************************************
+ * Copyright (c) 2023 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the runtime statistics and the stopping rule of adaptive profiling
+*/
+
+#include <cmath>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/profiler/runtime_statistics.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(RuntimeStatistics, empty) {
+
+  cutlass::profiler::RuntimeStatistics stats = cutlass::profiler::RuntimeStatistics::compute({});
+
+  EXPECT_EQ(stats.samples, 0);
+  EXPECT_EQ(stats.mean, 0);
+  EXPECT_TRUE(std::isinf(stats.confidence_interval()));
+}
+
+TEST(RuntimeStatistics, quantiles_and_spread) {
+
+  // Unsorted input: 1, 2, ..., 11
+  std::vector<double> samples = {6, 2, 9, 1, 11, 4, 7, 3, 10, 5, 8};
+
+  cutlass::profiler::RuntimeStatistics stats = cutlass::profiler::RuntimeStatistics::compute(samples);
+
+  EXPECT_EQ(stats.samples, 11);
+  EXPECT_DOUBLE_EQ(stats.mean, 6);
+  EXPECT_DOUBLE_EQ(stats.median, 6);
+  EXPECT_DOUBLE_EQ(stats.p10, 2);
+  EXPECT_DOUBLE_EQ(stats.p90, 10);
+  EXPECT_DOUBLE_EQ(stats.stddev, std::sqrt(11.0));
+  EXPECT_EQ(stats.outliers, 0);
+
+  // t(0.975, 10) * stddev / sqrt(n)
+  EXPECT_NEAR(stats.confidence_interval(), 2.228 * std::sqrt(11.0) / std::sqrt(11.0), 1e-12);
+}
+
+TEST(RuntimeStatistics, interpolated_quantiles_and_outliers) {
+
+  // Q1 = 1.75, Q3 = 3.25: the upper fence is 5.5
+  std::vector<double> samples = {1, 2, 3, 100};
+
+  cutlass::profiler::RuntimeStatistics stats = cutlass::profiler::RuntimeStatistics::compute(samples);
+
+  EXPECT_DOUBLE_EQ(stats.median, 2.5);
+  EXPECT_DOUBLE_EQ(stats.p10, 1.3);
+  EXPECT_DOUBLE_EQ(stats.p90, 100 - 0.3 * 97);
+  EXPECT_EQ(stats.outliers, 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(AdaptiveMeasurement, calibrate) {
+
+  using cutlass::profiler::AdaptiveMeasurement;
+
+  int const max_batch_size = AdaptiveMeasurement::kMaxBatchSize;
+
+  AdaptiveMeasurement measurement(0.01, 500, 0.1);
+
+  EXPECT_EQ(measurement.batch_size(), 1);
+
+  measurement.calibrate(0.03);
+  EXPECT_EQ(measurement.batch_size(), 4);
+
+  measurement.calibrate(1.0);
+  EXPECT_EQ(measurement.batch_size(), 1);
+
+  measurement.calibrate(1e-6);
+  EXPECT_EQ(measurement.batch_size(), max_batch_size);
+
+  // An unmeasurably short launch uses the largest batch
+  measurement.calibrate(0);
+  EXPECT_EQ(measurement.batch_size(), max_batch_size);
+}
+
+TEST(AdaptiveMeasurement, samples_are_batch_means) {
+
+  using cutlass::profiler::AdaptiveMeasurement;
+
+  AdaptiveMeasurement measurement(0.01, 500, 0.1);
+  measurement.calibrate(0.025);
+
+  ASSERT_EQ(measurement.batch_size(), 4);
+
+  measurement.append(0.4);
+  measurement.append(0.8);
+
+  cutlass::profiler::RuntimeStatistics stats = measurement.statistics();
+
+  EXPECT_EQ(stats.samples, 2);
+  EXPECT_EQ(measurement.iterations(), 8);
+  EXPECT_DOUBLE_EQ(stats.mean, 0.15);
+  EXPECT_DOUBLE_EQ(stats.median, 0.15);
+}
+
+TEST(AdaptiveMeasurement, stopping_rule) {
+
+  using cutlass::profiler::AdaptiveMeasurement;
+
+  // Constant samples converge once the minimum sample count is reached
+  {
+    AdaptiveMeasurement measurement(0.01, 500);
+    EXPECT_FALSE(measurement.done(0));
+
+    for (int i = 1; i < AdaptiveMeasurement::kMinSamples; ++i) {
+      measurement.append(1.0);
+      EXPECT_FALSE(measurement.done(1));
+    }
+
+    measurement.append(1.0);
+    EXPECT_TRUE(measurement.done(1));
+  }
+
+  // Noisy samples run until the wall-clock budget is spent
+  {
+    AdaptiveMeasurement measurement(0.01, 500);
+    for (int i = 0; i < 2 * AdaptiveMeasurement::kMinSamples; ++i) {
+      measurement.append((i % 2) ? 1.0 : 2.0);
+    }
+
+    EXPECT_FALSE(measurement.done(499));
+    EXPECT_TRUE(measurement.done(500));
+  }
+
+  // The budget does not stop sampling before the first sample
+  {
+    AdaptiveMeasurement measurement(0.01, 500);
+    EXPECT_FALSE(measurement.done(1000));
+  }
+
+  // Sampling stops at the sample limit
+  {
+    AdaptiveMeasurement measurement(0.01, 500);
+    for (int i = 0; i < AdaptiveMeasurement::kMaxSamples; ++i) {
+      measurement.append((i % 2) ? 1.0 : 2.0);
+    }
+    EXPECT_TRUE(measurement.done(0));
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,205 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the columnar profiler report format
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cutlass/util/columnar_report.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Returns a file path unique to the calling test, removing any existing file
+std::string make_report_path() {
+  auto const *info = ::testing::UnitTest::GetInstance()->current_test_info();
+  std::filesystem::path path = std::filesystem::path(::testing::TempDir()) /
+    (std::string("cutlass_columnar_") + info->name() + ".ccr");
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+cutlass::columnar::Schema make_schema() {
+  using cutlass::columnar::ColumnType;
+  return {
+    {"Problem", ColumnType::kInt64},
+    {"Operation", ColumnType::kString},
+    {"Runtime", ColumnType::kFloat64}
+  };
+}
+
+/// Writes rows [begin, end) with one row group per group_size rows
+void write_rows(cutlass::columnar::Writer &writer, int begin, int end, int group_size) {
+  for (int row = begin; row < end; ++row) {
+    writer.append_int64(0, int64_t(row) * 3 - 100);
+    writer.append_string(1, "kernel_" + std::to_string(row % 7));
+    writer.append_float64(2, row % 5 ? 0.5 * row : NAN);
+    if ((row + 1) % group_size == 0) {
+      writer.flush();
+    }
+  }
+}
+
+void check_rows(cutlass::columnar::Reader &reader, int row_count) {
+
+  ASSERT_EQ(reader.row_count(), uint64_t(row_count));
+
+  cutlass::columnar::ColumnData problem, operation, runtime;
+  ASSERT_TRUE(reader.read_column(reader.find("Problem"), problem));
+  ASSERT_TRUE(reader.read_column(reader.find("Operation"), operation));
+  ASSERT_TRUE(reader.read_column(reader.find("Runtime"), runtime));
+
+  ASSERT_EQ(problem.size(), size_t(row_count));
+  ASSERT_EQ(operation.size(), size_t(row_count));
+  ASSERT_EQ(runtime.size(), size_t(row_count));
+  EXPECT_EQ(operation.dictionary.size(), size_t(std::min(row_count, 7)));
+
+  for (int row = 0; row < row_count; ++row) {
+    EXPECT_EQ(problem.int64[row], int64_t(row) * 3 - 100);
+    EXPECT_EQ(operation.string(row), "kernel_" + std::to_string(row % 7));
+    if (row % 5) {
+      EXPECT_EQ(runtime.float64[row], 0.5 * row);
+    }
+    else {
+      EXPECT_TRUE(std::isnan(runtime.float64[row]));
+    }
+  }
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(ColumnarReport, round_trip) {
+
+  std::string path = make_report_path();
+  {
+    cutlass::columnar::Writer writer;
+    ASSERT_TRUE(writer.open(path, make_schema()));
+    write_rows(writer, 0, 1000, 64);
+  }
+
+  cutlass::columnar::Reader reader(path);
+  ASSERT_TRUE(reader.good());
+  EXPECT_TRUE(reader.schema() == make_schema());
+  EXPECT_EQ(reader.find("Missing"), -1);
+  EXPECT_EQ(reader.row_groups().size(), size_t(16));
+  EXPECT_FALSE(reader.truncated());
+  check_rows(reader, 1000);
+
+  // Reading a single row group decodes only its rows
+  cutlass::columnar::ColumnData problem;
+  ASSERT_TRUE(reader.read_column(1, 0, problem));
+  ASSERT_EQ(problem.size(), size_t(64));
+  EXPECT_EQ(problem.int64[0], 64 * 3 - 100);
+}
+
+TEST(ColumnarReport, append) {
+
+  std::string path = make_report_path();
+  {
+    cutlass::columnar::Writer writer;
+    ASSERT_TRUE(writer.open(path, make_schema()));
+    write_rows(writer, 0, 100, 10);
+  }
+  {
+    cutlass::columnar::Writer writer;
+    ASSERT_TRUE(writer.open(path, make_schema(), true));
+    write_rows(writer, 100, 250, 10);
+  }
+
+  cutlass::columnar::Reader reader(path);
+  ASSERT_TRUE(reader.good());
+  check_rows(reader, 250);
+
+  // Appending with a different schema is rejected
+  cutlass::columnar::Schema schema = make_schema();
+  schema.pop_back();
+  cutlass::columnar::Writer writer;
+  EXPECT_FALSE(writer.open(path, schema, true));
+}
+
+TEST(ColumnarReport, truncated_row_group) {
+
+  std::string path = make_report_path();
+  {
+    cutlass::columnar::Writer writer;
+    ASSERT_TRUE(writer.open(path, make_schema()));
+    write_rows(writer, 0, 40, 20);
+  }
+
+  // Simulate a crash while writing the second row group
+  uint64_t file_bytes = std::filesystem::file_size(path);
+  std::filesystem::resize_file(path, file_bytes - 5);
+
+  {
+    cutlass::columnar::Reader reader(path);
+    ASSERT_TRUE(reader.good());
+    EXPECT_TRUE(reader.truncated());
+    check_rows(reader, 20);
+  }
+
+  // Appending discards the partial row group
+  {
+    cutlass::columnar::Writer writer;
+    ASSERT_TRUE(writer.open(path, make_schema(), true));
+    write_rows(writer, 20, 60, 20);
+  }
+
+  cutlass::columnar::Reader reader(path);
+  EXPECT_FALSE(reader.truncated());
+  check_rows(reader, 60);
+}
+
+TEST(ColumnarReport, corrupt_header) {
+
+  std::string path = make_report_path();
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "not a columnar report";
+  }
+
+  cutlass::columnar::Reader reader(path);
+  EXPECT_FALSE(reader.good());
+
+  cutlass::columnar::Writer writer;
+  EXPECT_FALSE(writer.open(path, make_schema(), true));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,333 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the host reference convolution lowered onto the host GEMM
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/conv/convolution.h"
+#include "cutlass/epilogue/thread/activation.h"
+
+#include "cutlass/util/reference/host/conv.hpp"
+
+#include "cute/tensor.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Problem extents; spatial dims beyond the rank of the convolution have extent 1 and filter extent 1
+struct HostConvProblem {
+  int N, C, K;
+  int D, H, W;
+  int T, R, S;
+  int stride[3];    // (w, h, d)
+  int pad[3];
+  int dilation[3];
+
+  int output_extent(int dim, int x, int f) const {
+    return (x + 2 * pad[dim] - dilation[dim] * (f - 1) - 1) / stride[dim] + 1;
+  }
+  int Q() const { return output_extent(0, W, S); }
+  int P() const { return output_extent(1, H, R); }
+  int Z() const { return output_extent(2, D, T); }
+};
+
+/// Rank-Rank view of a packed (c, w, h, d, n) buffer
+template <int Rank, class Element>
+auto make_conv_tensor(Element* ptr, int c, int w, int h, int d, int n) {
+  if constexpr (Rank == 1) {
+    return cute::make_tensor(ptr, cute::make_layout(cute::make_shape(c, w, n)));
+  }
+  else if constexpr (Rank == 2) {
+    return cute::make_tensor(ptr, cute::make_layout(cute::make_shape(c, w, h, n)));
+  }
+  else {
+    return cute::make_tensor(ptr, cute::make_layout(cute::make_shape(c, w, h, d, n)));
+  }
+}
+
+template <int Rank>
+auto make_conv_param(int const (&value)[3]) {
+  if constexpr (Rank == 1) {
+    return cute::make_tuple(value[0]);
+  }
+  else if constexpr (Rank == 2) {
+    return cute::make_tuple(value[0], value[1]);
+  }
+  else {
+    return cute::make_tuple(value[0], value[1], value[2]);
+  }
+}
+
+/// Offset of (c, w, h, d, n) in a packed buffer with extents (C, W, H, D)
+inline size_t conv_offset(int c, int w, int h, int d, int n, int C, int W, int H, int D) {
+  return size_t(c) + size_t(C) * (w + size_t(W) * (h + size_t(H) * (d + size_t(D) * n)));
+}
+
+/// Runs ConvReferenceImpl with a ReLU epilogue, D = relu(acc + 0.5 * C), and compares it against
+/// a direct loop nest. Operands hold small integers so that the comparison is exact.
+template <cutlass::conv::Operator ConvOp, int Rank, class Element>
+void run_host_conv(HostConvProblem const& pb) {
+
+  int const N = pb.N, C = pb.C, K = pb.K;
+  int const D = pb.D, H = pb.H, W = pb.W;
+  int const T = pb.T, R = pb.R, S = pb.S;
+  int const Z = pb.Z(), P = pb.P(), Q = pb.Q();
+
+  std::vector<Element> activation(size_t(N) * D * H * W * C);
+  std::vector<Element> filter(size_t(K) * T * R * S * C);
+  std::vector<Element> gradient(size_t(N) * Z * P * Q * K);
+  for (size_t i = 0; i < activation.size(); ++i) {
+    activation[i] = Element(float(int(i * 7 % 9) - 4));
+  }
+  for (size_t i = 0; i < filter.size(); ++i) {
+    filter[i] = Element(float(int(i * 5 % 11) - 5));
+  }
+  for (size_t i = 0; i < gradient.size(); ++i) {
+    gradient[i] = Element(float(int(i * 3 % 7) - 3));
+  }
+
+  // Output extents (c, w, h, d, n) of the operator
+  int out[5];
+  if (ConvOp == cutlass::conv::Operator::kFprop) {
+    int e[5] = {K, Q, P, Z, N};
+    std::copy(e, e + 5, out);
+  }
+  else if (ConvOp == cutlass::conv::Operator::kDgrad) {
+    int e[5] = {C, W, H, D, N};
+    std::copy(e, e + 5, out);
+  }
+  else {
+    int e[5] = {C, S, R, T, K};
+    std::copy(e, e + 5, out);
+  }
+
+  std::vector<float> source(size_t(out[0]) * out[1] * out[2] * out[3] * out[4]);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = float(int(i % 5) - 2);
+  }
+  std::vector<float> result(source.size(), -1.0f);
+
+  auto mActivation = make_conv_tensor<Rank>(activation.data(), C, W, H, D, N);
+  auto mFilter = make_conv_tensor<Rank>(filter.data(), C, S, R, T, K);
+  auto mGradient = make_conv_tensor<Rank>(gradient.data(), K, Q, P, Z, N);
+  auto mC = make_conv_tensor<Rank>(source.data(), out[0], out[1], out[2], out[3], out[4]);
+  auto mD = make_conv_tensor<Rank>(result.data(), out[0], out[1], out[2], out[3], out[4]);
+
+  auto mA = [&] {
+    if constexpr (ConvOp == cutlass::conv::Operator::kFprop) { return mActivation; }
+    else { return mGradient; }
+  }();
+  auto mB = [&] {
+    if constexpr (ConvOp == cutlass::conv::Operator::kWgrad) { return mActivation; }
+    else { return mFilter; }
+  }();
+
+  using TensorScale = decltype(cute::make_tensor(static_cast<float*>(nullptr), cute::make_layout(cute::make_shape(0))));
+
+  cutlass::reference::host::ConvEpilogueFusionParams<
+    float, float, float, float, float, TensorScale, TensorScale, TensorScale,
+    cutlass::epilogue::thread::ReLu<float>> epilogue_fusion_params;
+  epilogue_fusion_params.alpha = 1.0f;
+  epilogue_fusion_params.beta = 0.5f;
+
+  auto padding = make_conv_param<Rank>(pb.pad);
+  auto tstride = make_conv_param<Rank>(pb.stride);
+  auto dilation = make_conv_param<Rank>(pb.dilation);
+
+  cutlass::reference::host::ConvReferenceImpl<
+    ConvOp, Rank,
+    decltype(mA), decltype(mB), decltype(mC), decltype(mD),
+    decltype(padding), decltype(tstride), decltype(dilation),
+    decltype(epilogue_fusion_params)>
+      reference_impl(mA, mB, mC, mD, padding, tstride, dilation, epilogue_fusion_params);
+
+  reference_impl.compute_reference();
+
+  auto act = [&](int c, int w, int h, int d, int n) {
+    return float(activation[conv_offset(c, w, h, d, n, C, W, H, D)]);
+  };
+  auto flt = [&](int c, int s, int r, int t, int k) {
+    return float(filter[conv_offset(c, s, r, t, k, C, S, R, T)]);
+  };
+  auto grad = [&](int k, int q, int p, int z, int n) {
+    return float(gradient[conv_offset(k, q, p, z, n, K, Q, P, Z)]);
+  };
+
+  int clamped = 0;
+  int mismatches = 0;
+  for (int i4 = 0; i4 < out[4]; ++i4) {
+    for (int i3 = 0; i3 < out[3]; ++i3) {
+      for (int i2 = 0; i2 < out[2]; ++i2) {
+        for (int i1 = 0; i1 < out[1]; ++i1) {
+          for (int i0 = 0; i0 < out[0]; ++i0) {
+            float accum = 0;
+
+            if (ConvOp == cutlass::conv::Operator::kFprop) {
+              for (int t = 0; t < T; ++t) {
+                for (int r = 0; r < R; ++r) {
+                  for (int s = 0; s < S; ++s) {
+                    int w = i1 * pb.stride[0] - pb.pad[0] + s * pb.dilation[0];
+                    int h = i2 * pb.stride[1] - pb.pad[1] + r * pb.dilation[1];
+                    int d = i3 * pb.stride[2] - pb.pad[2] + t * pb.dilation[2];
+                    if (w < 0 || w >= W || h < 0 || h >= H || d < 0 || d >= D) {
+                      continue;
+                    }
+                    for (int c = 0; c < C; ++c) {
+                      accum += act(c, w, h, d, i4) * flt(c, s, r, t, i0);
+                    }
+                  }
+                }
+              }
+            }
+            else if (ConvOp == cutlass::conv::Operator::kDgrad) {
+              for (int k = 0; k < K; ++k) {
+                for (int t = 0; t < T; ++t) {
+                  for (int r = 0; r < R; ++r) {
+                    for (int s = 0; s < S; ++s) {
+                      int q = i1 + pb.pad[0] - s * pb.dilation[0];
+                      int p = i2 + pb.pad[1] - r * pb.dilation[1];
+                      int z = i3 + pb.pad[2] - t * pb.dilation[2];
+                      if (q % pb.stride[0] || p % pb.stride[1] || z % pb.stride[2]) {
+                        continue;
+                      }
+                      q /= pb.stride[0];
+                      p /= pb.stride[1];
+                      z /= pb.stride[2];
+                      if (q < 0 || q >= Q || p < 0 || p >= P || z < 0 || z >= Z) {
+                        continue;
+                      }
+                      accum += grad(k, q, p, z, i4) * flt(i0, s, r, t, k);
+                    }
+                  }
+                }
+              }
+            }
+            else {
+              for (int n = 0; n < N; ++n) {
+                for (int z = 0; z < Z; ++z) {
+                  for (int p = 0; p < P; ++p) {
+                    for (int q = 0; q < Q; ++q) {
+                      int w = q * pb.stride[0] - pb.pad[0] + i1 * pb.dilation[0];
+                      int h = p * pb.stride[1] - pb.pad[1] + i2 * pb.dilation[1];
+                      int d = z * pb.stride[2] - pb.pad[2] + i3 * pb.dilation[2];
+                      if (w < 0 || w >= W || h < 0 || h >= H || d < 0 || d >= D) {
+                        continue;
+                      }
+                      accum += act(i0, w, h, d, n) * grad(i4, q, p, z, n);
+                    }
+                  }
+                }
+              }
+            }
+
+            size_t idx = conv_offset(i0, i1, i2, i3, i4, out[0], out[1], out[2], out[3]);
+            float output = accum + 0.5f * source[idx];
+            clamped += (output < 0);
+            float expected = output < 0 ? 0.0f : output;
+            mismatches += (result[idx] != expected);
+            if (mismatches == 1 && result[idx] != expected) {
+              EXPECT_EQ(expected, result[idx]) << "at (" << i0 << ", " << i1 << ", " << i2 << ", " << i3 << ", " << i4 << ")";
+            }
+          }
+        }
+      }
+    }
+  }
+
+  EXPECT_EQ(mismatches, 0);
+
+  // The epilogue activation is applied for every operator and rank
+  EXPECT_GT(clamped, 0);
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+// Rank 1 exceeds the pixel, channel and depth blocking of the lowering
+test::util::HostConvProblem const kProblem1d = {3, 70, 67, 1, 1, 37, 1, 1, 3, {2, 1, 1}, {1, 0, 0}, {2, 1, 1}};
+test::util::HostConvProblem const kProblem2d = {2, 9, 12, 1, 11, 13, 1, 3, 3, {2, 3, 1}, {1, 2, 0}, {1, 2, 1}};
+test::util::HostConvProblem const kProblem3d = {2, 6, 5, 5, 7, 9, 2, 3, 3, {2, 1, 2}, {1, 1, 0}, {1, 1, 2}};
+
+} // namespace
+
+TEST(HostConv, fprop_1d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kFprop, 1, float>(kProblem1d);
+}
+
+TEST(HostConv, fprop_2d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kFprop, 2, float>(kProblem2d);
+}
+
+TEST(HostConv, fprop_3d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kFprop, 3, float>(kProblem3d);
+}
+
+TEST(HostConv, fprop_2d_f16) {
+  test::util::run_host_conv<cutlass::conv::Operator::kFprop, 2, cutlass::half_t>(kProblem2d);
+}
+
+TEST(HostConv, dgrad_1d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kDgrad, 1, float>(kProblem1d);
+}
+
+TEST(HostConv, dgrad_2d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kDgrad, 2, float>(kProblem2d);
+}
+
+TEST(HostConv, dgrad_3d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kDgrad, 3, float>(kProblem3d);
+}
+
+TEST(HostConv, wgrad_1d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kWgrad, 1, float>(kProblem1d);
+}
+
+TEST(HostConv, wgrad_2d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kWgrad, 2, float>(kProblem2d);
+}
+
+TEST(HostConv, wgrad_3d) {
+  test::util::run_host_conv<cutlass::conv::Operator::kWgrad, 3, cutlass::half_t>(kProblem3d);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
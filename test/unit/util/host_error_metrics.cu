@@ -0,0 +1,146 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the fused host error metric reduction
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <cmath>
+#include <limits>
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/error_metrics.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+#include "cutlass/util/reference/host/tensor_norm.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostErrorMetrics, norms_match_tensor_norm) {
+
+  cutlass::MatrixCoord extent(517, 389);
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> computed(extent, false);
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> reference(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(computed.host_view(), 1, 4, -4);
+  cutlass::reference::host::TensorFillRandomUniform(reference.host_view(), 2, 4, -4);
+
+  auto metrics = cutlass::reference::host::TensorErrorMetricsReduce(computed.host_view(), reference.host_view());
+
+  double l1 = 0, linf = 0, max_rel = 0;
+  for (int r = 0; r < extent.row(); ++r) {
+    for (int c = 0; c < extent.column(); ++c) {
+      double diff = std::abs(double(computed.at({r, c})) - double(reference.at({r, c})));
+      l1 += diff;
+      linf = std::max(linf, diff);
+      max_rel = std::max(max_rel, diff / std::abs(double(reference.at({r, c}))));
+    }
+  }
+
+  double l2 = cutlass::reference::host::TensorNormDiff(computed.host_view(), reference.host_view());
+  double reference_l2 = cutlass::reference::host::TensorNorm(reference.host_view());
+
+  EXPECT_EQ(metrics.element_count, int64_t(extent.row()) * extent.column());
+  EXPECT_NEAR(metrics.l1(), l1, 1e-9 * l1);
+  EXPECT_NEAR(metrics.l2(), l2, 1e-12 * l2);
+  EXPECT_NEAR(metrics.reference_l2(), reference_l2, 1e-12 * reference_l2);
+  EXPECT_EQ(metrics.linf(), linf);
+  EXPECT_EQ(metrics.max_rel_error, max_rel);
+  EXPECT_NEAR(
+    cutlass::reference::host::TensorRelativeErrorMetric(computed.host_view(), reference.host_view()),
+    l2 / reference_l2, 1e-12);
+}
+
+TEST(HostErrorMetrics, ulp_histogram_and_non_finite) {
+
+  size_t const kCount = 1000;
+
+  std::vector<cutlass::half_t> computed(kCount, cutlass::half_t(1));
+  std::vector<cutlass::half_t> reference(kCount, cutlass::half_t(1));
+
+  // 1 ulp, 3 ulps, a signed zero and non-finite values
+  computed[1] = cutlass::half_t::bitcast(0x3c01);
+  computed[2] = cutlass::half_t::bitcast(0x3bfd);
+  computed[3] = cutlass::half_t(-0.0f);
+  reference[3] = cutlass::half_t(0.0f);
+  computed[4] = cutlass::half_t(std::numeric_limits<float>::quiet_NaN());
+  computed[5] = cutlass::half_t(std::numeric_limits<float>::infinity());
+  reference[6] = cutlass::half_t(-std::numeric_limits<float>::infinity());
+
+  auto metrics = cutlass::reference::host::BlockErrorMetricsReduce(computed.data(), reference.data(), kCount);
+
+  EXPECT_EQ(metrics.computed_nan_count, 1);
+  EXPECT_EQ(metrics.computed_inf_count, 1);
+  EXPECT_EQ(metrics.reference_nan_count, 0);
+  EXPECT_EQ(metrics.reference_inf_count, 1);
+
+  EXPECT_EQ(metrics.ulp_histogram[0], int64_t(kCount) - 5);
+  EXPECT_EQ(metrics.ulp_histogram[1], 1);
+  EXPECT_EQ(metrics.ulp_histogram[2], 1);
+  EXPECT_EQ(metrics.max_ulp_error, 3);
+
+  // Non-finite values propagate to the norms
+  EXPECT_TRUE(std::isnan(metrics.l2()));
+  EXPECT_EQ(metrics.max_abs_error, 3.0 / 2048);
+}
+
+TEST(HostErrorMetrics, accumulator_over_slabs) {
+
+  size_t const kCount = 300000;
+
+  std::vector<double> computed(kCount), reference(kCount);
+  for (size_t i = 0; i < kCount; ++i) {
+    reference[i] = 1.0 / double(i + 1);
+    computed[i] = reference[i] * (1 + 1e-9 * double(i % 5));
+  }
+
+  // Metrics of three slabs combine to the metrics of the whole block
+  cutlass::reference::host::TensorErrorMetricsAccumulator accumulator;
+  accumulator.update(computed.data(), reference.data(), 100000);
+  accumulator.update(computed.data() + 100000, reference.data() + 100000, 150000);
+  accumulator.update(computed.data() + 250000, reference.data() + 250000, 50000);
+
+  auto whole = cutlass::reference::host::BlockErrorMetricsReduce(computed.data(), reference.data(), kCount);
+  auto const &slabs = accumulator.metrics();
+
+  EXPECT_EQ(slabs.element_count, whole.element_count);
+  EXPECT_NEAR(slabs.l1(), whole.l1(), 1e-15 * whole.l1());
+  EXPECT_NEAR(slabs.l2(), whole.l2(), 1e-15 * whole.l2());
+  EXPECT_EQ(slabs.max_rel_error, whole.max_rel_error);
+  EXPECT_EQ(slabs.max_ulp_error, whole.max_ulp_error);
+  EXPECT_NEAR(whole.max_rel_error, 4e-9, 1e-15);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,229 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the blocked, multithreaded host reference GEMM
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/gemm.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Unblocked loop defining the accumulation order the host reference must reproduce
+template <
+  typename ElementA, typename LayoutA,
+  typename ElementB, typename LayoutB,
+  typename ElementC, typename LayoutC,
+  typename ScalarType, typename ComputeType,
+  typename InnerProductOp = cutlass::multiply_add<ComputeType>,
+  typename ConvertOp = cutlass::NumericConverter<ElementC, ScalarType>
+>
+void naive_gemm(
+  cutlass::gemm::GemmCoord problem_size,
+  ScalarType alpha,
+  cutlass::TensorRef<ElementA, LayoutA> tensor_a,
+  cutlass::TensorRef<ElementB, LayoutB> tensor_b,
+  ScalarType beta,
+  cutlass::TensorRef<ElementC, LayoutC> tensor_c,
+  cutlass::TensorRef<ElementC, LayoutC> tensor_d) {
+
+  InnerProductOp inner_product_op;
+  ConvertOp convert_op;
+
+  for (int m = 0; m < problem_size.m(); ++m) {
+    for (int n = 0; n < problem_size.n(); ++n) {
+      ComputeType accum = ComputeType(0);
+      for (int k = 0; k < problem_size.k(); ++k) {
+        ComputeType a = ComputeType(cutlass::reference::host::cast_if_scalar<ComputeType>(tensor_a.at({m, k})));
+        ComputeType b = ComputeType(cutlass::reference::host::cast_if_scalar<ComputeType>(tensor_b.at({k, n})));
+        accum = inner_product_op(a, b, accum);
+      }
+      tensor_d.at({m, n}) = convert_op(alpha * ScalarType(accum) + beta * ScalarType(tensor_c.at({m, n})));
+    }
+  }
+}
+
+template <
+  typename ElementA, typename LayoutA,
+  typename ElementB, typename LayoutB,
+  typename ElementC, typename LayoutC,
+  typename ComputeType
+>
+bool run_host_gemm(
+  cutlass::gemm::GemmCoord problem_size,
+  cutlass::reference::host::HostGemmConfig const &config,
+  int bits = -1) {
+
+  cutlass::HostTensor<ElementA, LayoutA> tensor_a(problem_size.mk(), false);
+  cutlass::HostTensor<ElementB, LayoutB> tensor_b(problem_size.kn(), false);
+  cutlass::HostTensor<ElementC, LayoutC> tensor_c(problem_size.mn(), false);
+  cutlass::HostTensor<ElementC, LayoutC> tensor_d(problem_size.mn(), false);
+  cutlass::HostTensor<ElementC, LayoutC> tensor_ref(problem_size.mn(), false);
+
+  cutlass::reference::host::TensorFillRandomUniform(tensor_a.host_view(), 2023, 4, -4, bits);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_b.host_view(), 2024, 4, -4, bits);
+  cutlass::reference::host::TensorFillRandomUniform(tensor_c.host_view(), 2025, 4, -4, bits);
+
+  ComputeType alpha = ComputeType(1.25f);
+  ComputeType beta = ComputeType(-0.5f);
+
+  cutlass::reference::host::compute_gemm<
+    ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ComputeType, ComputeType>(
+      problem_size, alpha, tensor_a.host_ref(), tensor_b.host_ref(), beta,
+      tensor_c.host_ref(), tensor_d.host_ref(), ComputeType(0), config);
+
+  naive_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC, ComputeType, ComputeType>(
+    problem_size, alpha, tensor_a.host_ref(), tensor_b.host_ref(), beta,
+    tensor_c.host_ref(), tensor_ref.host_ref());
+
+  return cutlass::reference::host::TensorEquals(tensor_d.host_view(), tensor_ref.host_view());
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostGemm, f32_rowmajor_bitwise) {
+
+  cutlass::reference::host::HostGemmConfig config;
+
+  bool passed = test::util::run_host_gemm<
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float>({131, 67, 259}, config);
+
+  EXPECT_TRUE(passed);
+}
+
+TEST(HostGemm, f16_columnmajor_small_blocks_bitwise) {
+
+  cutlass::reference::host::HostGemmConfig config;
+  config.block_m = 5;
+  config.block_n = 7;
+  config.block_k = 3;
+
+  bool passed = test::util::run_host_gemm<
+    cutlass::half_t, cutlass::layout::ColumnMajor,
+    cutlass::half_t, cutlass::layout::RowMajor,
+    cutlass::half_t, cutlass::layout::ColumnMajor,
+    float>({37, 45, 61}, config);
+
+  EXPECT_TRUE(passed);
+}
+
+TEST(HostGemm, bf16_rowmajor_bitwise) {
+
+  cutlass::reference::host::HostGemmConfig config;
+  config.block_n = 40;
+
+  bool passed = test::util::run_host_gemm<
+    cutlass::bfloat16_t, cutlass::layout::RowMajor,
+    cutlass::bfloat16_t, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::RowMajor,
+    float>({70, 83, 129}, config);
+
+  EXPECT_TRUE(passed);
+}
+
+TEST(HostGemm, e4m3_bitwise) {
+
+  cutlass::reference::host::HostGemmConfig config;
+
+  bool passed = test::util::run_host_gemm<
+    cutlass::float_e4m3_t, cutlass::layout::RowMajor,
+    cutlass::float_e5m2_t, cutlass::layout::RowMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({33, 97, 64}, config);
+
+  EXPECT_TRUE(passed);
+}
+
+TEST(HostGemm, f32_single_thread_bitwise) {
+
+  cutlass::reference::host::HostGemmConfig config;
+  config.threads = 1;
+
+  bool passed = test::util::run_host_gemm<
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::ColumnMajor,
+    float, cutlass::layout::ColumnMajor,
+    float>({64, 256, 17}, config);
+
+  EXPECT_TRUE(passed);
+}
+
+TEST(HostGemm, s4_output_odd_blocks_bitwise) {
+
+  cutlass::reference::host::HostGemmConfig config;
+  config.block_m = 3;
+  config.block_n = 5;
+  config.threads = 4;
+
+  // Odd tile widths place elements of adjacent tiles in the same byte of D
+  bool passed = test::util::run_host_gemm<
+    int8_t, cutlass::layout::RowMajor,
+    int8_t, cutlass::layout::ColumnMajor,
+    cutlass::int4b_t, cutlass::layout::RowMajor,
+    int>({29, 31, 19}, config, 0);
+
+  EXPECT_TRUE(passed);
+}
+
+TEST(HostGemm, f32_split_k) {
+
+  cutlass::reference::host::HostGemmConfig config;
+  config.block_k = 16;
+  config.threads = 4;
+  config.accumulation = cutlass::reference::host::HostGemmAccumulation::kSplitK;
+
+  // Integer-valued operands keep split-K partial sums exact
+  bool passed = test::util::run_host_gemm<
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::RowMajor,
+    float, cutlass::layout::RowMajor,
+    float>({8, 8, 1000}, config, 1);
+
+  EXPECT_TRUE(passed);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,231 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the tiled, multithreaded host reference GETT
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/reference/host/gett.hpp"
+
+#include "cute/tensor.hpp"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Runs D = alpha * A * B + beta * C through reference::host::Gett with the given tile shape
+template <int kBlockM, int kBlockN, class ElementA, class ElementAcc, class ElementD, class TensorA, class TensorB>
+std::vector<ElementD> run_host_gett(
+  TensorA const& A,
+  TensorB const& B,
+  cutlass::ComplexTransform transform_A = cutlass::ComplexTransform::kNone,
+  cutlass::ComplexTransform transform_B = cutlass::ComplexTransform::kNone) {
+
+  using namespace cute;
+
+  int M = size<0>(A);
+  int N = size<0>(B);
+  int L = size<2>(A);
+
+  std::vector<ElementD> c(size_t(M) * N * L, ElementD(1));
+  std::vector<ElementD> d(c.size());
+
+  auto layout_c = make_layout(make_shape(M, N, L), make_stride(int64_t(N), _1{}, int64_t(M) * N));
+  auto C = make_tensor(c.data(), layout_c);
+  auto D = make_tensor(d.data(), layout_c);
+
+  cutlass::reference::host::GettMainloopParams<ElementAcc, TensorA, TensorB> mainloop_params{
+    A, B, transform_A, transform_B};
+
+  cutlass::reference::host::GettEpilogueParams<
+    ElementD, ElementD, ElementAcc, ElementD, decltype(C), decltype(D)> epilogue_params;
+
+  epilogue_params.C = C;
+  epilogue_params.D = D;
+  epilogue_params.alpha = ElementD(2);
+  epilogue_params.beta = ElementD(-1);
+
+  cutlass::reference::host::Gett<kBlockM, kBlockN>(mainloop_params, epilogue_params);
+  return d;
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostGett, f16_f32_tile_shape_bitwise) {
+  using namespace cute;
+
+  int M = 83, N = 70, K = 301, L = 2;
+
+  std::vector<cutlass::half_t> a(size_t(M) * K * L), b(size_t(N) * K * L);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = cutlass::half_t(float(int(i * 7 % 9) - 4) / 3.0f);
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = cutlass::half_t(float(int(i * 5 % 11) - 5) / 7.0f);
+  }
+
+  // K-major A, M-major B
+  auto A = make_tensor(a.data(), make_layout(make_shape(M, K, L), make_stride(int64_t(K), _1{}, int64_t(M) * K)));
+  auto B = make_tensor(b.data(), make_layout(make_shape(N, K, L), make_stride(_1{}, int64_t(N), int64_t(N) * K)));
+
+  auto expected = test::util::run_host_gett<64, 64, cutlass::half_t, float, float>(A, B);
+  auto result = test::util::run_host_gett<16, 48, cutlass::half_t, float, float>(A, B);
+
+  // Each accumulator is updated in k order regardless of the tile shape
+  for (int l = 0; l < L; ++l) {
+    for (int m = 0; m < M; ++m) {
+      for (int n = 0; n < N; ++n) {
+        float accum = 0;
+        for (int k = 0; k < K; ++k) {
+          accum = float(A(m, k, l)) * float(B(n, k, l)) + accum;
+        }
+        size_t idx = (size_t(l) * M + m) * N + n;
+        EXPECT_EQ(2.0f * accum + -1.0f * 1.0f, expected[idx]);
+      }
+    }
+  }
+
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_EQ(expected[i], result[i]);
+  }
+}
+
+TEST(HostGett, dReLU_dBias_backprop_fusion) {
+  using namespace cute;
+
+  // Many tiles of different N and L share each M block
+  int M = 37, N = 70, K = 33, L = 24;
+  constexpr int kBlockM = 16;
+  constexpr int kBlockN = 32;
+
+  std::vector<float> a(size_t(M) * K * L), b(size_t(N) * K * L), aux(size_t(M) * N * L);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = float(int(i * 7 % 9) - 4) / 3.0f;
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = float(int(i * 5 % 11) - 5) / 7.0f;
+  }
+  for (size_t i = 0; i < aux.size(); ++i) {
+    aux[i] = float(i * 3 % 5 < 3);
+  }
+
+  auto A = make_tensor(a.data(), make_layout(make_shape(M, K, L), make_stride(int64_t(K), _1{}, int64_t(M) * K)));
+  auto B = make_tensor(b.data(), make_layout(make_shape(N, K, L), make_stride(int64_t(K), _1{}, int64_t(N) * K)));
+
+  auto layout_d = make_layout(make_shape(M, N, L), make_stride(int64_t(N), _1{}, int64_t(M) * N));
+  std::vector<float> d(size_t(M) * N * L);
+  std::vector<float> bias(M);
+  for (int m = 0; m < M; ++m) {
+    bias[m] = float(m) / 9.0f;
+  }
+  std::vector<float> bias_initial = bias;
+
+  auto D = make_tensor(d.data(), layout_d);
+  auto Aux = make_tensor(aux.data(), layout_d);
+  auto Bias = make_tensor(bias.data(), make_layout(make_shape(M)));
+
+  cutlass::reference::host::GettMainloopParams<float, decltype(A), decltype(B)> mainloop_params{A, B};
+
+  cutlass::reference::host::GettEpilogueParams<
+    float, float, float, float, decltype(D), decltype(D), decltype(Bias), decltype(Aux), decltype(Bias), decltype(Bias),
+    cutlass::epilogue::thread::dReLU<float>> epilogue_params;
+
+  epilogue_params.D = D;
+  epilogue_params.Aux = Aux;
+  epilogue_params.Bias = Bias;
+
+  cutlass::reference::host::Gett<kBlockM, kBlockN>(mainloop_params, epilogue_params);
+
+  // dBias accumulates the row sums of each tile in the order of a serial (l, m, n) tile loop
+  for (int m = 0; m < M; ++m) {
+    float dBias = bias_initial[m];
+    for (int l = 0; l < L; ++l) {
+      for (int n0 = 0; n0 < N; n0 += kBlockN) {
+        float row_sum = 0;
+        for (int n = n0; n < std::min(N, n0 + kBlockN); ++n) {
+          float accum = 0;
+          for (int k = 0; k < K; ++k) {
+            accum = A(m, k, l) * B(n, k, l) + accum;
+          }
+          float output = Aux(m, n, l) != 0 ? accum : 0.0f;
+          EXPECT_EQ(output, D(m, n, l));
+          row_sum += output;
+        }
+        dBias = row_sum + dBias;
+      }
+    }
+    EXPECT_EQ(dBias, bias[m]) << "m = " << m;
+  }
+}
+
+TEST(HostGett, complex_conjugate) {
+  using namespace cute;
+  using Complex = cutlass::complex<double>;
+
+  int M = 9, N = 13, K = 17;
+
+  std::vector<Complex> a(size_t(M) * K), b(size_t(N) * K);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = Complex(double(i % 5) - 2, double(i % 3) - 1);
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = Complex(double(i % 7) - 3, double(i % 4) - 2);
+  }
+
+  auto A = make_tensor(a.data(), make_layout(make_shape(M, K, 1), make_stride(K, _1{}, 0)));
+  auto B = make_tensor(b.data(), make_layout(make_shape(N, K, 1), make_stride(K, _1{}, 0)));
+
+  auto result = test::util::run_host_gett<4, 8, Complex, Complex, Complex>(
+    A, B, cutlass::ComplexTransform::kConjugate, cutlass::ComplexTransform::kNone);
+
+  for (int m = 0; m < M; ++m) {
+    for (int n = 0; n < N; ++n) {
+      Complex accum(0);
+      for (int k = 0; k < K; ++k) {
+        accum += cutlass::conj(A(m, k, 0)) * B(n, k, 0);
+      }
+      EXPECT_EQ(Complex(2) * accum - Complex(1), result[size_t(m) * N + n]);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
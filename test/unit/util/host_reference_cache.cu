@@ -0,0 +1,192 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the disk-backed host reference result cache
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/reference_cache.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Creates an empty cache directory unique to the calling test
+std::string make_cache_directory() {
+  auto const *info = ::testing::UnitTest::GetInstance()->current_test_info();
+  std::filesystem::path path = std::filesystem::path(::testing::TempDir()) /
+    (std::string("cutlass_reference_cache_") + info->name());
+  std::filesystem::remove_all(path);
+  std::filesystem::create_directories(path);
+  return path.string();
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostReferenceCache, hasher) {
+
+  std::vector<float> data(1001);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = float(i) * 0.25f;
+  }
+
+  auto hash = [&](auto &&... fields) {
+    cutlass::ReferenceCacheHasher hasher;
+    (hasher.update(fields), ...);
+    return hasher.update_block(data.data(), data.size()).digest();
+  };
+
+  cutlass::ReferenceCacheKey key = hash("gemm", "128x128x64");
+
+  EXPECT_EQ(key, hash("gemm", "128x128x64"));
+  EXPECT_EQ(key.str().size(), size_t(32));
+
+  // Field boundaries are part of the hash
+  EXPECT_NE(key, hash("gemm1", "28x128x64"));
+  EXPECT_NE(key, hash("gemm128x128x64"));
+
+  // A single bit of the data changes the key
+  data[1000] = -data[1000];
+  EXPECT_NE(key, hash("gemm", "128x128x64"));
+}
+
+TEST(HostReferenceCache, store_and_find) {
+
+  cutlass::ReferenceCache cache(make_cache_directory());
+
+  std::vector<cutlass::half_t> D(777);
+  std::vector<float> amax(1, 42.0f);
+  for (size_t i = 0; i < D.size(); ++i) {
+    D[i] = cutlass::half_t(float(i % 31) - 15);
+  }
+
+  cutlass::ReferenceCacheKey key = cutlass::ReferenceCacheHasher().update("store_and_find").digest();
+  cutlass::ReferenceCacheKey other = cutlass::ReferenceCacheHasher().update("other").digest();
+
+  EXPECT_FALSE(cache.find(key).valid());
+
+  EXPECT_TRUE(cache.store(key, {
+    cutlass::ReferenceCacheBuffer::block(D.data(), D.size()),
+    cutlass::ReferenceCacheBuffer::block(amax.data(), amax.size())}));
+
+  auto entry = cache.find(key);
+  ASSERT_TRUE(entry.valid());
+  EXPECT_EQ(entry.buffer_count(), 2);
+  EXPECT_EQ(entry.buffer_bytes(0), D.size() * sizeof(cutlass::half_t));
+  EXPECT_EQ(entry.buffer_bytes(1), sizeof(float));
+
+  std::vector<cutlass::half_t> D_restored(D.size());
+  std::vector<float> amax_restored(1);
+  EXPECT_TRUE(entry.copy_to({
+    cutlass::ReferenceCacheBuffer::block(D_restored.data(), D_restored.size()),
+    cutlass::ReferenceCacheBuffer::block(amax_restored.data(), amax_restored.size())}));
+  EXPECT_EQ(D, D_restored);
+  EXPECT_EQ(amax, amax_restored);
+
+  // Buffers of different sizes are rejected
+  std::vector<cutlass::half_t> D_short(D.size() - 1);
+  EXPECT_FALSE(entry.copy_to({
+    cutlass::ReferenceCacheBuffer::block(D_short.data(), D_short.size()),
+    cutlass::ReferenceCacheBuffer::block(amax_restored.data(), amax_restored.size())}));
+
+  // An entry renamed to another key is rejected
+  std::filesystem::copy_file(cache.path(key), cache.path(other));
+  EXPECT_FALSE(cache.find(other).valid());
+}
+
+TEST(HostReferenceCache, corrupt_entry) {
+
+  cutlass::ReferenceCache cache(make_cache_directory());
+
+  std::vector<double> D(100, 3.0);
+  cutlass::ReferenceCacheKey key = cutlass::ReferenceCacheHasher().update("corrupt_entry").digest();
+  ASSERT_TRUE(cache.store(key, {cutlass::ReferenceCacheBuffer::block(D.data(), D.size())}));
+
+  {
+    std::fstream file(cache.path(key), std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(-8, std::ios::end);
+    double value = 4.0;
+    file.write(reinterpret_cast<char const *>(&value), sizeof(value));
+  }
+
+  EXPECT_FALSE(cache.find(key).valid());
+
+  // A truncated entry is rejected as well
+  std::filesystem::resize_file(cache.path(key), 100);
+  EXPECT_FALSE(cache.find(key).valid());
+}
+
+TEST(HostReferenceCache, load_or_compute) {
+
+  std::string directory = make_cache_directory();
+  cutlass::ReferenceCacheKey key = cutlass::ReferenceCacheHasher().update("load_or_compute").digest();
+
+  int computations = 0;
+  auto compute = [&](std::vector<int> &D) {
+    return [&] {
+      ++computations;
+      for (size_t i = 0; i < D.size(); ++i) {
+        D[i] = int(i * i);
+      }
+    };
+  };
+
+  std::vector<int> D0(513, 0), D1(513, 0), D2(513, 0);
+
+  // A disabled cache always computes
+  cutlass::ReferenceCache disabled;
+  EXPECT_FALSE(disabled.enabled());
+  EXPECT_FALSE(disabled.load_or_compute(key, {cutlass::ReferenceCacheBuffer::block(D0.data(), D0.size())}, compute(D0)));
+  EXPECT_EQ(computations, 1);
+
+  // Separate cache objects on the same directory share results
+  EXPECT_FALSE(cutlass::ReferenceCache(directory).load_or_compute(
+    key, {cutlass::ReferenceCacheBuffer::block(D1.data(), D1.size())}, compute(D1)));
+  EXPECT_EQ(computations, 2);
+
+  EXPECT_TRUE(cutlass::ReferenceCache(directory).load_or_compute(
+    key, {cutlass::ReferenceCacheBuffer::block(D2.data(), D2.size())}, compute(D2)));
+  EXPECT_EQ(computations, 2);
+
+  EXPECT_EQ(D0, D1);
+  EXPECT_EQ(D1, D2);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,116 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the parallel host tensor comparisons
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <limits>
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostTensorCompare, equals_dense_and_padded) {
+
+  cutlass::MatrixCoord extent(301, 517);
+
+  // Dense views take the bitwise path; a padded leading dimension forces the elementwise scan
+  for (int ldm : {301, 320}) {
+    cutlass::HostTensor<float, cutlass::layout::ColumnMajor> a(extent, cutlass::layout::ColumnMajor(ldm), false);
+    cutlass::HostTensor<float, cutlass::layout::ColumnMajor> b(extent, cutlass::layout::ColumnMajor(ldm), false);
+
+    cutlass::reference::host::TensorFillRandomUniform(a.host_view(), 17, 8, -8, 2);
+    cutlass::reference::host::TensorFillRandomUniform(b.host_view(), 17, 8, -8, 2);
+
+    EXPECT_TRUE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+    EXPECT_TRUE(cutlass::reference::host::TensorRelativelyEquals(a.host_view(), b.host_view(), 1e-5f, 1e-5f));
+
+    // Signed zeros differ bitwise but compare equal
+    a.at({3, 4}) = 0.0f;
+    b.at({3, 4}) = -0.0f;
+    EXPECT_TRUE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+
+    // Identical NaNs compare unequal
+    a.at({300, 516}) = std::numeric_limits<float>::quiet_NaN();
+    b.at({300, 516}) = a.at({300, 516});
+    EXPECT_FALSE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+    EXPECT_TRUE(cutlass::reference::host::TensorNotEquals(a.host_view(), b.host_view()));
+  }
+}
+
+TEST(HostTensorCompare, report) {
+
+  cutlass::MatrixCoord extent(1000, 333);
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> a(extent, false);
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> b(extent, false);
+
+  cutlass::reference::host::TensorFill(a.host_view(), cutlass::half_t(2));
+  cutlass::reference::host::TensorFill(b.host_view(), cutlass::half_t(2));
+
+  auto report = cutlass::reference::host::TensorEqualsReport(a.host_view(), b.host_view());
+  EXPECT_TRUE(report.passed());
+  EXPECT_EQ(report.element_count, 1000 * 333);
+
+  // Perturb elements from the back so that the reported mismatches must be ordered
+  for (int r = 999; r >= 0; r -= 7) {
+    b.at({r, r % 333}) = cutlass::half_t(2.5f);
+  }
+  b.at({500, 1}) = cutlass::half_t(-2);
+
+  report = cutlass::reference::host::TensorEqualsReport(a.host_view(), b.host_view(), 4);
+  EXPECT_FALSE(report.passed());
+  EXPECT_EQ(report.mismatch_count, 144);
+  ASSERT_EQ(report.mismatches.size(), size_t(4));
+  EXPECT_EQ(report.mismatches[0], cutlass::make_Coord(5, 5));
+  EXPECT_EQ(report.mismatches[1], cutlass::make_Coord(12, 12));
+  EXPECT_EQ(report.mismatches[3], cutlass::make_Coord(26, 26));
+  EXPECT_EQ(report.max_abs_error, 4.0);
+  EXPECT_EQ(report.max_rel_error, 1.0);
+
+  auto relative = cutlass::reference::host::TensorRelativelyEqualsReport(
+    a.host_view(), b.host_view(), cutlass::half_t(0.2f), cutlass::half_t(1e-3f));
+  EXPECT_EQ(relative.mismatch_count, 1);
+  ASSERT_EQ(relative.mismatches.size(), size_t(1));
+  EXPECT_EQ(relative.mismatches[0], cutlass::make_Coord(500, 1));
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::RowMajor> c({1000, 334}, false);
+  EXPECT_TRUE(cutlass::reference::host::TensorEqualsReport(a.host_view(), c.host_view()).extent_mismatch);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,177 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the counter-based random fills of the host reference
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/philox.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostTensorFill, philox_known_answers) {
+
+  // Known-answer vectors of the Random123 reference implementation
+  cutlass::Array<uint32_t, 4> counter;
+  cutlass::Array<uint32_t, 2> key;
+
+  counter.fill(0);
+  key.fill(0);
+  auto result = cutlass::Philox4x32::block(counter, key);
+  EXPECT_EQ(result[0], 0x6627e8d5u);
+  EXPECT_EQ(result[1], 0xe169c58du);
+  EXPECT_EQ(result[2], 0xbc57ac4cu);
+  EXPECT_EQ(result[3], 0x9b00dbd8u);
+
+  counter.fill(0xffffffffu);
+  key.fill(0xffffffffu);
+  result = cutlass::Philox4x32::block(counter, key);
+  EXPECT_EQ(result[0], 0x408f276du);
+  EXPECT_EQ(result[1], 0x41c83b0eu);
+  EXPECT_EQ(result[2], 0xa20bc7c6u);
+  EXPECT_EQ(result[3], 0x6d5451fdu);
+
+  counter[0] = 0x243f6a88u; counter[1] = 0x85a308d3u; counter[2] = 0x13198a2eu; counter[3] = 0x03707344u;
+  key[0] = 0xa4093822u; key[1] = 0x299f31d0u;
+  result = cutlass::Philox4x32::block(counter, key);
+  EXPECT_EQ(result[0], 0xd16cfe09u);
+  EXPECT_EQ(result[1], 0x94fdccebu);
+  EXPECT_EQ(result[2], 0x5001e420u);
+  EXPECT_EQ(result[3], 0x24126ea1u);
+}
+
+TEST(HostTensorFill, uniform_independent_of_layout) {
+
+  cutlass::MatrixCoord extent(123, 77);
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> row_major(extent, false);
+  cutlass::HostTensor<float, cutlass::layout::ColumnMajor> column_major(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(row_major.host_view(), 2024, 4, -4, 3);
+  cutlass::reference::host::TensorFillRandomUniform(column_major.host_view(), 2024, 4, -4, 3);
+
+  // Element (r, c) is keyed by its linear index r * columns + c in either layout
+  cutlass::reference::host::detail::RandomUniformFunc<float> func(2024, 4, -4, 3);
+
+  int mismatches = 0;
+  for (int r = 0; r < extent.row(); ++r) {
+    for (int c = 0; c < extent.column(); ++c) {
+      float expected = func(uint64_t(r) * extent.column() + c);
+      mismatches += (row_major.at({r, c}) != expected) + (column_major.at({r, c}) != expected);
+      EXPECT_LE(-4.0f, expected);
+      EXPECT_GE(4.0f, expected);
+    }
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(HostTensorFill, block_gaussian_matches_sequence) {
+
+  size_t const capacity = 100000;
+
+  std::vector<cutlass::half_t> block(capacity);
+  cutlass::reference::host::BlockFillRandomGaussian(block.data(), capacity, 7, 0, 1, -1, 50.0);
+
+  // A sequentially invoked functor visits the same indices in order
+  cutlass::reference::host::detail::RandomGaussianFunc<cutlass::half_t> func(7, 0, 1, -1, 50.0);
+
+  size_t zeros = 0;
+  bool equal = true;
+  for (size_t i = 0; i < capacity; ++i) {
+    equal = equal && (block[i] == func());
+    zeros += (block[i] == cutlass::half_t(0));
+  }
+  EXPECT_TRUE(equal);
+
+  // Roughly half of the elements are zero
+  EXPECT_GT(zeros, capacity * 45 / 100);
+  EXPECT_LT(zeros, capacity * 55 / 100);
+}
+
+TEST(HostTensorFill, subbyte_deterministic) {
+
+  cutlass::MatrixCoord extent(64, 96);
+
+  cutlass::HostTensor<cutlass::int4b_t, cutlass::layout::ColumnMajor> a(extent, false);
+  cutlass::HostTensor<cutlass::int4b_t, cutlass::layout::ColumnMajor> b(extent, false);
+
+  cutlass::reference::host::TensorFillRandomUniform(a.host_view(), 11, 7, -8, 0);
+  cutlass::reference::host::TensorFillRandomUniform(b.host_view(), 11, 7, -8, 0);
+
+  EXPECT_TRUE(cutlass::reference::host::TensorEquals(a.host_view(), b.host_view()));
+}
+
+TEST(HostTensorFill, ell_idx_deterministic) {
+
+  int const rows = 37;
+  int const ell_cols = 9;
+  int const cols = 23;
+
+  cutlass::HostTensor<int32_t, cutlass::layout::RowMajor> a({rows, ell_cols}, false);
+  cutlass::HostTensor<int32_t, cutlass::layout::RowMajor> b({rows, ell_cols}, false);
+
+  cutlass::reference::host::TensorFillRandomEllIdx(a.host_view(), 5, rows, ell_cols, cols);
+  cutlass::reference::host::TensorFill(b.host_view(), -2);
+  cutlass::reference::host::TensorFillRandomEllIdx(b.host_view(), 5, 10, ell_cols, cols);
+
+  // Rows are keyed independently, so filling a prefix of the rows reproduces them
+  int mismatches = 0;
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < ell_cols; ++j) {
+      mismatches += (i < 10 ? b.at({i, j}) != a.at({i, j}) : b.at({i, j}) != -2);
+    }
+  }
+  EXPECT_EQ(mismatches, 0);
+
+  // Each row holds strictly increasing column indices padded with -1
+  for (int i = 0; i < rows; ++i) {
+    int previous = -1;
+    for (int j = 0; j < ell_cols; ++j) {
+      int col = a.at({i, j});
+      if (col == -1) {
+        previous = cols;
+        continue;
+      }
+      EXPECT_LT(previous, col);
+      EXPECT_LT(col, cols);
+      previous = col;
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
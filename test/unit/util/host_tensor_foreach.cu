@@ -0,0 +1,150 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for the execution policies of the host TensorForEach and BlockForEach
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <atomic>
+#include <vector>
+
+#include "cutlass/coord.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Counts visits of each point of a rank-3 index space
+struct VisitCounter {
+
+  cutlass::Coord<3> extent;
+  std::vector<std::atomic<int>> *visits;
+
+  void operator()(cutlass::Coord<3> const &coord) const {
+    int64_t index = (int64_t(coord[0]) * extent[1] + coord[1]) * extent[2] + coord[2];
+    (*visits)[index].fetch_add(1);
+  }
+};
+
+/// Visits every point of a rank-3 index space under a policy and checks each was visited once
+template <typename Policy>
+void check_visits_once(Policy const &policy) {
+
+  cutlass::Coord<3> extent = cutlass::make_Coord(5, 37, 211);
+  std::vector<std::atomic<int>> visits(size_t(extent.product()));
+
+  VisitCounter counter{extent, &visits};
+  cutlass::reference::host::TensorForEach(policy, extent, counter);
+
+  int wrong = 0;
+  for (auto const &count : visits) {
+    wrong += (count.load() != 1);
+  }
+  EXPECT_EQ(wrong, 0);
+}
+
+/// Generator returning a value keyed by an explicit index
+struct IndexedGenerator {
+  struct Params { int scale = 3; };
+  Params params;
+  explicit IndexedGenerator(Params const &params_): params(params_) { }
+  int operator()() const { return -1; }
+  int operator()(uint64_t index) const { return int(index) * params.scale; }
+};
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostTensorForEach, sequential) {
+  test::util::check_visits_once(cutlass::reference::host::execution::Sequential());
+}
+
+TEST(HostTensorForEach, thread_pool) {
+  test::util::check_visits_once(cutlass::reference::host::execution::ThreadPool());
+  test::util::check_visits_once(cutlass::reference::host::execution::ThreadPool(97, 2));
+}
+
+TEST(HostTensorForEach, chunked_static) {
+  test::util::check_visits_once(cutlass::reference::host::execution::ChunkedStatic());
+  test::util::check_visits_once(cutlass::reference::host::execution::ChunkedStatic(13));
+}
+
+TEST(HostTensorForEach, chunk_reduction) {
+
+  using namespace cutlass::reference::host;
+
+  cutlass::Coord<2> extent = cutlass::make_Coord(300, 301);
+  int const kChunks = 7;
+
+  // Per-chunk partial sums combined in chunk order
+  std::vector<double> partials(kChunks, 0);
+  TensorForEachChunk(execution::ChunkedStatic(kChunks), extent,
+    [&](TensorForEachChunkRange<2> const &chunk) {
+      double sum = 0;
+      chunk.for_each([&](cutlass::Coord<2> const &coord) {
+        sum += 1.0 / (1 + coord[0] * 301 + coord[1]);
+      });
+      partials[chunk.index] = sum;
+    });
+
+  double total = 0;
+  for (double partial : partials) {
+    total += partial;
+  }
+
+  double expected = 0;
+  for (int i = 0; i < 300 * 301; ++i) {
+    expected += 1.0 / (1 + i);
+  }
+  EXPECT_NEAR(expected, total, 1e-9);
+}
+
+TEST(HostBlockForEach, indexed_generator) {
+
+  using namespace cutlass::reference::host;
+
+  std::vector<int> block(10007, 0);
+  BlockForEach<int, test::util::IndexedGenerator>(
+    execution::ThreadPool(64), block.data(), block.size());
+
+  int wrong = 0;
+  for (size_t i = 0; i < block.size(); ++i) {
+    wrong += (block[i] != int(i) * 3);
+  }
+  EXPECT_EQ(wrong, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,271 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests for HostTensor storage policies
+*/
+
+#include "../common/cutlass_unit_test.h"
+
+#include <vector>
+
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/host_tensor.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+template <typename StoragePolicy>
+void TestLazyHostStorage() {
+
+  using Tensor = cutlass::HostTensor<float, cutlass::layout::RowMajor, StoragePolicy>;
+
+  Tensor tensor({300, 257}, false);
+  EXPECT_FALSE(tensor.host_allocated());
+  EXPECT_EQ(tensor.size(), size_t(300 * 257));
+
+  // The mirror is allocated and zero-filled on first access
+  EXPECT_EQ(tensor.at({299, 256}), 0.0f);
+  EXPECT_TRUE(tensor.host_allocated());
+
+  for (int i = 0; i < 300; ++i) {
+    tensor.at({i, i % 257}) = float(i);
+  }
+
+  Tensor copy(tensor);
+  for (int i = 0; i < 300; ++i) {
+    EXPECT_EQ(copy.at({i, i % 257}), float(i));
+  }
+
+  // Copies of an untouched lazy tensor stay unallocated
+  Tensor untouched({16, 16}, false);
+  Tensor untouched_copy(untouched);
+  EXPECT_FALSE(untouched_copy.host_allocated());
+}
+
+} // namespace
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(HostTensorStorage, dirty_range_set) {
+
+  cutlass::detail::DirtyRangeSet ranges;
+
+  ranges.add(0, 10);
+  ranges.add(20, 30);
+  ranges.add(40, 50);
+  EXPECT_EQ(ranges.ranges().size(), size_t(3));
+  EXPECT_EQ(ranges.bytes(), size_t(30));
+
+  // Touching and overlapping ranges merge
+  ranges.add(10, 20);
+  ranges.add(45, 60);
+  ASSERT_EQ(ranges.ranges().size(), size_t(2));
+  EXPECT_EQ(ranges.ranges()[0], std::make_pair(size_t(0), size_t(30)));
+  EXPECT_EQ(ranges.ranges()[1], std::make_pair(size_t(40), size_t(60)));
+
+  ranges.add(5, 5);
+  EXPECT_EQ(ranges.bytes(), size_t(50));
+
+  // Beyond kMaxRanges, ranges collapse to their hull
+  ranges.clear();
+  for (int i = 0; i <= cutlass::detail::DirtyRangeSet::kMaxRanges; ++i) {
+    ranges.add(size_t(i) * 10, size_t(i) * 10 + 1);
+  }
+  ASSERT_EQ(ranges.ranges().size(), size_t(1));
+  EXPECT_EQ(ranges.ranges()[0], std::make_pair(size_t(0), size_t(cutlass::detail::DirtyRangeSet::kMaxRanges * 10 + 1)));
+
+  // Removal splits ranges that contain the removed bytes
+  ranges.clear();
+  ranges.add(0, 30);
+  ranges.add(40, 60);
+  ranges.remove(10, 20);
+  ranges.remove(25, 45);
+  ASSERT_EQ(ranges.ranges().size(), size_t(3));
+  EXPECT_EQ(ranges.ranges()[0], std::make_pair(size_t(0), size_t(10)));
+  EXPECT_EQ(ranges.ranges()[1], std::make_pair(size_t(20), size_t(25)));
+  EXPECT_EQ(ranges.ranges()[2], std::make_pair(size_t(45), size_t(60)));
+}
+
+TEST(HostTensorStorage, default_storage) {
+
+  cutlass::HostTensor<cutlass::half_t, cutlass::layout::ColumnMajor> tensor({33, 17}, false);
+
+  EXPECT_TRUE(tensor.host_allocated());
+  for (int i = 0; i < 33; ++i) {
+    EXPECT_EQ(tensor.at({i, 16}), cutlass::half_t(0));
+  }
+
+  // The default policy does not track modified ranges
+  tensor.at({1, 1}) = cutlass::half_t(2);
+  EXPECT_TRUE(tensor.host_dirty_ranges().empty());
+}
+
+TEST(HostTensorStorage, lazy_anonymous) {
+  TestLazyHostStorage<cutlass::HostTensorStorage<cutlass::HostStorageKind::kAnonymous, true, false>>();
+}
+
+TEST(HostTensorStorage, lazy_huge_pages) {
+  TestLazyHostStorage<cutlass::HostTensorMappedStorage>();
+}
+
+TEST(HostTensorStorage, lazy_file) {
+  TestLazyHostStorage<cutlass::HostTensorFileMappedStorage>();
+}
+
+TEST(HostTensorStorage, lazy_vector) {
+  TestLazyHostStorage<cutlass::HostTensorStorage<cutlass::HostStorageKind::kVector, true, true>>();
+}
+
+TEST(HostTensorStorage, sync_dirty_ranges) {
+
+  using Tensor = cutlass::HostTensor<float, cutlass::layout::RowMajor, cutlass::HostTensorMappedStorage>;
+
+  int const kRows = 64;
+  int const kColumns = 48;
+  size_t const kCount = kRows * kColumns;
+
+  Tensor tensor({kRows, kColumns});
+
+  // A lazy mirror records nothing until touched and is then copied in full on the next sync
+  EXPECT_TRUE(tensor.host_dirty_ranges().empty());
+  tensor.at({0, 0}) = 0.0f;
+  EXPECT_EQ(tensor.host_dirty_ranges().bytes(), kCount * sizeof(float));
+  tensor.sync_device();
+  EXPECT_TRUE(tensor.host_dirty_ranges().empty());
+
+  // Element writes mark single elements
+  tensor.at({3, 5}) = 1.0f;
+  tensor.at({3, 6}) = 2.0f;
+  tensor.at({60, 0}) = 3.0f;
+  ASSERT_EQ(tensor.host_dirty_ranges().ranges().size(), size_t(2));
+  EXPECT_EQ(tensor.host_dirty_ranges().bytes(), 3 * sizeof(float));
+  EXPECT_EQ(std::get<0>(tensor.host_dirty_ranges().ranges()[0]), size_t(3 * kColumns + 5) * sizeof(float));
+
+  tensor.sync_device();
+  EXPECT_TRUE(tensor.host_dirty_ranges().empty());
+
+  std::vector<float> device_copy(kCount, -1.0f);
+  tensor.copy_out_device_to_host(device_copy.data());
+  EXPECT_EQ(device_copy[3 * kColumns + 5], 1.0f);
+  EXPECT_EQ(device_copy[3 * kColumns + 6], 2.0f);
+  EXPECT_EQ(device_copy[60 * kColumns], 3.0f);
+  EXPECT_EQ(device_copy[0], 0.0f);
+
+  // Partial device writes are copied back without touching the rest of the host mirror
+  std::vector<float> source(8, 7.0f);
+  tensor.copy_in_host_to_device(source.data(), 8);
+  EXPECT_EQ(tensor.device_dirty_ranges().bytes(), 8 * sizeof(float));
+
+  tensor.sync_host();
+  EXPECT_TRUE(tensor.device_dirty_ranges().empty());
+  EXPECT_EQ(tensor.at({0, 7}), 7.0f);
+  EXPECT_EQ(tensor.at({0, 8}), 0.0f);
+  EXPECT_EQ(tensor.at({3, 5}), 1.0f);
+
+  // Whole-tensor host access marks everything
+  tensor.host_view();
+  EXPECT_EQ(tensor.host_dirty_ranges().bytes(), kCount * sizeof(float));
+}
+
+TEST(HostTensorStorage, device_only) {
+
+  using Tensor = cutlass::HostTensor<int, cutlass::layout::RowMajor, cutlass::HostTensorMappedStorage>;
+
+  std::vector<int> source(128 * 128);
+  for (size_t i = 0; i < source.size(); ++i) {
+    source[i] = int(i);
+  }
+
+  Tensor tensor({128, 128});
+  tensor.copy_in_host_to_device(source.data());
+  EXPECT_FALSE(tensor.host_allocated());
+
+  // The first sync allocates the mirror and copies the entire tensor
+  tensor.sync_host();
+  EXPECT_TRUE(tensor.host_allocated());
+  EXPECT_EQ(tensor.at({0, 0}), 0);
+  EXPECT_EQ(tensor.at({127, 127}), 128 * 128 - 1);
+}
+
+TEST(HostTensorStorage, device_writes_leave_mirror_untouched) {
+
+  using Tensor = cutlass::HostTensor<int, cutlass::layout::RowMajor, cutlass::HostTensorMappedStorage>;
+
+  std::vector<int> source(64 * 64, 7);
+
+  Tensor tensor({64, 64});
+  tensor.copy_in_host_to_device(source.data());
+  tensor.sync_device();
+
+  // Syncing an untouched mirror neither allocates it nor overwrites device data
+  EXPECT_FALSE(tensor.host_allocated());
+
+  std::vector<int> device_copy(64 * 64, 0);
+  tensor.copy_out_device_to_host(device_copy.data());
+  EXPECT_EQ(device_copy[0], 7);
+  EXPECT_EQ(device_copy[64 * 64 - 1], 7);
+}
+
+TEST(HostTensorStorage, writes_cancel_other_side) {
+
+  using Tensor = cutlass::HostTensor<int, cutlass::layout::RowMajor, cutlass::HostTensorMappedStorage>;
+
+  std::vector<int> source(8, 7);
+
+  // Touching the mirror after a device write marks only the bytes the device did not write
+  Tensor tensor({16, 16});
+  tensor.copy_in_host_to_device(source.data(), 8);
+  tensor.at({4, 4}) = 1;
+  ASSERT_EQ(tensor.host_dirty_ranges().ranges().size(), size_t(1));
+  EXPECT_EQ(tensor.host_dirty_ranges().ranges()[0], std::make_pair(8 * sizeof(int), 16 * 16 * sizeof(int)));
+  tensor.sync_device();
+
+  // Device writes cancel the host modifications they replace
+  tensor.at({0, 2}) = 5;
+  tensor.at({1, 0}) = 5;
+  tensor.copy_in_host_to_device(source.data(), 8);
+  EXPECT_EQ(tensor.host_dirty_ranges().bytes(), sizeof(int));
+  tensor.sync_device();
+
+  std::vector<int> device_copy(16 * 16, 0);
+  tensor.copy_out_device_to_host(device_copy.data());
+  EXPECT_EQ(device_copy[2], 7);
+  EXPECT_EQ(device_copy[16], 5);
+  EXPECT_EQ(device_copy[4 * 16 + 4], 1);
+
+  // Host writes cancel device modifications likewise
+  tensor.copy_in_host_to_host(source.data(), 4);
+  EXPECT_EQ(tensor.device_dirty_ranges().bytes(), 4 * sizeof(int));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,165 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Tests that the device random fills reproduce the host reference fills
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "../common/cutlass_unit_test.h"
+
+#include "cutlass/complex.h"
+#include "cutlass/layout/matrix.h"
+#include "cutlass/numeric_types.h"
+
+#include "cutlass/util/device_memory.h"
+#include "cutlass/util/host_tensor.h"
+#include "cutlass/util/reference/device/tensor_fill.h"
+#include "cutlass/util/reference/host/tensor_compare.h"
+#include "cutlass/util/reference/host/tensor_fill.h"
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace test {
+namespace util {
+
+/// Fills a tensor on the host and on the device with the same uniform distribution
+template <typename Element, typename Layout>
+bool TestTensorFillRandomUniform(cutlass::MatrixCoord extent, uint64_t seed, double max, double min, int bits) {
+
+  cutlass::HostTensor<Element, Layout> host(extent);
+  cutlass::HostTensor<Element, Layout> device(extent);
+
+  cutlass::reference::host::TensorFillRandomUniform(host.host_view(), seed, max, min, bits);
+  cutlass::reference::device::TensorFillRandomUniform(
+    device.device_view(), seed,
+    typename cutlass::RealType<Element>::Type(max),
+    typename cutlass::RealType<Element>::Type(min),
+    bits);
+
+  device.sync_host();
+
+  return cutlass::reference::host::TensorEquals(host.host_view(), device.host_view());
+}
+
+} // namespace util
+} // namespace test
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+TEST(TensorFill, uniform_f32_matches_host) {
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<float, cutlass::layout::RowMajor>(
+    {123, 77}, 2024, 4, -4, -1)));
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<float, cutlass::layout::ColumnMajor>(
+    {123, 77}, 2024, 4, -4, 3)));
+}
+
+TEST(TensorFill, uniform_f16_matches_host) {
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<cutlass::half_t, cutlass::layout::RowMajor>(
+    {64, 130}, 17, 2, -2, 0)));
+}
+
+TEST(TensorFill, uniform_s8_matches_host) {
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<int8_t, cutlass::layout::ColumnMajor>(
+    {65, 33}, 5, 20, -20, 0)));
+}
+
+TEST(TensorFill, uniform_complex_f32_matches_host) {
+  EXPECT_TRUE((test::util::TestTensorFillRandomUniform<cutlass::complex<float>, cutlass::layout::RowMajor>(
+    {31, 47}, 9, 3, -1, 2)));
+}
+
+TEST(TensorFill, block_uniform_f16_matches_host) {
+
+  size_t const capacity = 100003;
+
+  std::vector<cutlass::half_t> host(capacity);
+  std::vector<cutlass::half_t> device(capacity);
+  cutlass::DeviceAllocation<cutlass::half_t> block(capacity);
+
+  cutlass::reference::host::BlockFillRandomUniform(host.data(), capacity, 7, 1, -1, -1);
+  cutlass::reference::device::BlockFillRandomUniform(
+    block.get(), capacity, 7, cutlass::half_t(1), cutlass::half_t(-1), -1);
+  block.copy_to_host(device.data());
+
+  int mismatches = 0;
+  for (size_t i = 0; i < capacity; ++i) {
+    mismatches += (host[i] != device[i]);
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(TensorFill, gaussian_f32_matches_host) {
+
+  cutlass::MatrixCoord extent(129, 91);
+
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> host(extent);
+  cutlass::HostTensor<float, cutlass::layout::RowMajor> device(extent);
+
+  cutlass::reference::host::TensorFillRandomGaussian(host.host_view(), 11, 1, 2);
+  cutlass::reference::device::TensorFillRandomGaussian(device.device_view(), 11, 1.0f, 2.0f);
+  device.sync_host();
+
+  // The device log, cos and sin may differ from the host library in the last bit of a double,
+  // which rarely survives the conversion to float
+  int mismatches = 0;
+  for (int r = 0; r < extent.row(); ++r) {
+    for (int c = 0; c < extent.column(); ++c) {
+      float h = host.at({r, c});
+      float d = device.at({r, c});
+      mismatches += (std::abs(h - d) > 1e-6f * std::max(1.0f, std::abs(h)));
+    }
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+TEST(TensorFill, block_sparse_meta_matches_host) {
+
+  size_t const capacity = 4099;
+
+  std::vector<uint32_t> host(capacity);
+  std::vector<uint32_t> device(capacity);
+  cutlass::DeviceAllocation<uint32_t> block(capacity);
+
+  cutlass::reference::host::BlockFillRandomSparseMeta(host.data(), capacity, 3, 2);
+  cutlass::reference::device::BlockFillRandomSparseMeta(block.get(), capacity, 3, 2);
+  block.copy_to_host(device.data());
+
+  int mismatches = 0;
+  for (size_t i = 0; i < capacity; ++i) {
+    mismatches += (host[i] != device[i]);
+  }
+  EXPECT_EQ(mismatches, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
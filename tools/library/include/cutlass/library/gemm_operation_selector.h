@@ -0,0 +1,186 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*
+  \file
+  \brief Problem-shape-aware selection of GEMM operations.
+
+  GemmOperationSelector ranks the operations of a GemmOperationVectorMap that are eligible for a
+  device (compute capability) and problem (alignment) by a cost model of tile quantization and
+  wave efficiency, and memoizes its decisions in a fixed-size lock-free table so that repeated
+  queries for similar problems cost a hash and a few atomic loads. Once the slots a decision may
+  occupy are taken, it evicts the decision in the last of them. Records of an optional TuningDatabase take
+  precedence over the cost model; they are matched and memoized by exact extents, while the cost
+  model decides per bucket of extents.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/operation_table.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+class TuningDatabase;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Problem extents considered by GEMM operation selection
+struct GemmSelectionProblem {
+
+  int m;
+  int n;
+  int k;
+  int batch_count;
+
+  GemmSelectionProblem(int m = 0, int n = 0, int k = 0, int batch_count = 1):
+    m(m), n(n), k(k), batch_count(batch_count) { }
+
+  bool operator==(GemmSelectionProblem const &rhs) const {
+    return m == rhs.m && n == rhs.n && k == rhs.k && batch_count == rhs.batch_count;
+  }
+};
+
+/// Rounds each extent up to the boundary of its selection bucket. Extents up to 64 are rounded to
+/// multiples of 8; larger extents to one of eight equal steps within their power-of-two octave.
+/// Cost model decisions are made for the bucketed problem, so every problem in a bucket selects
+/// the same operation unless a tuning database holds a record for it.
+GemmSelectionProblem gemm_selection_bucket(GemmSelectionProblem const &problem);
+
+/// Estimated relative execution time of a GEMM operation on a device with sm_count SMs. Models
+/// tile quantization in M, N and K, the number of waves of CTAs, and the lower throughput of
+/// small tiles and of SIMT instructions. Only the ordering of costs is meaningful.
+double gemm_operation_cost(
+  GemmDescription const &desc,
+  GemmSelectionProblem const &problem,
+  int sm_count);
+
+/// Returns true if the device's compute capability lies within the operation's supported range
+/// and the operation's alignment requirement is satisfied
+bool gemm_operation_eligible(GemmDescription const &desc, GemmPreferenceKey const &preference_key);
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Selects GEMM operations by estimated cost and memoizes the decisions
+class GemmOperationSelector {
+public:
+
+  /// Number of slots in the decision table
+  static int const kCapacity = 4096;
+
+  /// Maximum number of slots probed per lookup
+  static int const kMaxProbes = 16;
+
+private:
+
+  /// Number of 64-bit words identifying a decision
+  static int const kKeyWords = 7;
+
+  /// Identifies a decision: operation map, tuning database and its generation, compute
+  /// capability and alignment, SM count, and problem extents packed into words
+  struct Key {
+    uint64_t words[kKeyWords];
+
+    Key(
+      GemmOperationVectorMap const *operations,
+      TuningDatabase const *tuning_db,
+      uint64_t tuning_generation,
+      int compute_capability,
+      int alignment,
+      int sm_count,
+      GemmSelectionProblem const &problem);
+  };
+
+  /// Decision guarded by a sequence number, which is zero while the slot is empty and odd while
+  /// a writer replaces its contents. A read that overlaps a write is treated as a miss.
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> key[kKeyWords];
+    std::atomic<Operation const *> operation;
+  };
+
+  std::unique_ptr<Slot[]> table_;
+
+  static uint64_t hash(Key const &key);
+
+  /// Searches the table. Returns true and sets operation on a hit.
+  bool lookup(Key const &key, uint64_t hash, Operation const *&operation) const;
+
+  /// Publishes a decision into the first empty slot probed. If none is empty, the decision in the
+  /// last slot probed is replaced. Decisions are dropped while another thread writes that slot.
+  void insert(Key const &key, uint64_t hash, Operation const *operation);
+
+public:
+
+  GemmOperationSelector();
+
+  GemmOperationSelector(GemmOperationSelector const &) = delete;
+  GemmOperationSelector &operator=(GemmOperationSelector const &) = delete;
+
+  /// Returns the process-wide selector
+  static GemmOperationSelector &get();
+
+  /// Returns the selected eligible operation, or nullptr if none is eligible.
+  ///
+  /// If a tuning database is given and holds an applicable record near the exact problem extents,
+  /// its operation is chosen. Otherwise, among the highest compute capability offering eligible
+  /// operations, the operation with the lowest gemm_operation_cost() for the bucketed problem is
+  /// chosen; ties keep the manifest order.
+  Operation const *select(
+    GemmOperationVectorMap const &operations,
+    GemmPreferenceKey const &preference_key,
+    GemmSelectionProblem const &problem,
+    int sm_count,
+    TuningDatabase const *tuning_db = nullptr);
+
+  /// Computes a decision without consulting or updating the table
+  static Operation const *select_uncached(
+    GemmOperationVectorMap const &operations,
+    GemmPreferenceKey const &preference_key,
+    GemmSelectionProblem const &problem,
+    int sm_count,
+    TuningDatabase const *tuning_db = nullptr);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -36,6 +36,7 @@
 
 #include <memory>
 #include "cutlass/library/library.h"
+#include "cutlass/library/operation_table.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -44,6 +45,98 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+class TuningDatabase;
+class Handle;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Selected and initialized kUniversal GEMM for a fixed problem.
+///
+/// Handle::plan_gemm_universal() selects the operation, sizes and binds the workspaces and
+/// initializes the operation once. Executing the plan only binds the operand pointers and launches
+/// the kernel. Plans are neither copyable nor movable, since the host workspace holds the
+/// initialized operator in place.
+class GemmPlan {
+public:
+
+  /// Host workspace capacity
+  static int const kHostWorkspaceSize = (4 << 10);
+
+private:
+
+  friend class Handle;
+
+  /// Selected operation, or null if the plan is empty
+  Operation const *operation_;
+
+  /// Functional key and mode the plan was created for
+  GemmFunctionalKey key_;
+  GemmUniversalMode mode_;
+
+  /// Arguments of the planned problem. Pointers are bound by execute().
+  GemmUniversalArguments arguments_;
+
+  /// Problem alignment, in elements, for which the operation was selected. Calls whose pointers
+  /// and leading dimensions permit a wider alignment are re-planned.
+  int alignment_;
+
+  /// Byte alignment required of the A, B, C and D pointers (zero if unchecked)
+  int pointer_alignment_[4];
+
+  /// Device workspace bound to the plan
+  void *device_workspace_;
+
+  /// True if the plan allocated its device workspace
+  bool owns_device_workspace_;
+
+  /// CUDA stream on which the plan executes
+  cudaStream_t stream_;
+
+  /// Initialized operator
+  alignas(16) char host_workspace_[kHostWorkspaceSize];
+
+  /// Returns true if the plan was created for the given problem
+  bool matches_(
+    GemmFunctionalKey const &key,
+    GemmUniversalMode mode,
+    GemmUniversalArguments const &arguments) const;
+
+public:
+
+  GemmPlan();
+  ~GemmPlan();
+
+  GemmPlan(GemmPlan const &) = delete;
+  GemmPlan &operator=(GemmPlan const &) = delete;
+
+  /// Returns true if the plan holds an initialized operation
+  bool valid() const { return operation_ != nullptr; }
+
+  /// Gets the selected operation
+  Operation const *operation() const { return operation_; }
+
+  /// Gets the CUDA stream on which the plan executes
+  cudaStream_t get_stream() const { return stream_; }
+
+  /// Sets the CUDA stream on which the plan executes
+  void set_stream(cudaStream_t stream) { stream_ = stream; }
+
+  /// Releases the operation and any device workspace owned by the plan
+  void reset();
+
+  /// Executes the planned GEMM: D <= alpha * A*B + beta * C. Returns kErrorMisalignedOperand if
+  /// an operand pointer does not satisfy the alignment of the selected operation.
+  Status execute(
+    void const *alpha,
+    void const *ptr_A,
+    void const *ptr_B,
+    void const *beta,
+    void const *ptr_C,
+    void *ptr_D);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Handle object
 class Handle {
 private:
@@ -72,6 +165,28 @@ private:
   /// Pointer to the most recently executed operation
   Operation const *last_operation_;
 
+  /// Offline tuning results consulted before the cost model (may be null)
+  TuningDatabase const *tuning_db_;
+
+  /// Plan of the most recent gemm_universal() call, reused while the problem is unchanged and the
+  /// operands permit no wider alignment. It is bound to the handle's device workspace and
+  /// invalidated whenever that is reinitialized.
+  std::unique_ptr<GemmPlan> gemm_plan_;
+
+  /// Selects and initializes an operation for a plan. If device_workspace is null, the plan
+  /// allocates its own device workspace; otherwise it binds the given one.
+  Status plan_gemm_universal_(
+    GemmPlan &plan,
+    GemmFunctionalKey const &key,
+    GemmUniversalMode mode,
+    GemmUniversalArguments const &arguments,
+    void *device_workspace,
+    size_t device_workspace_size);
+
+  /// Invalidates the cached plan. Must be called before the handle's device workspace is
+  /// reinitialized by another operation.
+  void invalidate_gemm_plan_();
+
 public:
 
   /// Constructor
@@ -123,6 +238,13 @@ public:
   /// Gets the most recently executed operation
   Operation const *get_last_operation() const;
 
+  /// Gets the tuning database consulted when selecting operations
+  TuningDatabase const *get_tuning_database() const;
+
+  /// Sets the tuning database consulted when selecting operations. Defaults to
+  /// TuningDatabase::global(). The database must outlive the handle; null disables it.
+  void set_tuning_database(TuningDatabase const *tuning_db);
+
   //
   // Computations
   //
@@ -214,6 +336,51 @@ public:
     int64_t batch_stride_D = 0                /// Batch stride of D operand
   );
 
+  /// Creates a plan for repeated GEMM computations D <= alpha * A*B + beta * C of the same
+  /// problem. Operand pointers are bound by GemmPlan::execute(). The plan allocates its own device
+  /// workspace and executes on the handle's current stream by default.
+  ///
+  /// Pointers passed to GemmPlan::execute() must be aligned to 16 bytes for the plan to select
+  /// operations of the widest alignment supported by the problem.
+  Status plan_gemm_universal(
+
+    GemmPlan &plan,                           /// Plan to initialize
+
+    GemmUniversalMode mode,                   /// indicates the mode in which the kUniversal GEMM is launched
+
+    int M,                                    /// GEMM M dimension
+    int N,                                    /// GEMM N dimension
+    int K,                                    /// GEMM K dimension
+    NumericTypeID element_compute,            /// Data type of internal accumulation
+
+    NumericTypeID element_scalar,             /// Data type of alpha/beta scalars
+
+    NumericTypeID element_A,                  /// Data type of A matrix elements
+    LayoutTypeID layout_A,                    /// Layout of A matrix
+    ComplexTransform transform_A,             /// Complex transformation applied to A matrix - ignored for real-valued matrices
+    int64_t lda,                              /// Leading dimension of A matrix
+
+    NumericTypeID element_B,                  /// Data type of B matrix elements
+    LayoutTypeID layout_B,                    /// Layout of B matrix
+    ComplexTransform transform_B,             /// Complex transformation applied to B matrix - ignored for real-valued matrices
+    int64_t ldb,                              /// Leading dimension of B matrix
+
+    NumericTypeID element_C,                  /// Data type of C matrix
+    LayoutTypeID layout_C,                    /// Layout of D matrix
+    int64_t ldc,                              /// Leading dimension of C matrix
+
+    NumericTypeID element_D,                  /// Data type of D matrix
+    LayoutTypeID layout_D,                    /// Layout of D matrix
+    int64_t ldd,                              /// Leading dimension of D matrix
+
+    int batch_count = 1,                      /// Batch count or number of split-K slices
+
+    int64_t batch_stride_A = 0,               /// Batch stride of A operand
+    int64_t batch_stride_B = 0,               /// Batch stride of B operand
+    int64_t batch_stride_C = 0,               /// Batch stride of C operand
+    int64_t batch_stride_D = 0                /// Batch stride of D operand
+  );
+
   /// Planar complex GEMM
   ///
   /// Note, all data types are the real-valued base types used by the planar-complex GEMM kernel.
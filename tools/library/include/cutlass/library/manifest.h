@@ -40,6 +40,8 @@
 #include <list>
 #include <memory>
 #include <map>
+#include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -65,6 +67,101 @@ void initialize_all_reduction_op(Manifest &manifest);
 /// List of operations
 using OperationVector = std::vector<std::unique_ptr<Operation>>;
 
+/// Initializer constructing every operation of one kind and minimum compute capability
+using ManifestSectionInitializer = void (*)(Manifest &);
+
+/// Constructs one generated operation
+using OperationConstructor = Operation *(*)();
+
+/// Fields of one GEMM operation that reports OperationKind::kGemm with a plain GemmDescription. The
+/// generator emits these as constant-initialized tables, so registering and searching a GEMM
+/// operation does not construct it. Other kinds, e.g. sparse GEMMs, register an initializer.
+struct GemmOperationRecord {
+
+  /// Procedural name of the operation
+  char const *name;
+
+  /// Kind of GEMM performed
+  GemmKind gemm_kind;
+
+  /// Shape of a threadblock (in elements)
+  int threadblock_shape[3];
+
+  /// Number of pipeline stages, as reported by the generated operation
+  int threadblock_stages;
+
+  /// Number of warps in each logical dimension
+  int warp_count[3];
+
+  /// Shape of a cluster (in blocks)
+  int cluster_shape[3];
+
+  /// Shape of the target math instruction
+  int instruction_shape[3];
+
+  NumericTypeID element_accumulator;
+  OpcodeClassID opcode_class;
+  MathOperationID math_operation;
+
+  int minimum_compute_capability;
+  int maximum_compute_capability;
+
+  NumericTypeID element_A;
+  LayoutTypeID layout_A;
+  int alignment_A;
+  ComplexTransform transform_A;
+
+  NumericTypeID element_B;
+  LayoutTypeID layout_B;
+  int alignment_B;
+  ComplexTransform transform_B;
+
+  NumericTypeID element_C;
+  LayoutTypeID layout_C;
+  int alignment_C;
+
+  NumericTypeID element_D;
+  LayoutTypeID layout_D;
+  int alignment_D;
+
+  NumericTypeID element_epilogue;
+
+  /// Constructs the operation described by this record
+  OperationConstructor construct;
+};
+
+/// Lightweight descriptor of a group of operations that have not necessarily been constructed yet
+struct ManifestSection {
+
+  /// Kind of operations constructed by the initializer
+  OperationKind kind;
+
+  /// Minimum compute capability required by the operations (e.g. 80 for SM80)
+  int min_cc;
+
+  /// Name of the section (e.g. "sm80_gemm")
+  char const *name;
+
+  /// Function appending the operations of this section to the manifest, or null if the
+  /// section is described by records
+  ManifestSectionInitializer initialize;
+
+  /// True once the initializer has run or the records have been appended
+  bool materialized;
+
+  /// Records of the GEMM operations of this section, appended as operations that are
+  /// constructed on first use
+  GemmOperationRecord const *records;
+
+  /// Number of records
+  size_t record_count;
+};
+
+/// Name of the C symbol resolved by Manifest::load_library(). Every generated library defines it;
+/// the functions it calls have internal linkage or library-specific names, so a library opened by
+/// load_library() registers its own sections rather than interposed ones.
+#define CUTLASS_LIBRARY_REGISTER_SECTIONS_SYMBOL "cutlass_library_register_sections"
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Manifest of CUTLASS Library
@@ -77,12 +174,71 @@ private:
   /// Global list of operations
   OperationVector operations_;
 
+  /// Registered sections of generated operations
+  std::vector<ManifestSection> sections_;
+
+  /// Handles of shared objects opened by load_library(), closed after operations_ is released
+  std::vector<void *> libraries_;
+
+  /// Materializes one section
+  void materialize(ManifestSection &section);
+
 public:
   Manifest (Provider provider = library::Provider::kCUTLASS) : provider_(provider) { }
 
+  ~Manifest();
+
+  Manifest(Manifest const &) = delete;
+  Manifest &operator=(Manifest const &) = delete;
+
   /// Top-level initialization
   Status initialize();
 
+  /// Top-level initialization which registers generated operations without constructing them.
+  /// Reference and reduction operations are constructed eagerly; generated operations are
+  /// constructed by materialize().
+  Status initialize_lazy();
+
+  /// Registers a section of generated operations. Inline so that generated code and shared
+  /// objects loaded by load_library() can call it without linking manifest.cpp.
+  void register_section(
+    OperationKind kind,
+    int min_cc,
+    char const *name,
+    ManifestSectionInitializer initialize) {
+
+    sections_.push_back({kind, min_cc, name, initialize, false, nullptr, 0});
+  }
+
+  /// Registers a section of GEMM operations described by a static table of records. Materializing
+  /// it appends one operation per record which describes itself from the record and constructs
+  /// the generated operation on first use.
+  void register_section(
+    int min_cc,
+    char const *name,
+    GemmOperationRecord const *records,
+    size_t record_count) {
+
+    sections_.push_back({OperationKind::kGemm, min_cc, name, nullptr, false, records, record_count});
+  }
+
+  /// Opens a shared object and registers the sections exported by its
+  /// CUTLASS_LIBRARY_REGISTER_SECTIONS_SYMBOL function. Operations are not constructed.
+  Status load_library(std::string const &path);
+
+  /// Materializes all sections with min_cc <= compute_capability. Returns the number of
+  /// operations appended.
+  size_t materialize(int compute_capability);
+
+  /// Materializes all sections of the given kind with min_cc <= compute_capability.
+  size_t materialize(OperationKind kind, int compute_capability);
+
+  /// Materializes all sections
+  size_t materialize_all();
+
+  /// Registered sections
+  std::vector<ManifestSection> const &sections() const;
+
   /// Used for initialization
   void reserve(size_t operation_count);
 
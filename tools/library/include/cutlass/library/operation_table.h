@@ -39,6 +39,11 @@
 #include <iosfwd>
 #include <unordered_map>
 #include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
@@ -48,6 +53,355 @@
 namespace cutlass {
 namespace library {
 
+/////////////////////////////////////////////////////////////////////////////////////////////////
+//                          Immutable Flat Containers
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Ordered code of a functional key. Enumerants are packed eight bits each, so that keys compare
+/// as two integers. Keys with enumerants beyond eight bits may share a code; lookups compare the
+/// full keys of matching codes.
+struct FunctionalKeyCode {
+
+  uint64_t hi;
+  uint64_t lo;
+
+  FunctionalKeyCode(): hi(0), lo(0) { }
+
+  /// Packs up to sixteen enumerants
+  FunctionalKeyCode(std::initializer_list<int> fields): hi(0), lo(0) {
+    for (int field : fields) {
+      hi = (hi << 8) | (lo >> 56);
+      lo = (lo << 8) | uint64_t(uint8_t(field));
+    }
+  }
+
+  bool operator<(FunctionalKeyCode const &rhs) const {
+    return hi < rhs.hi || (hi == rhs.hi && lo < rhs.lo);
+  }
+
+  bool operator==(FunctionalKeyCode const &rhs) const {
+    return hi == rhs.hi && lo == rhs.lo;
+  }
+};
+
+/// Contiguous, read-only sequence of operations
+class OperationRange {
+public:
+
+  using value_type = Operation const *;
+  using const_iterator = Operation const * const *;
+  using iterator = const_iterator;
+
+private:
+
+  const_iterator begin_;
+  const_iterator end_;
+
+public:
+
+  OperationRange(): begin_(nullptr), end_(nullptr) { }
+
+  OperationRange(const_iterator begin, const_iterator end): begin_(begin), end_(end) { }
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+
+  size_t size() const { return size_t(end_ - begin_); }
+  bool empty() const { return begin_ == end_; }
+
+  Operation const *operator[](size_t idx) const { return begin_[idx]; }
+  Operation const *front() const { return *begin_; }
+  Operation const *back() const { return *(end_ - 1); }
+};
+
+/// Immutable map from a preference key onto operations, stored as an array sorted by
+/// PreferenceKey::operator<. Provides the query interface of std::map.
+template <typename PreferenceKey>
+class OperationPreferenceMap {
+public:
+
+  using key_type = PreferenceKey;
+  using mapped_type = OperationRange;
+  using value_type = std::pair<PreferenceKey, OperationRange>;
+  using const_iterator = value_type const *;
+  using iterator = const_iterator;
+
+private:
+
+  template <typename, typename> friend class OperationFunctionalMap;
+
+  const_iterator begin_;
+  const_iterator end_;
+
+  static bool key_less(value_type const &lhs, PreferenceKey const &rhs) {
+    return std::get<0>(lhs) < rhs;
+  }
+
+  static bool less_key(PreferenceKey const &lhs, value_type const &rhs) {
+    return lhs < std::get<0>(rhs);
+  }
+
+public:
+
+  OperationPreferenceMap(): begin_(nullptr), end_(nullptr) { }
+
+  const_iterator begin() const { return begin_; }
+  const_iterator end() const { return end_; }
+
+  size_t size() const { return size_t(end_ - begin_); }
+  bool empty() const { return begin_ == end_; }
+
+  const_iterator lower_bound(PreferenceKey const &key) const {
+    return std::lower_bound(begin_, end_, key, key_less);
+  }
+
+  const_iterator upper_bound(PreferenceKey const &key) const {
+    return std::upper_bound(begin_, end_, key, less_key);
+  }
+
+  /// Finds the entry equivalent to key under PreferenceKey::operator<
+  const_iterator find(PreferenceKey const &key) const {
+    const_iterator it = lower_bound(key);
+    return (it != end_ && !(key < std::get<0>(*it))) ? it : end_;
+  }
+};
+
+/// Immutable map from a functional key onto an OperationPreferenceMap. Built once from the
+/// manifest into four flat arrays: sorted key codes, the keys with their preference maps, the
+/// preference entries of all keys, and the operations of all preference entries. Provides the
+/// query interface of std::unordered_map.
+///
+/// References into the map remain valid until it is rebuilt. The map is movable but not copyable.
+template <typename FunctionalKey, typename PreferenceKey>
+class OperationFunctionalMap {
+public:
+
+  using key_type = FunctionalKey;
+  using mapped_type = OperationPreferenceMap<PreferenceKey>;
+  using value_type = std::pair<FunctionalKey, mapped_type>;
+  using const_iterator = value_type const *;
+  using iterator = const_iterator;
+
+  /// Operation registered under a functional and preference key
+  struct Entry {
+    FunctionalKey functional_key;
+    PreferenceKey preference_key;
+    Operation const *operation;
+  };
+
+private:
+
+  std::vector<FunctionalKeyCode> codes_;
+  std::vector<value_type> entries_;
+  std::vector<typename mapped_type::value_type> preferences_;
+  std::vector<Operation const *> operations_;
+
+public:
+
+  OperationFunctionalMap() = default;
+  OperationFunctionalMap(OperationFunctionalMap &&) = default;
+  OperationFunctionalMap &operator=(OperationFunctionalMap &&) = default;
+
+  OperationFunctionalMap(OperationFunctionalMap const &) = delete;
+  OperationFunctionalMap &operator=(OperationFunctionalMap const &) = delete;
+
+  const_iterator begin() const { return entries_.data(); }
+  const_iterator end() const { return entries_.data() + entries_.size(); }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  const_iterator find(FunctionalKey const &key) const {
+    FunctionalKeyCode code = functional_key_code(key);
+    auto it = std::lower_bound(codes_.begin(), codes_.end(), code);
+    for (; it != codes_.end() && *it == code; ++it) {
+      const_iterator entry = begin() + (it - codes_.begin());
+      if (std::get<0>(*entry) == key) {
+        return entry;
+      }
+    }
+    return end();
+  }
+
+  size_t count(FunctionalKey const &key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  /// Replaces the contents of the map. Operations with equal functional and equivalent preference
+  /// keys keep their relative order.
+  void build(std::vector<Entry> const &entries) {
+
+    std::vector<FunctionalKeyCode> entry_codes;
+    entry_codes.reserve(entries.size());
+    for (Entry const &entry : entries) {
+      entry_codes.push_back(functional_key_code(entry.functional_key));
+    }
+
+    std::vector<size_t> order(entries.size());
+    for (size_t idx = 0; idx < order.size(); ++idx) {
+      order[idx] = idx;
+    }
+
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+      return entry_codes[a] < entry_codes[b];
+    });
+
+    codes_.clear();
+    entries_.clear();
+    preferences_.clear();
+    operations_.clear();
+    operations_.reserve(entries.size());
+
+    // Half-open ranges into preferences_ and operations_, resolved to pointers once both are final
+    std::vector<std::pair<size_t, size_t>> preference_ranges;
+    std::vector<std::pair<size_t, size_t>> operation_ranges;
+
+    std::vector<size_t> group;
+
+    for (size_t code_begin = 0; code_begin < order.size(); ) {
+
+      size_t code_end = code_begin;
+      while (code_end < order.size() && entry_codes[order[code_end]] == entry_codes[order[code_begin]]) {
+        ++code_end;
+      }
+
+      // Distinct keys sharing a code, in order of first appearance
+      std::vector<bool> visited(code_end - code_begin, false);
+
+      for (size_t first = code_begin; first < code_end; ++first) {
+        if (visited[first - code_begin]) {
+          continue;
+        }
+
+        FunctionalKey const &key = entries[order[first]].functional_key;
+
+        group.clear();
+        for (size_t idx = first; idx < code_end; ++idx) {
+          if (!visited[idx - code_begin] && entries[order[idx]].functional_key == key) {
+            visited[idx - code_begin] = true;
+            group.push_back(order[idx]);
+          }
+        }
+
+        std::stable_sort(group.begin(), group.end(), [&](size_t a, size_t b) {
+          return entries[a].preference_key < entries[b].preference_key;
+        });
+
+        size_t preference_begin = preferences_.size();
+
+        for (size_t idx = 0; idx < group.size(); ) {
+          PreferenceKey const &preference_key = entries[group[idx]].preference_key;
+
+          size_t operation_begin = operations_.size();
+          for (; idx < group.size() &&
+                 !(preference_key < entries[group[idx]].preference_key); ++idx) {
+            operations_.push_back(entries[group[idx]].operation);
+          }
+
+          preferences_.emplace_back(preference_key, OperationRange());
+          operation_ranges.emplace_back(operation_begin, operations_.size());
+        }
+
+        codes_.push_back(entry_codes[order[first]]);
+        entries_.emplace_back(key, mapped_type());
+        preference_ranges.emplace_back(preference_begin, preferences_.size());
+      }
+
+      code_begin = code_end;
+    }
+
+    for (size_t idx = 0; idx < preferences_.size(); ++idx) {
+      std::get<1>(preferences_[idx]) = OperationRange(
+        operations_.data() + operation_ranges[idx].first,
+        operations_.data() + operation_ranges[idx].second);
+    }
+
+    for (size_t idx = 0; idx < entries_.size(); ++idx) {
+      std::get<1>(entries_[idx]).begin_ = preferences_.data() + preference_ranges[idx].first;
+      std::get<1>(entries_[idx]).end_ = preferences_.data() + preference_ranges[idx].second;
+    }
+  }
+};
+
+/// Immutable map from a functional key onto a single operation, stored as an array sorted by key
+/// code. Provides the query interface of std::unordered_map.
+template <typename FunctionalKey>
+class OperationUniqueFunctionalMap {
+public:
+
+  using key_type = FunctionalKey;
+  using mapped_type = Operation const *;
+  using value_type = std::pair<FunctionalKey, Operation const *>;
+  using const_iterator = value_type const *;
+  using iterator = const_iterator;
+
+private:
+
+  std::vector<FunctionalKeyCode> codes_;
+  std::vector<value_type> entries_;
+
+public:
+
+  const_iterator begin() const { return entries_.data(); }
+  const_iterator end() const { return entries_.data() + entries_.size(); }
+
+  size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  const_iterator find(FunctionalKey const &key) const {
+    FunctionalKeyCode code = functional_key_code(key);
+    auto it = std::lower_bound(codes_.begin(), codes_.end(), code);
+    for (; it != codes_.end() && *it == code; ++it) {
+      const_iterator entry = begin() + (it - codes_.begin());
+      if (std::get<0>(*entry) == key) {
+        return entry;
+      }
+    }
+    return end();
+  }
+
+  size_t count(FunctionalKey const &key) const {
+    return find(key) == end() ? 0 : 1;
+  }
+
+  /// Replaces the contents of the map. If a key occurs more than once, the last operation wins.
+  void build(std::vector<value_type> const &entries) {
+
+    std::vector<std::pair<FunctionalKeyCode, size_t>> order;
+    order.reserve(entries.size());
+    for (size_t idx = 0; idx < entries.size(); ++idx) {
+      order.emplace_back(functional_key_code(std::get<0>(entries[idx])), idx);
+    }
+
+    std::stable_sort(order.begin(), order.end(),
+      [](std::pair<FunctionalKeyCode, size_t> const &a, std::pair<FunctionalKeyCode, size_t> const &b) {
+        return std::get<0>(a) < std::get<0>(b);
+      });
+
+    codes_.clear();
+    entries_.clear();
+
+    for (auto const &item : order) {
+      value_type const &entry = entries[std::get<1>(item)];
+
+      // Replace an earlier entry of the same key within the same code
+      bool replaced = false;
+      for (size_t idx = entries_.size(); idx > 0 && codes_[idx - 1] == std::get<0>(item); --idx) {
+        if (std::get<0>(entries_[idx - 1]) == std::get<0>(entry)) {
+          std::get<1>(entries_[idx - 1]) = std::get<1>(entry);
+          replaced = true;
+          break;
+        }
+      }
+
+      if (!replaced) {
+        codes_.push_back(std::get<0>(item));
+        entries_.push_back(entry);
+      }
+    }
+  }
+};
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 //                          Data Structures for Gemm Functional Maps
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -190,6 +544,27 @@ struct GemmFunctionalKeyHasher {
   }
 };
 
+/// Ordered code of a GemmFunctionalKey
+inline
+FunctionalKeyCode functional_key_code(GemmFunctionalKey const &key) {
+  return FunctionalKeyCode{
+    int(key.provider),
+    int(key.gemm_kind),
+    int(key.element_compute),
+    int(key.element_scalar),
+    int(key.element_A),
+    int(key.layout_A),
+    int(key.transform_A),
+    int(key.element_B),
+    int(key.layout_B),
+    int(key.transform_B),
+    int(key.element_C),
+    int(key.layout_C),
+    int(key.element_D),
+    int(key.layout_D)
+  };
+}
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Establishes a partial ordering to search for GEMM operators
@@ -231,17 +606,10 @@ std::ostream& operator<< (std::ostream& out, const cutlass::library::GemmPrefere
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Maps minimum compute capability onto a vector of possible operations
-using GemmOperationVectorMap = std::map<
-  GemmPreferenceKey,
-  std::vector<Operation const *>
->;
+using GemmOperationVectorMap = OperationPreferenceMap<GemmPreferenceKey>;
 
 /// Maps a GemmFunctionalKey onto a vector of Operation * objects expected to be of kind kGemm
-using GemmOperationFunctionalMap = std::unordered_map<
-  GemmFunctionalKey,
-  GemmOperationVectorMap,
-  GemmFunctionalKeyHasher
->;
+using GemmOperationFunctionalMap = OperationFunctionalMap<GemmFunctionalKey, GemmPreferenceKey>;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 //                          Data Structures for Conv Functional Maps
@@ -355,6 +723,23 @@ struct ConvFunctionalKeyHasher {
       rotl(hash(int(key.element_compute)), 10);
   }
 };
+
+/// Ordered code of a ConvFunctionalKey
+inline
+FunctionalKeyCode functional_key_code(ConvFunctionalKey const &key) {
+  return FunctionalKeyCode{
+    int(key.provider),
+    int(key.conv_kind),
+    int(key.element_A),
+    int(key.layout_A),
+    int(key.element_B),
+    int(key.layout_B),
+    int(key.element_C),
+    int(key.layout_C),
+    int(key.element_accumulator),
+    int(key.element_compute)
+  };
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Establishes a partial ordering to search for Conv2d operators
@@ -387,17 +772,10 @@ struct ConvPreferenceKey {
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// Maps minimum compute capability onto a vector of possible operations
-using ConvOperationVectorMap = std::map<
-  ConvPreferenceKey,
-  std::vector<Operation const *>
->;
+using ConvOperationVectorMap = OperationPreferenceMap<ConvPreferenceKey>;
 
 /// Maps a GemmFunctionalKey onto a vector of Operation * objects expected to be of kind kGemm
-using ConvOperationFunctionalMap = std::unordered_map<
-  ConvFunctionalKey,
-  ConvOperationVectorMap,
-  ConvFunctionalKeyHasher
->;
+using ConvOperationFunctionalMap = OperationFunctionalMap<ConvFunctionalKey, ConvPreferenceKey>;
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 
@@ -476,6 +854,20 @@ struct ReductionFunctionalKeyHasher {
       rotl(hash(int(key.epilogue_math_op)), 7);
   }
 };
+
+/// Ordered code of a ReductionFunctionalKey
+inline
+FunctionalKeyCode functional_key_code(ReductionFunctionalKey const &key) {
+  return FunctionalKeyCode{
+    int(key.provider),
+    int(key.element_workspace),
+    int(key.element_accumulator),
+    int(key.element_output),
+    int(key.element_compute),
+    int(key.reduce_math_op),
+    int(key.epilogue_math_op)
+  };
+}
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 inline
@@ -493,11 +885,7 @@ std::ostream& operator<< (std::ostream& out, const ReductionFunctionalKey& key)
 /////////////////////////////////////////////////////////////////////////////////////////////////
 // ReductionOperationFunctionalMap has NO preference key and a single instance per functional key
 // i.e. only one tile size configuration per functional key
-using ReductionOperationFunctionalMap = std::unordered_map<
-  ReductionFunctionalKey,
-  library::Operation const *,
-  ReductionFunctionalKeyHasher
->;
+using ReductionOperationFunctionalMap = OperationUniqueFunctionalMap<ReductionFunctionalKey>;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -521,8 +909,18 @@ public:
   // provider (kCUTLASS)
   ReductionOperationFunctionalMap reduction_operations;
 
+private:
+
+  /// Operations appended so far, from which the maps are rebuilt
+  std::vector<GemmOperationFunctionalMap::Entry> gemm_entries_;
+  std::vector<ConvOperationFunctionalMap::Entry> conv2d_entries_;
+  std::vector<ConvOperationFunctionalMap::Entry> conv3d_entries_;
+  std::vector<ReductionOperationFunctionalMap::value_type> reduction_entries_;
+
 public:
 
+  /// Adds the operations of a manifest and rebuilds the maps. References into the maps obtained
+  /// before are invalidated.
   void append(Manifest const &manifest);
 
 };
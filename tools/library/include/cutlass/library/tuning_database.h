@@ -0,0 +1,214 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*
+  \file
+  \brief Persistent database of tuned operation choices.
+
+  The database maps a problem signature (operation kind, compute capability, element types and
+  layouts of the operands) and problem extents to the name of the fastest operation measured
+  offline, typically by cutlass_profiler --tuning-db=<path>. library::Handle consults it before
+  falling back to the cost model of GemmOperationSelector. Problems without an exact record use
+  the nearest record of the same signature, measured in log2 distance over the extents.
+
+  File format (little endian):
+
+    Header       : magic "CUTLTDB1", uint32 version, uint32 record count,
+                   uint64 string table offset, uint64 string table size
+    Records      : record count x TuningDatabaseFileRecord
+    String table : NUL-terminated strings referenced by byte offset from the records
+
+  Enumerants are stored as strings so that files remain valid when library enumerations change.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "cutlass/library/library.h"
+#include "cutlass/library/operation_table.h"
+#include "cutlass/library/gemm_operation_selector.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Version of the tuning database file format
+static uint32_t const kTuningDatabaseVersion = 1;
+
+/// Identifies the problems a tuning record applies to
+struct TuningSignature {
+
+  OperationKind kind;
+  int compute_capability;
+
+  NumericTypeID element_A;
+  LayoutTypeID layout_A;
+  NumericTypeID element_B;
+  LayoutTypeID layout_B;
+  NumericTypeID element_C;
+  LayoutTypeID layout_C;
+  NumericTypeID element_accumulator;
+
+  TuningSignature(
+    OperationKind kind = OperationKind::kInvalid,
+    int compute_capability = 0,
+    NumericTypeID element_A = NumericTypeID::kInvalid,
+    LayoutTypeID layout_A = LayoutTypeID::kInvalid,
+    NumericTypeID element_B = NumericTypeID::kInvalid,
+    LayoutTypeID layout_B = LayoutTypeID::kInvalid,
+    NumericTypeID element_C = NumericTypeID::kInvalid,
+    LayoutTypeID layout_C = LayoutTypeID::kInvalid,
+    NumericTypeID element_accumulator = NumericTypeID::kInvalid
+  ):
+    kind(kind), compute_capability(compute_capability),
+    element_A(element_A), layout_A(layout_A),
+    element_B(element_B), layout_B(layout_B),
+    element_C(element_C), layout_C(layout_C),
+    element_accumulator(element_accumulator) { }
+
+  /// Signature of problems computed by a GEMM operation on a device of compute capability cc
+  static TuningSignature gemm(GemmDescription const &desc, int compute_capability);
+
+  bool operator==(TuningSignature const &rhs) const;
+  bool operator<(TuningSignature const &rhs) const;
+};
+
+/// Best operation measured for one problem
+struct TuningRecord {
+
+  TuningSignature signature;
+
+  /// Problem extents
+  GemmSelectionProblem problem;
+
+  /// Name of the fastest operation
+  std::string operation_name;
+
+  /// Measured runtime in ms
+  double runtime;
+
+  TuningRecord(): runtime(0) { }
+
+  TuningRecord(
+    TuningSignature const &signature,
+    GemmSelectionProblem const &problem,
+    std::string const &operation_name,
+    double runtime
+  ):
+    signature(signature), problem(problem), operation_name(operation_name), runtime(runtime) { }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// In-memory tuning database. Immutable during lookups, so that concurrent queries need no
+/// synchronization. Every change assigns a new generation, which GemmOperationSelector includes
+/// in its memoized decisions so that none outlives the records it was made from.
+class TuningDatabase {
+public:
+
+  /// Default bound on the log2 distance between a query and the record it may use
+  static constexpr double kDefaultMaxDistance = 3.0;
+
+private:
+
+  /// Records sorted by signature and extents
+  std::vector<TuningRecord> records_;
+
+  /// Records farther than this from a query are not used
+  double max_distance_;
+
+  /// Unique across all databases of the process; replaced on every change
+  uint64_t generation_;
+
+  /// Assigns a new generation
+  void changed();
+
+public:
+
+  explicit TuningDatabase(double max_distance = kDefaultMaxDistance);
+
+  /// Returns the database named by the environment variable CUTLASS_LIBRARY_TUNING_DB, or nullptr
+  /// if the variable is unset or the file could not be loaded
+  static TuningDatabase const *global();
+
+  /// Loads records from a file, merging them into this database
+  Status load(std::string const &path);
+
+  /// Writes all records to a file. The file is replaced atomically.
+  Status save(std::string const &path) const;
+
+  /// Adds a record. If a record exists for the same signature and extents, the faster is kept.
+  /// Returns true if the database changed.
+  bool insert(TuningRecord const &record);
+
+  /// Number of records
+  size_t size() const { return records_.size(); }
+
+  bool empty() const { return records_.empty(); }
+
+  /// Records sorted by signature and extents
+  std::vector<TuningRecord> const &records() const { return records_; }
+
+  double max_distance() const { return max_distance_; }
+
+  void set_max_distance(double max_distance);
+
+  /// Identifies the current contents. Two states of any databases share a generation only if
+  /// they are the same state of the same database.
+  uint64_t generation() const { return generation_; }
+
+  /// Distance between two problems: the sum over extents of |log2(a / b)|
+  static double distance(GemmSelectionProblem const &a, GemmSelectionProblem const &b);
+
+  /// Returns records of the given signature within max_distance() of the problem, nearest first
+  std::vector<TuningRecord const *> nearest(
+    TuningSignature const &signature,
+    GemmSelectionProblem const &problem) const;
+
+  /// Returns the operation of the nearest applicable record, or nullptr. A record applies if its
+  /// operation is found in the map and is eligible for the preference key.
+  Operation const *find_gemm_operation(
+    GemmOperationVectorMap const &operations,
+    GemmPreferenceKey const &preference_key,
+    GemmSelectionProblem const &problem) const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,351 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*
+  \file
+  \brief Problem-shape-aware selection of GEMM operations.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "cutlass/library/gemm_operation_selector.h"
+#include "cutlass/library/tuning_database.h"
+#include "cutlass/library/util.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Arithmetic intensity (per unit of K) at which a tile reaches half of its peak throughput
+double const kHalfEfficiencyIntensity = 32;
+
+/// Throughput penalty of SIMT operations relative to Tensor Core operations
+double const kSimtPenalty = 8;
+
+/// Width of the widest global memory access, in bits
+int const kMaxAccessBits = 128;
+
+/// Rounds an extent up to the boundary of its selection bucket
+int bucket_extent(int extent) {
+  if (extent <= 0) {
+    return extent;
+  }
+  if (extent <= 64) {
+    return (extent + 7) / 8 * 8;
+  }
+
+  // Eight steps per power-of-two octave
+  int octave = 1;
+  while (octave <= extent / 2) {
+    octave *= 2;
+  }
+  int step = octave / 8;
+  return int((int64_t(extent) + step - 1) / step * step);
+}
+
+int ceil_div(int64_t a, int64_t b) {
+  return int((a + b - 1) / b);
+}
+
+/// Returns the maximum required alignment of an operation
+int maximum_alignment_requirement(GemmDescription const &desc) {
+  return std::max(std::max(desc.A.alignment, desc.B.alignment), desc.C.alignment);
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+GemmSelectionProblem gemm_selection_bucket(GemmSelectionProblem const &problem) {
+  return GemmSelectionProblem(
+    bucket_extent(problem.m),
+    bucket_extent(problem.n),
+    bucket_extent(problem.k),
+    bucket_extent(std::max(problem.batch_count, 1)));
+}
+
+double gemm_operation_cost(
+  GemmDescription const &desc,
+  GemmSelectionProblem const &problem,
+  int sm_count) {
+
+  TileDescription const &tile = desc.tile_description;
+
+  int tile_m = std::max(tile.threadblock_shape.m(), 1);
+  int tile_n = std::max(tile.threadblock_shape.n(), 1);
+  int tile_k = std::max(tile.threadblock_shape.k(), 1);
+  int cluster_m = std::max(tile.cluster_shape.m(), 1);
+  int cluster_n = std::max(tile.cluster_shape.n(), 1);
+
+  // CTAs are launched in whole clusters
+  int64_t tiles_m = int64_t(ceil_div(ceil_div(std::max(problem.m, 1), tile_m), cluster_m)) * cluster_m;
+  int64_t tiles_n = int64_t(ceil_div(ceil_div(std::max(problem.n, 1), tile_n), cluster_n)) * cluster_n;
+  int64_t k_padded = int64_t(ceil_div(std::max(problem.k, 1), tile_k)) * tile_k;
+
+  int64_t ctas = tiles_m * tiles_n * std::max(problem.batch_count, 1);
+  int64_t waves = (ctas + std::max(sm_count, 1) - 1) / std::max(sm_count, 1);
+
+  // Larger tiles reuse each loaded element more often and approach peak throughput
+  double intensity = double(tile_m) * tile_n / double(tile_m + tile_n);
+  double efficiency = intensity / (intensity + kHalfEfficiencyIntensity);
+
+  double cost = double(waves) * double(tile_m) * double(tile_n) * double(k_padded) / efficiency;
+
+  if (tile.math_instruction.opcode_class == OpcodeClassID::kSimt) {
+    cost *= kSimtPenalty;
+  }
+
+  // Operations compiled for narrower alignment issue narrower, less efficient memory accesses
+  int access_bits = std::min(desc.A.alignment * library::sizeof_bits(desc.A.element),
+                             desc.B.alignment * library::sizeof_bits(desc.B.element));
+  if (access_bits > 0 && access_bits < kMaxAccessBits) {
+    cost *= std::sqrt(double(kMaxAccessBits) / double(access_bits));
+  }
+
+  return cost;
+}
+
+bool gemm_operation_eligible(GemmDescription const &desc, GemmPreferenceKey const &preference_key) {
+  return desc.tile_description.minimum_compute_capability <= preference_key.compute_capability &&
+    preference_key.compute_capability <= desc.tile_description.maximum_compute_capability &&
+    maximum_alignment_requirement(desc) <= preference_key.alignment;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+GemmOperationSelector::Key::Key(
+  GemmOperationVectorMap const *operations,
+  TuningDatabase const *tuning_db,
+  uint64_t tuning_generation,
+  int compute_capability,
+  int alignment,
+  int sm_count,
+  GemmSelectionProblem const &problem):
+  words{
+    uint64_t(reinterpret_cast<std::uintptr_t>(operations)),
+    uint64_t(reinterpret_cast<std::uintptr_t>(tuning_db)),
+    tuning_generation,
+    uint64_t(uint32_t(compute_capability)) << 32 | uint32_t(alignment),
+    uint64_t(uint32_t(sm_count)) << 32 | uint32_t(problem.batch_count),
+    uint64_t(uint32_t(problem.m)) << 32 | uint32_t(problem.n),
+    uint64_t(uint32_t(problem.k))
+  } { }
+
+GemmOperationSelector::GemmOperationSelector():
+  table_(new Slot[kCapacity]) {
+
+  for (int idx = 0; idx < kCapacity; ++idx) {
+    Slot &slot = table_[idx];
+    slot.sequence.store(0, std::memory_order_relaxed);
+    for (int word = 0; word < kKeyWords; ++word) {
+      slot.key[word].store(0, std::memory_order_relaxed);
+    }
+    slot.operation.store(nullptr, std::memory_order_relaxed);
+  }
+}
+
+GemmOperationSelector &GemmOperationSelector::get() {
+  static GemmOperationSelector selector;
+  return selector;
+}
+
+uint64_t GemmOperationSelector::hash(Key const &key) {
+  uint64_t h = 0x9E3779B97F4A7C15ull;
+  for (uint64_t word : key.words) {
+    h ^= word + 0x9E3779B97F4A7C15ull + (h << 6) + (h >> 2);
+    h *= 0xFF51AFD7ED558CCDull;
+    h ^= h >> 33;
+  }
+  return h;
+}
+
+bool GemmOperationSelector::lookup(Key const &key, uint64_t hash, Operation const *&operation) const {
+  for (int probe = 0; probe < kMaxProbes; ++probe) {
+    Slot const &slot = table_[(hash + probe) % kCapacity];
+
+    uint64_t sequence = slot.sequence.load(std::memory_order_acquire);
+    if (!sequence) {
+      return false;
+    }
+
+    bool match = true;
+    for (int word = 0; word < kKeyWords; ++word) {
+      match = (slot.key[word].load(std::memory_order_relaxed) == key.words[word]) && match;
+    }
+    Operation const *candidate = slot.operation.load(std::memory_order_relaxed);
+
+    // The slot was read consistently only if no writer started or finished in the meantime
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (match && !(sequence & 1) && slot.sequence.load(std::memory_order_relaxed) == sequence) {
+      operation = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+void GemmOperationSelector::insert(Key const &key, uint64_t hash, Operation const *operation) {
+  Slot *target = nullptr;
+
+  for (int probe = 0; probe < kMaxProbes; ++probe) {
+    target = &table_[(hash + probe) % kCapacity];
+    if (!target->sequence.load(std::memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  // Claim the slot by making its sequence odd. Dropping the decision is cheaper than waiting for
+  // a concurrent writer, which is likely publishing the same decision.
+  uint64_t sequence = target->sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1) ||
+      !target->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+    return;
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  for (int word = 0; word < kKeyWords; ++word) {
+    target->key[word].store(key.words[word], std::memory_order_relaxed);
+  }
+  target->operation.store(operation, std::memory_order_relaxed);
+
+  target->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+Operation const *GemmOperationSelector::select_uncached(
+  GemmOperationVectorMap const &operations,
+  GemmPreferenceKey const &preference_key,
+  GemmSelectionProblem const &problem,
+  int sm_count,
+  TuningDatabase const *tuning_db) {
+
+  // Offline tuning results take precedence over the cost model. Records are matched against the
+  // exact extents; only the cost model works on buckets.
+  if (tuning_db) {
+    Operation const *tuned = tuning_db->find_gemm_operation(operations, preference_key, problem);
+    if (tuned) {
+      return tuned;
+    }
+  }
+
+  GemmSelectionProblem bucket = gemm_selection_bucket(problem);
+
+  auto cc_it = operations.upper_bound(preference_key);
+
+  Operation const *best = nullptr;
+  double best_cost = std::numeric_limits<double>::infinity();
+  int best_cc = -1;
+
+  // Search in descending order of compute capability. Operations registered under the highest
+  // compute capability offering an eligible operation are ranked by cost.
+  while (cc_it != operations.begin()) {
+    --cc_it;
+
+    if (best && cc_it->first.compute_capability < best_cc) {
+      break;
+    }
+
+    for (auto const *op : cc_it->second) {
+      GemmDescription const &desc = static_cast<GemmDescription const &>(op->description());
+
+      if (!gemm_operation_eligible(desc, preference_key)) {
+        continue;
+      }
+
+      double cost = gemm_operation_cost(desc, bucket, sm_count);
+      if (!best || cost < best_cost) {
+        best = op;
+        best_cost = cost;
+        best_cc = cc_it->first.compute_capability;
+      }
+    }
+  }
+
+  return best;
+}
+
+Operation const *GemmOperationSelector::select(
+  GemmOperationVectorMap const &operations,
+  GemmPreferenceKey const &preference_key,
+  GemmSelectionProblem const &problem,
+  int sm_count,
+  TuningDatabase const *tuning_db) {
+
+  // Decisions informed by a tuning database are memoized for the exact extents, since the nearest
+  // record may differ between problems of one bucket, and for the database's current generation
+  if (tuning_db) {
+    Key key(&operations, tuning_db, tuning_db->generation(), preference_key.compute_capability,
+      preference_key.alignment, sm_count, problem);
+
+    uint64_t h = hash(key);
+
+    Operation const *operation = nullptr;
+    if (lookup(key, h, operation)) {
+      return operation;
+    }
+
+    operation = tuning_db->find_gemm_operation(operations, preference_key, problem);
+    if (!operation) {
+      operation = select(operations, preference_key, problem, sm_count);
+    }
+    insert(key, h, operation);
+
+    return operation;
+  }
+
+  // Cost model decisions are memoized per bucket
+  Key key(&operations, nullptr, 0, preference_key.compute_capability, preference_key.alignment,
+    sm_count, gemm_selection_bucket(problem));
+
+  uint64_t h = hash(key);
+
+  Operation const *operation = nullptr;
+  if (lookup(key, h, operation)) {
+    return operation;
+  }
+
+  operation = select_uncached(operations, preference_key, problem, sm_count);
+  insert(key, h, operation);
+
+  return operation;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
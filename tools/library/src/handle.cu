@@ -37,7 +37,9 @@
 #include <cstdint>
 
 #include "cutlass/library/handle.h"
+#include "cutlass/library/gemm_operation_selector.h"
 #include "cutlass/library/singleton.h"
+#include "cutlass/library/tuning_database.h"
 #include "cutlass/library/util.h"
 
 namespace cutlass {
@@ -45,6 +47,87 @@ namespace library {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+GemmPlan::GemmPlan():
+  operation_(nullptr),
+  key_(Provider::kInvalid),
+  mode_(GemmUniversalMode::kGemm),
+  alignment_(0),
+  pointer_alignment_{0, 0, 0, 0},
+  device_workspace_(nullptr),
+  owns_device_workspace_(false),
+  stream_(nullptr) { }
+
+GemmPlan::~GemmPlan() {
+  reset();
+}
+
+/// Releases the operation and any device workspace owned by the plan
+void GemmPlan::reset() {
+  if (owns_device_workspace_ && device_workspace_) {
+    cudaFree(device_workspace_);
+  }
+  operation_ = nullptr;
+  device_workspace_ = nullptr;
+  owns_device_workspace_ = false;
+}
+
+/// Returns true if the plan was created for the given problem
+bool GemmPlan::matches_(
+  GemmFunctionalKey const &key,
+  GemmUniversalMode mode,
+  GemmUniversalArguments const &arguments) const {
+
+  return key_ == key &&
+    mode_ == mode &&
+    arguments_.problem_size == arguments.problem_size &&
+    arguments_.batch_count == arguments.batch_count &&
+    arguments_.pointer_mode == arguments.pointer_mode &&
+    arguments_.lda == arguments.lda &&
+    arguments_.ldb == arguments.ldb &&
+    arguments_.ldc == arguments.ldc &&
+    arguments_.ldd == arguments.ldd &&
+    arguments_.batch_stride_A == arguments.batch_stride_A &&
+    arguments_.batch_stride_B == arguments.batch_stride_B &&
+    arguments_.batch_stride_C == arguments.batch_stride_C &&
+    arguments_.batch_stride_D == arguments.batch_stride_D;
+}
+
+/// Executes the planned GEMM
+Status GemmPlan::execute(
+  void const *alpha,
+  void const *ptr_A,
+  void const *ptr_B,
+  void const *beta,
+  void const *ptr_C,
+  void *ptr_D) {
+
+  if (!operation_) {
+    return Status::kErrorNotSupported;
+  }
+
+  void const *pointers[] = {ptr_A, ptr_B, ptr_C, ptr_D};
+
+  for (int idx = 0; idx < 4; ++idx) {
+    if (pointer_alignment_[idx] &&
+        reinterpret_cast<std::uintptr_t>(pointers[idx]) % pointer_alignment_[idx]) {
+      return Status::kErrorMisalignedOperand;
+    }
+  }
+
+  GemmUniversalArguments arguments = arguments_;
+
+  arguments.A = ptr_A;
+  arguments.B = ptr_B;
+  arguments.C = ptr_C;
+  arguments.D = ptr_D;
+  arguments.alpha = alpha;
+  arguments.beta = beta;
+
+  return operation_->run(&arguments, host_workspace_, device_workspace_, stream_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Constructor
 Handle::Handle(
   cudaStream_t stream,
@@ -55,7 +138,8 @@ Handle::Handle(
   workspace_(nullptr),
   workspace_size_(0),
   scalar_pointer_mode_(ScalarPointerMode::kHost),
-  last_operation_(nullptr) {
+  last_operation_(nullptr),
+  tuning_db_(TuningDatabase::global()) {
 
   int device_idx = -1;
 
@@ -94,6 +178,8 @@ Handle::Handle(Handle && handle) {
   workspace_ = handle.workspace_;
   stream_ = handle.stream_;
   scalar_pointer_mode_ = handle.scalar_pointer_mode_;
+  tuning_db_ = handle.tuning_db_;
+  gemm_plan_ = std::move(handle.gemm_plan_);
 
   handle.workspace_ = nullptr;
   handle.workspace_size_ = 0;
@@ -108,6 +194,8 @@ Handle & Handle::operator=(Handle && handle) {
   workspace_ = handle.workspace_;
   stream_ = handle.stream_;
   scalar_pointer_mode_ = handle.scalar_pointer_mode_;
+  tuning_db_ = handle.tuning_db_;
+  gemm_plan_ = std::move(handle.gemm_plan_);
 
   handle.workspace_ = nullptr;
   handle.workspace_size_ = 0;
@@ -121,6 +209,9 @@ int Handle::compute_capability() const {
 
 /// Sets the current CUDA stream
 void Handle::set_stream(cudaStream_t stream) {
+  if (stream != stream_) {
+    invalidate_gemm_plan_();
+  }
   stream_ = stream;
 }
 
@@ -151,6 +242,9 @@ void *Handle::get_workspace() const {
 
 /// Sets the size of device workspace, invalidating previous calls to get_device_workspace()
 void Handle::set_workspace_size(size_t bytes) {
+
+  invalidate_gemm_plan_();
+
   if (bytes != workspace_size_) {
 
     if (workspace_) {
@@ -194,14 +288,26 @@ Operation const *Handle::get_last_operation() const {
   return last_operation_;
 }
 
-///////////////////////////////////////////////////////////////////////////////////////////////////
+TuningDatabase const *Handle::get_tuning_database() const {
+  return tuning_db_;
+}
+
+void Handle::set_tuning_database(TuningDatabase const *tuning_db) {
+  if (tuning_db != tuning_db_) {
+    invalidate_gemm_plan_();
+  }
+  tuning_db_ = tuning_db;
+}
 
-/// Returns the maximum required alignment for each operator
-static int maximum_alignment_requirement(GemmDescription const &desc) {
-  return std::max(
-    std::max(desc.A.alignment, desc.B.alignment), desc.C.alignment);
+/// Invalidates the cached plan
+void Handle::invalidate_gemm_plan_() {
+  if (gemm_plan_) {
+    gemm_plan_->reset();
+  }
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Returns the largest alignment (in units of elements) the problem satisfies, starting from a
 /// given upper limit.
 static int gemm_problem_alignment(
@@ -284,44 +390,48 @@ static int gemm_problem_alignment(
   return 0;
 }
 
-/// Find the best kernel in descending order of preference.
-static Operation const * find_gemm_operation(
-  GemmOperationFunctionalMap::const_iterator operators_it,
-  GemmPreferenceKey const preference_key) {
+/// Alignment, in elements, of a kUniversal GEMM problem including its operand pointers
+static int gemm_universal_alignment(
+  GemmFunctionalKey const &key,
+  GemmUniversalMode mode,
+  GemmUniversalArguments const &arguments) {
 
-  auto cc_it = operators_it->second.upper_bound(preference_key);
-
-  if (cc_it == operators_it->second.begin()) {
-    return nullptr;
-  }
-
-  Operation const *operation = nullptr;
-
-  // Search in descending order of compute capability
-  do {
-    --cc_it;
-
-    // Search tile sizes in order, for now.
-    for (auto const * op : cc_it->second) {
-
-      GemmDescription const &desc = static_cast<GemmDescription const &>(op->description());
+  // Maximum alignment expectation among all kernels (in units of bytes)
+  int const kMaximumAlignmentSize = 16;
 
-      int min_cc = desc.tile_description.minimum_compute_capability;
-      int max_cc = desc.tile_description.maximum_compute_capability;
+  void const *ptr_A_check = arguments.A;
+  void const *ptr_B_check = arguments.B;
+  void const *ptr_C_check = arguments.C;
+  void *      ptr_D_check = arguments.D;
 
-      int op_alignment = maximum_alignment_requirement(desc);
+  // Ignore alignment of pointers to pointers. We can't check this from the host,
+  // as each batch index has its own pointer in device memory.
+  if (mode == GemmUniversalMode::kArray) {
+    ptr_A_check = nullptr;
+    ptr_B_check = nullptr;
+    ptr_C_check = nullptr;
+    ptr_D_check = nullptr;
+  }
 
-      if ((min_cc <= preference_key.compute_capability) &&
-        (preference_key.compute_capability <= max_cc) &&
-        (op_alignment <= preference_key.alignment)) {
+  return gemm_problem_alignment(
+    arguments.problem_size.m(), arguments.problem_size.n(), arguments.problem_size.k(),
+    key.element_A, ptr_A_check, arguments.lda, 0,
+    key.element_B, ptr_B_check, arguments.ldb, 0,
+    key.element_C, ptr_C_check, arguments.ldc, 0,
+    ptr_D_check, arguments.ldd, 0, kMaximumAlignmentSize
+  );
+}
 
-        operation = op;
-        break;
-      }
-    }
-  } while (!operation && cc_it != operators_it->second.begin());
+/// Find the tuned or lowest-cost kernel for the problem among those preferred for the device.
+static Operation const * find_gemm_operation(
+  GemmOperationFunctionalMap::const_iterator operators_it,
+  GemmPreferenceKey const preference_key,
+  GemmSelectionProblem const &problem,
+  int sm_count,
+  TuningDatabase const *tuning_db) {
 
-  return operation;
+  return GemmOperationSelector::get().select(
+    operators_it->second, preference_key, problem, sm_count, tuning_db);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -416,7 +526,9 @@ Status Handle::gemm(
 
   GemmPreferenceKey preference_key(compute_capability(), alignment);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  Operation const *operation = find_gemm_operation(
+    operators_it, preference_key, GemmSelectionProblem(M, N, K),
+    device_.multiProcessorCount, tuning_db_);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -453,6 +565,9 @@ Status Handle::gemm(
     return cutlass::Status::kErrorNotSupported;
   }
 
+  // The device workspace no longer holds the state of the cached gemm_universal() plan
+  invalidate_gemm_plan_();
+
   // Initialize host and device workspaces
   Status status = operation->initialize(
     &configuration,
@@ -529,10 +644,6 @@ Status Handle::gemm_universal(
   int64_t batch_stride_D                    /// Batch stride of D operand
 ) {
 
-  //
-  // Find the operation
-  //
-
   GemmFunctionalKey key(
     provider_,
     GemmKind::kUniversal,
@@ -550,6 +661,78 @@ Status Handle::gemm_universal(
     layout_D
   );
 
+  GemmUniversalArguments arguments{
+    {M, N, K},
+    batch_count,
+    ptr_A,
+    ptr_B,
+    ptr_C,
+    ptr_D,
+    alpha,
+    beta,
+    scalar_pointer_mode_,
+    lda,
+    ldb,
+    ldc,
+    ldd,
+    batch_stride_A,
+    batch_stride_B,
+    batch_stride_C,
+    batch_stride_D
+  };
+
+  //
+  // Reuse the plan of the previous call if only the pointers changed and they permit no wider
+  // alignment than the plan was selected for
+  //
+
+  if (gemm_plan_ && gemm_plan_->valid() && gemm_plan_->matches_(key, mode, arguments) &&
+      gemm_universal_alignment(key, mode, arguments) <= gemm_plan_->alignment_) {
+
+    Status status = gemm_plan_->execute(alpha, ptr_A, ptr_B, beta, ptr_C, ptr_D);
+
+    // Misaligned pointers may still be served by an operation of narrower alignment
+    if (status != Status::kErrorMisalignedOperand) {
+      last_operation_ = gemm_plan_->operation();
+      return status;
+    }
+  }
+
+  if (!gemm_plan_) {
+    gemm_plan_.reset(new GemmPlan);
+  }
+
+  Status status = plan_gemm_universal_(
+    *gemm_plan_, key, mode, arguments, workspace_, workspace_size_);
+
+  if (status != Status::kSuccess) {
+    return status;
+  }
+
+  last_operation_ = gemm_plan_->operation();
+
+  // Run the operator
+
+  return gemm_plan_->execute(alpha, ptr_A, ptr_B, beta, ptr_C, ptr_D);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Selects and initializes an operation for a plan
+Status Handle::plan_gemm_universal_(
+  GemmPlan &plan,
+  GemmFunctionalKey const &key,
+  GemmUniversalMode mode,
+  GemmUniversalArguments const &arguments,
+  void *device_workspace,
+  size_t device_workspace_size) {
+
+  plan.reset();
+
+  //
+  // Find the operation
+  //
+
   auto operators_it = Singleton::get().operation_table.gemm_operations.find(key);
 
   if (operators_it == Singleton::get().operation_table.gemm_operations.end()) {
@@ -560,34 +743,16 @@ Status Handle::gemm_universal(
     return cutlass::Status::kErrorNotSupported;
   }
 
+  int M = arguments.problem_size.m();
+  int N = arguments.problem_size.n();
+  int K = arguments.problem_size.k();
+  int batch_count = arguments.batch_count;
+
   //
   // Compute the largest alignment restriction the kernel can satisfy.
   //
 
-  // Maximum alignment expectation among all kernels (in units of bytes)
-  int const kMaximumAlignmentSize = 16;
-
-  void const *ptr_A_check = ptr_A;
-  void const *ptr_B_check = ptr_B;
-  void const *ptr_C_check = ptr_C;
-  void *      ptr_D_check = ptr_D;
-
-  // Ignore alignment of pointers to pointers. We can't check this from the host,
-  // as each batch index has its own pointer in device memory.
-  if (mode == GemmUniversalMode::kArray) {
-    ptr_A_check = nullptr;
-    ptr_B_check = nullptr;
-    ptr_C_check = nullptr;
-    ptr_D_check = nullptr;
-  }
-
-  int alignment = gemm_problem_alignment(
-    M, N, K,
-    element_A, ptr_A_check, lda, 0,
-    element_B, ptr_B_check, ldb, 0,
-    element_C, ptr_C_check, ldc, 0,
-    ptr_D_check, ldd, 0, kMaximumAlignmentSize
-  );
+  int alignment = gemm_universal_alignment(key, mode, arguments);
 
   //
   // Find the best kernel in descending order of preference.
@@ -595,14 +760,19 @@ Status Handle::gemm_universal(
 
   GemmPreferenceKey preference_key(compute_capability(), alignment);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  // In the split-K modes, batch_count slices K across CTAs
+  GemmSelectionProblem selection_problem =
+    (mode == GemmUniversalMode::kGemm || mode == GemmUniversalMode::kGemmSplitKParallel) ?
+      GemmSelectionProblem(M, N, (K + std::max(batch_count, 1) - 1) / std::max(batch_count, 1), batch_count) :
+      GemmSelectionProblem(M, N, K, batch_count);
+
+  Operation const *operation = find_gemm_operation(
+    operators_it, preference_key, selection_problem, device_.multiProcessorCount, tuning_db_);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
   }
 
-  last_operation_ = operation;
-
   //
   // Configure operation
   //
@@ -611,30 +781,135 @@ Status Handle::gemm_universal(
     mode,
     {M, N, K},
     batch_count,
-    lda,
-    ldb,
-    ldc,
-    ldd
+    arguments.lda,
+    arguments.ldb,
+    arguments.ldc,
+    arguments.ldd
   };
 
   // Query host work space size
   uint64_t host_workspace_size_needed = operation->get_host_workspace_size(&configuration);
 
-  if (uint64_t(kHostWorkspaceSize) < host_workspace_size_needed) {
+  if (uint64_t(GemmPlan::kHostWorkspaceSize) < host_workspace_size_needed) {
     return cutlass::Status::kErrorNotSupported;
   }
 
-  char host_workspace[kHostWorkspaceSize];
+  // Query device workspace size
+  uint64_t device_workspace_size_needed = operation->get_device_workspace_size(&configuration, &arguments);
+
+  if (device_workspace) {
+    if (uint64_t(device_workspace_size) < device_workspace_size_needed) {
+      return cutlass::Status::kErrorNotSupported;
+    }
+  }
+  else if (device_workspace_size_needed) {
+    cudaError_t error = cudaMalloc(&device_workspace, device_workspace_size_needed);
+    if (error != cudaSuccess) {
+      return cutlass::Status::kErrorMemoryAllocation;
+    }
+    plan.owns_device_workspace_ = true;
+  }
+
+  plan.device_workspace_ = device_workspace;
+  plan.stream_ = stream_;
+
+  // Initialize host and device workspaces
+  Status status = operation->initialize(
+    &configuration,
+    plan.host_workspace_,
+    plan.device_workspace_,
+    plan.stream_);
+
+  if (status != cutlass::Status::kSuccess) {
+    plan.reset();
+    return status;
+  }
+
+  GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+
+  TensorDescription const *tensors[] = {&desc.A, &desc.B, &desc.C, &desc.D};
+
+  for (int idx = 0; idx < 4; ++idx) {
+    plan.pointer_alignment_[idx] = (mode == GemmUniversalMode::kArray) ? 0 :
+      std::max(tensors[idx]->alignment * library::sizeof_bits(tensors[idx]->element) / 8, 1);
+  }
+
+  plan.operation_ = operation;
+  plan.key_ = key;
+  plan.mode_ = mode;
+  plan.alignment_ = alignment;
+  plan.arguments_ = arguments;
+
+  return cutlass::Status::kSuccess;
+}
+
+/// Creates a plan for repeated GEMM computations of the same problem
+Status Handle::plan_gemm_universal(
+
+  GemmPlan &plan,
+
+  GemmUniversalMode mode,
+
+  int M,
+  int N,
+  int K,
+  NumericTypeID element_compute,
+
+  NumericTypeID element_scalar,
+
+  NumericTypeID element_A,
+  LayoutTypeID layout_A,
+  ComplexTransform transform_A,
+  int64_t lda,
+
+  NumericTypeID element_B,
+  LayoutTypeID layout_B,
+  ComplexTransform transform_B,
+  int64_t ldb,
 
+  NumericTypeID element_C,
+  LayoutTypeID layout_C,
+  int64_t ldc,
+
+  NumericTypeID element_D,
+  LayoutTypeID layout_D,
+  int64_t ldd,
+
+  int batch_count,
+
+  int64_t batch_stride_A,
+  int64_t batch_stride_B,
+  int64_t batch_stride_C,
+  int64_t batch_stride_D
+) {
+
+  GemmFunctionalKey key(
+    provider_,
+    GemmKind::kUniversal,
+    element_compute,
+    element_scalar,
+    element_A,
+    layout_A,
+    transform_A,
+    element_B,
+    layout_B,
+    transform_B,
+    element_C,
+    layout_C,
+    element_D,
+    layout_D
+  );
+
+  // Pointers are bound at execution; null pointers satisfy any alignment
   GemmUniversalArguments arguments{
     {M, N, K},
     batch_count,
-    ptr_A,
-    ptr_B,
-    ptr_C,
-    ptr_D,
-    alpha,
-    beta,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
     scalar_pointer_mode_,
     lda,
     ldb,
@@ -646,27 +921,7 @@ Status Handle::gemm_universal(
     batch_stride_D
   };
 
-  // Query device workspace size
-  uint64_t device_workspace_size_needed = operation->get_device_workspace_size(&configuration, &arguments);
-
-  if (uint64_t(workspace_size_) < device_workspace_size_needed) {
-    return cutlass::Status::kErrorNotSupported;
-  }
-
-  // Initialize host and device workspaces
-  Status status = operation->initialize(
-    &configuration,
-    host_workspace,
-    workspace_,
-    stream_);
-
-  if (status != cutlass::Status::kSuccess) {
-    return status;
-  }
-
-  // Run the operator
-
-  return operation->run(&arguments, host_workspace, workspace_, stream_);
+  return plan_gemm_universal_(plan, key, mode, arguments, nullptr, 0);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -792,7 +1047,9 @@ Status Handle::gemm_planar_complex(
 
   GemmPreferenceKey preference_key(compute_capability(), alignment);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  Operation const *operation = find_gemm_operation(
+    operators_it, preference_key, GemmSelectionProblem(M, N, K, batch_count),
+    device_.multiProcessorCount, tuning_db_);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -834,6 +1091,9 @@ Status Handle::gemm_planar_complex(
     return cutlass::Status::kErrorNotSupported;
   }
 
+  // The device workspace no longer holds the state of the cached gemm_universal() plan
+  invalidate_gemm_plan_();
+
   // Initialize host and device workspaces
   Status status = operation->initialize(
     &configuration,
@@ -989,7 +1249,10 @@ Status Handle::gemm_planar_complex_array(
 
   GemmPreferenceKey preference_key(compute_capability(), alignment);
 
-  Operation const *operation = find_gemm_operation(operators_it, preference_key);
+  Operation const *operation = find_gemm_operation(
+    operators_it, preference_key,
+    GemmSelectionProblem(expected_M, expected_N, expected_K, batch_count),
+    device_.multiProcessorCount, tuning_db_);
 
   if (!operation) {
     return cutlass::Status::kErrorNotSupported;
@@ -1030,6 +1293,9 @@ Status Handle::gemm_planar_complex_array(
     return cutlass::Status::kErrorNotSupported;
   }
 
+  // The device workspace no longer holds the state of the cached gemm_universal() plan
+  invalidate_gemm_plan_();
+
   // Initialize host and device workspaces
   Status status = operation->initialize(
     &configuration,
@@ -1087,7 +1353,7 @@ Operation const* find_conv_operation_for_parallel_reduction(Operation const *ope
     conv_desc.element_epilogue);
 
   // conv operation table for conv2d or conv3d
-  auto conv_operations = (conv_desc.kind == OperationKind::kConv2d) ?
+  auto const &conv_operations = (conv_desc.kind == OperationKind::kConv2d) ?
                           Singleton::get().operation_table.conv2d_operations :
                           Singleton::get().operation_table.conv3d_operations;
 
@@ -1154,7 +1420,7 @@ Operation const* find_gemm_operation_for_parallel_reduction(Operation const *ope
     LayoutTypeID::kColumnMajor);
 
   // gemm operation table
-  auto gemm_operations = Singleton::get().operation_table.gemm_operations;
+  auto const &gemm_operations = Singleton::get().operation_table.gemm_operations;
 
   // find ConvFunctionalKey in gemm operation table
   auto operators_it = gemm_operations.find(key);
@@ -35,7 +35,19 @@
     This is the root of the data structure containing CUTLASS objects
 */
 
+#include <limits>
 #include <memory>
+#include <mutex>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
 #include "cutlass/library/manifest.h"
 
 namespace cutlass {
@@ -47,12 +59,158 @@ void initialize_reference_operations(Manifest &manifest);
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+} // namespace library
+} // namespace cutlass
+
+// register the procedurally generated sections of this library (generated in initialize_all.cpp)
+extern "C" void cutlass_library_register_sections(cutlass::library::Manifest *manifest);
+
+namespace cutlass {
+namespace library {
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+using RegisterSectionsFunction = void (*)(Manifest *);
+
+void *open_library(std::string const &path) {
+#if defined(_WIN32)
+  return reinterpret_cast<void *>(LoadLibraryA(path.c_str()));
+#else
+  return dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+#endif
+}
+
+void *find_symbol(void *library, char const *symbol) {
+#if defined(_WIN32)
+  return reinterpret_cast<void *>(GetProcAddress(reinterpret_cast<HMODULE>(library), symbol));
+#else
+  return dlsym(library, symbol);
+#endif
+}
+
+void close_library(void *library) {
+#if defined(_WIN32)
+  FreeLibrary(reinterpret_cast<HMODULE>(library));
+#else
+  dlclose(library);
+#endif
+}
+
+/// GEMM operation described by a GemmOperationRecord. The generated operation is constructed on
+/// first use. The description is assembled from the record and is the same for the lifetime of the
+/// operation; the generator only emits records for kinds that report a plain GemmDescription, with
+/// the stage and warp counts read from the generated type.
+class DeferredGemmOperation : public Operation {
+private:
+
+  GemmOperationRecord const &record_;
+
+  GemmDescription description_;
+
+  mutable std::once_flag constructed_flag_;
+
+  mutable std::unique_ptr<Operation> operation_;
+
+  static cutlass::gemm::GemmCoord make_coord(int const (&extent)[3]) {
+    return cutlass::gemm::GemmCoord(extent[0], extent[1], extent[2]);
+  }
+
+  /// Constructs the generated operation if needed
+  Operation const &operation() const {
+    std::call_once(constructed_flag_, [this] {
+      operation_.reset(record_.construct());
+    });
+    return *operation_;
+  }
+
+public:
+
+  explicit DeferredGemmOperation(GemmOperationRecord const &record): record_(record) {
+
+    description_.name = record.name;
+    description_.provider = Provider::kCUTLASS;
+    description_.kind = OperationKind::kGemm;
+    description_.gemm_kind = record.gemm_kind;
+
+    TileDescription &tile = description_.tile_description;
+    tile.threadblock_shape = make_coord(record.threadblock_shape);
+    tile.threadblock_stages = record.threadblock_stages;
+    tile.warp_count = make_coord(record.warp_count);
+    tile.cluster_shape = make_coord(record.cluster_shape);
+    tile.math_instruction = MathInstructionDescription(
+      make_coord(record.instruction_shape),
+      record.element_accumulator,
+      record.opcode_class,
+      record.math_operation);
+    tile.minimum_compute_capability = record.minimum_compute_capability;
+    tile.maximum_compute_capability = record.maximum_compute_capability;
+
+    description_.A = TensorDescription(record.element_A, record.layout_A, record.alignment_A);
+    description_.B = TensorDescription(record.element_B, record.layout_B, record.alignment_B);
+    description_.C = TensorDescription(record.element_C, record.layout_C, record.alignment_C);
+    description_.D = TensorDescription(record.element_D, record.layout_D, record.alignment_D);
+    description_.element_epilogue = record.element_epilogue;
+    description_.split_k_mode = SplitKMode::kNone;
+    description_.transform_A = record.transform_A;
+    description_.transform_B = record.transform_B;
+  }
+
+  /// Description assembled from the record
+  OperationDescription const & description() const override {
+    return description_;
+  }
+
+  Status can_implement(void const *configuration, void const *arguments) const override {
+    return operation().can_implement(configuration, arguments);
+  }
+
+  uint64_t get_host_workspace_size(void const *configuration) const override {
+    return operation().get_host_workspace_size(configuration);
+  }
+
+  uint64_t get_device_workspace_size(
+    void const *configuration,
+    void const *arguments = nullptr) const override {
+
+    return operation().get_device_workspace_size(configuration, arguments);
+  }
+
+  Status initialize(
+    void const *configuration,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    cudaStream_t stream = nullptr) const override {
+
+    return operation().initialize(configuration, host_workspace, device_workspace, stream);
+  }
+
+  Status run(
+    void const *arguments,
+    void *host_workspace,
+    void *device_workspace = nullptr,
+    cudaStream_t stream = nullptr) const override {
+
+    return operation().run(arguments, host_workspace, device_workspace, stream);
+  }
+};
+
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+Manifest::~Manifest() {
+  release();
+}
+
 /// Top-level initialization
 Status Manifest::initialize() {
 
   if (!operations_.empty()) {
     operations_.clear();
   }
+  sections_.clear();
 
   // initialize procedurally generated cutlass op in manifest object
   initialize_all(*this);
@@ -66,6 +224,100 @@ Status Manifest::initialize() {
   return Status::kSuccess;
 }
 
+/// Top-level initialization which registers generated operations without constructing them
+Status Manifest::initialize_lazy() {
+
+  if (!operations_.empty()) {
+    operations_.clear();
+  }
+  sections_.clear();
+
+  // register procedurally generated cutlass op in manifest object
+  cutlass_library_register_sections(this);
+
+  // initialize manually instanced reference op in manifest object
+  initialize_reference_operations(*this);
+
+  // initialize manually instanced reduction reference op in manifest object
+  initialize_all_reduction_op(*this);
+
+  return Status::kSuccess;
+}
+
+/// Opens a shared object and registers its sections
+Status Manifest::load_library(std::string const &path) {
+
+  void *library = open_library(path);
+  if (!library) {
+    return Status::kErrorInternal;
+  }
+
+  auto register_sections = reinterpret_cast<RegisterSectionsFunction>(
+    find_symbol(library, CUTLASS_LIBRARY_REGISTER_SECTIONS_SYMBOL));
+
+  if (!register_sections) {
+    close_library(library);
+    return Status::kErrorNotSupported;
+  }
+
+  libraries_.push_back(library);
+  register_sections(this);
+
+  return Status::kSuccess;
+}
+
+/// Runs the initializer of a section, or appends one deferred operation per record
+void Manifest::materialize(ManifestSection &section) {
+
+  if (section.initialize) {
+    section.initialize(*this);
+  }
+
+  for (size_t idx = 0; idx < section.record_count; ++idx) {
+    append(new DeferredGemmOperation(section.records[idx]));
+  }
+
+  section.materialized = true;
+}
+
+/// Materializes all sections with min_cc <= compute_capability
+size_t Manifest::materialize(int compute_capability) {
+
+  size_t operation_count = operations_.size();
+
+  for (ManifestSection &section : sections_) {
+    if (!section.materialized && section.min_cc <= compute_capability) {
+      materialize(section);
+    }
+  }
+
+  return operations_.size() - operation_count;
+}
+
+/// Materializes all sections of the given kind with min_cc <= compute_capability
+size_t Manifest::materialize(OperationKind kind, int compute_capability) {
+
+  size_t operation_count = operations_.size();
+
+  for (ManifestSection &section : sections_) {
+    if (!section.materialized && section.kind == kind && section.min_cc <= compute_capability) {
+      materialize(section);
+    }
+  }
+
+  return operations_.size() - operation_count;
+}
+
+/// Materializes all sections
+size_t Manifest::materialize_all() {
+  return materialize(std::numeric_limits<int>::max());
+}
+
+/// Registered sections
+std::vector<ManifestSection> const & Manifest::sections() const {
+  return sections_;
+}
+
 /// Used for initialization
 void Manifest::reserve(size_t operation_count) {
   operations_.reserve(operation_count);
@@ -73,7 +325,16 @@ void Manifest::reserve(size_t operation_count) {
 
 /// Graceful shutdown
 Status Manifest::release() {
+
+  // Operations may be defined in shared objects opened by load_library()
   operations_.clear();
+  sections_.clear();
+
+  for (void *library : libraries_) {
+    close_library(library);
+  }
+  libraries_.clear();
+
   return Status::kSuccess;
 }
 
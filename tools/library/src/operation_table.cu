@@ -79,7 +79,7 @@ void OperationTable::append(Manifest const &manifest) {
 
       GemmPreferenceKey preference_key(cc, alignment);
 
-      gemm_operations[functional_key][preference_key].push_back(op);
+      gemm_entries_.push_back({functional_key, preference_key, op});
     }
 
     // insert all conv2d or conv3d operation into operation table
@@ -107,8 +107,8 @@ void OperationTable::append(Manifest const &manifest) {
 
       // insert conv operation to conv2d_operations or conv3d_operations map
       (desc.kind == OperationKind::kConv2d) ?
-        conv2d_operations[functional_key][preference_key].push_back(op) : 
-        conv3d_operations[functional_key][preference_key].push_back(op);
+        conv2d_entries_.push_back({functional_key, preference_key, op}) :
+        conv3d_entries_.push_back({functional_key, preference_key, op});
     }
 
     // insert all reduction operation into operation table
@@ -127,12 +127,17 @@ void OperationTable::append(Manifest const &manifest) {
 
       Operation const *op = operation.get();
 
-      reduction_operations[functional_key] = op;
+      reduction_entries_.emplace_back(functional_key, op);
 
     }
 
   }
 
+  // Build the immutable lookup structures once all operations are known
+  gemm_operations.build(gemm_entries_);
+  conv2d_operations.build(conv2d_entries_);
+  conv3d_operations.build(conv3d_entries_);
+  reduction_operations.build(reduction_entries_);
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
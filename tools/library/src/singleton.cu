@@ -29,7 +29,13 @@
  *
  **************************************************************************************************/
 
+#include <cstdlib>
 #include <memory>
+#include <sstream>
+#include <string>
+
+#include <cuda_runtime.h>
+
 #include "cutlass/library/library.h"
 #include "cutlass/library/manifest.h"
 #include "cutlass/library/operation_table.h"
@@ -42,9 +48,78 @@ namespace library {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// True if CUTLASS_LIBRARY_LAZY requests that generated operations be constructed on demand
+bool lazy_initialization() {
+  char const *lazy = std::getenv("CUTLASS_LIBRARY_LAZY");
+  return lazy && *lazy && std::string(lazy) != "0";
+}
+
+/// Loads the kernel libraries listed in CUTLASS_LIBRARY_KERNEL_LIBRARIES
+void load_kernel_libraries(Manifest &manifest) {
+
+  char const *paths = std::getenv("CUTLASS_LIBRARY_KERNEL_LIBRARIES");
+  if (!paths) {
+    return;
+  }
+
+#if defined(_WIN32)
+  char const kSeparator = ';';
+#else
+  char const kSeparator = ':';
+#endif
+
+  std::stringstream ss(paths);
+  std::string path;
+  while (std::getline(ss, path, kSeparator)) {
+    if (!path.empty()) {
+      manifest.load_library(path);
+    }
+  }
+}
+
+/// Compute capability of the current device, or -1 if it cannot be queried
+int current_compute_capability() {
+
+  int device_idx = 0;
+  cudaDeviceProp properties;
+
+  if (cudaGetDevice(&device_idx) != cudaSuccess ||
+      cudaGetDeviceProperties(&properties, device_idx) != cudaSuccess) {
+    return -1;
+  }
+
+  return properties.major * 10 + properties.minor;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 Singleton::Singleton() {
 
-  manifest.initialize();
+  if (lazy_initialization()) {
+
+    // Only operations runnable on the current device are appended. GEMM operations are
+    // described by generated records and constructed on first use; other kinds are
+    // constructed when their section is materialized.
+    manifest.initialize_lazy();
+    load_kernel_libraries(manifest);
+
+    int compute_capability = current_compute_capability();
+    if (compute_capability < 0) {
+      manifest.materialize_all();
+    }
+    else {
+      manifest.materialize(compute_capability);
+    }
+  }
+  else {
+    manifest.initialize();
+    load_kernel_libraries(manifest);
+    manifest.materialize_all();
+  }
 
   operation_table.append(manifest);
 }
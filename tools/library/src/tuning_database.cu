@@ -0,0 +1,465 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*
+  \file
+  \brief Persistent database of tuned operation choices.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <tuple>
+
+#include "cutlass/library/tuning_database.h"
+#include "cutlass/library/util.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace library {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+char const kTuningDatabaseMagic[8] = {'C', 'U', 'T', 'L', 'T', 'D', 'B', '1'};
+
+struct TuningDatabaseFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_count;
+  uint64_t string_table_offset;
+  uint64_t string_table_bytes;
+};
+
+/// Fixed-size record. Enumerants and the operation name are offsets into the string table.
+struct TuningDatabaseFileRecord {
+  uint32_t kind;
+  uint32_t element_A;
+  uint32_t layout_A;
+  uint32_t element_B;
+  uint32_t layout_B;
+  uint32_t element_C;
+  uint32_t layout_C;
+  uint32_t element_accumulator;
+  uint32_t operation_name;
+  int32_t compute_capability;
+  int32_t m;
+  int32_t n;
+  int32_t k;
+  int32_t batch_count;
+  double runtime;
+};
+
+/// Builds a string table with each distinct string stored once
+class StringTableWriter {
+public:
+
+  std::vector<char> bytes;
+  std::map<std::string, uint32_t> offsets;
+
+  uint32_t intern(std::string const &str) {
+    auto it = offsets.find(str);
+    if (it != offsets.end()) {
+      return it->second;
+    }
+    uint32_t offset = uint32_t(bytes.size());
+    bytes.insert(bytes.end(), str.begin(), str.end());
+    bytes.push_back('\0');
+    offsets.emplace(str, offset);
+    return offset;
+  }
+};
+
+/// Reads a string from a string table. Returns false if the offset is out of bounds or the
+/// string is not terminated.
+bool read_string(std::vector<char> const &table, uint32_t offset, std::string &str) {
+  if (offset >= table.size()) {
+    return false;
+  }
+  char const *begin = table.data() + offset;
+  char const *end = static_cast<char const *>(std::memchr(begin, '\0', table.size() - offset));
+  if (!end) {
+    return false;
+  }
+  str.assign(begin, end);
+  return true;
+}
+
+auto signature_tuple(TuningSignature const &s) {
+  return std::make_tuple(
+    int(s.kind), s.compute_capability,
+    int(s.element_A), int(s.layout_A),
+    int(s.element_B), int(s.layout_B),
+    int(s.element_C), int(s.layout_C),
+    int(s.element_accumulator));
+}
+
+auto problem_tuple(GemmSelectionProblem const &p) {
+  return std::make_tuple(p.m, p.n, p.k, p.batch_count);
+}
+
+/// Orders records by signature, then by extents
+bool record_less(TuningRecord const &a, TuningRecord const &b) {
+  if (a.signature < b.signature) {
+    return true;
+  }
+  if (b.signature < a.signature) {
+    return false;
+  }
+  return problem_tuple(a.problem) < problem_tuple(b.problem);
+}
+
+double log2_ratio(int a, int b) {
+  return std::abs(std::log2(double(std::max(a, 1)) / double(std::max(b, 1))));
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TuningSignature TuningSignature::gemm(GemmDescription const &desc, int compute_capability) {
+  return TuningSignature(
+    desc.kind,
+    compute_capability,
+    desc.A.element, desc.A.layout,
+    desc.B.element, desc.B.layout,
+    desc.C.element, desc.C.layout,
+    desc.tile_description.math_instruction.element_accumulator);
+}
+
+bool TuningSignature::operator==(TuningSignature const &rhs) const {
+  return signature_tuple(*this) == signature_tuple(rhs);
+}
+
+bool TuningSignature::operator<(TuningSignature const &rhs) const {
+  return signature_tuple(*this) < signature_tuple(rhs);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+TuningDatabase::TuningDatabase(double max_distance): max_distance_(max_distance) {
+  changed();
+}
+
+void TuningDatabase::changed() {
+  // Process-wide, so that a database allocated at the address of a destroyed one does not
+  // inherit its memoized decisions
+  static std::atomic<uint64_t> next_generation(1);
+  generation_ = next_generation.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TuningDatabase::set_max_distance(double max_distance) {
+  if (max_distance != max_distance_) {
+    max_distance_ = max_distance;
+    changed();
+  }
+}
+
+TuningDatabase const *TuningDatabase::global() {
+
+  static std::unique_ptr<TuningDatabase> database = []() {
+    std::unique_ptr<TuningDatabase> db;
+    char const *path = std::getenv("CUTLASS_LIBRARY_TUNING_DB");
+    if (path && *path) {
+      db.reset(new TuningDatabase);
+      if (db->load(path) != Status::kSuccess) {
+        db.reset();
+      }
+    }
+    return db;
+  }();
+
+  return database.get();
+}
+
+Status TuningDatabase::load(std::string const &path) {
+
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  if (!file.good()) {
+    return Status::kErrorInvalidProblem;
+  }
+
+  std::streamoff file_bytes = file.tellg();
+  if (file_bytes < 0 || !file.seekg(0)) {
+    return Status::kErrorInvalidProblem;
+  }
+
+  TuningDatabaseFileHeader header;
+  if (!file.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, kTuningDatabaseMagic, sizeof(kTuningDatabaseMagic)) ||
+      header.version != kTuningDatabaseVersion) {
+    return Status::kErrorInvalidProblem;
+  }
+
+  // Reject sections that extend past the end of the file before allocating memory for them, so
+  // that a truncated or corrupt header cannot request an arbitrarily large allocation
+  uint64_t size = uint64_t(file_bytes);
+  uint64_t records_end = sizeof(header) + uint64_t(header.record_count) * sizeof(TuningDatabaseFileRecord);
+  if (records_end > size ||
+      header.string_table_offset < records_end ||
+      header.string_table_offset > size ||
+      header.string_table_bytes > size - header.string_table_offset) {
+    return Status::kErrorInvalidProblem;
+  }
+
+  std::vector<TuningDatabaseFileRecord> file_records(header.record_count);
+  if (!file.read(reinterpret_cast<char *>(file_records.data()),
+                 std::streamsize(file_records.size() * sizeof(TuningDatabaseFileRecord)))) {
+    return Status::kErrorInvalidProblem;
+  }
+
+  std::vector<char> strings(header.string_table_bytes);
+  if (!file.seekg(std::streamoff(header.string_table_offset)) ||
+      !file.read(strings.data(), std::streamsize(strings.size()))) {
+    return Status::kErrorInvalidProblem;
+  }
+
+  std::vector<TuningRecord> loaded;
+  loaded.reserve(file_records.size());
+
+  for (TuningDatabaseFileRecord const &file_record : file_records) {
+
+    std::string kind, element_A, layout_A, element_B, layout_B, element_C, layout_C,
+      element_accumulator, operation_name;
+
+    if (!read_string(strings, file_record.kind, kind) ||
+        !read_string(strings, file_record.element_A, element_A) ||
+        !read_string(strings, file_record.layout_A, layout_A) ||
+        !read_string(strings, file_record.element_B, element_B) ||
+        !read_string(strings, file_record.layout_B, layout_B) ||
+        !read_string(strings, file_record.element_C, element_C) ||
+        !read_string(strings, file_record.layout_C, layout_C) ||
+        !read_string(strings, file_record.element_accumulator, element_accumulator) ||
+        !read_string(strings, file_record.operation_name, operation_name)) {
+      return Status::kErrorInvalidProblem;
+    }
+
+    TuningRecord record(
+      TuningSignature(
+        from_string<OperationKind>(kind),
+        file_record.compute_capability,
+        from_string<NumericTypeID>(element_A), from_string<LayoutTypeID>(layout_A),
+        from_string<NumericTypeID>(element_B), from_string<LayoutTypeID>(layout_B),
+        from_string<NumericTypeID>(element_C), from_string<LayoutTypeID>(layout_C),
+        from_string<NumericTypeID>(element_accumulator)),
+      GemmSelectionProblem(file_record.m, file_record.n, file_record.k, file_record.batch_count),
+      operation_name,
+      file_record.runtime);
+
+    // Records naming enumerants unknown to this library cannot match any operation
+    TuningSignature const &s = record.signature;
+    if (s.kind == OperationKind::kInvalid ||
+        s.element_A == NumericTypeID::kInvalid || s.layout_A == LayoutTypeID::kInvalid ||
+        s.element_B == NumericTypeID::kInvalid || s.layout_B == LayoutTypeID::kInvalid ||
+        s.element_C == NumericTypeID::kInvalid || s.layout_C == LayoutTypeID::kInvalid ||
+        s.element_accumulator == NumericTypeID::kInvalid) {
+      continue;
+    }
+
+    loaded.push_back(std::move(record));
+  }
+
+  for (TuningRecord const &record : loaded) {
+    insert(record);
+  }
+
+  return Status::kSuccess;
+}
+
+Status TuningDatabase::save(std::string const &path) const {
+
+  StringTableWriter strings;
+  std::vector<TuningDatabaseFileRecord> file_records;
+  file_records.reserve(records_.size());
+
+  for (TuningRecord const &record : records_) {
+    TuningSignature const &s = record.signature;
+
+    TuningDatabaseFileRecord file_record;
+    file_record.kind = strings.intern(to_string(s.kind));
+    file_record.element_A = strings.intern(to_string(s.element_A));
+    file_record.layout_A = strings.intern(to_string(s.layout_A));
+    file_record.element_B = strings.intern(to_string(s.element_B));
+    file_record.layout_B = strings.intern(to_string(s.layout_B));
+    file_record.element_C = strings.intern(to_string(s.element_C));
+    file_record.layout_C = strings.intern(to_string(s.layout_C));
+    file_record.element_accumulator = strings.intern(to_string(s.element_accumulator));
+    file_record.operation_name = strings.intern(record.operation_name);
+    file_record.compute_capability = s.compute_capability;
+    file_record.m = record.problem.m;
+    file_record.n = record.problem.n;
+    file_record.k = record.problem.k;
+    file_record.batch_count = record.problem.batch_count;
+    file_record.runtime = record.runtime;
+
+    file_records.push_back(file_record);
+  }
+
+  TuningDatabaseFileHeader header;
+  std::memcpy(header.magic, kTuningDatabaseMagic, sizeof(kTuningDatabaseMagic));
+  header.version = kTuningDatabaseVersion;
+  header.record_count = uint32_t(file_records.size());
+  header.string_table_offset = sizeof(header) + file_records.size() * sizeof(TuningDatabaseFileRecord);
+  header.string_table_bytes = strings.bytes.size();
+
+  // Write to a temporary file and rename it so that readers never observe a partial database
+  std::string temp_path = path + ".tmp";
+  {
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<char const *>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const *>(file_records.data()),
+               std::streamsize(file_records.size() * sizeof(TuningDatabaseFileRecord)));
+    file.write(strings.bytes.data(), std::streamsize(strings.bytes.size()));
+    if (!file.good()) {
+      std::remove(temp_path.c_str());
+      return Status::kErrorInternal;
+    }
+  }
+
+  if (std::rename(temp_path.c_str(), path.c_str())) {
+    std::remove(temp_path.c_str());
+    return Status::kErrorInternal;
+  }
+
+  return Status::kSuccess;
+}
+
+bool TuningDatabase::insert(TuningRecord const &record) {
+
+  auto it = std::lower_bound(records_.begin(), records_.end(), record, record_less);
+
+  if (it != records_.end() && !record_less(record, *it)) {
+    if (record.runtime > 0 && (it->runtime <= 0 || record.runtime < it->runtime)) {
+      *it = record;
+      changed();
+      return true;
+    }
+    return false;
+  }
+
+  records_.insert(it, record);
+  changed();
+  return true;
+}
+
+double TuningDatabase::distance(GemmSelectionProblem const &a, GemmSelectionProblem const &b) {
+  return log2_ratio(a.m, b.m) + log2_ratio(a.n, b.n) + log2_ratio(a.k, b.k) +
+    log2_ratio(a.batch_count, b.batch_count);
+}
+
+std::vector<TuningRecord const *> TuningDatabase::nearest(
+  TuningSignature const &signature,
+  GemmSelectionProblem const &problem) const {
+
+  TuningRecord probe;
+  probe.signature = signature;
+  probe.problem = GemmSelectionProblem(
+    std::numeric_limits<int>::min(), std::numeric_limits<int>::min(),
+    std::numeric_limits<int>::min(), std::numeric_limits<int>::min());
+
+  std::vector<std::pair<double, TuningRecord const *>> candidates;
+
+  for (auto it = std::lower_bound(records_.begin(), records_.end(), probe, record_less);
+       it != records_.end() && it->signature == signature; ++it) {
+
+    double d = distance(it->problem, problem);
+    if (d <= max_distance_) {
+      candidates.emplace_back(d, &*it);
+    }
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+    [](std::pair<double, TuningRecord const *> const &a,
+       std::pair<double, TuningRecord const *> const &b) {
+      return std::get<0>(a) < std::get<0>(b);
+    });
+
+  std::vector<TuningRecord const *> result;
+  result.reserve(candidates.size());
+  for (auto const &candidate : candidates) {
+    result.push_back(std::get<1>(candidate));
+  }
+  return result;
+}
+
+Operation const *TuningDatabase::find_gemm_operation(
+  GemmOperationVectorMap const &operations,
+  GemmPreferenceKey const &preference_key,
+  GemmSelectionProblem const &problem) const {
+
+  if (records_.empty()) {
+    return nullptr;
+  }
+
+  // All operations of a functional map share element types and layouts
+  Operation const *any_operation = nullptr;
+  for (auto const &entry : operations) {
+    if (!entry.second.empty()) {
+      any_operation = entry.second.front();
+      break;
+    }
+  }
+  if (!any_operation) {
+    return nullptr;
+  }
+
+  TuningSignature signature = TuningSignature::gemm(
+    static_cast<GemmDescription const &>(any_operation->description()),
+    preference_key.compute_capability);
+
+  for (TuningRecord const *record : nearest(signature, problem)) {
+    for (auto const &entry : operations) {
+      for (Operation const *operation : entry.second) {
+        GemmDescription const &desc = static_cast<GemmDescription const &>(operation->description());
+        if (record->operation_name == desc.name && gemm_operation_eligible(desc, preference_key)) {
+          return operation;
+        }
+      }
+    }
+  }
+
+  return nullptr;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace library
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
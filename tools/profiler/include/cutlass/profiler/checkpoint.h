@@ -0,0 +1,92 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Set of completed (operation, problem) pairs recovered from an earlier report
+*/
+
+#pragma once
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// CUTLASS Profiler includes
+#include "performance_result.h"
+
+// CUTLASS Library includes
+#include "cutlass/library/library.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Records which operations have already been profiled on which problems. A pair is identified by
+/// the operation name and the values of all problem space arguments, exactly as they appear in
+/// the report, so any report written by --output or --columnar-output can serve as a checkpoint.
+class Checkpoint {
+private:
+
+  /// Keys of completed pairs
+  std::unordered_set<std::string> completed_;
+
+  /// Report file that was loaded
+  std::string file_name_;
+
+public:
+
+  /// Loads the report of an operation kind. The path is interpreted like --output, or like
+  /// --columnar-output if it ends in '.ccr'. Returns false if the report exists but cannot be
+  /// read. A missing report yields an empty checkpoint.
+  bool load(
+    std::string const &path,
+    library::OperationKind op_kind,
+    std::vector<std::string> const &argument_names);
+
+  /// Returns true if the operation and problem of the result were recorded in the report
+  bool contains(PerformanceResult const &result) const;
+
+  /// Number of completed pairs
+  size_t size() const { return completed_.size(); }
+
+  /// Report file that was loaded
+  std::string const &file_name() const { return file_name_; }
+
+private:
+
+  bool load_csv_(std::string const &file_name, std::vector<std::string> const &argument_names);
+  bool load_columnar_(std::string const &file_name, std::vector<std::string> const &argument_names);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
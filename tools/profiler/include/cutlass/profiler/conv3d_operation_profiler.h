@@ -376,6 +376,13 @@ public:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem);
 
+  /// Names of tensor arguments compared with operation tensor descriptions before configuration
+  virtual std::vector<char const *> matched_tensor_names() const;
+
+  /// Tensor descriptions of an operation in the order of matched_tensor_names()
+  virtual std::vector<library::TensorDescription> matched_tensors(
+    library::OperationDescription const &op_desc) const;
+
 protected:
 
   /// Updates the arguments structure for the CUTLASS operator based on
@@ -384,7 +391,7 @@ protected:
 
   /// Method to profile an initialized CUTLASS operation
   virtual Status profile_cutlass_(
-    double &runtime,
+    PerformanceResult &result,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
@@ -117,6 +117,22 @@ public:
     double epsilon,
     double nonzero_floor);
 
+  /// Returns true if two blocks in host memory have exactly the same value
+  static bool host_block_compare_equal(
+    library::NumericTypeID numeric_type, 
+    void const *ptr_A, 
+    void const *ptr_B, 
+    size_t capacity);
+
+  /// Returns true if two blocks in host memory have approximately the same value
+  static bool host_block_compare_relatively_equal(
+    library::NumericTypeID numeric_type, 
+    void const *ptr_A, 
+    void const *ptr_B, 
+    size_t capacity,
+    double epsilon,
+    double nonzero_floor);
+
 public:
   //
   // Methods
@@ -213,6 +213,20 @@ public:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem);
 
+  /// Describes a profiled result of the current problem for the tuning database
+  virtual bool tuning_record(
+    Options const &options,
+    library::Operation const *operation,
+    PerformanceResult const &result,
+    library::TuningRecord &record) const;
+
+  /// Names of tensor arguments compared with operation tensor descriptions before configuration
+  virtual std::vector<char const *> matched_tensor_names() const;
+
+  /// Tensor descriptions of an operation in the order of matched_tensor_names()
+  virtual std::vector<library::TensorDescription> matched_tensors(
+    library::OperationDescription const &op_desc) const;
+
 protected:
 
   /// Initializes the performance result
@@ -240,9 +254,14 @@ protected:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem);
 
+  /// Verifies the current result against the host reference on a background thread
+  void defer_host_reference_(
+    Options const &options,
+    library::GemmDescription const &gemm_desc);
+
   /// Method to profile a CUTLASS Operation
   Status profile_cutlass_(
-    double &runtime,
+    PerformanceResult &result,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
@@ -0,0 +1,112 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Background threads running host reference verification
+*/
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// CUTLASS Profiler includes
+#include "enumerated_types.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Runs verification jobs on background threads. Each job owns host snapshots of the tensors it
+/// needs, so the device workspace may be reused by the next operation while the job runs. The
+/// total size of snapshots held by queued and running jobs is bounded.
+class HostVerificationQueue {
+public:
+
+  /// Computes the disposition of a verification
+  using Job = std::function<Disposition()>;
+
+  /// Creates the snapshots of a job on the calling thread and returns the job
+  using JobFactory = std::function<Job()>;
+
+private:
+
+  struct Task {
+    Job job;
+    std::promise<Disposition> disposition;
+    size_t bytes;
+  };
+
+  std::vector<std::thread> workers_;
+
+  std::mutex mutex_;
+  std::condition_variable task_available_;
+  std::condition_variable memory_available_;
+
+  std::deque<Task> tasks_;
+
+  /// Bound on bytes held by queued and running jobs
+  size_t memory_limit_;
+
+  /// Bytes held by queued and running jobs
+  size_t bytes_in_flight_;
+
+  bool stop_;
+
+  void worker_loop_();
+
+public:
+
+  HostVerificationQueue(int thread_count, size_t memory_limit);
+
+  /// Waits for all queued jobs to finish
+  ~HostVerificationQueue();
+
+  HostVerificationQueue(HostVerificationQueue const &) = delete;
+  HostVerificationQueue &operator=(HostVerificationQueue const &) = delete;
+
+  /// Queues a job whose snapshots occupy the given number of bytes. Blocks until the memory bound
+  /// admits them, then invokes the factory on the calling thread. A job larger than the bound is
+  /// admitted once no other job is in flight.
+  std::shared_future<Disposition> submit(size_t bytes, JobFactory const &factory);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,151 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Index of operations matched against the tile and tensor arguments of each problem
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+// CUTLASS Library includes
+#include "cutlass/library/library.h"
+
+// Profiler includes
+#include "problem_space.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Finds the operations compatible with a problem.
+///
+/// Argument positions are resolved once at construction, and operations sharing the same tile
+/// description and tensor types are grouped into a bucket. Each problem is parsed once into a
+/// Filter and compared against every bucket rather than against every operation.
+class OperationMatcher {
+public:
+
+  using OperationVector = std::vector<library::Operation const *>;
+
+  /// Element and layout of a tensor; kUnknown matches any value in a Filter
+  using TensorType = std::pair<library::NumericTypeID, library::LayoutTypeID>;
+
+  /// Returns the tensor descriptions of an operation in the order of the tensor argument names
+  using TensorFunction = std::function<
+    std::vector<library::TensorDescription>(library::OperationDescription const &)>;
+
+  /// Tile description fields which may be constrained by a problem
+  enum Field {
+    kOpcodeClass,
+    kInstM, kInstN, kInstK,
+    kCtaM, kCtaN, kCtaK,
+    kClusterM, kClusterN, kClusterK,
+    kStages,
+    kWarpsM, kWarpsN, kWarpsK,
+    kAccumulator,
+    kFieldCount
+  };
+
+  using FieldVector = std::array<int64_t, kFieldCount>;
+
+  /// Typed tile and tensor arguments of one problem
+  struct Filter {
+
+    /// Bit i is set if field i is constrained
+    uint32_t mask = 0;
+
+    /// Values of constrained fields
+    FieldVector fields{};
+
+    /// Constraint on each matched tensor
+    std::vector<TensorType> tensors;
+  };
+
+private:
+
+  /// Operations with identical tile description fields and tensor types
+  struct Bucket {
+    FieldVector fields;
+    std::vector<TensorType> tensors;
+    std::vector<size_t> operations;
+  };
+
+  /// Position of each field within a problem, or -1 if the problem space lacks it
+  std::array<int, kFieldCount> field_index_;
+
+  /// Position of each matched tensor within a problem
+  std::vector<int> tensor_index_;
+
+  /// Candidate operations in their original order
+  OperationVector operations_;
+
+  std::vector<Bucket> buckets_;
+
+public:
+
+  OperationMatcher(
+    ProblemSpace const &problem_space,
+    OperationVector const &operations,
+    std::vector<char const *> const &tensor_names = std::vector<char const *>(),
+    TensorFunction const &tensors = TensorFunction());
+
+  /// Parses the tile and tensor arguments of a problem
+  Filter parse(ProblemSpace::Problem const &problem) const;
+
+  /// Returns the operations satisfying a filter, in their original order
+  OperationVector match(Filter const &filter) const;
+
+  /// Returns the operations compatible with a problem, in their original order
+  OperationVector match(ProblemSpace::Problem const &problem) const {
+    return match(parse(problem));
+  }
+
+  /// Number of distinct tile description and tensor type combinations
+  size_t bucket_count() const { return buckets_.size(); }
+
+  /// Tile description fields of an operation
+  static FieldVector fields(library::OperationDescription const &op_desc);
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -37,6 +37,9 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <deque>
+#include <functional>
+#include <future>
 #include <unordered_map>
 
 // CUTLASS includes
@@ -46,13 +49,17 @@
 #include "cutlass/library/library.h"
 #include "cutlass/library/util.h"
 #include "cutlass/library/manifest.h"
+#include "cutlass/library/tuning_database.h"
 
 // Profiler includes
 #include "options.h"
 #include "device_context.h"
 #include "performance_result.h"
 #include "performance_report.h"
+#include "checkpoint.h"
+#include "host_verification_queue.h"
 #include "problem_space.h"
+#include "operation_matcher.h"
 #include "debug.h"
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -91,6 +98,43 @@ protected:
   /// Performance result vector constructed by profiling the operation
   PerformanceResultVector results_;
 
+  /// Wall-clock duration of the most recent adaptive measurement (ms)
+  double last_measurement_duration_;
+
+  /// Background host reference verification. Present while profile_all() runs if enabled.
+  std::unique_ptr<HostVerificationQueue> host_verification_queue_;
+
+private:
+
+  /// Host verification of one result of the current operation
+  struct DeferredVerification {
+
+    /// Index of the result in results_
+    size_t result_index;
+
+    /// Verification provider
+    library::Provider provider;
+
+    /// Outcome, available once the job completes
+    std::shared_future<Disposition> disposition;
+  };
+
+  /// Results of one operation and problem, held until their deferred verifications complete
+  struct PendingResults {
+    size_t problem_index;
+    PerformanceResultVector results;
+    std::vector<DeferredVerification> verifications;
+
+    /// Tuning record of each result, if it describes one
+    std::vector<std::pair<bool, library::TuningRecord>> tuning_records;
+  };
+
+  /// Host verifications of results_ not yet complete
+  std::vector<DeferredVerification> deferred_verifications_;
+
+  /// Results not yet reported, in report order
+  std::deque<PendingResults> pending_results_;
+
 public:
 
   //
@@ -179,6 +223,22 @@ public:
     ProblemSpace const &problem_space,
     ProblemSpace::Problem const &problem) = 0;
 
+  /// Describes a profiled result of the current problem for the tuning database. Returns false if
+  /// results of this operation kind or problem are not recorded.
+  virtual bool tuning_record(
+    Options const &options,
+    library::Operation const *operation,
+    PerformanceResult const &result,
+    library::TuningRecord &record) const;
+
+  /// Names of tensor arguments compared with operation tensor descriptions before a problem is
+  /// configured. Operations are otherwise filtered by initialize_configuration() alone.
+  virtual std::vector<char const *> matched_tensor_names() const;
+
+  /// Tensor descriptions of an operation in the order of matched_tensor_names()
+  virtual std::vector<library::TensorDescription> matched_tensors(
+    library::OperationDescription const &op_desc) const;
+
 public:
 
   //
@@ -188,7 +248,11 @@ public:
   /// Sleep for a given duration in ms
   static void sleep(int sleep_duration);
 
-  /// Returns true if the current operation description satisfies the problem space
+  /// Returns true if a result is correct and timed, and thus eligible for the tuning database
+  static bool is_tuning_candidate(PerformanceResult const &result);
+
+  /// Returns true if the current operation description satisfies the problem space. Tile
+  /// arguments only; OperationMatcher applies the same rules to many operations at once.
   static bool satisfies(
     library::OperationDescription const &op_desc,
     ProblemSpace const &problem_space,
@@ -232,14 +296,54 @@ protected:
 
   /// Method to profile an initialized CUTLASS operation
   virtual Status profile_cutlass_(
-    double &runtime,
+    PerformanceResult &result,
     Options const &options,
     library::Operation const *operation,
     void *arguments,
     void *host_workspace,
     void *device_workspace);
 
+  /// Runs warmup and timed launches and records runtime and runtime statistics in the result.
+  /// The argument of `launch` counts launches from zero, warmup included.
+  Status profile_kernel_(
+    PerformanceResult &result,
+    Options const &options,
+    std::function<Status (int)> const &launch);
+
+  /// Returns the operations of this kind which run on the device and pass the name filters
+  OperationMatcher::OperationVector candidate_operations_(
+    Options const &options,
+    library::Manifest const &manifest);
+
+  /// Returns true if host reference verification of the current operation may run in the
+  /// background. Workspaces of incorrect results cannot be saved once the next operation runs.
+  bool host_verification_deferred_(Options const &options) const;
+
+  /// Verifies the last result with the host reference in the background. The factory copies the
+  /// tensors needed by the job to host memory of the given size.
+  void defer_host_verification_(size_t bytes, HostVerificationQueue::JobFactory const &factory);
+
+  /// Sets the disposition of a verified result to the worst outcome among its verification
+  /// providers, or to passed if any passed
+  static void update_disposition_(PerformanceResult &result);
+
 private:
+
+  /// Hands results_ to the report, or holds them until their deferred verifications complete
+  void report_results_(
+    Options const &options,
+    PerformanceReport &report,
+    library::Operation const *operation,
+    library::TuningDatabase *tuning_db,
+    bool &tuning_db_updated);
+
+  /// Reports held results whose verifications completed, in order. If wait is true, waits for all.
+  void report_pending_results_(
+    PerformanceReport &report,
+    library::TuningDatabase *tuning_db,
+    bool &tuning_db_updated,
+    bool wait);
+
   /// finds string matches filter_string in operation_name
   bool find_string_matches_(
     std::string const &filter_string, 
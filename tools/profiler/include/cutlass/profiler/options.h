@@ -166,6 +166,13 @@ public:
     /// Indicates when to save the workspace
     SaveWorkspace save_workspace;
 
+    /// Number of background threads running host reference verification. If zero, the host
+    /// reference runs before the operation is profiled.
+    int host_threads;
+
+    /// Bound on the host memory held by snapshots awaiting host reference verification (MiB)
+    int host_memory;
+
     //
     // Methods
     //
@@ -194,6 +201,13 @@ public:
     /// Number of iterations to profile each kernel - if 0, kernels are launched up to the profiling duration
     int iterations;
 
+    /// Wall-clock budget to profile each kernel when iterations is 0 (ms)
+    int duration;
+
+    /// Target half-width of the 95% confidence interval of the mean runtime, relative to the mean,
+    /// when iterations is 0
+    double relative_error;
+
     /// Number of ms to sleep between profiling periods (ms)
     int sleep_duration;
 
@@ -203,6 +217,12 @@ public:
     /// If true, profiling returns an error code if no kernels are found to match the filters.
     bool error_on_no_match = false;
 
+    /// Index of the shard of (operation, problem) pairs profiled by this process
+    int shard_index;
+
+    /// Number of shards the (operation, problem) pairs are partitioned into
+    int shard_count;
+
     /// List of providers of each functionality to be profiled
     ProviderVector providers;
 
@@ -220,6 +240,12 @@ public:
 
     /// Returns the index of a provider if its enabled
     size_t index(library::Provider provider) const;
+
+    /// Returns true if the number of iterations is chosen by a statistical stopping rule
+    bool adaptive() const { return iterations <= 0; }
+
+    /// Returns true if the (operation, problem) pair with the given ordinal belongs to this shard
+    bool in_shard(size_t ordinal) const { return int(ordinal % size_t(shard_count)) == shard_index; }
   };
   
   /// Options related to reporting
@@ -234,6 +260,15 @@ public:
     /// Path to a file containing junit xml results
     std::string junit_output_path;
 
+    /// Path to a file containing columnar binary results
+    std::string columnar_output_path;
+
+    /// Path to a report of an earlier run whose (operation, problem) pairs are skipped
+    std::string resume_path;
+
+    /// Path to a tuning database into which the fastest operation for each problem is merged
+    std::string tuning_db_path;
+
     /// Sequence of tags to attach to each result
     std::vector<std::pair<std::string, std::string>> pivot_tags;
 
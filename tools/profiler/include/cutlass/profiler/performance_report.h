@@ -45,6 +45,9 @@
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
 
+// CUTLASS Util includes
+#include "cutlass/util/columnar_report.h"
+
 namespace cutlass {
 namespace profiler {
 
@@ -71,6 +74,12 @@ private:
   /// Output file containing junit results
   std::ofstream junit_output_file_;
 
+  /// Operation file name containing columnar performance report of op_kind
+  std::string op_columnar_file_name_;
+
+  /// Output file containing columnar results
+  columnar::Writer columnar_output_file_;
+
   /// Flag indicating the performance report is valid
   bool good_;
 
@@ -80,6 +89,9 @@ private:
   /// Counter uniquely identifying problem within the report
   size_t problem_index_;
 
+  /// Problem of the rows buffered in the columnar output
+  size_t columnar_problem_index_;
+
   /// Collection of all results
   PerformanceResultVector concatenated_results_;
 
@@ -90,11 +102,29 @@ public:
 
   bool good() const { return good_; }
 
+  /// Index of the current problem
+  size_t problem_index() const { return problem_index_; }
+
   void next_problem();
+
+  /// Writes the row group of buffered columnar results if they belong to a problem before
+  /// problem_index, which the caller guarantees will receive no further results. Each row group
+  /// thus holds exactly one problem.
+  void complete_problems(size_t problem_index);
+
   void append_result(PerformanceResult result);
   void sort_results(PerformanceResultVector &results);
   void append_results(PerformanceResultVector const &results);
 
+  /// Appends results whose problem index was assigned when they were produced, for results held
+  /// back while the report moved on to later problems
+  void append_deferred_results(PerformanceResultVector const &results);
+
+private:
+
+  /// Writes a result with its problem index to all outputs
+  void write_result_(PerformanceResult const &result);
+
 public:
 
   /// Prints the CSV header
@@ -103,6 +133,12 @@ public:
   /// Prints the CSV
   std::ostream & print_result_csv_(std::ostream &out, PerformanceResult const &result);
 
+  /// Returns the columns of the columnar output
+  columnar::Schema columnar_schema_() const;
+
+  /// Appends the result as a row of the columnar output
+  void append_result_columnar_(PerformanceResult const &result);
+
   /// @defgroup jUnit Result Generation
   /// Functions related to generation of the jUnit results
   /// @{
@@ -40,6 +40,7 @@
 
 // CUTLASS Profiler includes
 #include "enumerated_types.h"
+#include "runtime_statistics.h"
 
 // CUTLASS Library includes
 #include "cutlass/library/library.h"
@@ -86,6 +87,13 @@ struct PerformanceResult {
   /// Average runtime in ms
   double runtime;
 
+  /// Number of timed kernel launches
+  int iterations;
+
+  /// Distribution of the mean launch runtime of each timed batch (ms). With a fixed number of
+  /// iterations all launches form a single batch.
+  RuntimeStatistics runtime_statistics;
+
   //
   // Members
   //
@@ -99,7 +107,8 @@ struct PerformanceResult {
     status(Status::kInvalid),
     bytes(0), 
     flops(0), 
-    runtime(0)
+    runtime(0),
+    iterations(0)
   { }
 
   /// Returns true if the runtime is valid
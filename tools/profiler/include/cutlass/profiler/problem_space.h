@@ -763,6 +763,10 @@ public:
 
     explicit Iterator();
     Iterator(ProblemSpace const &problem_space);
+
+    /// Constructs an iterator to the point at a linear index, with the first argument varying fastest
+    Iterator(ProblemSpace const &problem_space, size_t index);
+
     Iterator(Iterator &&it);
 
     // Rule of three
@@ -837,6 +841,12 @@ public:
 
   /// Returns the number of dimensions of the problem space
   size_t rank() const { return arguments.size(); }
+
+  /// Returns the number of values of each argument
+  std::vector<size_t> extents() const;
+
+  /// Returns the number of points in the problem space
+  size_t size() const;
  
 private:
 
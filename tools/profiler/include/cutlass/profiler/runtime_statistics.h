@@ -0,0 +1,151 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Summary statistics and stopping rule for adaptive kernel measurement
+*/
+
+#pragma once
+
+#include <vector>
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Summary statistics of runtime samples (ms). Each sample is the mean launch runtime of one
+/// batch of back-to-back launches, so percentiles, stddev and outliers describe batch means.
+/// For a batch of n independent launches the stddev is about 1/sqrt(n) of the per-launch stddev.
+struct RuntimeStatistics {
+
+  /// Number of samples (batches)
+  int samples;
+
+  /// Arithmetic mean
+  double mean;
+
+  /// 50th percentile
+  double median;
+
+  /// 10th percentile
+  double p10;
+
+  /// 90th percentile
+  double p90;
+
+  /// Sample standard deviation
+  double stddev;
+
+  /// Number of samples outside the Tukey fences [Q1 - 1.5 IQR, Q3 + 1.5 IQR]
+  int outliers;
+
+  //
+  // Methods
+  //
+
+  RuntimeStatistics():
+    samples(0), mean(0), median(0), p10(0), p90(0), stddev(0), outliers(0) { }
+
+  /// Computes statistics of a set of samples
+  static RuntimeStatistics compute(std::vector<double> samples);
+
+  /// Half-width of the 95% confidence interval of the mean
+  double confidence_interval() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Decides how many kernel launches make up one sample and when to stop sampling.
+///
+/// Each sample times a batch of back-to-back launches long enough to amortize event overhead.
+/// Sampling stops when the 95% confidence interval of the mean falls within a relative error
+/// of the mean, or when the wall-clock budget or sample limit is reached.
+class AdaptiveMeasurement {
+public:
+
+  /// Minimum number of samples before the stopping rule is evaluated
+  static int const kMinSamples = 5;
+
+  /// Maximum number of samples
+  static int const kMaxSamples = 1000;
+
+  /// Maximum number of launches in one sample
+  static int const kMaxBatchSize = 1024;
+
+private:
+
+  /// Target half-width of the confidence interval relative to the mean
+  double relative_error_;
+
+  /// Wall-clock budget (ms)
+  double budget_;
+
+  /// Minimum duration of a sample (ms)
+  double min_sample_duration_;
+
+  /// Launches per sample
+  int batch_size_;
+
+  /// Mean launch runtime of each batch (ms)
+  std::vector<double> samples_;
+
+public:
+
+  AdaptiveMeasurement(
+    double relative_error,
+    double budget,
+    double min_sample_duration = 0.1);
+
+  /// Chooses the batch size from the runtime of a single calibration launch
+  void calibrate(double launch_runtime);
+
+  /// Number of launches to time in the next sample
+  int batch_size() const { return batch_size_; }
+
+  /// Records the total runtime of one batch of batch_size() launches
+  void append(double batch_runtime);
+
+  /// Returns true if no further samples are needed after `elapsed` ms of wall-clock time
+  bool done(double elapsed) const;
+
+  /// Total number of timed launches
+  int iterations() const;
+
+  /// Statistics of the batch means so far
+  RuntimeStatistics statistics() const;
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
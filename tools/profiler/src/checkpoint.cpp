@@ -0,0 +1,221 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Set of completed (operation, problem) pairs recovered from an earlier report
+*/
+
+#include <fstream>
+#include <sstream>
+
+#include "cutlass/library/util.h"
+#include "cutlass/util/columnar_report.h"
+
+#include "cutlass/profiler/checkpoint.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Appends a field to the key of an (operation, problem) pair
+void append_key(std::string &key, std::string const &value) {
+  key.push_back('\n');
+  key.append(value);
+}
+
+/// Splits a line of the CSV report. Values never contain commas.
+std::vector<std::string> split_csv_line(std::string const &line) {
+
+  std::vector<std::string> fields;
+  std::stringstream ss(line);
+  std::string field;
+
+  while (std::getline(ss, field, ',')) {
+    fields.push_back(field);
+  }
+
+  // A trailing comma denotes a final empty field
+  if (!line.empty() && line.back() == ',') {
+    fields.emplace_back();
+  }
+
+  return fields;
+}
+
+/// Returns the index of a column or -1 if not present
+int find_column(std::vector<std::string> const &header, std::string const &name) {
+  for (size_t idx = 0; idx < header.size(); ++idx) {
+    if (header[idx] == name) {
+      return int(idx);
+    }
+  }
+  return -1;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+bool Checkpoint::load(
+  std::string const &path,
+  library::OperationKind op_kind,
+  std::vector<std::string> const &argument_names) {
+
+  completed_.clear();
+
+  bool columnar = path.size() >= 4 && path.compare(path.size() - 4, 4, ".ccr") == 0;
+
+  // Derive the file name exactly as PerformanceReport does
+  std::string base_path = path.substr(0, path.rfind(columnar ? ".ccr" : ".csv"));
+  file_name_ = base_path + "." + to_string(op_kind) + (columnar ? ".ccr" : ".csv");
+
+  if (!std::ifstream(file_name_).good()) {
+    return true;
+  }
+
+  return columnar ? load_columnar_(file_name_, argument_names) : load_csv_(file_name_, argument_names);
+}
+
+bool Checkpoint::contains(PerformanceResult const &result) const {
+
+  if (completed_.empty()) {
+    return false;
+  }
+
+  std::string key = result.operation_name;
+  for (auto const &arg : result.arguments) {
+    append_key(key, arg.second);
+  }
+
+  return completed_.count(key) != 0;
+}
+
+bool Checkpoint::load_csv_(std::string const &file_name, std::vector<std::string> const &argument_names) {
+
+  std::ifstream file(file_name);
+  std::string line;
+
+  if (!std::getline(file, line)) {
+    return true;
+  }
+
+  std::vector<std::string> header = split_csv_line(line);
+
+  int operation_column = find_column(header, "Operation");
+  std::vector<int> argument_columns;
+
+  for (auto const &name : argument_names) {
+    argument_columns.push_back(find_column(header, name));
+    if (argument_columns.back() < 0) {
+      return false;
+    }
+  }
+
+  if (operation_column < 0) {
+    return false;
+  }
+
+  while (std::getline(file, line)) {
+
+    std::vector<std::string> fields = split_csv_line(line);
+
+    // Rows cut short by an interrupted run are ignored
+    if (fields.size() != header.size()) {
+      continue;
+    }
+
+    std::string key = fields[operation_column];
+    for (int column : argument_columns) {
+      append_key(key, fields[column]);
+    }
+
+    completed_.insert(key);
+  }
+
+  return true;
+}
+
+bool Checkpoint::load_columnar_(std::string const &file_name, std::vector<std::string> const &argument_names) {
+
+  columnar::Reader reader(file_name);
+
+  if (!reader.good()) {
+    return false;
+  }
+
+  int operation_column = reader.find("Operation");
+  std::vector<int> argument_columns;
+
+  for (auto const &name : argument_names) {
+    argument_columns.push_back(reader.find(name));
+    if (argument_columns.back() < 0) {
+      return false;
+    }
+  }
+
+  if (operation_column < 0) {
+    return false;
+  }
+
+  // Decode one row group at a time to bound memory use on large reports
+  for (size_t group = 0; group < reader.row_groups().size(); ++group) {
+
+    columnar::ColumnData operations;
+    std::vector<columnar::ColumnData> arguments(argument_columns.size());
+
+    if (!reader.read_column(group, size_t(operation_column), operations)) {
+      return false;
+    }
+
+    for (size_t idx = 0; idx < argument_columns.size(); ++idx) {
+      if (!reader.read_column(group, size_t(argument_columns[idx]), arguments[idx])) {
+        return false;
+      }
+    }
+
+    for (size_t row = 0; row < operations.size(); ++row) {
+      std::string key = operations.string(row);
+      for (auto const &argument : arguments) {
+        append_key(key, argument.string(row));
+      }
+      completed_.insert(key);
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
@@ -1218,7 +1218,7 @@ bool Conv2dOperationProfiler::profile(
     }
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &conv_workspace_.arguments,
@@ -1230,17 +1230,30 @@ bool Conv2dOperationProfiler::profile(
 
 }
 
+/// Names of tensor arguments compared with operation tensor descriptions before configuration
+std::vector<char const *> Conv2dOperationProfiler::matched_tensor_names() const {
+  return {"Activation", "Filter", "Output"};
+}
+
+/// Tensor descriptions of an operation in the order of matched_tensor_names()
+std::vector<library::TensorDescription> Conv2dOperationProfiler::matched_tensors(
+  library::OperationDescription const &op_desc) const {
+
+  library::ConvDescription const &desc = static_cast<library::ConvDescription const &>(op_desc);
+  return {desc.activation(), desc.filter(), desc.output()};
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Method to profile a CUTLASS Operation
 Status Conv2dOperationProfiler::profile_cutlass_(
-  double &runtime,
+  PerformanceResult &result,
   Options const &options,
   library::Operation const *operation,
   void *arguments,
   void *host_workspace,
   void *device_workspace) {
 
-  GpuTimer timer;
-
   // initialize conv2d underlying operation to handle parallel reduction
   library::Operation const* underlying_operation = operation; 
 
@@ -1252,74 +1265,8 @@ Status Conv2dOperationProfiler::profile_cutlass_(
     }
   }
 
-  //
-  // Optional sleep to limit power consumption and thermals
-  //
-
-  sleep(options.profiling.sleep_duration);
-
-  //
-  // Warmup loop
-  //
-
-  Status status;
-
-  for (int iteration = 0; iteration < options.profiling.warmup_iterations; ++iteration) {
+  return profile_kernel_(result, options, [&](int iteration) {
 
-    // Setup rotating workspace
-    int workspace_idx = options.profiling.warmup_iterations + iteration;
-    int problem_idx = (workspace_idx % conv_workspace_.problem_count);
-
-    conv_arguments->A = conv_workspace_.A->batch_data(problem_idx);
-    conv_arguments->B = conv_workspace_.B->batch_data(problem_idx);
-    conv_arguments->C = conv_workspace_.C->batch_data(problem_idx);
-    conv_arguments->D = conv_workspace_.Computed->batch_data(problem_idx);
-    
-    if (conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {
-      // update library::ConvArguments for parallel split-k reduction
-      conv_arguments->D = conv_workspace_.device_workspace.data();
-
-      /// initialize library::ReductionArguments
-      conv_workspace_.reduction_arguments.workspace           = conv_workspace_.device_workspace.data();
-      conv_workspace_.reduction_arguments.source              = conv_workspace_.C->batch_data(problem_idx);
-      conv_workspace_.reduction_arguments.destination         = conv_workspace_.Computed->batch_data(problem_idx);
-    }
-
-    // Run underlying conv2d operation
-    status = underlying_operation->run(
-      arguments,
-      host_workspace,
-      device_workspace);
-
-    // Run parallel reduction kernel for parallel split_k_mode
-    if (conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {
-
-      status = reduction_op_->run(
-        &conv_workspace_.reduction_arguments,
-        conv_workspace_.reduction_host_workspace.data(),
-        nullptr);
-    }
-
-    if (status != Status::kSuccess) {
-      return status;
-    }
-  }
-  
-  //
-  // Initialize GPU timer
-  //
-
-  timer.start();
-
-  //
-  // Profiling loop
-  //
-
-  int Iterations = options.profiling.iterations;
-
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
-    
     // Setup rotating workspace
     int problem_idx = (iteration % conv_workspace_.problem_count);
 
@@ -1339,13 +1286,13 @@ Status Conv2dOperationProfiler::profile_cutlass_(
     }
 
     // Run underlying conv2d operation
-    status = underlying_operation->run(
+    Status status = underlying_operation->run(
       arguments,
       host_workspace,
       device_workspace);
 
     // Run parallel reduction kernel for parallel split_k_mode
-    if (conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {      
+    if (conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {
 
       status = reduction_op_->run(
         &conv_workspace_.reduction_arguments,
@@ -1353,24 +1300,8 @@ Status Conv2dOperationProfiler::profile_cutlass_(
         nullptr);
     }
 
-    if (status != Status::kSuccess) {
-      return status;
-    }
-  }
-
-  //
-  // Wait for completion
-  //
-
-  timer.stop_and_wait();
-
-  //
-  // Update performance result
-  //
-  
-  runtime = timer.duration(iteration);
-
-  return status;
+    return status;
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1081,7 +1081,7 @@ bool Conv3dOperationProfiler::profile(
     set_cutlass_operator_arguments_();
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &conv_workspace_.arguments,
@@ -1121,17 +1121,30 @@ void Conv3dOperationProfiler::set_cutlass_operator_arguments_(int problem_idx) {
   }
 }
 
+/// Names of tensor arguments compared with operation tensor descriptions before configuration
+std::vector<char const *> Conv3dOperationProfiler::matched_tensor_names() const {
+  return {"Activation", "Filter", "Output"};
+}
+
+/// Tensor descriptions of an operation in the order of matched_tensor_names()
+std::vector<library::TensorDescription> Conv3dOperationProfiler::matched_tensors(
+  library::OperationDescription const &op_desc) const {
+
+  library::ConvDescription const &desc = static_cast<library::ConvDescription const &>(op_desc);
+  return {desc.activation(), desc.filter(), desc.output()};
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Method to profile a CUTLASS Operation
 Status Conv3dOperationProfiler::profile_cutlass_(
-  double &runtime,
+  PerformanceResult &result,
   Options const &options,
   library::Operation const *operation,
   void *arguments,
   void *host_workspace,
   void *device_workspace) {
 
-  GpuTimer timer;
-
   // initialize conv2d underlying operation to handle parallel reduction
   library::Operation const* underlying_operation = operation;
 
@@ -1141,98 +1154,29 @@ Status Conv3dOperationProfiler::profile_cutlass_(
     }
   }
 
-  //
-  // Optional sleep to limit power consumption and thermals
-  //
-
-  sleep(options.profiling.sleep_duration);
-
-  //
-  // Warmup loop
-  //
-
-  Status status;
-
-  for (int iteration = 0; iteration < options.profiling.warmup_iterations; ++iteration) {
+  return profile_kernel_(result, options, [&](int iteration) {
 
     // Setup rotating workspace
-    int workspace_idx = options.profiling.warmup_iterations + iteration;
-    int problem_idx = (workspace_idx % conv_workspace_.problem_count);
+    int problem_idx = (iteration % conv_workspace_.problem_count);
 
     set_cutlass_operator_arguments_(problem_idx);
 
     // Run underlying conv2d operation
-    status = underlying_operation->run(
+    Status status = underlying_operation->run(
       arguments,
       host_workspace,
       device_workspace);
 
     // Run parallel reduction kernel for parallel split_k_mode
     if (conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {
-
       status = reduction_op_->run(
         &conv_workspace_.reduction_arguments,
         conv_workspace_.reduction_host_workspace.data(),
         nullptr);
     }
 
-    if (status != Status::kSuccess) {
-      return status;
-    }
-  }
-  
-  //
-  // Initialize GPU timer
-  //
-
-  timer.start();
-
-  //
-  // Profiling loop
-  //
-
-  int Iterations = options.profiling.iterations;
-
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
-
-    // Setup rotating workspace
-    int problem_idx = (iteration % conv_workspace_.problem_count);
- 
-    set_cutlass_operator_arguments_(problem_idx);
- 
-    // Run underlying conv2d operation
-    status = underlying_operation->run(
-      arguments,
-      host_workspace,
-      device_workspace);
-
-    // Run parallel reduction kernel for parallel split_k_mode
-    if (conv_workspace_.configuration.split_k_mode == conv::SplitKMode::kParallel) {      
-      status = reduction_op_->run(
-        &conv_workspace_.reduction_arguments,
-        conv_workspace_.reduction_host_workspace.data(),
-        nullptr);
-    }
-
-    if (status != Status::kSuccess) {
-      return status;
-    }
-  }
-
-  //
-  // Wait for completion
-  //
-
-  timer.stop_and_wait();
-
-  //
-  // Update performance result
-  //
-  
-  runtime = timer.duration(iteration);
-
-  return status;
+    return status;
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1837,6 +1837,110 @@ bool DeviceAllocation::block_compare_relatively_equal(
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace {
+
+/// Invokes func with a value of the element type identified by numeric_type
+template <typename Func>
+bool dispatch_host_compare(library::NumericTypeID numeric_type, Func func) {
+
+  switch (numeric_type) {
+  case library::NumericTypeID::kFE4M3: return func(float_e4m3_t());
+  case library::NumericTypeID::kFE5M2: return func(float_e5m2_t());
+  case library::NumericTypeID::kF16: return func(half_t());
+  case library::NumericTypeID::kBF16: return func(bfloat16_t());
+  case library::NumericTypeID::kTF32: return func(tfloat32_t());
+  case library::NumericTypeID::kF32: return func(float());
+  case library::NumericTypeID::kF64: return func(double());
+  case library::NumericTypeID::kCF16: return func(complex<half_t>());
+  case library::NumericTypeID::kCBF16: return func(complex<bfloat16_t>());
+  case library::NumericTypeID::kCTF32: return func(complex<tfloat32_t>());
+  case library::NumericTypeID::kCF32: return func(complex<float>());
+  case library::NumericTypeID::kCF64: return func(complex<double>());
+  case library::NumericTypeID::kS2: return func(int2b_t());
+  case library::NumericTypeID::kS4: return func(int4b_t());
+  case library::NumericTypeID::kS8: return func(int8_t());
+  case library::NumericTypeID::kS16: return func(int16_t());
+  case library::NumericTypeID::kS32: return func(int32_t());
+  case library::NumericTypeID::kS64: return func(int64_t());
+  case library::NumericTypeID::kB1: return func(uint1b_t());
+  case library::NumericTypeID::kU2: return func(uint2b_t());
+  case library::NumericTypeID::kU4: return func(uint4b_t());
+  case library::NumericTypeID::kU8: return func(uint8_t());
+  case library::NumericTypeID::kU16: return func(uint16_t());
+  case library::NumericTypeID::kU32: return func(uint32_t());
+  case library::NumericTypeID::kU64: return func(uint64_t());
+  default:
+    break;
+  }
+
+  throw std::runtime_error(std::string("Unsupported numeric type: ") + to_string(numeric_type));
+}
+
+template <typename Element>
+struct is_complex_element : std::false_type { };
+
+template <typename T>
+struct is_complex_element<complex<T>> : std::true_type { };
+
+} // namespace
+
+/// Returns true if two blocks in host memory have exactly the same value
+bool DeviceAllocation::host_block_compare_equal(
+  library::NumericTypeID numeric_type, 
+  void const *ptr_A, 
+  void const *ptr_B, 
+  size_t capacity) {
+
+  return dispatch_host_compare(numeric_type, [&](auto element) {
+
+    using Element = decltype(element);
+
+    for (size_t idx = 0; idx < capacity; ++idx) {
+      Element a = ReferenceFactory<Element>::get(reinterpret_cast<Element const *>(ptr_A), idx);
+      Element b = ReferenceFactory<Element>::get(reinterpret_cast<Element const *>(ptr_B), idx);
+      if (a != b) {
+        return false;
+      }
+    }
+    return true;
+  });
+}
+
+/// Returns true if two blocks in host memory have approximately the same value. As on the device,
+/// complex numbers require bitwise equality.
+bool DeviceAllocation::host_block_compare_relatively_equal(
+  library::NumericTypeID numeric_type, 
+  void const *ptr_A, 
+  void const *ptr_B, 
+  size_t capacity,
+  double epsilon,
+  double nonzero_floor) {
+
+  return dispatch_host_compare(numeric_type, [&](auto element) {
+
+    using Element = decltype(element);
+
+    if constexpr (is_complex_element<Element>::value) {
+      return host_block_compare_equal(numeric_type, ptr_A, ptr_B, capacity);
+    }
+    else {
+      Element element_epsilon = static_cast<Element>(epsilon);
+      Element element_nonzero_floor = static_cast<Element>(nonzero_floor);
+
+      for (size_t idx = 0; idx < capacity; ++idx) {
+        Element a = ReferenceFactory<Element>::get(reinterpret_cast<Element const *>(ptr_A), idx);
+        Element b = ReferenceFactory<Element>::get(reinterpret_cast<Element const *>(ptr_B), idx);
+        if (!relatively_equal(a, b, element_epsilon, element_nonzero_floor)) {
+          return false;
+        }
+      }
+      return true;
+    }
+  });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Permits copying dynamic vectors into static-length vectors 
 template <typename TensorCoord, int Rank>
 struct vector_to_coord {
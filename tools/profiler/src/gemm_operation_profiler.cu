@@ -750,19 +750,11 @@ bool GemmOperationProfiler::verify_cutlass(
 
     // Update disposition to worst case verification outcome among all
     // verification providers which are supported
-    bool is_any_verification_run_passed = false;
-    for (auto &m : results_.back().verification_map) {
-      if (m.second == Disposition::kFailed || m.second == Disposition::kIncorrect) {
-        results_.back().disposition = m.second;
-        return true;
-      }
-      if (!is_any_verification_run_passed && m.second == Disposition::kPassed) {
-        is_any_verification_run_passed = true;
-      }
-    }
+    update_disposition_(results_.back());
 
-    if (is_any_verification_run_passed) {
-      results_.back().disposition = Disposition::kPassed;
+    if (results_.back().disposition == Disposition::kFailed ||
+        results_.back().disposition == Disposition::kIncorrect) {
+      return true;
     }
   }
 
@@ -928,6 +920,11 @@ bool GemmOperationProfiler::verify_with_reference_(
       continue;
     }
 
+    if (provider == library::Provider::kReferenceHost && host_verification_deferred_(options)) {
+      defer_host_reference_(options, gemm_desc);
+      continue;
+    }
+
     void *ptr_A = gemm_workspace_.A->data();
     void *ptr_B = gemm_workspace_.B->data();
     void *ptr_C = gemm_workspace_.C->data();
@@ -1046,6 +1043,113 @@ bool GemmOperationProfiler::verify_with_reference_(
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Verifies the current result against the host reference on a background thread
+void GemmOperationProfiler::defer_host_reference_(
+  Options const &options,
+  library::GemmDescription const &gemm_desc) {
+
+  GemmWorkspace &ws = gemm_workspace_;
+
+  size_t bytes = ws.A->bytes() + ws.B->bytes() + ws.C->bytes() + ws.Computed->bytes() + ws.Reference->bytes();
+
+  defer_host_verification_(bytes, [&]() -> HostVerificationQueue::Job {
+
+    // Snapshot the operands and the computed result, as the workspace is reused by the next operation
+    auto host_A = std::make_shared<std::vector<uint8_t>>(ws.A->bytes());
+    auto host_B = std::make_shared<std::vector<uint8_t>>(ws.B->bytes());
+    auto host_C = std::make_shared<std::vector<uint8_t>>(ws.C->bytes());
+    auto host_computed = std::make_shared<std::vector<uint8_t>>(ws.Computed->bytes());
+    auto host_reference = std::make_shared<std::vector<uint8_t>>(ws.Reference->bytes());
+
+    ws.A->copy_to_host(host_A->data());
+    ws.B->copy_to_host(host_B->data());
+    ws.C->copy_to_host(host_C->data());
+    ws.Computed->copy_to_host(host_computed->data());
+
+    // The handle is constructed here so that it targets the current device
+    auto handle = std::make_shared<library::Handle>(nullptr, 0);
+    handle->set_provider(library::Provider::kReferenceHost);
+
+    GemmProblem problem = problem_;
+    library::GemmUniversalConfiguration configuration = ws.configuration;
+    library::GemmDescription desc = gemm_desc;
+
+    int64_t batch_stride_A = ws.A->batch_stride();
+    int64_t batch_stride_B = ws.B->batch_stride();
+    int64_t batch_stride_C = ws.C->batch_stride();
+    int64_t batch_stride_D = ws.Reference->batch_stride();
+
+    // Matches the extent compared by compare_tensors()
+    library::NumericTypeID element_D = ws.Computed->type();
+    size_t count = ws.Computed->batch_stride() ? size_t(ws.Computed->batch_stride()) : ws.Reference->capacity();
+    bool same_type = ws.Computed->type() == ws.Reference->type();
+
+    double epsilon = options.verification.epsilon;
+    double nonzero_floor = options.verification.nonzero_floor;
+
+    return [=]() -> Disposition {
+
+      Status status = handle->gemm_universal(
+        problem.mode,
+        configuration.problem_size.m(),
+        configuration.problem_size.n(),
+        configuration.problem_size.k(),
+        desc.tile_description.math_instruction.element_accumulator,
+        desc.element_epilogue,
+
+        problem.alpha.data(),
+
+        desc.A.element,
+        desc.A.layout,
+        desc.transform_A,
+        host_A->data(),
+        int(configuration.lda),
+
+        desc.B.element,
+        desc.B.layout,
+        desc.transform_B,
+        host_B->data(),
+        int(configuration.ldb),
+
+        problem.beta.data(),
+
+        desc.C.element,
+        desc.C.layout,
+        host_C->data(),
+        int(configuration.ldc),
+
+        desc.D.element,
+        desc.D.layout,
+        host_reference->data(),
+        int(configuration.ldd),
+
+        configuration.batch_count,
+        batch_stride_A,
+        batch_stride_B,
+        batch_stride_C,
+        batch_stride_D);
+
+      if (status != Status::kSuccess) {
+        return Disposition::kNotRun;
+      }
+
+      if (!same_type) {
+        return Disposition::kIncorrect;
+      }
+
+      bool passed = (epsilon == 0) ?
+        DeviceAllocation::host_block_compare_equal(
+          element_D, host_computed->data(), host_reference->data(), count) :
+        DeviceAllocation::host_block_compare_relatively_equal(
+          element_D, host_computed->data(), host_reference->data(), count, epsilon, nonzero_floor);
+
+      return passed ? Disposition::kPassed : Disposition::kIncorrect;
+    };
+  });
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Measures performance results
 bool GemmOperationProfiler::profile(
   Options const &options,
@@ -1084,7 +1188,7 @@ bool GemmOperationProfiler::profile(
     }
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &gemm_workspace_.arguments,
@@ -1097,95 +1201,73 @@ bool GemmOperationProfiler::profile(
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Method to profile a CUTLASS Operation
-Status GemmOperationProfiler::profile_cutlass_(
-  double &runtime,
+/// Describes a profiled result of the current problem for the tuning database
+bool GemmOperationProfiler::tuning_record(
   Options const &options,
   library::Operation const *operation,
-  void *arguments,
-  void *host_workspace,
-  void *device_workspace) {
-
-  GpuTimer timer;
-  // initialize gemm underlying operation to handle parallel reduction
-  library::Operation const * underlying_operation = operation;
+  PerformanceResult const &result,
+  library::TuningRecord &record) const {
 
-  if (problem_.split_k_mode == library::SplitKMode::kParallel) {
-    if (!(underlying_operation = library::find_gemm_operation_for_parallel_reduction(operation))) {
-      return Status::kErrorNotSupported;
-    }
+  // library::Handle does not select kernels for split-K reductions or grouped problems
+  if (problem_.split_k_slices != 1 ||
+      (problem_.mode != library::GemmUniversalMode::kGemm &&
+       problem_.mode != library::GemmUniversalMode::kBatched)) {
+    return false;
   }
 
-  //
-  // Optional sleep to limit power consumption and thermals
-  //
-
-  sleep(options.profiling.sleep_duration);
-
-  //
-  // Warmup loop
-  //
+  library::GemmDescription const &desc =
+    static_cast<library::GemmDescription const &>(operation->description());
 
-  Status status;
+  record = library::TuningRecord(
+    library::TuningSignature::gemm(desc, options.device.compute_capability()),
+    library::GemmSelectionProblem(
+      int(problem_.m), int(problem_.n), int(problem_.k),
+      problem_.mode == library::GemmUniversalMode::kBatched ? problem_.batch_count : 1),
+    desc.name,
+    result.runtime);
 
-  for (int iteration = 0; iteration < options.profiling.warmup_iterations; ++iteration) {
+  return true;
+}
 
-    int problem_idx = (iteration % gemm_workspace_.problem_count) * problem_.batch_count;
+/////////////////////////////////////////////////////////////////////////////////////////////////
 
-    gemm_workspace_.arguments.A = gemm_workspace_.A->batch_data(problem_idx);
-    gemm_workspace_.arguments.B = gemm_workspace_.B->batch_data(problem_idx);
-    gemm_workspace_.arguments.C = gemm_workspace_.C->batch_data(problem_idx);
-    gemm_workspace_.arguments.D = gemm_workspace_.Computed->batch_data(problem_idx);
+/// Names of tensor arguments compared with operation tensor descriptions before configuration
+std::vector<char const *> GemmOperationProfiler::matched_tensor_names() const {
+  return {"A", "B", "C", "D"};
+}
 
-    if (problem_.split_k_mode == library::SplitKMode::kParallel) {
-      gemm_workspace_.arguments.D                     = gemm_workspace_.device_workspace.data();
+/// Tensor descriptions of an operation in the order of matched_tensor_names()
+std::vector<library::TensorDescription> GemmOperationProfiler::matched_tensors(
+  library::OperationDescription const &op_desc) const {
 
-      gemm_workspace_.reduction_arguments.workspace   = gemm_workspace_.device_workspace.data();
-      gemm_workspace_.reduction_arguments.source      = gemm_workspace_.C->batch_data(problem_idx);
-      gemm_workspace_.reduction_arguments.destination = gemm_workspace_.Computed->batch_data(problem_idx);
-    }
+  library::GemmDescription const &desc = static_cast<library::GemmDescription const &>(op_desc);
+  return {desc.A, desc.B, desc.C, desc.D};
+}
 
-    // Execute the CUTLASS operation
-    status = underlying_operation->run(
-      &gemm_workspace_.arguments,
-      host_workspace,
-      device_workspace);
+/////////////////////////////////////////////////////////////////////////////////////////////////
 
-    if (status != Status::kSuccess) {
-      return status;
-    }
+/// Method to profile a CUTLASS Operation
+Status GemmOperationProfiler::profile_cutlass_(
+  PerformanceResult &result,
+  Options const &options,
+  library::Operation const *operation,
+  void *arguments,
+  void *host_workspace,
+  void *device_workspace) {
 
-    // Run parallel reduction kernel for parallel split_k_mode
-    if (problem_.split_k_mode == library::SplitKMode::kParallel) {
-      status = reduction_op_->run(
-        &gemm_workspace_.reduction_arguments,
-        gemm_workspace_.reduction_host_workspace.data(),
-        nullptr);
+  // initialize gemm underlying operation to handle parallel reduction
+  library::Operation const * underlying_operation = operation;
 
-      if (status != Status::kSuccess) {
-        return status;
-      }
+  if (problem_.split_k_mode == library::SplitKMode::kParallel) {
+    if (!(underlying_operation = library::find_gemm_operation_for_parallel_reduction(operation))) {
+      return Status::kErrorNotSupported;
     }
   }
 
-  //
-  // Initialize GPU timer
-  //
-
-  timer.start();
-
-  //
-  // Profiling loop
-  //
-
-  int Iterations = options.profiling.iterations;
-
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
+  return profile_kernel_(result, options, [&](int iteration) {
 
     // Iterate over copies of the problem in memory
-    int workspace_idx = options.profiling.warmup_iterations + iteration;
-    int problem_idx = (workspace_idx % gemm_workspace_.problem_count) * problem_.batch_count;
+    int problem_idx = (iteration % gemm_workspace_.problem_count) * problem_.batch_count;
 
     gemm_workspace_.arguments.A = gemm_workspace_.A->batch_data(problem_idx);
     gemm_workspace_.arguments.B = gemm_workspace_.B->batch_data(problem_idx);
@@ -1200,7 +1282,8 @@ Status GemmOperationProfiler::profile_cutlass_(
       gemm_workspace_.reduction_arguments.destination = gemm_workspace_.Computed->batch_data(problem_idx);
     }
 
-    status = underlying_operation->run(
+    // Execute the CUTLASS operation
+    Status status = underlying_operation->run(
       arguments,
       host_workspace,
       device_workspace);
@@ -1215,25 +1298,10 @@ Status GemmOperationProfiler::profile_cutlass_(
         &gemm_workspace_.reduction_arguments,
         gemm_workspace_.reduction_host_workspace.data(),
         nullptr);
-
-      if (status != Status::kSuccess) {
-        return status;
-      }
     }
-  }
-
-  //
-  // Wait for completion
-  //
-
-  timer.stop_and_wait();
-  //
-  // Update performance result
-  //
-
-  runtime = timer.duration(iteration);
 
-  return status;
+    return status;
+  });
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
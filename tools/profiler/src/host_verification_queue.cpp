@@ -0,0 +1,146 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Background threads running host reference verification
+*/
+
+#include <exception>
+
+#include "cutlass/profiler/host_verification_queue.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+HostVerificationQueue::HostVerificationQueue(int thread_count, size_t memory_limit):
+  memory_limit_(memory_limit), bytes_in_flight_(0), stop_(false) {
+
+  for (int idx = 0; idx < thread_count; ++idx) {
+    workers_.emplace_back([this] { worker_loop_(); });
+  }
+}
+
+HostVerificationQueue::~HostVerificationQueue() {
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+
+  task_available_.notify_all();
+
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+std::shared_future<Disposition> HostVerificationQueue::submit(size_t bytes, JobFactory const &factory) {
+
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    memory_available_.wait(lock, [&] {
+      return !bytes_in_flight_ || bytes_in_flight_ + bytes <= memory_limit_;
+    });
+    bytes_in_flight_ += bytes;
+  }
+
+  Task task;
+  task.bytes = bytes;
+
+  try {
+    task.job = factory();
+  }
+  catch (...) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    bytes_in_flight_ -= bytes;
+    memory_available_.notify_all();
+    throw;
+  }
+
+  std::shared_future<Disposition> result = task.disposition.get_future().share();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push_back(std::move(task));
+  }
+
+  task_available_.notify_one();
+
+  return result;
+}
+
+void HostVerificationQueue::worker_loop_() {
+
+  while (true) {
+
+    Task task;
+
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_available_.wait(lock, [&] { return stop_ || !tasks_.empty(); });
+
+      // Queued jobs are drained before stopping
+      if (tasks_.empty()) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    // Release the snapshots before publishing the result, so they are freed once the consumer
+    // observes it. Exceptions are rethrown by the consumer.
+    try {
+      Disposition disposition = task.job();
+      task.job = nullptr;
+      task.disposition.set_value(disposition);
+    }
+    catch (...) {
+      task.job = nullptr;
+      task.disposition.set_exception(std::current_exception());
+    }
+
+    size_t bytes = task.bytes;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      bytes_in_flight_ -= bytes;
+    }
+
+    memory_available_.notify_all();
+  }
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
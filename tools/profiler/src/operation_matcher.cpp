@@ -0,0 +1,351 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Index of operations matched against the tile and tensor arguments of each problem
+*/
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+
+#include "cutlass/profiler/operation_matcher.h"
+#include "cutlass/profiler/operation_profiler.h"
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Problem space argument names of each OperationMatcher::Field
+char const *kFieldNames[OperationMatcher::kFieldCount] = {
+  "op_class",
+  "inst_m", "inst_n", "inst_k",
+  "cta_m", "cta_n", "cta_k",
+  "cluster_m", "cluster_n", "cluster_k",
+  "stages",
+  "warps_m", "warps_n", "warps_k",
+  "accum"
+};
+
+/// Returns the position of an argument within a problem, or -1 if it is not defined
+int argument_position(ProblemSpace const &problem_space, char const *name) {
+  auto it = problem_space.argument_index_map.find(name);
+  return it == problem_space.argument_index_map.end() ? -1 : int(it->second);
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+OperationMatcher::FieldVector OperationMatcher::fields(library::OperationDescription const &op_desc) {
+
+  library::TileDescription const &tile = op_desc.tile_description;
+
+  return FieldVector{
+    int64_t(tile.math_instruction.opcode_class),
+    tile.math_instruction.instruction_shape.m(),
+    tile.math_instruction.instruction_shape.n(),
+    tile.math_instruction.instruction_shape.k(),
+    tile.threadblock_shape.m(),
+    tile.threadblock_shape.n(),
+    tile.threadblock_shape.k(),
+    tile.cluster_shape.m(),
+    tile.cluster_shape.n(),
+    tile.cluster_shape.k(),
+    tile.threadblock_stages,
+    tile.warp_count.m(),
+    tile.warp_count.n(),
+    tile.warp_count.k(),
+    int64_t(tile.math_instruction.element_accumulator)
+  };
+}
+
+OperationMatcher::OperationMatcher(
+  ProblemSpace const &problem_space,
+  OperationVector const &operations,
+  std::vector<char const *> const &tensor_names,
+  TensorFunction const &tensors
+):
+  operations_(operations) {
+
+  for (int field = 0; field < kFieldCount; ++field) {
+    field_index_[field] = argument_position(problem_space, kFieldNames[field]);
+  }
+
+  for (char const *name : tensor_names) {
+    int position = argument_position(problem_space, name);
+    if (position < 0) {
+      throw std::runtime_error("Matched tensor argument is not defined in the problem space");
+    }
+    tensor_index_.push_back(position);
+  }
+
+  // Group operations by tile description and tensor types
+  std::map<std::pair<FieldVector, std::vector<TensorType>>, size_t> bucket_index;
+
+  for (size_t op_idx = 0; op_idx < operations_.size(); ++op_idx) {
+
+    library::OperationDescription const &op_desc = operations_[op_idx]->description();
+
+    std::vector<TensorType> tensor_types;
+    if (!tensor_index_.empty()) {
+      for (library::TensorDescription const &tensor : tensors(op_desc)) {
+        tensor_types.emplace_back(tensor.element, tensor.layout);
+      }
+    }
+
+    auto key = std::make_pair(fields(op_desc), tensor_types);
+    auto it = bucket_index.find(key);
+
+    if (it == bucket_index.end()) {
+      it = bucket_index.emplace(key, buckets_.size()).first;
+      buckets_.push_back(Bucket{std::get<0>(key), std::get<1>(key), {}});
+    }
+
+    buckets_[std::get<1>(*it)].operations.push_back(op_idx);
+  }
+}
+
+/// Parses the tile and tensor arguments of a problem
+OperationMatcher::Filter OperationMatcher::parse(ProblemSpace::Problem const &problem) const {
+
+  Filter filter;
+
+  for (int field = 0; field < kFieldCount; ++field) {
+
+    if (field_index_[field] < 0) {
+      continue;
+    }
+
+    KernelArgument::Value const *value_ptr = problem.at(field_index_[field]).get();
+    bool defined = false;
+
+    if (field == kOpcodeClass) {
+      library::OpcodeClassID opcode_class;
+      if ((defined = arg_as_OpcodeClassID(opcode_class, value_ptr))) {
+        filter.fields[field] = int64_t(opcode_class);
+      }
+    }
+    else if (field == kAccumulator) {
+      library::NumericTypeID numeric_type;
+      if ((defined = arg_as_NumericTypeID(numeric_type, value_ptr))) {
+        filter.fields[field] = int64_t(numeric_type);
+      }
+    }
+    else {
+      defined = arg_as_int(filter.fields[field], value_ptr);
+    }
+
+    if (defined) {
+      filter.mask |= (1u << field);
+    }
+  }
+
+  for (int position : tensor_index_) {
+
+    KernelArgument::Value const *value_ptr = problem.at(position).get();
+
+    if (value_ptr->argument->description->type != ArgumentTypeID::kTensor) {
+      throw std::runtime_error("Kernel argument mismatch");
+    }
+
+    auto const *tensor_ptr = static_cast<TensorArgument::TensorValue const *>(value_ptr);
+
+    if (tensor_ptr->not_null) {
+      filter.tensors.emplace_back(tensor_ptr->desc.element, tensor_ptr->desc.layout);
+    }
+    else {
+      filter.tensors.emplace_back(library::NumericTypeID::kUnknown, library::LayoutTypeID::kUnknown);
+    }
+  }
+
+  return filter;
+}
+
+/// Returns the operations satisfying a filter, in their original order
+OperationMatcher::OperationVector OperationMatcher::match(Filter const &filter) const {
+
+  std::vector<size_t> matched;
+
+  for (Bucket const &bucket : buckets_) {
+
+    bool satisfied = true;
+
+    for (int field = 0; satisfied && field < kFieldCount; ++field) {
+      if ((filter.mask & (1u << field)) && bucket.fields[field] != filter.fields[field]) {
+        satisfied = false;
+      }
+    }
+
+    for (size_t idx = 0; satisfied && idx < filter.tensors.size(); ++idx) {
+
+      TensorType const &constraint = filter.tensors[idx];
+      TensorType const &tensor = bucket.tensors[idx];
+
+      if ((std::get<0>(constraint) != library::NumericTypeID::kUnknown &&
+           std::get<0>(constraint) != std::get<0>(tensor)) ||
+          (std::get<1>(constraint) != library::LayoutTypeID::kUnknown &&
+           std::get<1>(constraint) != std::get<1>(tensor))) {
+        satisfied = false;
+      }
+    }
+
+    if (satisfied) {
+      matched.insert(matched.end(), bucket.operations.begin(), bucket.operations.end());
+    }
+  }
+
+  std::sort(matched.begin(), matched.end());
+
+  OperationVector result;
+  result.reserve(matched.size());
+
+  for (size_t op_idx : matched) {
+    result.push_back(operations_[op_idx]);
+  }
+
+  return result;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns true if the current operation description satisfies the problem space
+bool OperationProfiler::satisfies(
+  library::OperationDescription const &op_desc,
+  ProblemSpace const &problem_space,
+  ProblemSpace::Problem const &problem) {
+
+  library::OpcodeClassID opcode_class;
+  if (arg_as_OpcodeClassID(opcode_class, "op_class", problem_space, problem)) {
+    if (opcode_class != op_desc.tile_description.math_instruction.opcode_class) {
+      return false;
+    }
+  }
+  int64_t int_value;
+
+  if (arg_as_int(int_value, "inst_m", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.math_instruction.instruction_shape.m()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "inst_n", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.math_instruction.instruction_shape.n()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "inst_k", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.math_instruction.instruction_shape.k()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "cta_m", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.threadblock_shape.m()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "cta_n", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.threadblock_shape.n()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "cta_k", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.threadblock_shape.k()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "cluster_m", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.cluster_shape.m()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "cluster_n", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.cluster_shape.n()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "cluster_k", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.cluster_shape.k()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "stages", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.threadblock_stages) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "warps_m", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.warp_count.m()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "warps_n", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.warp_count.n()) != int_value) {
+      return false;
+    }
+  }
+
+  if (arg_as_int(int_value, "warps_k", problem_space, problem)) {
+    if (int64_t(op_desc.tile_description.warp_count.k()) != int_value) {
+      return false;
+    }
+  }
+
+  library::NumericTypeID numeric_type;
+  if (arg_as_NumericTypeID(numeric_type, "accum", problem_space, problem)) {
+    if (numeric_type != op_desc.tile_description.math_instruction.element_accumulator) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,8 @@
 */
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <stdexcept>
 #include <iomanip>
 #include <cstring>
@@ -52,6 +54,7 @@
 #include "cutlass/profiler/gpu_timer.h"
 
 #include "cutlass/trace.h"
+#include "cutlass/util/host_parallel.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -60,7 +63,8 @@ namespace profiler {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-OperationProfiler::OperationProfiler(): kind_(library::OperationKind::kInvalid) { }
+OperationProfiler::OperationProfiler():
+  kind_(library::OperationKind::kInvalid), last_measurement_duration_(0) { }
 
 /// Ctor
 OperationProfiler::OperationProfiler(
@@ -69,7 +73,7 @@ OperationProfiler::OperationProfiler(
   ArgumentDescriptionVector const &arguments,
   ProviderVector const & verification_providers
 ):
-  kind_(kind), arguments_(arguments) {
+  kind_(kind), arguments_(arguments), last_measurement_duration_(0) {
 
   ArgumentDescriptionVector tile_description_arguments{
     {ArgumentTypeID::kEnumerated, {"op_class", "opcode-class"}, "Class of math instruction (simt, tensorop, wmmatensorop, wmma)"},
@@ -151,108 +155,6 @@ void OperationProfiler::print_usage(std::ostream &out) const {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-/// Returns true if the current operation description satisfies the problem space
-bool OperationProfiler::satisfies(
-  library::OperationDescription const &op_desc,
-  ProblemSpace const &problem_space,
-  ProblemSpace::Problem const &problem) {
-
-  library::OpcodeClassID opcode_class;
-  if (arg_as_OpcodeClassID(opcode_class, "op_class", problem_space, problem)) {
-    if (opcode_class != op_desc.tile_description.math_instruction.opcode_class) {
-      return false;
-    }
-  }
-  int64_t int_value;
-
-  if (arg_as_int(int_value, "inst_m", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.math_instruction.instruction_shape.m()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "inst_n", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.math_instruction.instruction_shape.n()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "inst_k", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.math_instruction.instruction_shape.k()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "cta_m", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.threadblock_shape.m()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "cta_n", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.threadblock_shape.n()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "cta_k", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.threadblock_shape.k()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "cluster_m", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.cluster_shape.m()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "cluster_n", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.cluster_shape.n()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "cluster_k", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.cluster_shape.k()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "stages", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.threadblock_stages) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "warps_m", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.warp_count.m()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "warps_n", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.warp_count.n()) != int_value) {
-      return false;
-    }
-  }
-
-  if (arg_as_int(int_value, "warps_k", problem_space, problem)) {
-    if (int64_t(op_desc.tile_description.warp_count.k()) != int_value) {
-      return false;
-    }
-  }
-
-  library::NumericTypeID numeric_type;
-  if (arg_as_NumericTypeID(numeric_type, "accum", problem_space, problem)) {
-    if (numeric_type != op_desc.tile_description.math_instruction.element_accumulator) {
-      return false;
-    }
-  }
-
-  return true;
-}
-
 #if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
 
 std::ostream& operator<<(std::ostream& out, library::Provider provider) {
@@ -321,6 +223,89 @@ std::ostream& operator<<(std::ostream& out, library::OperationKind provider) {
 
 #endif // defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
 
+/// Returns the operations of this kind which run on the device and pass the name filters
+OperationMatcher::OperationVector OperationProfiler::candidate_operations_(
+  Options const &options,
+  library::Manifest const &manifest) {
+
+  OperationMatcher::OperationVector candidates;
+
+  for (auto const& operation_ptr : manifest) {
+
+    library::Operation const *operation = operation_ptr.get();
+#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
+    std::cerr << "  Operation: " << typeid(*operation).name() << "\n"
+              << "    name: " << operation->description().name << "\n"
+              << "    kind: " << operation->description().kind << "\n"
+              << "    provider: " << operation->description().provider << "\n";
+#endif // CUTLASS_DEBUG_TRACE_LEVEL
+
+    auto min_cc = operation->description().tile_description.minimum_compute_capability;
+    auto max_cc = operation->description().tile_description.maximum_compute_capability;
+
+#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
+    std::cerr << "    min_cc: " << min_cc << "\n";
+    std::cerr << "    max_cc: " << min_cc << "\n";
+#endif
+
+#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
+    if (operation->description().kind != kind_) {
+      std::cerr << "    @ kind " << operation->description().kind
+                << " != kind_ " << kind_ << "\n";
+    }
+    if (operation->description().provider != library::Provider::kCUTLASS) {
+      std::cerr << "    @ provider " << operation->description().provider
+                << " != library::Provider::kCUTLASS\n";
+    }
+    if (options.device.compute_capability() < min_cc) {
+      std::cerr << "    @ compute_capability "
+                << options.device.compute_capability()
+                << " < min_cc " << min_cc << "\n";
+    }
+    if (options.device.compute_capability() > max_cc) {
+      std::cerr << "    @ compute_capability "
+                << options.device.compute_capability()
+                << " > max_cc " << max_cc << "\n";
+    }
+#endif
+
+    // Execute compatible cutlass operations if they satisfy the current device's compute capability
+    if (operation->description().kind != kind_ ||
+        operation->description().provider != library::Provider::kCUTLASS ||
+        options.device.compute_capability() < min_cc ||
+        options.device.compute_capability() > max_cc) {
+      continue;
+    }
+
+    std::string operation_name(operation->description().name);
+
+    // Filter kernels by name
+    bool filtered_by_name = options.operation_names.empty();
+    if (!filtered_by_name) {
+
+      for (auto const & op_name : options.operation_names) {
+        if (find_string_matches_(op_name, operation_name)) {
+          filtered_by_name = true;
+          break;
+        }
+      }
+    }
+
+    for (auto const & op_name : options.excluded_operation_names) {
+      if (find_string_matches_(op_name, operation_name)) {
+        filtered_by_name = false;
+        break;
+      }
+    }
+
+    if (filtered_by_name) {
+      candidates.push_back(operation);
+    }
+  }
+
+  return candidates;
+}
+
 /// Entry point to profile all operations in the manifest
 int OperationProfiler::profile_all(
   Options const &options,
@@ -331,95 +316,105 @@ int OperationProfiler::profile_all(
   // 1. Construct performance report
   PerformanceReport report(options, problem_space.argument_names(), kind_);
 
-  // 2. For each problem in problem space
-  ProblemSpace::Iterator problem_it = problem_space.begin();
-  ProblemSpace::Iterator problem_end = problem_space.end();
+  // Device, kind and name filters do not depend on the problem and are applied once. The
+  // remaining operations are indexed by their tile description and tensor types.
+  OperationMatcher matcher(
+    problem_space,
+    candidate_operations_(options, manifest),
+    matched_tensor_names(),
+    [this](library::OperationDescription const &op_desc) {
+      return matched_tensors(op_desc);
+    });
 
   bool continue_profiling = true;
   int retval = 0;
 
-  // For each problem in problem space
-  for (; continue_profiling && problem_it != problem_end; ++problem_it) {
-    ProblemSpace::Problem problem = problem_it.at();
-    report.next_problem();
+  // The fastest operation for each problem is merged into the tuning database, if one is given
+  library::TuningDatabase tuning_db;
+  bool tuning_db_enabled = !options.report.tuning_db_path.empty();
+  bool tuning_db_updated = false;
 
-    // For each operation in manifest
-    int matched_operation_count = 0;
-    for (auto const& operation_ptr : manifest) {
+  if (tuning_db_enabled && std::ifstream(options.report.tuning_db_path).good()) {
+    if (tuning_db.load(options.report.tuning_db_path) != Status::kSuccess) {
+      std::cerr << "Could not read tuning database at path '"
+        << options.report.tuning_db_path << "'. It will not be updated." << std::endl;
+      tuning_db_enabled = false;
+    }
+  }
 
-      library::Operation const *operation = operation_ptr.get();
-#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
-      std::cerr << "  Operation: " << typeid(*operation).name() << "\n"
-                << "    name: " << operation->description().name << "\n"
-                << "    kind: " << operation->description().kind << "\n"
-                << "    provider: " << operation->description().provider << "\n";
-#endif // CUTLASS_DEBUG_TRACE_LEVEL
+  // Operation and problem pairs recorded in the report of an earlier run are skipped
+  Checkpoint checkpoint;
+  size_t skipped_count = 0;
+
+  if (!options.report.resume_path.empty()) {
+    if (!checkpoint.load(options.report.resume_path, kind_, problem_space.argument_names())) {
+      std::cerr << "Could not read report at path '" << checkpoint.file_name()
+        << "' to resume from." << std::endl;
+      return 1;
+    }
+  }
 
-      auto min_cc = operation->description().tile_description.minimum_compute_capability;
-      auto max_cc = operation->description().tile_description.maximum_compute_capability;
+  // Ordinal of the current (operation, problem) pair, which determines its shard
+  size_t pair_ordinal = 0;
 
-#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
-      std::cerr << "    min_cc: " << min_cc << "\n";
-      std::cerr << "    max_cc: " << min_cc << "\n";
-#endif
+  // Host reference verification overlaps with profiling of subsequent operations. With
+  // --verification-required it stays synchronous, as whether a verification ran must be known
+  // before the operation is profiled.
+  if (options.verification.enabled && options.verification.host_threads > 0 &&
+      !options.verification.required &&
+      options.verification.provider_enabled(library::Provider::kReferenceHost)) {
 
-      // Clear named allocations
-      device_context.free();
+    host_verification_queue_.reset(new HostVerificationQueue(
+      options.verification.host_threads,
+      size_t(std::max(options.verification.host_memory, 0)) << 20));
+  }
 
-#if defined(CUTLASS_DEBUG_TRACE_LEVEL) && (CUTLASS_DEBUG_TRACE_LEVEL > 1)
-      if (operation->description().kind != kind_) {
-        std::cerr << "    @ kind " << operation->description().kind
-                  << " != kind_ " << kind_ << "\n";
-      }
-      if (operation->description().provider != library::Provider::kCUTLASS) {
-        std::cerr << "    @ provider " << operation->description().provider
-                  << " != library::Provider::kCUTLASS\n";
-      }
-      if (options.device.compute_capability() < min_cc) {
-        std::cerr << "    @ compute_capability "
-                  << options.device.compute_capability()
-                  << " < min_cc " << min_cc << "\n";
-      }
-      if (options.device.compute_capability() > max_cc) {
-        std::cerr << "    @ compute_capability "
-                  << options.device.compute_capability()
-                  << " > max_cc " << max_cc << "\n";
+  library::TuningDatabase *tuning_db_ptr = tuning_db_enabled ? &tuning_db : nullptr;
+
+  // 2. For each block of problems in problem space, enumerate and match problems in parallel
+  size_t const kProblemBlockSize = 4096;
+  size_t problem_count = problem_space.size();
+
+  for (size_t block_begin = 0; continue_profiling && block_begin < problem_count; block_begin += kProblemBlockSize) {
+
+    size_t block_size = (std::min)(kProblemBlockSize, problem_count - block_begin);
+
+    std::vector<ProblemSpace::Problem> problems(block_size);
+    std::vector<OperationMatcher::OperationVector> matched_operations(block_size);
+
+    host_parallel_for(0, int64_t(block_size), 64, [&](int64_t chunk_begin, int64_t chunk_end) {
+      ProblemSpace::Iterator problem_it(problem_space, block_begin + size_t(chunk_begin));
+      for (int64_t idx = chunk_begin; idx < chunk_end; ++idx, ++problem_it) {
+        problems[idx] = problem_it.at();
+        matched_operations[idx] = matcher.match(problems[idx]);
       }
-#endif
+    });
 
-      // Execute compatible cutlass operations if they satisfy the current device's compute capability
-      if (operation->description().kind == kind_ &&
-          operation->description().provider == library::Provider::kCUTLASS &&
-          options.device.compute_capability() >= min_cc &&
-          options.device.compute_capability() <= max_cc) {
+    // For each problem in the block
+    for (size_t problem_idx = 0; continue_profiling && problem_idx < block_size; ++problem_idx) {
+      ProblemSpace::Problem const &problem = problems[problem_idx];
+      report.next_problem();
 
-        std::string operation_name(operation->description().name);
-        // Filter kernels by name
-        bool filtered_by_name = options.operation_names.empty();
-        if (!filtered_by_name) {
-
-          for (auto const & op_name : options.operation_names) {
-            if (find_string_matches_(op_name, operation_name)) {
-              filtered_by_name = true;
-              break;
-            }
-          }
-        }
+      // Results held back for earlier problems may be complete by now, and with them the problems
+      report_pending_results_(report, tuning_db_ptr, tuning_db_updated, false);
 
-        for (auto const & op_name : options.excluded_operation_names) {
-          if (find_string_matches_(op_name, operation_name)) {
-            filtered_by_name = false;
-            break;
-          }
-        }
+      // For each operation matching the problem
+      int matched_operation_count = 0;
+      for (library::Operation const *operation : matched_operations[problem_idx]) {
 
-        if (!filtered_by_name || !satisfies(operation->description(), problem_space, problem)) {
-          continue;
-        }
+        std::string operation_name(operation->description().name);
+
+        // Clear named allocations
+        device_context.free();
 
         // we have found a kernel match, so increment the counter for match kernels
         ++matched_operation_count;
 
+        // Pairs belonging to other shards are profiled by other processes
+        if (!options.profiling.in_shard(pair_ordinal++)) {
+          continue;
+        }
+
         // A. Initialize configuration
         Status status = this->initialize_configuration(
           options,
@@ -429,12 +424,18 @@ int OperationProfiler::profile_all(
           problem_space,
           problem);
 
+        // The configured result identifies the pair exactly as the report recorded it
+        if (status == Status::kSuccess && checkpoint.contains(model_result_)) {
+          ++skipped_count;
+          continue;
+        }
+
         if (status == Status::kErrorInternal) {
 
           // If there was an internal error, consume the CUDA error and move to the next operation.
           (void)cudaGetLastError();
 
-          report.append_results(results_);
+          report_results_(options, report, operation, tuning_db_ptr, tuning_db_updated);
           continue;
         }
         else if (status != Status::kSuccess) {
@@ -463,7 +464,7 @@ int OperationProfiler::profile_all(
             // If there was an internal error, consume the CUDA error and move to the next operation.
             (void)cudaGetLastError();
 
-            report.append_results(results_);
+            report_results_(options, report, operation, tuning_db_ptr, tuning_db_updated);
             continue;
           }
           else if (status != Status::kSuccess) {
@@ -492,8 +493,7 @@ int OperationProfiler::profile_all(
         }
 
         if (options.execution_mode == ExecutionMode::kDryRun) {
-          report.append_results(results_);
-          results_.clear();
+          report_results_(options, report, operation, tuning_db_ptr, tuning_db_updated);
           continue;
         }
 
@@ -524,25 +524,200 @@ int OperationProfiler::profile_all(
             problem);
         }
 
-        report.append_results(results_);
-        results_.clear();
+        report_results_(options, report, operation, tuning_db_ptr, tuning_db_updated);
+
+        if (!continue_profiling) {
+          break;
+        }
+      }
+
+      // If we did not find any kernels that match our filters and error_on_no_match was set, report an error
+      if (options.profiling.error_on_no_match && matched_operation_count <= 0) {
+        #if !NDEBUG
+        std::cout << "Error: No matching kernels found with kernel selection filters [--error_on_no_match]" << std::endl;
+        #endif
+        retval = 1;
       }
+    }
+  }
 
-      if (!continue_profiling) {
-        break;
+  // Wait for outstanding host verifications and report their results
+  report_pending_results_(report, tuning_db_ptr, tuning_db_updated, true);
+  host_verification_queue_.reset();
+
+  if (skipped_count && options.report.verbose) {
+    std::cout << "\nSkipped " << skipped_count << " operation and problem pairs recorded in '"
+      << checkpoint.file_name() << "'" << std::endl;
+  }
+
+  if (tuning_db_updated && tuning_db.save(options.report.tuning_db_path) != Status::kSuccess) {
+    std::cerr << "Could not write tuning database at path '"
+      << options.report.tuning_db_path << "'" << std::endl;
+    retval = 1;
+  }
+
+  return retval;
+}
+
+/// Hands results_ to the report, or holds them until their deferred verifications complete
+void OperationProfiler::report_results_(
+  Options const &options,
+  PerformanceReport &report,
+  library::Operation const *operation,
+  library::TuningDatabase *tuning_db,
+  bool &tuning_db_updated) {
+
+  PendingResults pending;
+  pending.problem_index = report.problem_index();
+
+  for (auto &result : results_) {
+
+    result.problem_index = report.problem_index();
+
+    // Tuning records describe the current problem and are built now. They are inserted once the
+    // disposition of the result is final.
+    library::TuningRecord record;
+    bool has_record = tuning_db && tuning_record(options, operation, result, record);
+    pending.tuning_records.emplace_back(has_record, record);
+  }
+
+  pending.results = std::move(results_);
+  pending.verifications = std::move(deferred_verifications_);
+
+  results_.clear();
+  deferred_verifications_.clear();
+
+  pending_results_.push_back(std::move(pending));
+
+  report_pending_results_(report, tuning_db, tuning_db_updated, false);
+}
+
+/// Reports held results whose verifications completed, in order
+void OperationProfiler::report_pending_results_(
+  PerformanceReport &report,
+  library::TuningDatabase *tuning_db,
+  bool &tuning_db_updated,
+  bool wait) {
+
+  while (!pending_results_.empty()) {
+
+    PendingResults &pending = pending_results_.front();
+
+    bool ready = true;
+    if (!wait) {
+      for (auto const &verification : pending.verifications) {
+        if (verification.disposition.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+          ready = false;
+          break;
+        }
       }
     }
 
-    // If we did not find any kernels that match our filters and error_on_no_match was set, report an error
-    if (options.profiling.error_on_no_match && matched_operation_count <= 0) {
-      #if !NDEBUG
-      std::cout << "Error: No matching kernels found with kernel selection filters [--error_on_no_match]" << std::endl;
-      #endif
-      retval = 1;
+    if (!ready) {
+      break;
     }
+
+    for (auto const &verification : pending.verifications) {
+
+      Disposition disposition = Disposition::kFailed;
+      try {
+        disposition = verification.disposition.get();
+      }
+      catch (...) { }
+
+      PerformanceResult &result = pending.results.at(verification.result_index);
+      result.verification_map[verification.provider] = disposition;
+      update_disposition_(result);
+    }
+
+    for (size_t idx = 0; idx < pending.results.size(); ++idx) {
+      if (pending.tuning_records[idx].first && is_tuning_candidate(pending.results[idx])) {
+        tuning_db_updated |= tuning_db->insert(pending.tuning_records[idx].second);
+      }
+    }
+
+    report.append_deferred_results(pending.results);
+    pending_results_.pop_front();
   }
 
-  return retval;
+  // Problems before the oldest held result and before the current problem receive no more results
+  report.complete_problems(pending_results_.empty() ?
+    report.problem_index() : pending_results_.front().problem_index);
+}
+
+/// Returns true if host reference verification of the current operation may run in the background
+bool OperationProfiler::host_verification_deferred_(Options const &options) const {
+  return host_verification_queue_ && options.verification.save_workspace != SaveWorkspace::kIncorrect;
+}
+
+/// Verifies the last result with the host reference in the background
+void OperationProfiler::defer_host_verification_(
+  size_t bytes,
+  HostVerificationQueue::JobFactory const &factory) {
+
+  DeferredVerification verification;
+  verification.result_index = results_.size() - 1;
+  verification.provider = library::Provider::kReferenceHost;
+  verification.disposition = host_verification_queue_->submit(bytes, factory);
+
+  // Placeholder until the outcome is known. No queue exists with --verification-required, so the
+  // placeholder is never mistaken for a verification that ran.
+  results_.back().verification_map[verification.provider] = Disposition::kNotVerified;
+
+  deferred_verifications_.push_back(verification);
+}
+
+/// Sets the disposition of a verified result to the worst outcome among its verification providers
+void OperationProfiler::update_disposition_(PerformanceResult &result) {
+
+  bool is_any_verification_run_passed = false;
+
+  for (auto &m : result.verification_map) {
+    if (m.second == Disposition::kFailed || m.second == Disposition::kIncorrect) {
+      result.disposition = m.second;
+      return;
+    }
+    if (m.second == Disposition::kPassed) {
+      is_any_verification_run_passed = true;
+    }
+  }
+
+  if (is_any_verification_run_passed) {
+    result.disposition = Disposition::kPassed;
+  }
+}
+
+/// Describes a profiled result of the current problem for the tuning database
+bool OperationProfiler::tuning_record(
+  Options const &options,
+  library::Operation const *operation,
+  PerformanceResult const &result,
+  library::TuningRecord &record) const {
+
+  return false;
+}
+
+/// Names of tensor arguments compared with operation tensor descriptions before configuration
+std::vector<char const *> OperationProfiler::matched_tensor_names() const {
+  return {};
+}
+
+/// Tensor descriptions of an operation in the order of matched_tensor_names()
+std::vector<library::TensorDescription> OperationProfiler::matched_tensors(
+  library::OperationDescription const &op_desc) const {
+
+  return {};
+}
+
+/// Returns true if a result is correct and timed, and thus eligible for the tuning database
+bool OperationProfiler::is_tuning_candidate(PerformanceResult const &result) {
+  return result.provider == library::Provider::kCUTLASS &&
+    result.status == Status::kSuccess &&
+    result.good() &&
+    result.disposition != Disposition::kFailed &&
+    result.disposition != Disposition::kIncorrect &&
+    result.disposition != Disposition::kInvalidProblem &&
+    result.disposition != Disposition::kNotSupported;
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -640,75 +815,134 @@ void OperationProfiler::save_workspace(
 
 /// Method to profile a CUTLASS Operation
 Status OperationProfiler::profile_cutlass_(
-  double &runtime,
+  PerformanceResult &result,
   Options const &options,
   library::Operation const *operation,
   void *arguments,
   void *host_workspace,
   void *device_workspace) {
 
+  return profile_kernel_(result, options, [&](int) {
+    return operation->run(
+      arguments,
+      host_workspace,
+      device_workspace);
+  });
+}
+
+/// Runs warmup and timed launches and records runtime statistics
+Status OperationProfiler::profile_kernel_(
+  PerformanceResult &result,
+  Options const &options,
+  std::function<Status (int)> const &launch) {
+
   GpuTimer timer;
 
   //
-  // Optional sleep to limit power consumption and thermals
+  // Optional sleep to limit power consumption and thermals. Adaptive measurement sleeps no
+  // longer than the previous measurement lasted so short kernels do not wait on long pauses.
   //
 
-  sleep(options.profiling.sleep_duration);
+  int sleep_duration = options.profiling.sleep_duration;
+
+  if (options.profiling.adaptive()) {
+    sleep_duration = (std::min)(sleep_duration, int(std::ceil(last_measurement_duration_)));
+  }
+
+  sleep(sleep_duration);
 
   //
   // Warmup loop
   //
 
-  Status status;
+  Status status = Status::kSuccess;
 
-  for (int iteration = 0; iteration < options.profiling.warmup_iterations; ++iteration) {
+  int launch_idx = 0;
+  for (; launch_idx < options.profiling.warmup_iterations; ++launch_idx) {
 
-    status = operation->run(
-      arguments,
-      host_workspace,
-      device_workspace);
+    status = launch(launch_idx);
 
     if (status != Status::kSuccess) {
       return status;
     }
   }
 
-  //
-  // Initialize GPU timer
-  //
+  if (!options.profiling.adaptive()) {
 
-  timer.start();
+    //
+    // Profiling loop with a fixed number of iterations
+    //
 
-  //
-  // Profiling loop
-  //
-
-  int Iterations = options.profiling.iterations;
+    timer.start();
 
-  int iteration = 0;
-  for (; iteration < Iterations; ++iteration) {
+    int iteration = 0;
+    for (; iteration < options.profiling.iterations; ++iteration) {
 
-    status = operation->run(
-      arguments,
-      host_workspace,
-      device_workspace);
+      status = launch(launch_idx++);
 
-    if (status != Status::kSuccess) {
-      return status;
+      if (status != Status::kSuccess) {
+        return status;
+      }
     }
+
+    timer.stop_and_wait();
+
+    result.runtime = timer.duration(iteration);
+    result.iterations = iteration;
+    result.runtime_statistics = RuntimeStatistics::compute({result.runtime});
+
+    return status;
   }
 
   //
-  // Wait for completion
+  // Adaptive profiling loop: time batches of launches until the mean is known to the requested
+  // relative error or the wall-clock budget is spent
   //
 
+  auto start = std::chrono::steady_clock::now();
+
+  auto elapsed = [&start]() {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  };
+
+  AdaptiveMeasurement measurement(options.profiling.relative_error, options.profiling.duration);
+
+  // A single launch sizes the batches so that each sample amortizes the event overhead
+  timer.start();
+
+  status = launch(launch_idx++);
+
+  if (status != Status::kSuccess) {
+    return status;
+  }
+
   timer.stop_and_wait();
 
-  //
-  // Update performance result
-  //
+  measurement.calibrate(timer.duration());
+
+  while (!measurement.done(elapsed())) {
+
+    timer.start();
+
+    for (int iteration = 0; iteration < measurement.batch_size(); ++iteration) {
+
+      status = launch(launch_idx++);
+
+      if (status != Status::kSuccess) {
+        return status;
+      }
+    }
+
+    timer.stop_and_wait();
+
+    measurement.append(timer.duration());
+  }
+
+  last_measurement_duration_ = elapsed();
 
-  runtime = timer.duration(iteration);
+  result.runtime_statistics = measurement.statistics();
+  result.runtime = result.runtime_statistics.mean;
+  result.iterations = measurement.iterations();
 
   return status;
 }
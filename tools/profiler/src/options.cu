@@ -33,6 +33,8 @@
 */
 
 #include <algorithm>
+#include <sstream>
+#include <stdexcept>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/version.h"
@@ -399,8 +401,27 @@ Options::Profiling::Profiling(cutlass::CommandLine const &cmdline) {
   cmdline.get_cmd_line_argument("workspace-count", workspace_count, 0);  
   cmdline.get_cmd_line_argument("warmup-iterations", warmup_iterations, 10);
   cmdline.get_cmd_line_argument("profiling-iterations", iterations, 100);
+  cmdline.get_cmd_line_argument("profiling-duration", duration, 500);
+  cmdline.get_cmd_line_argument("profiling-error", relative_error, 0.01);
   cmdline.get_cmd_line_argument("sleep-duration", sleep_duration, 50);
   cmdline.get_cmd_line_argument("profiling-enabled", enabled, true);
+
+  shard_index = 0;
+  shard_count = 1;
+
+  if (cmdline.check_cmd_line_flag("shard")) {
+
+    std::string shard;
+    cmdline.get_cmd_line_argument("shard", shard);
+
+    char separator = 0;
+    std::stringstream ss(shard);
+    ss >> shard_index >> separator >> shard_count;
+
+    if (ss.fail() || separator != '/' || shard_count < 1 || shard_index < 0 || shard_index >= shard_count) {
+      throw std::runtime_error("Invalid --shard=" + shard + ". Expected <index>/<count> with 0 <= index < count.");
+    }
+  }
   
   if (cmdline.check_cmd_line_flag("providers")) {
 
@@ -431,7 +452,17 @@ void Options::Profiling::print_usage(std::ostream &out) const {
 
     << "  --profiling-iterations=<iterations>          "
     << "    Number of iterations to profile each kernel. If zero, kernels" << end_of_line
-    << "      are launched up to the profiling duration.\n\n"
+    << "      are timed in batches of back-to-back launches until the confidence" << end_of_line
+    << "      interval of the mean runtime is within --profiling-error or up to the" << end_of_line
+    << "      profiling duration. Runtime percentiles and stddev describe the mean" << end_of_line
+    << "      launch runtime of each batch, not of individual launches.\n\n"
+
+    << "  --profiling-duration=<duration>              "
+    << "    Wall-clock budget to profile each kernel if --profiling-iterations=0 (ms).\n\n"
+
+    << "  --profiling-error=<error>                    "
+    << "    Target half-width of the 95% confidence interval of the mean runtime," << end_of_line
+    << "      relative to the mean, if --profiling-iterations=0.\n\n"
 
     << "  --warmup-iterations=<iterations>             "
     << "    Number of iterations to execute each kernel prior to profiling.\n\n"
@@ -442,6 +473,10 @@ void Options::Profiling::print_usage(std::ostream &out) const {
     << "  --profiling-enabled=<bool>                   "
     << "    If true, profiling is actually conducted.\n\n"
 
+    << "  --shard=<index>/<count>                      "
+    << "    Profiles only every count-th (operation, problem) pair, starting with the index-th." << end_of_line
+    << "      The partition is deterministic, so reports of all shards may be concatenated.\n\n"
+
   ;
 }
 
@@ -449,8 +484,11 @@ void Options::Profiling::print_options(std::ostream &out, int indent) const {
 
   out
     << indent_str(indent) << "profiling_iterations: " << iterations << "\n"
+    << indent_str(indent) << "profiling_duration: " << duration << "\n"
+    << indent_str(indent) << "profiling_error: " << relative_error << "\n"
     << indent_str(indent) << "sleep_duration: " << sleep_duration << "\n"
     << indent_str(indent) << "profiling_enabled: " << enabled << "\n"
+    << indent_str(indent) << "shard: " << shard_index << "/" << shard_count << "\n"
     << indent_str(indent) << "providers: [";
 
   int j = 0;
@@ -499,6 +537,9 @@ Options::Verification::Verification(cutlass::CommandLine const &cmdline) {
     save_workspace = SaveWorkspace::kNever;
   }
 
+  cmdline.get_cmd_line_argument("verification-host-threads", host_threads, 1);
+  cmdline.get_cmd_line_argument("verification-host-memory", host_memory, 4096);
+
   if (cmdline.check_cmd_line_flag("verification-providers")) {
     
     std::vector<std::string> tokens;
@@ -541,6 +582,16 @@ void Options::Verification::print_usage(std::ostream &out) const {
     << "       --save-workspace=incorrect  save workspace for incorrect results" << end_of_line
     << "       --save-workspace=always     always save workspace\n\n"
 
+    << "  --verification-host-threads=<int>            "
+    << "    Number of background threads running host reference verification while the next" << end_of_line
+    << "      operation is profiled. This is the default whenever the host reference verifies results;" << end_of_line
+    << "      results are then reported once verified, possibly after later problems have started." << end_of_line
+    << "      If zero, or with --verification-required, the host reference runs before profiling. (default: 1)\n\n"
+
+    << "  --verification-host-memory=<MiB>             "
+    << "    Bound on host memory held by tensor snapshots awaiting host reference verification." << end_of_line
+    << "      Profiling waits for queued verifications when it is reached. (default: 4096)\n\n"
+
     << "  --verification-providers=<providers>         "
     << "    List of providers used to verify result. (default: '*')" << end_of_line
     << "      Gemm verification-providers {cublas*}" << end_of_line
@@ -554,6 +605,8 @@ void Options::Verification::print_options(std::ostream &out, int indent) const {
     << indent_str(indent) << "verification_enabled: " << enabled << "\n"
     << indent_str(indent) << "epsilon: " << epsilon << "\n"
     << indent_str(indent) << "save_workspace: " << to_string(save_workspace) << "\n"
+    << indent_str(indent) << "verification_host_threads: " << host_threads << "\n"
+    << indent_str(indent) << "verification_host_memory: " << host_memory << "\n"
     << indent_str(indent) << "verification_providers: [";
 
   int j = 0;
@@ -587,6 +640,9 @@ Options::Report::Report(cutlass::CommandLine const &cmdline) {
   cmdline.get_cmd_line_argument("append", append, false);
   cmdline.get_cmd_line_argument("output", output_path);
   cmdline.get_cmd_line_argument("junit-output", junit_output_path);
+  cmdline.get_cmd_line_argument("columnar-output", columnar_output_path);
+  cmdline.get_cmd_line_argument("resume", resume_path);
+  cmdline.get_cmd_line_argument("tuning-db", tuning_db_path);
  
   if (cmdline.check_cmd_line_flag("tags")) {
     cmdline.get_cmd_line_argument_pairs("tags", pivot_tags);
@@ -615,6 +671,18 @@ void Options::Report::print_usage(std::ostream &out) const {
     << "  --junit-output=<path>                        "
     << "    Path to junit output file for result reporting. Operation kind and '.junit.xml' is appended.\n\n"
 
+    << "  --columnar-output=<path>                     "
+    << "    Path to columnar binary output file, written one row group per problem. Operation kind" << end_of_line
+    << "      and '.ccr' is appended. See cutlass/util/columnar_report.h for the format and a reader.\n\n"
+
+    << "  --resume=<path>                              "
+    << "    Path to a report of an earlier run, given as for --output or --columnar-output. Operation" << end_of_line
+    << "      and problem pairs recorded in it are skipped. Typically used with --append=true.\n\n"
+
+    << "  --tuning-db=<path>                           "
+    << "    Path to a tuning database. The fastest correct CUTLASS kernel for each problem is merged" << end_of_line
+    << "      into it. library::Handle loads it from the CUTLASS_LIBRARY_TUNING_DB environment variable.\n\n"
+
     << "  --print-kernel-before-running=<bool>                "
     << "    Prints the name of the kernel being profiled before running the kernel." << end_of_line
     << "      This is useful for determining which kernel is causing a run of the profiler to hang\n\n"
@@ -640,6 +708,9 @@ void Options::Report::print_options(std::ostream &out, int indent) const {
     << indent_str(indent) << "append: " << append << "\n"
     << indent_str(indent) << "output: " << output_path << "\n"
     << indent_str(indent) << "junit-output: " << junit_output_path << "\n"
+    << indent_str(indent) << "columnar-output: " << columnar_output_path << "\n"
+    << indent_str(indent) << "resume: " << resume_path << "\n"
+    << indent_str(indent) << "tuning-db: " << tuning_db_path << "\n"
     << indent_str(indent) << "print-kernel-before-running: " << print_kernel_before_running << "\n"
     << indent_str(indent) << "report-not-run: " << report_not_run << "\n"
     << indent_str(indent) << "tags:\n";
@@ -37,6 +37,7 @@
 #include <iomanip>
 #include <algorithm>
 #include <cstring>
+#include <limits>
 
 #include "cutlass/library/util.h"
 
@@ -72,7 +73,7 @@ PerformanceReport::PerformanceReport(
   std::vector<std::string> const &argument_names,
   library::OperationKind const &op_kind
 ):
-  options_(options), argument_names_(argument_names), problem_index_(0), good_(true), op_kind_(op_kind) {
+  options_(options), argument_names_(argument_names), problem_index_(0), columnar_problem_index_(0), good_(true), op_kind_(op_kind) {
 
   // Strip '.csv' if present
   std::string base_path = options_.report.output_path;
@@ -84,6 +85,10 @@ PerformanceReport::PerformanceReport(
   base_path = base_path.substr(0, base_path.rfind(".junit"));
   op_junit_file_name_ = base_path + "." + to_string(op_kind_) + ".junit.xml";
 
+  base_path = options_.report.columnar_output_path;
+  base_path = base_path.substr(0, base_path.rfind(".ccr"));
+  op_columnar_file_name_ = base_path + "." + to_string(op_kind_) + ".ccr";
+
   //
   // Open output file for operation of PerformanceReport::op_kind
   //
@@ -133,16 +138,47 @@ PerformanceReport::PerformanceReport(
 
     print_junit_header_(junit_output_file_);
   }
+
+  if (!options_.report.columnar_output_path.empty()) {
+
+    if (!columnar_output_file_.open(op_columnar_file_name_, columnar_schema_(), options_.report.append)) {
+
+      std::cerr << "Could not open columnar output file at path '"
+         << options_.report.columnar_output_path << "'";
+
+      if (options_.report.append) {
+        std::cerr << ". An existing file must have the same columns to be appended to";
+      }
+
+      std::cerr << std::endl;
+
+      good_ = false;
+    }
+  }
 }
 
 void PerformanceReport::next_problem() {
   ++problem_index_;
 }
 
+void PerformanceReport::complete_problems(size_t problem_index) {
+
+  // Each problem's results form one row group, written once the problem is complete so that an
+  // interrupted run keeps every completed problem
+  if (columnar_output_file_.pending_rows() && columnar_problem_index_ < problem_index) {
+    columnar_output_file_.flush();
+  }
+}
+
 void PerformanceReport::append_result(PerformanceResult result) {
 
   result.problem_index = problem_index_;
 
+  write_result_(result);
+}
+
+void PerformanceReport::write_result_(PerformanceResult const &result) {
+
   if (options_.report.verbose) {
     std::cout << "\n";
     print_result_pretty_(std::cout, result) << std::flush; 
@@ -152,6 +188,17 @@ void PerformanceReport::append_result(PerformanceResult result) {
     print_junit_result_(junit_output_file_, result);
   }
 
+  if (columnar_output_file_.good()) {
+
+    // Results arrive in problem order, so the first result of a problem completes the previous one
+    if (columnar_output_file_.pending_rows() && result.problem_index != columnar_problem_index_) {
+      columnar_output_file_.flush();
+    }
+    columnar_problem_index_ = result.problem_index;
+
+    append_result_columnar_(result);
+  }
+
   if (output_file_.is_open()) {
     print_result_csv_(output_file_, result) << std::endl;
   }
@@ -188,6 +235,17 @@ void PerformanceReport::append_results(PerformanceResultVector const &results) {
   }
 }
 
+void PerformanceReport::append_deferred_results(PerformanceResultVector const &results) {
+
+  if (options_.report.verbose) {
+    std::cout << "\n\n";
+  }
+
+  for (auto const & result : results) {
+    write_result_(result);
+  }
+}
+
 PerformanceReport::~PerformanceReport() {
 
   //
@@ -222,6 +280,11 @@ PerformanceReport::~PerformanceReport() {
     junit_output_file_.close();
     std::cout << "\nWrote jUnit results to '" << op_junit_file_name_ << "'" << std::endl;
   }
+
+  if (columnar_output_file_.good()) {
+    columnar_output_file_.close();
+    std::cout << "\nWrote columnar results to '" << op_columnar_file_name_ << "'" << std::endl;
+  }
 }
 
 static const char *disposition_status_color(Disposition disposition) {
@@ -306,6 +369,13 @@ std::ostream & PerformanceReport::print_result_pretty_(
 
     out
       << "         Runtime: " << result.runtime << "  ms\n"
+      << "      Iterations: " << result.iterations << "\n"
+      << "  Runtime median: " << result.runtime_statistics.median << "  ms"
+      << "  (p10: " << result.runtime_statistics.p10
+      << ", p90: " << result.runtime_statistics.p90
+      << ", stddev: " << result.runtime_statistics.stddev
+      << ", outliers: " << result.runtime_statistics.outliers
+      << " of " << result.runtime_statistics.samples << " batches)\n"
       << "          Memory: " << result.gbytes_per_sec() << " GiB/s\n"
       << "\n            Math: " << result.gflops_per_sec() << " GFLOP/s\n";
 
@@ -340,6 +410,12 @@ std::ostream & PerformanceReport::print_csv_header_(
     << ",Runtime"
     << ",GB/s"
     << ",GFLOPs"
+    << ",Iterations"
+    << ",RuntimeMedian"
+    << ",RuntimeP10"
+    << ",RuntimeP90"
+    << ",RuntimeStddev"
+    << ",RuntimeOutliers"
     ;
 
   return out;
@@ -390,9 +466,93 @@ std::ostream & PerformanceReport::print_result_csv_(
     ); 
   }
 
+  out
+    << "," << result.iterations
+    << "," << result.runtime_statistics.median
+    << "," << result.runtime_statistics.p10
+    << "," << result.runtime_statistics.p90
+    << "," << result.runtime_statistics.stddev
+    << "," << result.runtime_statistics.outliers
+    ;
+
   return out;
 }
 
+/// Returns the columns of the columnar output. They match the CSV columns.
+columnar::Schema PerformanceReport::columnar_schema_() const {
+
+  using columnar::ColumnType;
+
+  columnar::Schema schema;
+
+  for (auto const & tag : options_.report.pivot_tags) {
+    schema.push_back({tag.first, ColumnType::kString});
+  }
+
+  schema.push_back({"Problem", ColumnType::kInt64});
+  schema.push_back({"Provider", ColumnType::kString});
+  schema.push_back({"OperationKind", ColumnType::kString});
+  schema.push_back({"Operation", ColumnType::kString});
+  schema.push_back({"Disposition", ColumnType::kString});
+  schema.push_back({"Status", ColumnType::kString});
+
+  for (auto const &arg_name : argument_names_) {
+    schema.push_back({arg_name, ColumnType::kString});
+  }
+
+  schema.push_back({"Bytes", ColumnType::kInt64});
+  schema.push_back({"Flops", ColumnType::kInt64});
+  schema.push_back({"Flops/Byte", ColumnType::kFloat64});
+  schema.push_back({"Runtime", ColumnType::kFloat64});
+  schema.push_back({"GB/s", ColumnType::kFloat64});
+  schema.push_back({"GFLOPs", ColumnType::kFloat64});
+  schema.push_back({"Iterations", ColumnType::kInt64});
+  schema.push_back({"RuntimeMedian", ColumnType::kFloat64});
+  schema.push_back({"RuntimeP10", ColumnType::kFloat64});
+  schema.push_back({"RuntimeP90", ColumnType::kFloat64});
+  schema.push_back({"RuntimeStddev", ColumnType::kFloat64});
+  schema.push_back({"RuntimeOutliers", ColumnType::kInt64});
+
+  return schema;
+}
+
+/// Appends the result as a row of the columnar output. Throughput of failed runs is NaN.
+void PerformanceReport::append_result_columnar_(PerformanceResult const &result) {
+
+  columnar::Writer &out = columnar_output_file_;
+  size_t column = 0;
+
+  for (auto const & tag : options_.report.pivot_tags) {
+    out.append_string(column++, tag.second);
+  }
+
+  out.append_int64(column++, int64_t(result.problem_index));
+  out.append_string(column++, to_string(result.provider, true));
+  out.append_string(column++, to_string(result.op_kind));
+  out.append_string(column++, result.operation_name);
+  out.append_string(column++, to_string(result.disposition));
+  out.append_string(column++, library::to_string(result.status));
+
+  for (auto const & arg : result.arguments) {
+    out.append_string(column++, arg.second);
+  }
+
+  double const nan = std::numeric_limits<double>::quiet_NaN();
+
+  out.append_int64(column++, result.bytes);
+  out.append_int64(column++, result.flops);
+  out.append_float64(column++, result.bytes ? double(result.flops) / double(result.bytes) : nan);
+  out.append_float64(column++, result.runtime);
+  out.append_float64(column++, result.good() ? result.gbytes_per_sec() : nan);
+  out.append_float64(column++, result.good() ? result.gflops_per_sec() : nan);
+  out.append_int64(column++, result.iterations);
+  out.append_float64(column++, result.runtime_statistics.median);
+  out.append_float64(column++, result.runtime_statistics.p10);
+  out.append_float64(column++, result.runtime_statistics.p90);
+  out.append_float64(column++, result.runtime_statistics.stddev);
+  out.append_int64(column++, int64_t(result.runtime_statistics.outliers));
+}
+
 std::ostream & PerformanceReport::print_junit_header_(std::ostream &out) {
 
   out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << std::endl;
@@ -405,6 +405,29 @@ ProblemSpace::Iterator::Iterator(ProblemSpace const &problem_space) {
   }
 }
 
+ProblemSpace::Iterator::Iterator(ProblemSpace const &problem_space, size_t index) {
+
+  for (auto const & arg_ptr : problem_space.arguments) {
+    construct_(arg_ptr.get());
+  }
+
+  if (index >= problem_space.size()) {
+    move_to_end();
+    return;
+  }
+
+  std::vector<size_t> extents = problem_space.extents();
+
+  for (size_t arg_idx = 0; arg_idx < iterators.size(); ++arg_idx) {
+    size_t digit = index % extents.at(arg_idx);
+    index /= extents.at(arg_idx);
+
+    for (size_t step = 0; step < digit; ++step) {
+      ++(*iterators.at(arg_idx));
+    }
+  }
+}
+
 ProblemSpace::Iterator::Iterator(Iterator && it) {
   iterators = std::move(it.iterators);
 }
@@ -726,6 +749,46 @@ ProblemSpace::Iterator ProblemSpace::end() const {
   return it;
 }
 
+/// Returns the number of values of each argument
+std::vector<size_t> ProblemSpace::extents() const {
+
+  std::vector<size_t> extents;
+  extents.reserve(arguments.size());
+
+  for (auto const & arg_ptr : arguments) {
+    std::unique_ptr<KernelArgument::ValueIterator> it = arg_ptr->begin();
+    std::unique_ptr<KernelArgument::ValueIterator> end = arg_ptr->end();
+
+    size_t extent = 0;
+    for (; !(*it == *end); ++(*it)) {
+      ++extent;
+    }
+
+    // Iterator::operator++() visits an argument without values once, unless it is the last
+    // argument, whose end terminates the enumeration.
+    if (!extent && extents.size() + 1 < arguments.size()) {
+      extent = 1;
+    }
+    extents.push_back(extent);
+  }
+
+  return extents;
+}
+
+/// Returns the number of points in the problem space
+size_t ProblemSpace::size() const {
+
+  if (arguments.empty()) {
+    return 0;
+  }
+
+  size_t size = 1;
+  for (size_t extent : extents()) {
+    size *= extent;
+  }
+  return size;
+}
+
 /// Gets all argument names as an ordered vector
 std::vector<std::string> ProblemSpace::argument_names() const {
 
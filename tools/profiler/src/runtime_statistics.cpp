@@ -0,0 +1,174 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/* \file
+   \brief Summary statistics and stopping rule for adaptive kernel measurement
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "cutlass/profiler/runtime_statistics.h"
+
+namespace cutlass {
+namespace profiler {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/// Linearly interpolated quantile of sorted samples
+double quantile(std::vector<double> const &sorted, double q) {
+  double position = q * double(sorted.size() - 1);
+  size_t lower = size_t(position);
+  size_t upper = std::min(lower + 1, sorted.size() - 1);
+  double fraction = position - double(lower);
+  return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+/// Two-sided 97.5% quantile of Student's t distribution with `dof` degrees of freedom
+double student_t_975(int dof) {
+  static double const kTable[] = {
+    12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+    2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+    2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+  };
+  int const kEntries = int(sizeof(kTable) / sizeof(kTable[0]));
+
+  if (dof < 1) {
+    return INFINITY;
+  }
+  return dof <= kEntries ? kTable[dof - 1] : 1.960;
+}
+
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+RuntimeStatistics RuntimeStatistics::compute(std::vector<double> samples) {
+
+  RuntimeStatistics stats;
+
+  if (samples.empty()) {
+    return stats;
+  }
+
+  std::sort(samples.begin(), samples.end());
+
+  stats.samples = int(samples.size());
+  stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / double(samples.size());
+  stats.median = quantile(samples, 0.5);
+  stats.p10 = quantile(samples, 0.1);
+  stats.p90 = quantile(samples, 0.9);
+
+  if (samples.size() > 1) {
+    double sum_of_squares = 0;
+    for (double sample : samples) {
+      sum_of_squares += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = std::sqrt(sum_of_squares / double(samples.size() - 1));
+  }
+
+  double q1 = quantile(samples, 0.25);
+  double q3 = quantile(samples, 0.75);
+  double lower_fence = q1 - 1.5 * (q3 - q1);
+  double upper_fence = q3 + 1.5 * (q3 - q1);
+
+  stats.outliers = int(std::count_if(samples.begin(), samples.end(), [&](double sample) {
+    return sample < lower_fence || sample > upper_fence;
+  }));
+
+  return stats;
+}
+
+double RuntimeStatistics::confidence_interval() const {
+  if (samples < 2) {
+    return INFINITY;
+  }
+  return student_t_975(samples - 1) * stddev / std::sqrt(double(samples));
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+AdaptiveMeasurement::AdaptiveMeasurement(
+  double relative_error,
+  double budget,
+  double min_sample_duration
+):
+  relative_error_(relative_error),
+  budget_(budget),
+  min_sample_duration_(min_sample_duration),
+  batch_size_(1) { }
+
+void AdaptiveMeasurement::calibrate(double launch_runtime) {
+  if (launch_runtime <= 0) {
+    batch_size_ = kMaxBatchSize;
+  }
+  else {
+    double launches = std::ceil(min_sample_duration_ / launch_runtime);
+    batch_size_ = int(std::min(std::max(launches, 1.0), double(kMaxBatchSize)));
+  }
+}
+
+void AdaptiveMeasurement::append(double batch_runtime) {
+  samples_.push_back(batch_runtime / double(batch_size_));
+}
+
+bool AdaptiveMeasurement::done(double elapsed) const {
+
+  int count = int(samples_.size());
+
+  if (count >= kMaxSamples || (count && elapsed >= budget_)) {
+    return true;
+  }
+
+  if (count < kMinSamples) {
+    return false;
+  }
+
+  RuntimeStatistics stats = statistics();
+  return stats.confidence_interval() <= relative_error_ * stats.mean;
+}
+
+int AdaptiveMeasurement::iterations() const {
+  return int(samples_.size()) * batch_size_;
+}
+
+RuntimeStatistics AdaptiveMeasurement::statistics() const {
+  return RuntimeStatistics::compute(samples_);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace profiler
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
@@ -557,7 +557,7 @@ bool SparseGemmOperationProfiler::profile(
     gemm_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &gemm_workspace_.arguments,
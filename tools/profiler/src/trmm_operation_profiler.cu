@@ -689,7 +689,7 @@ bool TrmmOperationProfiler::profile(
     trmm_workspace_.arguments.pointer_mode = library::ScalarPointerMode::kHost;
 
     results_.back().status = profile_cutlass_(
-      results_.back().runtime,
+      results_.back(),
       options,
       operation,
       &trmm_workspace_.arguments,
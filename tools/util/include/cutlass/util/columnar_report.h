@@ -0,0 +1,859 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Appendable columnar binary format for profiler results, with a streaming writer and a
+      random-access reader.
+
+    A file consists of a header describing the columns followed by any number of self-contained
+    row groups. All integers are little-endian.
+
+      File      := Header RowGroup*
+      Header    := "CUTLCOL1"  u32 column_count  Column[column_count]  u32 crc32(preceding bytes)
+      Column    := u8 type  u16 name_length  name_bytes
+      RowGroup  := u32 "CRGP"  u32 row_count  u64 payload_bytes  Payload  u32 crc32(Payload)
+      Payload   := Chunk[column_count]
+      Chunk     := u8 encoding  u64 chunk_bytes  chunk_data
+
+    Column types and their encodings:
+
+      kInt64    kDeltaVarint  zigzag LEB128 varints of the difference to the previous row
+      kFloat64  kPlain        IEEE-754 binary64 values
+      kString   kPlain        per row: varint length, bytes
+                kDictionary   varint entry count, entries (varint length, bytes), per row: varint index
+
+    A row group is written with a single call and flushed, so a crash leaves at most one partial
+    group at the end of the file. The reader ignores such a group, and a writer opened in append
+    mode truncates it before appending new groups.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <filesystem>
+
+namespace cutlass {
+namespace columnar {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Type of the values stored in a column
+enum class ColumnType : uint8_t {
+  kInt64 = 0,
+  kFloat64 = 1,
+  kString = 2
+};
+
+/// Encoding of a column chunk within a row group
+enum class Encoding : uint8_t {
+  kPlain = 0,
+  kDeltaVarint = 1,
+  kDictionary = 2
+};
+
+/// Describes one column of a file
+struct Column {
+  std::string name;
+  ColumnType type;
+
+  bool operator==(Column const &rhs) const {
+    return name == rhs.name && type == rhs.type;
+  }
+
+  bool operator!=(Column const &rhs) const {
+    return !(*this == rhs);
+  }
+};
+
+using Schema = std::vector<Column>;
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+static char const kFileMagic[8] = {'C', 'U', 'T', 'L', 'C', 'O', 'L', '1'};
+static uint32_t const kRowGroupMarker = 0x50475243u;   // "CRGP"
+static size_t const kRowGroupHeaderBytes = 16;
+
+/// CRC-32 (IEEE 802.3 polynomial)
+inline uint32_t crc32(void const *data, size_t size, uint32_t crc = 0) {
+
+  static uint32_t const *table = [] {
+    static uint32_t entries[256];
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (int k = 0; k < 8; ++k) {
+        c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+      }
+      entries[i] = c;
+    }
+    return entries;
+  }();
+
+  uint8_t const *bytes = static_cast<uint8_t const *>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < size; ++i) {
+    crc = table[(crc ^ bytes[i]) & 0xff] ^ (crc >> 8);
+  }
+  return ~crc;
+}
+
+/// Appends little-endian encoded values to a byte buffer
+struct ByteWriter {
+
+  std::string bytes;
+
+  void put_u8(uint8_t value) {
+    bytes.push_back(char(value));
+  }
+
+  void put_u16(uint16_t value) {
+    for (int i = 0; i < 2; ++i) {
+      bytes.push_back(char(value >> (8 * i)));
+    }
+  }
+
+  void put_u32(uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      bytes.push_back(char(value >> (8 * i)));
+    }
+  }
+
+  void put_u64(uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      bytes.push_back(char(value >> (8 * i)));
+    }
+  }
+
+  void put_f64(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    put_u64(bits);
+  }
+
+  void put_varint(uint64_t value) {
+    while (value >= 0x80) {
+      bytes.push_back(char(uint8_t(value) | 0x80));
+      value >>= 7;
+    }
+    bytes.push_back(char(value));
+  }
+
+  void put_string(std::string const &value) {
+    put_varint(value.size());
+    bytes.append(value);
+  }
+};
+
+/// Decodes little-endian values from a byte range. Reads past the end yield zero and clear ok.
+struct ByteReader {
+
+  uint8_t const *ptr;
+  uint8_t const *end;
+  bool ok;
+
+  ByteReader(void const *data, size_t size):
+    ptr(static_cast<uint8_t const *>(data)), end(static_cast<uint8_t const *>(data) + size), ok(true) { }
+
+  bool has(size_t count) {
+    if (size_t(end - ptr) < count) {
+      ok = false;
+      ptr = end;
+      return false;
+    }
+    return true;
+  }
+
+  uint64_t get_bytes(int count) {
+    uint64_t value = 0;
+    if (has(size_t(count))) {
+      for (int i = 0; i < count; ++i) {
+        value |= uint64_t(ptr[i]) << (8 * i);
+      }
+      ptr += count;
+    }
+    return value;
+  }
+
+  uint8_t get_u8() { return uint8_t(get_bytes(1)); }
+  uint16_t get_u16() { return uint16_t(get_bytes(2)); }
+  uint32_t get_u32() { return uint32_t(get_bytes(4)); }
+  uint64_t get_u64() { return get_bytes(8); }
+
+  double get_f64() {
+    uint64_t bits = get_u64();
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  uint64_t get_varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      if (!has(1)) {
+        return 0;
+      }
+      uint8_t byte = *ptr++;
+      value |= uint64_t(byte & 0x7f) << shift;
+      if (!(byte & 0x80)) {
+        return value;
+      }
+    }
+    ok = false;
+    return 0;
+  }
+
+  std::string get_string() {
+    uint64_t size = get_varint();
+    if (!has(size_t(size))) {
+      return std::string();
+    }
+    std::string value(reinterpret_cast<char const *>(ptr), size_t(size));
+    ptr += size;
+    return value;
+  }
+};
+
+inline uint64_t zigzag_encode(int64_t value) {
+  return (uint64_t(value) << 1) ^ uint64_t(value >> 63);
+}
+
+inline int64_t zigzag_decode(uint64_t value) {
+  return int64_t(value >> 1) ^ -int64_t(value & 1);
+}
+
+/// Reads exactly size bytes at offset. Returns false on a short read.
+inline bool read_at(std::ifstream &file, uint64_t offset, void *data, size_t size) {
+  file.clear();
+  file.seekg(std::streamoff(offset));
+  file.read(static_cast<char *>(data), std::streamsize(size));
+  return file.gcount() == std::streamsize(size);
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Values of one column, decoded from one or more row groups
+struct ColumnData {
+
+  ColumnType type = ColumnType::kInt64;
+
+  /// Values of kInt64 columns
+  std::vector<int64_t> int64;
+
+  /// Values of kFloat64 columns
+  std::vector<double> float64;
+
+  /// Distinct values of kString columns
+  std::vector<std::string> dictionary;
+
+  /// Per-row index into dictionary for kString columns
+  std::vector<uint32_t> indices;
+
+  /// Number of rows
+  size_t size() const {
+    switch (type) {
+      case ColumnType::kInt64: return int64.size();
+      case ColumnType::kFloat64: return float64.size();
+      default: break;
+    }
+    return indices.size();
+  }
+
+  /// Value of a kString column at a row
+  std::string const &string(size_t row) const {
+    return dictionary[indices[row]];
+  }
+
+  /// Returns the dictionary index of a string, adding it if not present
+  uint32_t intern(std::string const &value) {
+    auto it = lookup_.find(value);
+    if (it != lookup_.end()) {
+      return it->second;
+    }
+    uint32_t index = uint32_t(dictionary.size());
+    dictionary.push_back(value);
+    lookup_.emplace(value, index);
+    return index;
+  }
+
+  void clear() {
+    int64.clear();
+    float64.clear();
+    dictionary.clear();
+    indices.clear();
+    lookup_.clear();
+  }
+
+private:
+
+  std::unordered_map<std::string, uint32_t> lookup_;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Reads a columnar file. Opening scans only the row group headers, so individual columns of large
+/// files may be loaded without decoding the others.
+class Reader {
+public:
+
+  /// Location of a row group within the file
+  struct RowGroup {
+    uint64_t offset;
+    uint64_t payload_bytes;
+    uint32_t row_count;
+  };
+
+private:
+
+  std::ifstream file_;
+  Schema schema_;
+  std::vector<RowGroup> row_groups_;
+  uint64_t row_count_ = 0;
+  uint64_t valid_bytes_ = 0;
+  bool truncated_ = false;
+
+public:
+
+  Reader() { }
+
+  explicit Reader(std::string const &path) {
+    open(path);
+  }
+
+  /// Opens a file and indexes its row groups. Returns false if the header is missing or corrupt.
+  bool open(std::string const &path) {
+
+    file_.close();
+    schema_.clear();
+    row_groups_.clear();
+    row_count_ = 0;
+    valid_bytes_ = 0;
+    truncated_ = false;
+
+    file_.open(path, std::ios::binary);
+    if (!file_.is_open()) {
+      return false;
+    }
+
+    file_.seekg(0, std::ios::end);
+    uint64_t file_bytes = uint64_t(file_.tellg());
+
+    // Read a prefix large enough for typical schemas and grow it if the header does not fit
+    std::vector<char> header;
+    uint64_t header_bytes = 0;
+    bool need_more = true;
+
+    while (need_more) {
+      size_t size = size_t(std::min<uint64_t>(file_bytes, header.empty() ? 4096 : header.size() * 2));
+      if (size == header.size()) {
+        return false;
+      }
+      header.resize(size);
+      if (!detail::read_at(file_, 0, header.data(), header.size()) ||
+          !parse_header_(header, header_bytes, need_more)) {
+        if (!need_more) {
+          return false;
+        }
+      }
+    }
+
+    // Index row groups
+    uint64_t offset = header_bytes;
+    while (offset < file_bytes) {
+
+      uint8_t group_header[detail::kRowGroupHeaderBytes];
+      if (file_bytes - offset < detail::kRowGroupHeaderBytes + 4 ||
+          !detail::read_at(file_, offset, group_header, sizeof(group_header))) {
+        truncated_ = true;
+        break;
+      }
+
+      detail::ByteReader reader(group_header, sizeof(group_header));
+      uint32_t marker = reader.get_u32();
+      RowGroup group;
+      group.offset = offset;
+      group.row_count = reader.get_u32();
+      group.payload_bytes = reader.get_u64();
+
+      uint64_t group_bytes = detail::kRowGroupHeaderBytes + group.payload_bytes + 4;
+      if (marker != detail::kRowGroupMarker || group.payload_bytes > file_bytes - offset ||
+          group_bytes > file_bytes - offset) {
+        truncated_ = true;
+        break;
+      }
+
+      // Only the final group can be partially written; verify its checksum eagerly
+      if (offset + group_bytes == file_bytes) {
+        std::vector<char> payload;
+        if (!read_payload_(group, payload)) {
+          truncated_ = true;
+          break;
+        }
+      }
+
+      row_groups_.push_back(group);
+      row_count_ += group.row_count;
+      offset += group_bytes;
+    }
+
+    valid_bytes_ = offset;
+    if (truncated_) {
+      valid_bytes_ = row_groups_.empty() ? header_bytes :
+        row_groups_.back().offset + detail::kRowGroupHeaderBytes + row_groups_.back().payload_bytes + 4;
+    }
+
+    return true;
+  }
+
+  bool good() const {
+    return file_.is_open() && !schema_.empty();
+  }
+
+  Schema const &schema() const {
+    return schema_;
+  }
+
+  /// Returns the index of a column or -1 if not present
+  int find(std::string const &name) const {
+    for (size_t idx = 0; idx < schema_.size(); ++idx) {
+      if (schema_[idx].name == name) {
+        return int(idx);
+      }
+    }
+    return -1;
+  }
+
+  std::vector<RowGroup> const &row_groups() const {
+    return row_groups_;
+  }
+
+  uint64_t row_count() const {
+    return row_count_;
+  }
+
+  /// True if the file ends with bytes that do not form a complete row group
+  bool truncated() const {
+    return truncated_;
+  }
+
+  /// Number of leading bytes forming a valid header and complete row groups
+  uint64_t valid_bytes() const {
+    return valid_bytes_;
+  }
+
+  /// Decodes one column of one row group, appending its rows to data. Returns false if the row group
+  /// is corrupt.
+  bool read_column(size_t row_group, size_t column, ColumnData &data) {
+
+    if (row_group >= row_groups_.size() || column >= schema_.size()) {
+      return false;
+    }
+
+    if (!data.size()) {
+      data.type = schema_[column].type;
+    }
+    if (data.type != schema_[column].type) {
+      return false;
+    }
+
+    RowGroup const &group = row_groups_[row_group];
+    std::vector<char> payload;
+    if (!read_payload_(group, payload)) {
+      return false;
+    }
+
+    // Skip preceding chunks
+    detail::ByteReader reader(payload.data(), payload.size());
+    for (size_t idx = 0; idx < column; ++idx) {
+      reader.get_u8();
+      uint64_t chunk_bytes = reader.get_u64();
+      if (!reader.has(size_t(chunk_bytes))) {
+        return false;
+      }
+      reader.ptr += chunk_bytes;
+    }
+
+    Encoding encoding = Encoding(reader.get_u8());
+    uint64_t chunk_bytes = reader.get_u64();
+    if (!reader.has(size_t(chunk_bytes))) {
+      return false;
+    }
+
+    detail::ByteReader chunk(reader.ptr, size_t(chunk_bytes));
+    return decode_chunk_(chunk, encoding, group.row_count, data);
+  }
+
+  /// Decodes one column across all row groups
+  bool read_column(size_t column, ColumnData &data) {
+    data.clear();
+    if (column < schema_.size()) {
+      data.type = schema_[column].type;
+    }
+    for (size_t idx = 0; idx < row_groups_.size(); ++idx) {
+      if (!read_column(idx, column, data)) {
+        return false;
+      }
+    }
+    return column < schema_.size();
+  }
+
+private:
+
+  /// Parses the file header. Sets need_more if the buffer ends before the header does.
+  bool parse_header_(std::vector<char> const &header, uint64_t &header_bytes, bool &need_more) {
+
+    schema_.clear();
+    need_more = false;
+
+    if (header.size() < sizeof(detail::kFileMagic)) {
+      return false;
+    }
+    if (std::memcmp(header.data(), detail::kFileMagic, sizeof(detail::kFileMagic))) {
+      return false;
+    }
+
+    detail::ByteReader reader(header.data() + sizeof(detail::kFileMagic), header.size() - sizeof(detail::kFileMagic));
+    uint32_t column_count = reader.get_u32();
+
+    for (uint32_t idx = 0; idx < column_count && reader.ok; ++idx) {
+      Column column;
+      column.type = ColumnType(reader.get_u8());
+      uint16_t name_bytes = reader.get_u16();
+      if (reader.has(name_bytes)) {
+        column.name.assign(reinterpret_cast<char const *>(reader.ptr), name_bytes);
+        reader.ptr += name_bytes;
+      }
+      schema_.push_back(column);
+    }
+
+    size_t crc_offset = size_t(reinterpret_cast<char const *>(reader.ptr) - header.data());
+    uint32_t crc = reader.get_u32();
+
+    if (!reader.ok) {
+      schema_.clear();
+      need_more = true;
+      return false;
+    }
+
+    if (crc != detail::crc32(header.data(), crc_offset)) {
+      schema_.clear();
+      return false;
+    }
+
+    for (Column const &column : schema_) {
+      if (uint8_t(column.type) > uint8_t(ColumnType::kString)) {
+        schema_.clear();
+        return false;
+      }
+    }
+
+    header_bytes = crc_offset + 4;
+    return true;
+  }
+
+  bool read_payload_(RowGroup const &group, std::vector<char> &payload) {
+
+    payload.resize(size_t(group.payload_bytes));
+    uint8_t crc_bytes[4];
+
+    if (!detail::read_at(file_, group.offset + detail::kRowGroupHeaderBytes, payload.data(), payload.size()) ||
+        !detail::read_at(file_, group.offset + detail::kRowGroupHeaderBytes + group.payload_bytes, crc_bytes, 4)) {
+      return false;
+    }
+
+    return detail::ByteReader(crc_bytes, 4).get_u32() == detail::crc32(payload.data(), payload.size());
+  }
+
+  static bool decode_chunk_(detail::ByteReader &chunk, Encoding encoding, uint32_t row_count, ColumnData &data) {
+
+    switch (data.type) {
+    case ColumnType::kInt64:
+      if (encoding != Encoding::kDeltaVarint) {
+        return false;
+      }
+      {
+        int64_t value = 0;
+        for (uint32_t row = 0; row < row_count; ++row) {
+          value += detail::zigzag_decode(chunk.get_varint());
+          data.int64.push_back(value);
+        }
+      }
+      break;
+
+    case ColumnType::kFloat64:
+      if (encoding != Encoding::kPlain) {
+        return false;
+      }
+      for (uint32_t row = 0; row < row_count; ++row) {
+        data.float64.push_back(chunk.get_f64());
+      }
+      break;
+
+    case ColumnType::kString:
+      if (encoding == Encoding::kPlain) {
+        for (uint32_t row = 0; row < row_count && chunk.ok; ++row) {
+          data.indices.push_back(data.intern(chunk.get_string()));
+        }
+      }
+      else if (encoding == Encoding::kDictionary) {
+        uint64_t entry_count = chunk.get_varint();
+        std::vector<uint32_t> remap;
+        for (uint64_t idx = 0; idx < entry_count && chunk.ok; ++idx) {
+          remap.push_back(data.intern(chunk.get_string()));
+        }
+        for (uint32_t row = 0; row < row_count && chunk.ok; ++row) {
+          uint64_t index = chunk.get_varint();
+          if (index >= remap.size()) {
+            return false;
+          }
+          data.indices.push_back(remap[size_t(index)]);
+        }
+      }
+      else {
+        return false;
+      }
+      break;
+    }
+
+    return chunk.ok;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Writes a columnar file. Rows are buffered until flush() writes them as one row group.
+class Writer {
+private:
+
+  std::ofstream file_;
+  Schema schema_;
+  std::vector<ColumnData> columns_;
+  bool good_ = false;
+
+public:
+
+  Writer() { }
+
+  ~Writer() {
+    close();
+  }
+
+  Writer(Writer const &) = delete;
+  Writer &operator=(Writer const &) = delete;
+
+  /// Opens a file for writing. In append mode an existing file must have the same schema; a partial
+  /// row group left by an interrupted writer is discarded.
+  bool open(std::string const &path, Schema const &schema, bool append = false) {
+
+    close();
+    schema_ = schema;
+    columns_.assign(schema.size(), ColumnData());
+    for (size_t idx = 0; idx < schema.size(); ++idx) {
+      columns_[idx].type = schema[idx].type;
+    }
+
+    bool write_header = true;
+
+    if (append && std::filesystem::exists(path) && std::filesystem::file_size(path) > 0) {
+
+      uint64_t valid_bytes = 0;
+      {
+        Reader reader(path);
+        if (!reader.good() || reader.schema() != schema) {
+          return false;
+        }
+        valid_bytes = reader.valid_bytes();
+      }
+
+      std::error_code error;
+      if (std::filesystem::file_size(path) != valid_bytes) {
+        std::filesystem::resize_file(path, valid_bytes, error);
+        if (error) {
+          return false;
+        }
+      }
+
+      write_header = false;
+    }
+
+    file_.open(path, std::ios::binary | (write_header ? std::ios::trunc : std::ios::app));
+    if (!file_.is_open()) {
+      return false;
+    }
+
+    if (write_header) {
+      detail::ByteWriter header;
+      header.bytes.append(detail::kFileMagic, sizeof(detail::kFileMagic));
+      header.put_u32(uint32_t(schema.size()));
+      for (Column const &column : schema) {
+        header.put_u8(uint8_t(column.type));
+        header.put_u16(uint16_t(column.name.size()));
+        header.bytes.append(column.name, 0, uint16_t(column.name.size()));
+      }
+      header.put_u32(detail::crc32(header.bytes.data(), header.bytes.size()));
+      file_.write(header.bytes.data(), std::streamsize(header.bytes.size()));
+      file_.flush();
+    }
+
+    good_ = file_.good();
+    return good_;
+  }
+
+  bool good() const {
+    return good_;
+  }
+
+  Schema const &schema() const {
+    return schema_;
+  }
+
+  void append_int64(size_t column, int64_t value) {
+    columns_[column].int64.push_back(value);
+  }
+
+  void append_float64(size_t column, double value) {
+    columns_[column].float64.push_back(value);
+  }
+
+  void append_string(size_t column, std::string const &value) {
+    columns_[column].indices.push_back(columns_[column].intern(value));
+  }
+
+  /// Number of buffered rows not yet written
+  size_t pending_rows() const {
+    return columns_.empty() ? 0 : columns_.front().size();
+  }
+
+  /// Writes buffered rows as a row group and flushes the file
+  void flush() {
+
+    size_t row_count = pending_rows();
+    if (!good_ || !row_count) {
+      return;
+    }
+
+    for (ColumnData const &column : columns_) {
+      if (column.size() != row_count) {
+        good_ = false;
+        return;
+      }
+    }
+
+    detail::ByteWriter payload;
+    detail::ByteWriter chunk;
+
+    for (ColumnData const &column : columns_) {
+
+      chunk.bytes.clear();
+      Encoding encoding = Encoding::kPlain;
+
+      switch (column.type) {
+      case ColumnType::kInt64:
+        encoding = Encoding::kDeltaVarint;
+        {
+          int64_t previous = 0;
+          for (int64_t value : column.int64) {
+            chunk.put_varint(detail::zigzag_encode(int64_t(uint64_t(value) - uint64_t(previous))));
+            previous = value;
+          }
+        }
+        break;
+
+      case ColumnType::kFloat64:
+        for (double value : column.float64) {
+          chunk.put_f64(value);
+        }
+        break;
+
+      case ColumnType::kString:
+        // Dictionary encoding pays off unless most values are distinct
+        if (column.dictionary.size() * 2 <= row_count) {
+          encoding = Encoding::kDictionary;
+          chunk.put_varint(column.dictionary.size());
+          for (std::string const &entry : column.dictionary) {
+            chunk.put_string(entry);
+          }
+          for (uint32_t index : column.indices) {
+            chunk.put_varint(index);
+          }
+        }
+        else {
+          for (uint32_t index : column.indices) {
+            chunk.put_string(column.dictionary[index]);
+          }
+        }
+        break;
+      }
+
+      payload.put_u8(uint8_t(encoding));
+      payload.put_u64(chunk.bytes.size());
+      payload.bytes.append(chunk.bytes);
+    }
+
+    detail::ByteWriter group;
+    group.put_u32(detail::kRowGroupMarker);
+    group.put_u32(uint32_t(row_count));
+    group.put_u64(payload.bytes.size());
+    group.bytes.append(payload.bytes);
+    group.put_u32(detail::crc32(payload.bytes.data(), payload.bytes.size()));
+
+    file_.write(group.bytes.data(), std::streamsize(group.bytes.size()));
+    file_.flush();
+    good_ = file_.good();
+
+    for (ColumnData &column : columns_) {
+      column.clear();
+    }
+  }
+
+  /// Flushes buffered rows and closes the file
+  void close() {
+    if (file_.is_open()) {
+      flush();
+      file_.close();
+    }
+    good_ = false;
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace columnar
+} // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,145 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Executes CUTLASS 3.x kernels on the host.
+
+    Every block of the grid is executed by one host thread. Blocks are claimed one at a time from
+    a shared counter by the threads of cutlass::host_parallel_for(), so uneven blocks are balanced
+    across the pool. The threads of a block are executed one after another on that host thread,
+    with ThreadIdxX(), BlockIdxX(), BlockDimX() and GridDimX() (and their Y and Z variants)
+    reporting the coordinates of the thread being executed.
+
+    Blocks of more than one thread are therefore only supported by kernels that do not
+    synchronize within a block, such as GemmUniversal with a MainloopCpu collective and the
+    DefaultEpilogue. A block of a single thread may use any barrier.
+
+    The kernel must be compiled by the host compiler: device functions compiled by NVCC cannot be
+    called from the host.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/util/host_parallel.h"
+
+namespace cutlass {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Invokes Operator{}(params, smem) for every thread of every block of the grid on the host.
+///
+/// Returns Status::kErrorNotSupported if a block of more than one thread reached a barrier, in
+/// which case the results are undefined. At most max_threads host threads participate if
+/// max_threads > 0.
+template <typename Operator>
+Status host_kernel_launch(
+  dim3 grid,
+  dim3 block,
+  int smem_size,
+  typename Operator::Params const &params,
+  int max_threads = 0) {
+
+  int64_t block_count = int64_t(grid.x) * grid.y * grid.z;
+  if (block_count == 0 || int64_t(block.x) * block.y * block.z == 0) {
+    return Status::kSuccess;
+  }
+
+  std::atomic<bool> serialized_barrier{false};
+
+  host_parallel_for(0, block_count, 1, [&](int64_t block_begin, int64_t block_end) {
+
+    // Shared memory of the block, aligned for any SharedStorage
+    struct alignas(128) SmemLine {
+      char bytes[128];
+    };
+    std::vector<SmemLine> smem((std::max(smem_size, 1) + sizeof(SmemLine) - 1) / sizeof(SmemLine));
+
+    detail::HostLaunchIndex &index = detail::host_launch_index();
+    detail::HostLaunchIndex const saved = index;
+
+    index.block_dim[0] = block.x;
+    index.block_dim[1] = block.y;
+    index.block_dim[2] = block.z;
+    index.grid_dim[0] = grid.x;
+    index.grid_dim[1] = grid.y;
+    index.grid_dim[2] = grid.z;
+
+    for (int64_t block_idx = block_begin; block_idx < block_end; ++block_idx) {
+      index.block_idx[0] = uint(block_idx % grid.x);
+      index.block_idx[1] = uint((block_idx / grid.x) % grid.y);
+      index.block_idx[2] = uint(block_idx / (int64_t(grid.x) * grid.y));
+      index.serialized_barrier = false;
+
+      for (uint z = 0; z < block.z; ++z) {
+        for (uint y = 0; y < block.y; ++y) {
+          for (uint x = 0; x < block.x; ++x) {
+            index.thread_idx[0] = x;
+            index.thread_idx[1] = y;
+            index.thread_idx[2] = z;
+
+            Operator op;
+            op(params, reinterpret_cast<char *>(smem.data()));
+          }
+        }
+      }
+
+      if (index.serialized_barrier) {
+        serialized_barrier.store(true, std::memory_order_relaxed);
+      }
+    }
+
+    index = saved;
+  }, max_threads);
+
+  return serialized_barrier.load() ? Status::kErrorNotSupported : Status::kSuccess;
+}
+
+/// Executes a GemmUniversal-style kernel on the host using its own grid and block shapes.
+template <typename GemmKernel>
+Status host_kernel_launch(typename GemmKernel::Params const &params, int max_threads = 0) {
+  return host_kernel_launch<GemmKernel>(
+    GemmKernel::get_grid_shape(params),
+    GemmKernel::get_block_shape(),
+    GemmKernel::SharedStorageSize,
+    params,
+    max_threads);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
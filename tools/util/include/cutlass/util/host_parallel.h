@@ -0,0 +1,348 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Host-side parallel loop used by the reference implementations and host utilities.
+
+    Work is partitioned into chunks whose boundaries depend only on the iteration range and the
+    grain size, never on the number of threads. Callers that reduce per-chunk partial results in
+    chunk order therefore obtain identical results for any thread count.
+
+    When compiled with OpenMP the chunks are distributed by an OpenMP parallel loop. Otherwise a
+    lazily constructed pool of std::thread workers is used. Nested calls issued from inside a
+    parallel region execute serially on the calling thread.
+
+    The number of threads defaults to std::thread::hardware_concurrency() and may be overridden
+    with the CUTLASS_HOST_THREADS environment variable.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace cutlass {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Nesting depth of host parallel regions on the calling thread
+inline int &host_parallel_depth() {
+  static thread_local int depth = 0;
+  return depth;
+}
+
+/// RAII guard marking the calling thread as executing inside a parallel region
+struct HostParallelRegion {
+  HostParallelRegion() { ++host_parallel_depth(); }
+  ~HostParallelRegion() { --host_parallel_depth(); }
+};
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Returns the default number of host threads used by parallel host utilities
+inline int host_thread_count() {
+  static int const count = [] {
+    if (char const *env = std::getenv("CUTLASS_HOST_THREADS")) {
+      int requested = std::atoi(env);
+      if (requested > 0) {
+        return requested;
+      }
+    }
+    int hw = int(std::thread::hardware_concurrency());
+    return hw > 0 ? hw : 1;
+  }();
+  return count;
+}
+
+/// Returns true if the calling thread is executing inside a host parallel region
+inline bool host_in_parallel_region() {
+#if defined(_OPENMP)
+  if (omp_in_parallel()) {
+    return true;
+  }
+#endif
+  return detail::host_parallel_depth() > 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Persistent pool of worker threads executing one chunked loop at a time.
+///
+/// The calling thread participates in the loop, so a pool of N threads owns N - 1 workers.
+class HostThreadPool {
+public:
+
+  using ChunkFunc = std::function<void(int64_t, int64_t)>;
+
+private:
+
+  struct Job {
+    ChunkFunc const *func = nullptr;
+    int64_t begin = 0;
+    int64_t end = 0;
+    int64_t grain = 1;
+    int64_t chunk_count = 0;
+    int participants = 0;
+  };
+
+  std::vector<std::thread> workers_;
+
+  std::mutex submit_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+
+  Job job_;
+  uint64_t generation_ = 0;
+  std::atomic<int64_t> next_chunk_{0};
+  int pending_ = 0;
+  bool stop_ = false;
+
+  std::exception_ptr error_;
+
+  /// Claims and executes chunks of the current job until none remain
+  void run_chunks(Job const &job) {
+    detail::HostParallelRegion region;
+    while (true) {
+      int64_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed);
+      if (chunk >= job.chunk_count) {
+        break;
+      }
+      int64_t chunk_begin = job.begin + chunk * job.grain;
+      int64_t chunk_end = std::min(job.end, chunk_begin + job.grain);
+      try {
+        (*job.func)(chunk_begin, chunk_end);
+      }
+      catch (...) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_) {
+          error_ = std::current_exception();
+        }
+        // Drain the remaining chunks so that the loop terminates promptly
+        next_chunk_.store(job.chunk_count, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  void worker_loop(int worker_idx) {
+    uint64_t seen_generation = 0;
+    while (true) {
+      Job job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        wake_.wait(lock, [&] { return stop_ || generation_ != seen_generation; });
+        if (stop_) {
+          return;
+        }
+        seen_generation = generation_;
+        job = job_;
+        // Participant 0 is the submitting thread
+        if (worker_idx + 1 >= job.participants) {
+          continue;
+        }
+      }
+
+      run_chunks(job);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--pending_ == 0) {
+          done_.notify_all();
+        }
+      }
+    }
+  }
+
+public:
+
+  explicit HostThreadPool(int thread_count = host_thread_count()) {
+    for (int idx = 0; idx + 1 < thread_count; ++idx) {
+      workers_.emplace_back([this, idx] { worker_loop(idx); });
+    }
+  }
+
+  HostThreadPool(HostThreadPool const &) = delete;
+  HostThreadPool &operator=(HostThreadPool const &) = delete;
+
+  ~HostThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  /// Process-wide pool sized by host_thread_count()
+  static HostThreadPool &instance() {
+    static HostThreadPool pool;
+    return pool;
+  }
+
+  /// Number of threads executing a loop, including the calling thread
+  int size() const {
+    return int(workers_.size()) + 1;
+  }
+
+  /// Invokes func(chunk_begin, chunk_end) for each grain-sized chunk of [begin, end) and blocks
+  /// until all chunks complete. At most max_threads threads participate if max_threads > 0.
+  void parallel_for(int64_t begin, int64_t end, int64_t grain, ChunkFunc const &func, int max_threads = 0) {
+    if (end <= begin) {
+      return;
+    }
+    grain = std::max<int64_t>(grain, 1);
+
+    Job job;
+    job.func = &func;
+    job.begin = begin;
+    job.end = end;
+    job.grain = grain;
+    job.chunk_count = (end - begin + grain - 1) / grain;
+    job.participants = int(std::min<int64_t>(job.chunk_count, max_threads > 0 ? std::min(max_threads, size()) : size()));
+
+    if (job.participants <= 1 || host_in_parallel_region()) {
+      detail::HostParallelRegion region;
+      for (int64_t chunk_begin = begin; chunk_begin < end; chunk_begin += grain) {
+        func(chunk_begin, std::min(end, chunk_begin + grain));
+      }
+      return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_ = job;
+      pending_ = job.participants - 1;
+      error_ = nullptr;
+      next_chunk_.store(0, std::memory_order_relaxed);
+      ++generation_;
+    }
+    wake_.notify_all();
+
+    run_chunks(job);
+
+    std::exception_ptr error;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      // Every participating worker must retire before func goes out of scope
+      done_.wait(lock, [&] { return pending_ == 0; });
+      error = error_;
+      error_ = nullptr;
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Invokes func(chunk_begin, chunk_end) over grain-sized chunks of [begin, end) in parallel.
+///
+/// Chunk boundaries are independent of the thread count. At most max_threads threads participate
+/// if max_threads > 0; max_threads == 1 executes the loop serially on the calling thread.
+template <typename Func>
+void host_parallel_for(int64_t begin, int64_t end, int64_t grain, Func &&func, int max_threads = 0) {
+
+  if (end <= begin) {
+    return;
+  }
+  grain = std::max<int64_t>(grain, 1);
+  int64_t chunk_count = (end - begin + grain - 1) / grain;
+
+  if (max_threads == 1 || chunk_count == 1 || host_in_parallel_region()) {
+    detail::HostParallelRegion region;
+    for (int64_t chunk_begin = begin; chunk_begin < end; chunk_begin += grain) {
+      func(chunk_begin, std::min(end, chunk_begin + grain));
+    }
+    return;
+  }
+
+#if defined(_OPENMP)
+  int thread_count = max_threads > 0 ? max_threads : host_thread_count();
+  std::exception_ptr error;
+
+  #pragma omp parallel for schedule(dynamic) num_threads(thread_count)
+  for (int64_t chunk = 0; chunk < chunk_count; ++chunk) {
+    detail::HostParallelRegion region;
+    int64_t chunk_begin = begin + chunk * grain;
+    try {
+      func(chunk_begin, std::min(end, chunk_begin + grain));
+    }
+    catch (...) {
+      #pragma omp critical(cutlass_host_parallel_for_error)
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+#else
+  HostThreadPool::ChunkFunc chunk_func = [&func](int64_t chunk_begin, int64_t chunk_end) {
+    func(chunk_begin, chunk_end);
+  };
+  HostThreadPool::instance().parallel_for(begin, end, grain, chunk_func, max_threads);
+#endif
+}
+
+/// Returns a grain size splitting [0, extent) into roughly chunks_per_thread chunks per thread,
+/// but never smaller than min_grain. The result depends on the thread count, so loops reducing
+/// per-chunk partials that must be reproducible should use a fixed grain instead.
+inline int64_t host_parallel_grain(int64_t extent, int64_t min_grain = 1, int chunks_per_thread = 4) {
+  int64_t chunks = int64_t(host_thread_count()) * std::max(chunks_per_thread, 1);
+  return std::max<int64_t>(min_grain, (extent + chunks - 1) / std::max<int64_t>(chunks, 1));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,395 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Runtime-dispatched SIMD kernels used by host reference implementations.
+
+    Kernels are compiled for AVX2 and AVX-512 through function target attributes, so no special
+    compiler flags are required; the widest instruction set supported by the running CPU is
+    selected on first use. A portable scalar implementation is used on other architectures and
+    compilers. The CUTLASS_HOST_SIMD environment variable ("scalar", "avx2" or "avx512") caps
+    the selected instruction set.
+
+    Every kernel produces results bit-identical to the scalar host code it replaces: conversions
+    to float are exact and the GEMM micro-kernel issues a separate multiply and add per element,
+    matching multiply_add<float> without floating-point contraction.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+#include "cutlass/numeric_types.h"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(__CUDA_ARCH__)
+#define CUTLASS_HOST_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define CUTLASS_HOST_SIMD_X86 0
+#endif
+
+// Kernels must not contract multiplies and adds into FMA to remain bit-identical to scalar code
+#if defined(__GNUC__) && !defined(__clang__)
+#define CUTLASS_HOST_SIMD_NO_CONTRACT __attribute__((optimize("fp-contract=off")))
+#else
+#define CUTLASS_HOST_SIMD_NO_CONTRACT
+#endif
+
+namespace cutlass {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Instruction sets targeted by host SIMD kernels
+enum class HostSimdIsa {
+  kScalar,
+  kAVX2,
+  kAVX512
+};
+
+/// Returns the instruction set used by host SIMD kernels in this process
+inline HostSimdIsa host_simd_isa() {
+  static HostSimdIsa const isa = [] {
+    HostSimdIsa detected = HostSimdIsa::kScalar;
+#if CUTLASS_HOST_SIMD_X86
+    __builtin_cpu_init();
+    // Both paths widen half_t with F16C, and the AVX-512 kernels finish their tails with AVX2
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")) {
+      detected = __builtin_cpu_supports("avx512f") ? HostSimdIsa::kAVX512 : HostSimdIsa::kAVX2;
+    }
+#endif
+    if (char const *env = std::getenv("CUTLASS_HOST_SIMD")) {
+      HostSimdIsa cap = detected;
+      if (!std::strcmp(env, "scalar")) {
+        cap = HostSimdIsa::kScalar;
+      }
+      else if (!std::strcmp(env, "avx2")) {
+        cap = HostSimdIsa::kAVX2;
+      }
+      if (int(cap) < int(detected)) {
+        detected = cap;
+      }
+    }
+    return detected;
+  }();
+  return isa;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Element types with a vectorized widening conversion to float
+template <typename Element>
+struct HostSimdWidenable : std::false_type {};
+
+template <> struct HostSimdWidenable<float> : std::true_type {};
+template <> struct HostSimdWidenable<half_t> : std::true_type {};
+template <> struct HostSimdWidenable<bfloat16_t> : std::true_type {};
+template <> struct HostSimdWidenable<float_e4m3_t> : std::true_type {};
+template <> struct HostSimdWidenable<float_e5m2_t> : std::true_type {};
+
+namespace detail {
+
+/// Conversion table from 8-bit floating-point encodings to float
+template <typename Element>
+float const *host_simd_fp8_table() {
+  static float const *table = [] {
+    static float values[256];
+    for (int idx = 0; idx < 256; ++idx) {
+      values[idx] = float(Element::bitcast(uint8_t(idx)));
+    }
+    return values;
+  }();
+  return table;
+}
+
+#if CUTLASS_HOST_SIMD_X86
+
+__attribute__((target("avx2,f16c")))
+inline void host_widen_half_avx2(uint16_t const *src, float *dst, int64_t n) {
+  int64_t idx = 0;
+  for (; idx + 8 <= n; idx += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + idx));
+    _mm256_storeu_ps(dst + idx, _mm256_cvtph_ps(h));
+  }
+  for (; idx < n; ++idx) {
+    dst[idx] = float(half_t::bitcast(src[idx]));
+  }
+}
+
+__attribute__((target("avx2")))
+inline void host_widen_bf16_avx2(uint16_t const *src, float *dst, int64_t n) {
+  int64_t idx = 0;
+  for (; idx + 8 <= n; idx += 8) {
+    __m128i h = _mm_loadu_si128(reinterpret_cast<__m128i const *>(src + idx));
+    __m256i w = _mm256_slli_epi32(_mm256_cvtepu16_epi32(h), 16);
+    _mm256_storeu_ps(dst + idx, _mm256_castsi256_ps(w));
+  }
+  for (; idx < n; ++idx) {
+    uint32_t bits = uint32_t(src[idx]) << 16;
+    std::memcpy(dst + idx, &bits, sizeof(float));
+  }
+}
+
+__attribute__((target("avx512f")))
+inline void host_widen_half_avx512(uint16_t const *src, float *dst, int64_t n) {
+  int64_t idx = 0;
+  for (; idx + 16 <= n; idx += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + idx));
+    _mm512_storeu_ps(dst + idx, _mm512_cvtph_ps(h));
+  }
+  host_widen_half_avx2(src + idx, dst + idx, n - idx);
+}
+
+__attribute__((target("avx512f")))
+inline void host_widen_bf16_avx512(uint16_t const *src, float *dst, int64_t n) {
+  int64_t idx = 0;
+  for (; idx + 16 <= n; idx += 16) {
+    __m256i h = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(src + idx));
+    __m512i w = _mm512_slli_epi32(_mm512_cvtepu16_epi32(h), 16);
+    _mm512_storeu_ps(dst + idx, _mm512_castsi512_ps(w));
+  }
+  host_widen_bf16_avx2(src + idx, dst + idx, n - idx);
+}
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Converts n contiguous elements to float
+inline void host_widen(float const *src, float *dst, int64_t n) {
+  std::memcpy(dst, src, size_t(n) * sizeof(float));
+}
+
+inline void host_widen(half_t const *src, float *dst, int64_t n) {
+#if CUTLASS_HOST_SIMD_X86
+  switch (host_simd_isa()) {
+  case HostSimdIsa::kAVX512:
+    detail::host_widen_half_avx512(reinterpret_cast<uint16_t const *>(src), dst, n);
+    return;
+  case HostSimdIsa::kAVX2:
+    detail::host_widen_half_avx2(reinterpret_cast<uint16_t const *>(src), dst, n);
+    return;
+  default:
+    break;
+  }
+#endif
+  for (int64_t idx = 0; idx < n; ++idx) {
+    dst[idx] = float(src[idx]);
+  }
+}
+
+inline void host_widen(bfloat16_t const *src, float *dst, int64_t n) {
+#if CUTLASS_HOST_SIMD_X86
+  switch (host_simd_isa()) {
+  case HostSimdIsa::kAVX512:
+    detail::host_widen_bf16_avx512(reinterpret_cast<uint16_t const *>(src), dst, n);
+    return;
+  case HostSimdIsa::kAVX2:
+    detail::host_widen_bf16_avx2(reinterpret_cast<uint16_t const *>(src), dst, n);
+    return;
+  default:
+    break;
+  }
+#endif
+  for (int64_t idx = 0; idx < n; ++idx) {
+    dst[idx] = float(src[idx]);
+  }
+}
+
+inline void host_widen(float_e4m3_t const *src, float *dst, int64_t n) {
+  float const *table = detail::host_simd_fp8_table<float_e4m3_t>();
+  uint8_t const *bytes = reinterpret_cast<uint8_t const *>(src);
+  for (int64_t idx = 0; idx < n; ++idx) {
+    dst[idx] = table[bytes[idx]];
+  }
+}
+
+inline void host_widen(float_e5m2_t const *src, float *dst, int64_t n) {
+  float const *table = detail::host_simd_fp8_table<float_e5m2_t>();
+  uint8_t const *bytes = reinterpret_cast<uint8_t const *>(src);
+  for (int64_t idx = 0; idx < n; ++idx) {
+    dst[idx] = table[bytes[idx]];
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Signature of the single-precision GEMM micro-kernel.
+///
+/// For r in [0, rows) and j in [0, n), computes in increasing order of kk in [0, k):
+///   accum[r * ldm + j] = a[kk * lda + r] * b[kk * n + j] + accum[r * ldm + j]
+using HostSgemmKernel = void (*)(int rows, int k, int n,
+                                 float const *a, int lda,
+                                 float const *b,
+                                 float *accum, int ldm);
+
+/// Updates columns [j_begin, n) of the accumulator rows one element at a time
+CUTLASS_HOST_SIMD_NO_CONTRACT inline void host_sgemm_columns(int rows, int k, int n, int j_begin, float const *a, int lda,
+                               float const *b, float *accum, int ldm) {
+  for (int r = 0; r < rows; ++r) {
+    float *accum_row = accum + int64_t(r) * ldm;
+    for (int kk = 0; kk < k; ++kk) {
+      float const a_rk = a[int64_t(kk) * lda + r];
+      float const *b_row = b + int64_t(kk) * n;
+      for (int j = j_begin; j < n; ++j) {
+        float product = a_rk * b_row[j];
+        accum_row[j] = product + accum_row[j];
+      }
+    }
+  }
+}
+
+inline void host_sgemm_kernel_scalar(int rows, int k, int n, float const *a, int lda,
+                                     float const *b, float *accum, int ldm) {
+  host_sgemm_columns(rows, k, n, 0, a, lda, b, accum, ldm);
+}
+
+#if CUTLASS_HOST_SIMD_X86
+
+/// Holds a 4 x 16 accumulator block in registers across the k loop
+__attribute__((target("avx2"))) CUTLASS_HOST_SIMD_NO_CONTRACT
+inline void host_sgemm_kernel_avx2(int rows, int k, int n, float const *a, int lda,
+                                   float const *b, float *accum, int ldm) {
+  if (rows != 4) {
+    host_sgemm_columns(rows, k, n, 0, a, lda, b, accum, ldm);
+    return;
+  }
+
+  float *accum_0 = accum;
+  float *accum_1 = accum + ldm;
+  float *accum_2 = accum + 2 * int64_t(ldm);
+  float *accum_3 = accum + 3 * int64_t(ldm);
+
+  int j = 0;
+  for (; j + 16 <= n; j += 16) {
+    __m256 c00 = _mm256_loadu_ps(accum_0 + j), c01 = _mm256_loadu_ps(accum_0 + j + 8);
+    __m256 c10 = _mm256_loadu_ps(accum_1 + j), c11 = _mm256_loadu_ps(accum_1 + j + 8);
+    __m256 c20 = _mm256_loadu_ps(accum_2 + j), c21 = _mm256_loadu_ps(accum_2 + j + 8);
+    __m256 c30 = _mm256_loadu_ps(accum_3 + j), c31 = _mm256_loadu_ps(accum_3 + j + 8);
+
+    for (int kk = 0; kk < k; ++kk) {
+      float const *a_k = a + int64_t(kk) * lda;
+      float const *b_k = b + int64_t(kk) * n + j;
+      __m256 b0 = _mm256_loadu_ps(b_k);
+      __m256 b1 = _mm256_loadu_ps(b_k + 8);
+      __m256 a0 = _mm256_broadcast_ss(a_k + 0);
+      __m256 a1 = _mm256_broadcast_ss(a_k + 1);
+      __m256 a2 = _mm256_broadcast_ss(a_k + 2);
+      __m256 a3 = _mm256_broadcast_ss(a_k + 3);
+      c00 = _mm256_add_ps(_mm256_mul_ps(a0, b0), c00); c01 = _mm256_add_ps(_mm256_mul_ps(a0, b1), c01);
+      c10 = _mm256_add_ps(_mm256_mul_ps(a1, b0), c10); c11 = _mm256_add_ps(_mm256_mul_ps(a1, b1), c11);
+      c20 = _mm256_add_ps(_mm256_mul_ps(a2, b0), c20); c21 = _mm256_add_ps(_mm256_mul_ps(a2, b1), c21);
+      c30 = _mm256_add_ps(_mm256_mul_ps(a3, b0), c30); c31 = _mm256_add_ps(_mm256_mul_ps(a3, b1), c31);
+    }
+
+    _mm256_storeu_ps(accum_0 + j, c00); _mm256_storeu_ps(accum_0 + j + 8, c01);
+    _mm256_storeu_ps(accum_1 + j, c10); _mm256_storeu_ps(accum_1 + j + 8, c11);
+    _mm256_storeu_ps(accum_2 + j, c20); _mm256_storeu_ps(accum_2 + j + 8, c21);
+    _mm256_storeu_ps(accum_3 + j, c30); _mm256_storeu_ps(accum_3 + j + 8, c31);
+  }
+
+  host_sgemm_columns(4, k, n, j, a, lda, b, accum, ldm);
+}
+
+/// Holds a 4 x 32 accumulator block in registers across the k loop
+__attribute__((target("avx512f"))) CUTLASS_HOST_SIMD_NO_CONTRACT
+inline void host_sgemm_kernel_avx512(int rows, int k, int n, float const *a, int lda,
+                                     float const *b, float *accum, int ldm) {
+  if (rows != 4) {
+    host_sgemm_columns(rows, k, n, 0, a, lda, b, accum, ldm);
+    return;
+  }
+
+  float *accum_0 = accum;
+  float *accum_1 = accum + ldm;
+  float *accum_2 = accum + 2 * int64_t(ldm);
+  float *accum_3 = accum + 3 * int64_t(ldm);
+
+  int j = 0;
+  for (; j + 32 <= n; j += 32) {
+    __m512 c00 = _mm512_loadu_ps(accum_0 + j), c01 = _mm512_loadu_ps(accum_0 + j + 16);
+    __m512 c10 = _mm512_loadu_ps(accum_1 + j), c11 = _mm512_loadu_ps(accum_1 + j + 16);
+    __m512 c20 = _mm512_loadu_ps(accum_2 + j), c21 = _mm512_loadu_ps(accum_2 + j + 16);
+    __m512 c30 = _mm512_loadu_ps(accum_3 + j), c31 = _mm512_loadu_ps(accum_3 + j + 16);
+
+    for (int kk = 0; kk < k; ++kk) {
+      float const *a_k = a + int64_t(kk) * lda;
+      float const *b_k = b + int64_t(kk) * n + j;
+      __m512 b0 = _mm512_loadu_ps(b_k);
+      __m512 b1 = _mm512_loadu_ps(b_k + 16);
+      __m512 a0 = _mm512_set1_ps(a_k[0]);
+      __m512 a1 = _mm512_set1_ps(a_k[1]);
+      __m512 a2 = _mm512_set1_ps(a_k[2]);
+      __m512 a3 = _mm512_set1_ps(a_k[3]);
+      c00 = _mm512_add_ps(_mm512_mul_ps(a0, b0), c00); c01 = _mm512_add_ps(_mm512_mul_ps(a0, b1), c01);
+      c10 = _mm512_add_ps(_mm512_mul_ps(a1, b0), c10); c11 = _mm512_add_ps(_mm512_mul_ps(a1, b1), c11);
+      c20 = _mm512_add_ps(_mm512_mul_ps(a2, b0), c20); c21 = _mm512_add_ps(_mm512_mul_ps(a2, b1), c21);
+      c30 = _mm512_add_ps(_mm512_mul_ps(a3, b0), c30); c31 = _mm512_add_ps(_mm512_mul_ps(a3, b1), c31);
+    }
+
+    _mm512_storeu_ps(accum_0 + j, c00); _mm512_storeu_ps(accum_0 + j + 16, c01);
+    _mm512_storeu_ps(accum_1 + j, c10); _mm512_storeu_ps(accum_1 + j + 16, c11);
+    _mm512_storeu_ps(accum_2 + j, c20); _mm512_storeu_ps(accum_2 + j + 16, c21);
+    _mm512_storeu_ps(accum_3 + j, c30); _mm512_storeu_ps(accum_3 + j + 16, c31);
+  }
+
+  host_sgemm_columns(4, k, n, j, a, lda, b, accum, ldm);
+}
+
+#endif // CUTLASS_HOST_SIMD_X86
+
+} // namespace detail
+
+/// Returns the single-precision GEMM micro-kernel for the selected instruction set
+inline detail::HostSgemmKernel host_sgemm_kernel() {
+#if CUTLASS_HOST_SIMD_X86
+  switch (host_simd_isa()) {
+  case HostSimdIsa::kAVX512:
+    return detail::host_sgemm_kernel_avx512;
+  case HostSimdIsa::kAVX2:
+    return detail::host_sgemm_kernel_avx2;
+  default:
+    break;
+  }
+#endif
+  return detail::host_sgemm_kernel_scalar;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
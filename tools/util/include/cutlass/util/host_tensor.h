@@ -37,6 +37,9 @@
   host memory synchronize device memory automatically. Explicit copy operations provide abstractions
   for CUDA memcpy operations.
 
+  The optional storage policy (see cutlass/util/host_tensor_storage.h) selects memory-mapped host
+  storage, lazy allocation of the host mirror and synchronization of modified ranges only.
+
   Call {host, device}_{data, ref, view}() for accessing host or device memory.
 
   See cutlass/tensor_ref.h and cutlass/tensor_view.h for more details.
@@ -50,6 +53,7 @@
 #include "cutlass/fast_math.h"
 
 #include "device_memory.h"
+#include "host_tensor_storage.h"
 
 namespace cutlass {
 
@@ -60,7 +64,9 @@ template <
   /// Data type of element stored within tensor (concept: NumericType)
   typename Element_,
   /// Defines a mapping from logical coordinate to linear memory (concept: Layout)
-  typename Layout_
+  typename Layout_,
+  /// Host storage policy (concept: HostTensorStorage)
+  typename StoragePolicy_ = HostTensorDefaultStorage
 >
 class HostTensor {
 public:
@@ -71,6 +77,9 @@ public:
   /// Mapping function from logical coordinate to linear memory
   using Layout = Layout_;
 
+  /// Host storage policy
+  using StoragePolicy = StoragePolicy_;
+
   /// Logical rank of tensor index space
   static int const kRank = Layout::kRank;
 
@@ -134,11 +143,98 @@ public:
 
   /// Host-side memory allocation
   /// avoid the std::vector<bool> specialization
-  std::vector<std::conditional_t<std::is_same_v<Element,bool>, uint8_t, Element>> host_;
+  detail::HostStorageBuffer<
+    std::conditional_t<std::is_same_v<Element,bool>, uint8_t, Element>,
+    StoragePolicy::kKind,
+    StoragePolicy::kLazy> host_;
 
   /// Device-side memory
   device_memory::allocation<Element> device_;
 
+  /// Byte ranges modified in host memory since the last sync_device()
+  detail::DirtyRangeSet host_dirty_;
+
+  /// Byte ranges modified in device memory since the last sync_host()
+  detail::DirtyRangeSet device_dirty_;
+
+  /// False while a lazy host mirror holds no data, during which host changes are not tracked
+  bool host_tracked_ = true;
+
+  /// Byte range occupied by count elements starting at idx
+  static std::pair<size_t, size_t> byte_range(LongIndex idx, LongIndex count) {
+    size_t begin = size_t(idx) * sizeof_bits<Element>::value / 8;
+    size_t end = (size_t(idx + count) * sizeof_bits<Element>::value + 7) / 8;
+    return std::make_pair(begin, end);
+  }
+
+  /// Size of the allocation in bytes
+  size_t storage_bytes() const {
+    return host_.size() * sizeof(Element);
+  }
+
+  /// Adds count elements starting at idx to a dirty range set, clamped to the allocation
+  void add_dirty(detail::DirtyRangeSet &ranges, LongIndex idx, LongIndex count) {
+    if constexpr (StoragePolicy::kTrackDirty) {
+      std::pair<size_t, size_t> range = (count < 0) ?
+        std::make_pair(size_t(0), storage_bytes()) : byte_range(idx, count);
+      ranges.add(std::get<0>(range), std::min(std::get<1>(range), storage_bytes()));
+    }
+  }
+
+  /// Marks count elements starting at idx written on one side and cancels the bytes pending for
+  /// the other side that the write replaces entirely. Partially covered sub-byte storage stays.
+  void add_written(
+    detail::DirtyRangeSet &written,
+    detail::DirtyRangeSet &superseded,
+    LongIndex idx,
+    LongIndex count) {
+
+    if constexpr (StoragePolicy::kTrackDirty) {
+      add_dirty(written, idx, count);
+      if (count < 0) {
+        superseded.clear();
+      }
+      else {
+        superseded.remove(
+          (size_t(idx) * sizeof_bits<Element>::value + 7) / 8,
+          size_t(idx + count) * sizeof_bits<Element>::value / 8);
+      }
+    }
+  }
+
+  /// Starts tracking a lazy host mirror ahead of its first modification. The zero-filled mirror
+  /// then differs from every byte the device has not written since allocation.
+  void touch_host() {
+    if constexpr (StoragePolicy::kTrackDirty) {
+      if (!host_tracked_) {
+        host_tracked_ = true;
+        add_dirty(host_dirty_, 0, -1);
+        for (auto const &range : device_dirty_.ranges()) {
+          host_dirty_.remove(std::get<0>(range), std::get<1>(range));
+        }
+      }
+    }
+  }
+
+  /// Copies byte ranges between host and device memory
+  void copy_ranges(detail::DirtyRangeSet const &ranges, bool to_device) {
+    if (ranges.empty()) {
+      return;
+    }
+    uint8_t *host_bytes = reinterpret_cast<uint8_t *>(host_.data());
+    uint8_t *device_bytes = reinterpret_cast<uint8_t *>(device_.get());
+    for (auto const &range : ranges.ranges()) {
+      size_t begin = std::get<0>(range);
+      size_t bytes = std::get<1>(range) - begin;
+      if (to_device) {
+        device_memory::copy_to_device(device_bytes + begin, host_bytes + begin, bytes);
+      }
+      else {
+        device_memory::copy_to_host(host_bytes + begin, device_bytes + begin, bytes);
+      }
+    }
+  }
+
  public:
   //
   // Device and Host Methods
@@ -175,6 +271,9 @@ public:
 
     host_.clear();
     device_.reset();
+    host_dirty_.clear();
+    device_dirty_.clear();
+    host_tracked_ = true;
   }
 
   /// Resizes internal memory allocations without affecting layout or extent
@@ -194,6 +293,15 @@ public:
       device_memory = device_memory::allocate<Element>(count);
     }
     device_.reset(device_memory, device_backed_ ? count : 0);
+
+    // Host memory is zero-initialized and device memory is not, so the first sync_device()
+    // copies the entire tensor. A lazy mirror is marked by touch_host() once allocated.
+    host_dirty_.clear();
+    device_dirty_.clear();
+    host_tracked_ = host_.allocated();
+    if (host_tracked_) {
+      add_dirty(host_dirty_, 0, -1);
+    }
   }
 
   /// Updates the extent and layout of the HostTensor. Allocates memory according to the new
@@ -255,14 +363,20 @@ public:
   }
 
   /// Gets pointer to host data
-  Element * host_data() { return reinterpret_cast<Element *>(host_.data()); }
+  Element * host_data() {
+    touch_host();
+    add_dirty(host_dirty_, 0, -1);
+    return reinterpret_cast<Element *>(host_.data());
+  }
 
   /// Gets pointer to host data with a pointer offset
   Element * host_data_ptr_offset(LongIndex ptr_element_offset) { return &ReferenceFactory<Element>::get(host_data(), ptr_element_offset); }
 
   /// Gets a reference to an element in host memory
   Reference host_data(LongIndex idx) {
-    return ReferenceFactory<Element>::get(host_data(), idx);
+    touch_host();
+    add_dirty(host_dirty_, idx, 1);
+    return ReferenceFactory<Element>::get(reinterpret_cast<Element *>(host_.data()), idx);
   }
 
   /// Gets pointer to host data
@@ -277,7 +391,12 @@ public:
   }
 
   /// Gets pointer to device data
-  Element * device_data() { return device_.get(); }
+  Element * device_data() {
+    if (device_backed()) {
+      add_dirty(device_dirty_, 0, -1);
+    }
+    return device_.get();
+  }
 
   /// Gets pointer to device data
   Element const * device_data() const { return device_.get(); }
@@ -385,19 +504,67 @@ public:
     return extent_;
   }
 
+  /// Returns true if the host mirror has been allocated. Lazy storage allocates it on first access.
+  bool host_allocated() const {
+    return host_.allocated();
+  }
+
+  /// Byte ranges modified in host memory since the last sync_device()
+  detail::DirtyRangeSet const & host_dirty_ranges() const {
+    return host_dirty_;
+  }
+
+  /// Byte ranges modified in device memory since the last sync_host()
+  detail::DirtyRangeSet const & device_dirty_ranges() const {
+    return device_dirty_;
+  }
+
+  /// Records that count elements starting at idx were modified in host memory. A negative count
+  /// marks the entire tensor. The write supersedes device modifications of the same elements.
+  void mark_host_dirty(LongIndex idx = 0, LongIndex count = -1) {
+    touch_host();
+    add_written(host_dirty_, device_dirty_, idx, count);
+  }
+
+  /// Records that count elements starting at idx were modified in device memory. A negative count
+  /// marks the entire tensor. The write supersedes host modifications of the same elements.
+  void mark_device_dirty(LongIndex idx = 0, LongIndex count = -1) {
+    if (device_backed()) {
+      add_written(device_dirty_, host_dirty_, idx, count);
+    }
+  }
+
   /// Copies data from device to host
   void sync_host() {
     if (device_backed()) {
-      device_memory::copy_to_host(
-          host_data(), device_data(), size());
+      if constexpr (StoragePolicy::kTrackDirty) {
+        if (!host_tracked_) {
+          // The host mirror holds no data yet
+          host_tracked_ = true;
+          device_dirty_.clear();
+          add_dirty(device_dirty_, 0, -1);
+        }
+        copy_ranges(device_dirty_, false);
+        device_dirty_.clear();
+      }
+      else {
+        device_memory::copy_to_host(
+            reinterpret_cast<Element *>(host_.data()), device_.get(), size());
+      }
     }
   }
 
   /// Copies data from host to device
   void sync_device() {
     if (device_backed()) {
-      device_memory::copy_to_device(
-          device_data(), host_data(), size());
+      if constexpr (StoragePolicy::kTrackDirty) {
+        copy_ranges(host_dirty_, true);
+        host_dirty_.clear();
+      }
+      else {
+        device_memory::copy_to_device(
+            device_.get(), reinterpret_cast<Element const *>(host_.data()), size());
+      }
     }
   }
 
@@ -412,8 +579,9 @@ public:
     else {
       count = __NV_STD_MIN(capacity(), count);
     }
+    mark_host_dirty(0, count);
     device_memory::copy_to_host(
-      host_data(), ptr_device, count);
+      reinterpret_cast<Element *>(host_.data()), ptr_device, count);
   }
 
   /// Copy data from a caller-supplied device pointer into host memory.
@@ -427,8 +595,9 @@ public:
     else {
       count = __NV_STD_MIN(capacity(), count);
     }
+    mark_device_dirty(0, count);
     device_memory::copy_device_to_device(
-      device_data(), ptr_device, count);
+      device_.get(), ptr_device, count);
   }
 
   /// Copy data from a caller-supplied device pointer into host memory.
@@ -442,8 +611,9 @@ public:
     else {
       count = __NV_STD_MIN(capacity(), count);
     }
+    mark_device_dirty(0, count);
     device_memory::copy_to_device(
-      device_data(), ptr_host, count);
+      device_.get(), ptr_host, count);
   }
 
   /// Copy data from a caller-supplied device pointer into host memory.
@@ -457,8 +627,9 @@ public:
     else {
       count = __NV_STD_MIN(capacity(), count);
     }
+    mark_host_dirty(0, count);
     device_memory::copy_host_to_host(
-      host_data(), ptr_host, count);
+      reinterpret_cast<Element *>(host_.data()), ptr_host, count);
   }
 
   /// Copy data from a caller-supplied device pointer into host memory.
@@ -0,0 +1,398 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Host storage policies for HostTensor.
+
+    HostTensorStorage selects how HostTensor allocates its host mirror and how it synchronizes the
+    mirror with device memory.
+
+    - Kind chooses the allocation: a std::vector (the default), an anonymous memory mapping,
+      an anonymous mapping advised to use transparent huge pages, or a mapping of an unlinked
+      temporary file so that the kernel can write cold pages back to disk rather than to swap.
+      Mapped storage is zero-filled and is committed page by page on first touch.
+
+    - Lazy defers allocating the host mirror until host memory is first accessed, so tensors
+      used only on the device never occupy host memory.
+
+    - TrackDirty records the byte ranges modified on each side since the last synchronization.
+      sync_device() and sync_host() then copy only those ranges. Non-const host and device
+      accessors conservatively mark the whole tensor modified; at() and host_data(idx) mark a
+      single element, and callers may narrow further with mark_host_dirty()/mark_device_dirty().
+      Writes through a pointer obtained before the most recent synchronization must be announced
+      explicitly with mark_host_dirty() or mark_device_dirty(). Explicit writes to one side
+      (the copy_in_*() methods and mark_*_dirty()) cancel ranges pending for the other side.
+      An unallocated lazy mirror records no host changes; when first touched it marks every byte
+      the device has not written since allocation.
+
+    Mapped storage falls back to zero-initialized heap memory on platforms without mmap().
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define CUTLASS_HOST_STORAGE_MMAP 1
+#else
+#define CUTLASS_HOST_STORAGE_MMAP 0
+#endif
+
+#include "cutlass/cutlass.h"
+
+namespace cutlass {
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Kind of allocation backing the host mirror of a HostTensor
+enum class HostStorageKind {
+  kVector,                ///< std::vector
+  kAnonymous,             ///< anonymous private memory mapping
+  kHugePages,             ///< anonymous mapping advised to use transparent huge pages
+  kFile                   ///< shared mapping of an unlinked temporary file
+};
+
+/// Storage policy of HostTensor
+template <
+  HostStorageKind Kind = HostStorageKind::kVector,
+  bool Lazy = false,
+  bool TrackDirty = false
+>
+struct HostTensorStorage {
+  static HostStorageKind const kKind = Kind;
+  static bool const kLazy = Lazy;
+  static bool const kTrackDirty = TrackDirty;
+};
+
+/// Eagerly allocated std::vector synchronized in full (the historical behavior)
+using HostTensorDefaultStorage = HostTensorStorage<>;
+
+/// Huge-page mapping allocated on first host access and synchronized by modified ranges
+using HostTensorMappedStorage = HostTensorStorage<HostStorageKind::kHugePages, true, true>;
+
+/// File-backed mapping allocated on first host access and synchronized by modified ranges
+using HostTensorFileMappedStorage = HostTensorStorage<HostStorageKind::kFile, true, true>;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Set of disjoint half-open byte ranges. Beyond kMaxRanges entries, ranges collapse to their hull.
+class DirtyRangeSet {
+public:
+
+  static int const kMaxRanges = 32;
+
+  using Range = std::pair<size_t, size_t>;
+
+private:
+
+  std::vector<Range> ranges_;
+
+public:
+
+  /// Adds the range [begin, end)
+  void add(size_t begin, size_t end) {
+    if (begin >= end) {
+      return;
+    }
+
+    // First range whose end reaches begin; ranges that touch are merged
+    auto it = std::lower_bound(ranges_.begin(), ranges_.end(), begin,
+      [](Range const &range, size_t value) { return std::get<1>(range) < value; });
+
+    auto last = it;
+    while (last != ranges_.end() && std::get<0>(*last) <= end) {
+      begin = std::min(begin, std::get<0>(*last));
+      end = std::max(end, std::get<1>(*last));
+      ++last;
+    }
+
+    it = ranges_.erase(it, last);
+    ranges_.insert(it, Range(begin, end));
+
+    if (int(ranges_.size()) > kMaxRanges) {
+      Range hull(std::get<0>(ranges_.front()), std::get<1>(ranges_.back()));
+      ranges_.assign(1, hull);
+    }
+  }
+
+  /// Removes the range [begin, end), splitting ranges that contain it. Unlike add(), the result
+  /// never collapses to a hull, since that would mark bytes the caller just removed.
+  void remove(size_t begin, size_t end) {
+    if (begin >= end) {
+      return;
+    }
+
+    std::vector<Range> kept;
+    kept.reserve(ranges_.size() + 1);
+    for (auto const &range : ranges_) {
+      if (std::get<1>(range) <= begin || std::get<0>(range) >= end) {
+        kept.push_back(range);
+        continue;
+      }
+      if (std::get<0>(range) < begin) {
+        kept.push_back(Range(std::get<0>(range), begin));
+      }
+      if (std::get<1>(range) > end) {
+        kept.push_back(Range(end, std::get<1>(range)));
+      }
+    }
+    ranges_.swap(kept);
+  }
+
+  void clear() {
+    ranges_.clear();
+  }
+
+  bool empty() const {
+    return ranges_.empty();
+  }
+
+  /// Total number of bytes covered
+  size_t bytes() const {
+    size_t total = 0;
+    for (auto const &range : ranges_) {
+      total += std::get<1>(range) - std::get<0>(range);
+    }
+    return total;
+  }
+
+  std::vector<Range> const &ranges() const {
+    return ranges_;
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Host allocation of count objects of trivially copyable type T, zero-initialized
+template <typename T, HostStorageKind Kind, bool Lazy>
+class HostStorageBuffer {
+private:
+
+  mutable std::vector<T> vector_;
+
+  mutable T *mapping_ = nullptr;
+  mutable size_t mapping_bytes_ = 0;
+  size_t count_ = 0;
+
+  static size_t page_round(size_t bytes) {
+#if CUTLASS_HOST_STORAGE_MMAP
+    size_t page = size_t(::sysconf(_SC_PAGESIZE));
+    return (bytes + page - 1) / page * page;
+#else
+    return bytes;
+#endif
+  }
+
+  /// Directory holding the temporary files of file-backed storage
+  static std::string file_directory() {
+    char const *env = std::getenv("CUTLASS_HOST_TENSOR_MAP_DIR");
+    if (env && *env) {
+      return std::string(env);
+    }
+    env = std::getenv("TMPDIR");
+    return std::string(env && *env ? env : "/tmp");
+  }
+
+  /// Creates the mapping for Kind != kVector
+  void map() const {
+    size_t bytes = page_round(count_ * sizeof(T));
+    if (!bytes) {
+      return;
+    }
+
+    void *ptr = nullptr;
+
+#if CUTLASS_HOST_STORAGE_MMAP
+    if (Kind == HostStorageKind::kFile) {
+      std::string path = file_directory() + "/cutlass_host_tensor_XXXXXX";
+      std::vector<char> name(path.begin(), path.end());
+      name.push_back('\0');
+
+      int fd = ::mkstemp(name.data());
+      if (fd < 0) {
+        throw std::bad_alloc();
+      }
+      ::unlink(name.data());
+
+      if (::ftruncate(fd, off_t(bytes)) == 0) {
+        ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+    }
+    else {
+      ptr = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    }
+
+    if (ptr == MAP_FAILED || !ptr) {
+      throw std::bad_alloc();
+    }
+
+#if defined(MADV_HUGEPAGE)
+    if (Kind == HostStorageKind::kHugePages) {
+      // Advisory only; the mapping remains valid if huge pages are unavailable
+      ::madvise(ptr, bytes, MADV_HUGEPAGE);
+    }
+#endif
+#else
+    ptr = std::calloc(bytes, 1);
+    if (!ptr) {
+      throw std::bad_alloc();
+    }
+#endif
+
+    mapping_ = static_cast<T *>(ptr);
+    mapping_bytes_ = bytes;
+  }
+
+  void unmap() {
+    if (mapping_) {
+#if CUTLASS_HOST_STORAGE_MMAP
+      ::munmap(mapping_, mapping_bytes_);
+#else
+      std::free(mapping_);
+#endif
+    }
+    mapping_ = nullptr;
+    mapping_bytes_ = 0;
+  }
+
+  void allocate() const {
+    if (Kind == HostStorageKind::kVector) {
+      vector_.resize(count_);
+    }
+    else {
+      map();
+    }
+  }
+
+public:
+
+  HostStorageBuffer() { }
+
+  HostStorageBuffer(HostStorageBuffer const &rhs) {
+    *this = rhs;
+  }
+
+  HostStorageBuffer(HostStorageBuffer &&rhs) noexcept {
+    *this = std::move(rhs);
+  }
+
+  /// Deep copy. An unallocated lazy buffer copies as unallocated.
+  HostStorageBuffer &operator=(HostStorageBuffer const &rhs) {
+    if (this != &rhs) {
+      clear();
+      count_ = rhs.count_;
+      if (rhs.count_ && rhs.allocated()) {
+        allocate();
+        std::memcpy(data(), rhs.data(), count_ * sizeof(T));
+      }
+      else if (!Lazy) {
+        allocate();
+      }
+    }
+    return *this;
+  }
+
+  HostStorageBuffer &operator=(HostStorageBuffer &&rhs) noexcept {
+    if (this != &rhs) {
+      clear();
+      vector_ = std::move(rhs.vector_);
+      mapping_ = rhs.mapping_;
+      mapping_bytes_ = rhs.mapping_bytes_;
+      count_ = rhs.count_;
+      rhs.mapping_ = nullptr;
+      rhs.mapping_bytes_ = 0;
+      rhs.count_ = 0;
+      rhs.vector_.clear();
+    }
+    return *this;
+  }
+
+  ~HostStorageBuffer() {
+    unmap();
+  }
+
+  /// Number of objects
+  size_t size() const {
+    return count_;
+  }
+
+  /// True if host memory has been allocated
+  bool allocated() const {
+    return count_ == 0 || !vector_.empty() || mapping_ != nullptr;
+  }
+
+  /// Releases the allocation
+  void clear() {
+    vector_.clear();
+    vector_.shrink_to_fit();
+    unmap();
+    count_ = 0;
+  }
+
+  /// Replaces the allocation with count zero-initialized objects
+  void resize(size_t count) {
+    clear();
+    count_ = count;
+    if (!Lazy) {
+      allocate();
+    }
+  }
+
+  /// Pointer to the allocation, allocating it first for lazy storage
+  T *data() const {
+    if (!allocated()) {
+      allocate();
+    }
+    if (Kind == HostStorageKind::kVector) {
+      return vector_.data();
+    }
+    return mapping_;
+  }
+};
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,122 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Counter-based Philox4x32-10 random number generator.
+
+    Philox (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3", SC 2011) maps a 128-bit
+    counter and a 64-bit key to 128 random bits. Random fills key the generator with the seed and
+    place the linear element index in the counter, so every element is a pure function of
+    (seed, index) and may be generated in any order on any number of threads.
+
+    The counter is laid out as {draw, 0, index_lo, index_hi}. This is the state that
+    curand_init(seed, index, 0, &state) establishes for curandStatePhilox4_32_10_t, so the k-th
+    curand4() call of such a state returns Philox4x32::generate(seed, index, k).
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "cutlass/cutlass.h"
+#include "cutlass/array.h"
+
+namespace cutlass {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Philox4x32-10 block function
+struct Philox4x32 {
+
+  static uint32_t const kMultiplier0 = 0xD2511F53u;
+  static uint32_t const kMultiplier1 = 0xCD9E8D57u;
+  static uint32_t const kWeyl0 = 0x9E3779B9u;
+  static uint32_t const kWeyl1 = 0xBB67AE85u;
+  static int const kRounds = 10;
+
+  /// Applies the block function to an arbitrary counter and key
+  CUTLASS_HOST_DEVICE
+  static Array<uint32_t, 4> block(Array<uint32_t, 4> counter, Array<uint32_t, 2> key) {
+
+    CUTLASS_PRAGMA_UNROLL
+    for (int round = 0; round < kRounds; ++round) {
+      uint64_t product0 = uint64_t(kMultiplier0) * counter[0];
+      uint64_t product1 = uint64_t(kMultiplier1) * counter[2];
+
+      Array<uint32_t, 4> next;
+      next[0] = uint32_t(product1 >> 32) ^ counter[1] ^ key[0];
+      next[1] = uint32_t(product1);
+      next[2] = uint32_t(product0 >> 32) ^ counter[3] ^ key[1];
+      next[3] = uint32_t(product0);
+      counter = next;
+
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+
+    return counter;
+  }
+
+  /// Returns the 128 random bits of the given draw for the element at a linear index
+  CUTLASS_HOST_DEVICE
+  static Array<uint32_t, 4> generate(uint64_t seed, uint64_t index, uint32_t draw = 0) {
+
+    Array<uint32_t, 4> counter;
+    counter[0] = draw;
+    counter[1] = 0;
+    counter[2] = uint32_t(index);
+    counter[3] = uint32_t(index >> 32);
+
+    Array<uint32_t, 2> key;
+    key[0] = uint32_t(seed);
+    key[1] = uint32_t(seed >> 32);
+
+    return block(counter, key);
+  }
+
+  /// Converts 64 random bits to a double uniformly distributed in the open interval (0, 1)
+  CUTLASS_HOST_DEVICE
+  static double to_uniform_double(uint32_t lo, uint32_t hi) {
+    uint64_t bits = ((uint64_t(hi) << 32) | lo) >> 11;
+    return (double(bits) + 0.5) * (1.0 / 9007199254740992.0);   // 2^-53
+  }
+
+  /// Converts 32 random bits to a double uniformly distributed in [0, 1)
+  CUTLASS_HOST_DEVICE
+  static double to_unit_double(uint32_t bits) {
+    return double(bits) * (1.0 / 4294967296.0);   // 2^-32
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
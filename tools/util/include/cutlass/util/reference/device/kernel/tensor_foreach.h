@@ -36,6 +36,11 @@
 #include "cutlass/subbyte_reference.h"
 #include "cutlass/fast_math.h"
 
+#if !defined(__CUDACC_RTC__)
+#include <type_traits>
+#include <utility>
+#endif
+
 namespace cutlass {
 namespace reference {
 namespace device {
@@ -92,6 +97,13 @@ struct TensorForEachHelper<Func, Rank, 0> {
   }
 };
 
+/// True if Func supplies a value for an explicit linear index via func(uint64_t)
+template <typename Func, typename = void>
+struct IsIndexedGenerator : std::false_type { };
+
+template <typename Func>
+struct IsIndexedGenerator<Func, decltype((void)std::declval<Func const &>()(uint64_t(0)))> : std::true_type { };
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -153,6 +165,7 @@ __global__ void
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Kernel fills a block with func(index) for functors keyed by the linear index, else with func()
 template <typename Element, typename Func>
 #if defined (CUTLASS_ENABLE_SYCL)
 void
@@ -169,7 +182,12 @@ __global__ void
   size_t index = ThreadIdxX() + BlockIdxX() * BlockDimX();
 
   for (; index < capacity; index += BlockDimX() * GridDimX()) {
-    ReferenceFactory<Element>::get(ptr, index) = func();
+    if constexpr (detail::IsIndexedGenerator<Func>::value) {
+      ReferenceFactory<Element>::get(ptr, index) = func(uint64_t(index));
+    }
+    else {
+      ReferenceFactory<Element>::get(ptr, index) = func();
+    }
   }
 }
 
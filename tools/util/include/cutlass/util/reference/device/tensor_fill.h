@@ -48,9 +48,6 @@
 
 #endif
 
-// CUDA includes
-#include <curand_kernel.h>
-
 // Cutlass includes
 #include "cutlass/cutlass.h"
 #include "cutlass/array.h"
@@ -62,6 +59,7 @@
 
 #include "cutlass/util/reference/device/tensor_foreach.h"
 #include "cutlass/util/distribution.h"
+#include "cutlass/util/philox.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -74,36 +72,33 @@ namespace device {
 
 namespace detail {
 
-template <typename FloatType>
-CUTLASS_DEVICE
-FloatType random_normal_float(curandState_t *state) {
-  return curand_normal(state);
-}
+/// Value of pi used by the Box-Muller transform. This is the double nearest to pi, which is what
+/// the host fills obtain from std::acos(-1).
+static double const kRandomFillPi = 3.14159265358979323846;
 
-template <>
-CUTLASS_DEVICE
-double random_normal_float<double>(curandState_t *state) {
-  return curand_normal_double(state);
-}
+/// Linear index of a coordinate within an extent, with the last rank changing fastest. Random
+/// fills key the Philox generator with this index exactly as reference::host does, so a tensor
+/// filled on the host or on the device with the same seed holds the same values.
+template <int Rank, typename Index, typename LongIndex>
+CUTLASS_HOST_DEVICE
+uint64_t TensorLinearIndex(
+  Coord<Rank, Index, LongIndex> const &coord,
+  Coord<Rank, Index, LongIndex> const &extent) {
 
-template <typename FloatType>
-CUTLASS_DEVICE
-FloatType random_uniform_float(curandState_t *state) {
-  return curand_uniform(state);
-}
+  uint64_t index = 0;
 
-template <>
-CUTLASS_DEVICE
-double random_uniform_float<double>(curandState_t *state) {
-  return curand_uniform_double(state);
+  CUTLASS_PRAGMA_UNROLL
+  for (int i = 0; i < Rank; ++i) {
+    index = index * uint64_t(extent[i]) + uint64_t(coord[i]);
+  }
+  return index;
 }
 
+/// Gaussian random values keyed by (seed, linear index) via the Philox generator. Mirrors
+/// reference::host::detail::RandomGaussianFunc with all nonzero probability.
 template <typename Element>
 struct RandomGaussianFunc {
 
-  using FloatType = typename std::conditional<(sizeof(Element) > 4), double, float>::type;
-  using IntType = typename std::conditional<(sizeof(Element) > 4), int64_t, int>::type;
-
   /// Parameters structure
   struct Params {
 
@@ -112,11 +107,13 @@ struct RandomGaussianFunc {
     //
 
     uint64_t seed;
-    FloatType mean;
-    FloatType stddev;
+    double mean;
+    double stddev;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
+
+    /// Default ctor
+    CUTLASS_HOST_DEVICE
+    Params() { }
 
     //
     // Methods
@@ -125,17 +122,15 @@ struct RandomGaussianFunc {
     /// Construction of Gaussian RNG functor.
     Params(
       uint64_t seed_ = 0,
-      Element mean_ = 0, 
+      Element mean_ = 0,
       Element stddev_ = 1,
       int int_scale_ = -1
     ):
-      seed(seed_), 
-      mean(static_cast<FloatType>(mean_)), 
-      stddev(static_cast<FloatType>(stddev_)), 
+      seed(seed_),
+      mean(static_cast<double>(mean_)),
+      stddev(static_cast<double>(stddev_)),
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(2) << int_scale); // scale up to clamp low order bits
-      float_scale_down = FloatType(1) / FloatType(IntType(2) << int_scale);
     }
   };
 
@@ -146,39 +141,32 @@ struct RandomGaussianFunc {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomGaussianFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a linear index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
 
-    FloatType rnd = random_normal_float<FloatType>(&rng_state);
+    // Box-Muller transform to generate random numbers with Normal distribution
+    Array<uint32_t, 4> bits = Philox4x32::generate(params.seed, index);
+    double u1 = Philox4x32::to_uniform_double(bits[0], bits[1]);
+    double u2 = Philox4x32::to_uniform_double(bits[2], bits[3]);
+
+    double rnd = ::sqrt(-2 * ::log(u1)) * ::cos(2 * kRandomFillPi * u2);
     rnd = params.mean + params.stddev * rnd;
 
-    Element result;
     if (params.int_scale >= 0) {
-      rnd = FloatType(IntType(std::llround(rnd * params.float_scale_up)));
-      result = Element(IntType(rnd * params.float_scale_down));
-    }
-    else {
-      result = Element(rnd);
+      rnd = double(::llround(rnd * double(1 << params.int_scale))) / double(1 << params.int_scale);
     }
 
-    return result;
+    return static_cast<Element>(rnd);
   }
 };
 
@@ -187,8 +175,6 @@ template <typename Real>
 struct RandomGaussianFunc<complex<Real>> {
 
   using Element = complex<Real>;
-  using FloatType = typename std::conditional<(sizeof(Real) > 4), double, float>::type;
-  using IntType = typename std::conditional<(sizeof(Real) > 4), int64_t, int>::type;
 
   /// Parameters structure
   struct Params {
@@ -198,11 +184,13 @@ struct RandomGaussianFunc<complex<Real>> {
     //
 
     uint64_t seed;
-    FloatType mean;
-    FloatType stddev;
+    double mean;
+    double stddev;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
+
+    /// Default ctor
+    CUTLASS_HOST_DEVICE
+    Params() { }
 
     //
     // Methods
@@ -211,18 +199,15 @@ struct RandomGaussianFunc<complex<Real>> {
     /// Construction of Gaussian RNG functor.
     Params(
       uint64_t seed_ = 0,
-      Real mean_ = 0, 
+      Real mean_ = 0,
       Real stddev_ = 1,
       int int_scale_ = -1
     ):
-      seed(seed_), 
-      mean(static_cast<FloatType>(mean_)), 
-      stddev(static_cast<FloatType>(stddev_)), 
+      seed(seed_),
+      mean(static_cast<double>(mean_)),
+      stddev(static_cast<double>(stddev_)),
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(1) << int_scale);
-      float_scale_up += FloatType(0.5) * float_scale_up;
-      float_scale_down = FloatType(1) / FloatType(IntType(1) << int_scale);
     }
   };
 
@@ -233,46 +218,41 @@ struct RandomGaussianFunc<complex<Real>> {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomGaussianFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a linear index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
 
-    FloatType rnd_r = random_normal_float<FloatType>(&rng_state);
-    FloatType rnd_i = random_normal_float<FloatType>(&rng_state);
-    rnd_r = params.mean + params.stddev * rnd_r;
-    rnd_i = params.mean + params.stddev * rnd_i;
+    // Both parts come from one Box-Muller pair
+    Array<uint32_t, 4> bits = Philox4x32::generate(params.seed, index);
+    double u1 = Philox4x32::to_uniform_double(bits[0], bits[1]);
+    double u2 = Philox4x32::to_uniform_double(bits[2], bits[3]);
 
-    Element result;
-    if (params.int_scale >= 0) {
-      rnd_r = FloatType(IntType(rnd_r * params.float_scale_up));
-      rnd_i = FloatType(IntType(rnd_i * params.float_scale_down));
+    double rnd[2];
+    rnd[0] = ::sqrt(-2 * ::log(u1)) * ::cos(2 * kRandomFillPi * u2);
+    rnd[1] = ::sqrt(-2 * ::log(u1)) * ::sin(2 * kRandomFillPi * u2);
 
-      result = {
-        Real(rnd_r * params.float_scale_down),
-        Real(rnd_i * params.float_scale_down)
-      };
-    }
-    else {
-      result = Element(Real(rnd_r), Real(rnd_i));
+    Real reals[2];
+
+    CUTLASS_PRAGMA_UNROLL
+    for (int i = 0; i < 2; ++i) {
+      rnd[i] = params.mean + params.stddev * rnd[i];
+
+      if (params.int_scale >= 0) {
+        rnd[i] = double(int(rnd[i] * double(1 << params.int_scale))) / double(1 << params.int_scale);
+      }
+      reals[i] = from_real<Real>(rnd[i]);
     }
 
-    return result;
+    return Element(reals[0], reals[1]);
   }
 };
 
@@ -328,17 +308,16 @@ struct TensorFillRandomGaussianFunc {
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   TensorFillRandomGaussianFunc(Params const &params): params(params), random(params.random) {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a coordinate
   CUTLASS_DEVICE
   void operator()(TensorCoord const &coord) {
 
-    params.view.at(coord) = random();
+    params.view.at(coord) = random(TensorLinearIndex(coord, params.view.extent()));
   }
 };
 
@@ -399,19 +378,12 @@ void BlockFillRandomGaussian(
 
 namespace detail {
 
-/// Computes a random Gaussian distribution
-template <typename Element>                ///< Element type 
+/// Uniform random values keyed by (seed, linear index) via the Philox generator. Mirrors
+/// reference::host::detail::RandomUniformFunc.
+template <typename Element>                ///< Element type
 struct RandomUniformFunc {
 
-  using FloatType = typename std::conditional<
-    (sizeof(Element) > 4),
-    double,
-    float>::type;
-
-  using IntType = typename std::conditional<
-    (sizeof(Element) > 4),
-    int64_t,
-    int>::type;
+  using Real = typename RealType<Element>::Type;
 
   /// Parameters structure
   struct Params {
@@ -421,11 +393,9 @@ struct RandomUniformFunc {
     //
 
     uint64_t seed;
-    FloatType range;
-    FloatType max;
+    double range;
+    double min;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
 
     /// Default ctor
     CUTLASS_HOST_DEVICE
@@ -435,20 +405,18 @@ struct RandomUniformFunc {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of uniform RNG functor.
     Params(
-      uint64_t seed_ = 0, 
-      Element max_ = 1,
-      Element min = 0,
+      uint64_t seed_ = 0,
+      Element max = 1,
+      Element min_ = 0,
       int int_scale_ = -1
     ):
-      seed(seed_), 
-      range(static_cast<FloatType>(max_ - min)), 
-      max(static_cast<FloatType>(max_)),
+      seed(seed_),
+      range(static_cast<double>(max) - static_cast<double>(min_)),
+      min(static_cast<double>(min_)),
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(2) << int_scale); // scale up to clamp low order bits
-      float_scale_down = FloatType(1) / FloatType(IntType(2) << int_scale);
     }
   };
 
@@ -459,61 +427,40 @@ struct RandomUniformFunc {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomUniformFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a linear index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
+
+    Array<uint32_t, 4> bits = Philox4x32::generate(params.seed, index);
+    double rnd = Philox4x32::to_uniform_double(bits[0], bits[1]);
 
-    FloatType rnd = random_uniform_float<FloatType>(&rng_state);
-    rnd = params.max - params.range * rnd;
+    rnd = params.min + params.range * rnd;
 
     // Random values are cast to integer after scaling by a power of two to facilitate error
     // testing
-    Element result;
-
     if (params.int_scale >= 0) {
-      rnd = FloatType(IntType(std::llround(rnd * params.float_scale_up)));
-      result = Element(IntType(rnd * params.float_scale_down));
-    }
-    else {
-      result = Element(rnd);
+      rnd = double(::llround(rnd * double(1 << params.int_scale))) / double(1 << params.int_scale);
     }
 
-    return result;
+    return static_cast<Element>(Real(rnd));
   }
 };
 
-/// Computes a random Gaussian distribution
+/// Partial specialization for initializing a complex value.
 template <typename Real>
 struct RandomUniformFunc<complex<Real>> {
 
   using Element = complex<Real>;
 
-  using FloatType = typename std::conditional<
-    (sizeof(Real) > 4),
-    double,
-    float>::type;
-
-  using IntType = typename std::conditional<
-    (sizeof(Real) > 4),
-    int64_t,
-    int>::type;
-
   /// Parameters structure
   struct Params {
 
@@ -522,11 +469,9 @@ struct RandomUniformFunc<complex<Real>> {
     //
 
     uint64_t seed;
-    FloatType range;
-    FloatType min;
+    double range;
+    double min;
     int int_scale;
-    FloatType float_scale_up;
-    FloatType float_scale_down;
 
     /// Default ctor
     CUTLASS_HOST_DEVICE
@@ -536,21 +481,18 @@ struct RandomUniformFunc<complex<Real>> {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of uniform RNG functor.
     Params(
-      uint64_t seed_ = 0, 
-      FloatType max = 1,
-      FloatType min_ = 0,
+      uint64_t seed_ = 0,
+      double max = 1,
+      double min_ = 0,
       int int_scale_ = -1
     ):
-      seed(seed_), 
-      range(static_cast<FloatType>(max - min_)), 
-      min(static_cast<FloatType>(min_)), 
+      seed(seed_),
+      range(max - min_),
+      min(min_),
       int_scale(int_scale_) {
 
-      float_scale_up = FloatType(IntType(1) << int_scale);
-      float_scale_up += FloatType(0.5) * float_scale_up;
-      float_scale_down = FloatType(1) / FloatType(IntType(1) << int_scale);
     }
   };
 
@@ -561,54 +503,45 @@ struct RandomUniformFunc<complex<Real>> {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomUniformFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a linear index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
 
-    FloatType rnd_r = random_uniform_float<FloatType>(&rng_state);
-    FloatType rnd_i = random_uniform_float<FloatType>(&rng_state);
+    Array<uint32_t, 4> bits = Philox4x32::generate(params.seed, index);
 
-    rnd_r = params.min + params.range * rnd_r;
-    rnd_i = params.min + params.range * rnd_i;
+    Real reals[2];
 
-    // Random values are cast to integer after scaling by a power of two to facilitate error
-    // testing
-    Element result;
+    CUTLASS_PRAGMA_UNROLL
+    for (int i = 0; i < 2; ++i) {
+      double rnd = Philox4x32::to_uniform_double(bits[2 * i], bits[2 * i + 1]);
 
-    if (params.int_scale >= 0) {
-      rnd_r = FloatType(IntType(rnd_r * params.float_scale_up));
-      rnd_i = FloatType(IntType(rnd_i * params.float_scale_up));
+      rnd = params.min + params.range * rnd;
 
-      result = {
-        Real(rnd_r * params.float_scale_down),
-        Real(rnd_i * params.float_scale_down)
-      };
-    }
-    else {
-      result = Element(Real(rnd_r), Real(rnd_i));
+      // Random values are cast to integer after scaling by a power of two to facilitate error
+      // testing
+      if (params.int_scale >= 0) {
+        rnd = double(int(rnd * double(1 << params.int_scale)));
+        reals[i] = from_real<Real>(Real(rnd / double(1 << params.int_scale)));
+      }
+      else {
+        reals[i] = from_real<Real>(Real(rnd));
+      }
     }
 
-    return result;
+    return Element(reals[0], reals[1]);
   }
 };
 
-/// Computes a random Gaussian distribution
+/// Computes a random uniform distribution
 template <
   typename Element,               ///< Element type
   typename Layout>                ///< Layout function
@@ -643,7 +576,7 @@ struct TensorFillRandomUniformFunc {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of uniform RNG functor.
     Params(
       TensorView view_ = TensorView(),
       typename RandomFunc::Params random_ = RandomFunc::Params()
@@ -664,16 +597,15 @@ struct TensorFillRandomUniformFunc {
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   TensorFillRandomUniformFunc(Params const &params): params(params), random(params.random) {
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a coordinate
   CUTLASS_DEVICE
   void operator()(TensorCoord const &coord) {
 
-    params.view.at(coord) = random();
+    params.view.at(coord) = random(TensorLinearIndex(coord, params.view.extent()));
   }
 };
 
@@ -736,14 +668,11 @@ void BlockFillRandomUniform(
 
 namespace detail {
 
-/// Computes a random sparse meta 
+/// Computes a random sparse meta keyed by (seed, linear index) via the Philox generator. Mirrors
+/// reference::host::detail::RandomSparseMetaFunc.
 template <typename Element>               ///< Element type
 struct RandomSparseMetaFunc {
 
-  using FloatType = float;
-
-  using IntType = int32_t;
-
   /// Parameters structure
   struct Params {
 
@@ -752,7 +681,7 @@ struct RandomSparseMetaFunc {
     //
 
     uint64_t seed;
-    FloatType range;
+    int range;
     int MetaSizeInBits;
 
     /// Default ctor
@@ -763,12 +692,12 @@ struct RandomSparseMetaFunc {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of sparse meta RNG functor.
     Params(
-      uint64_t seed_ = 0, 
-      int MetaSizeInBits_ = 2 
+      uint64_t seed_ = 0,
+      int MetaSizeInBits_ = 2
     ):
-      seed(seed_), 
+      seed(seed_),
       MetaSizeInBits(MetaSizeInBits_) {
       if (MetaSizeInBits_ == 2) {
         range = 6;
@@ -789,25 +718,18 @@ struct RandomSparseMetaFunc {
   /// Parameters object
   Params params;
 
-  /// RNG state object
-  curandState_t rng_state;
-
   //
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   RandomSparseMetaFunc(Params const &params): params(params) {
 
-    uint64_t gtid = threadIdx.x + blockIdx.x * blockDim.x;
-
-    curand_init(params.seed, gtid, 0, &rng_state);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a linear index
   CUTLASS_DEVICE
-  Element operator()() {
+  Element operator()(uint64_t index) const {
     Element FourToTwoMeta[6] = {0x4, 0x8, 0x9, 0xc, 0xd, 0xe};
     Element TwoToOneMeta[2] = {0x4, 0xe};
 
@@ -816,11 +738,17 @@ struct RandomSparseMetaFunc {
 
     Element result = 0x0;
 
+    // Each 4b field selects a metadata pattern using 16 random bits
+    Array<uint32_t, 4> bits;
+
     CUTLASS_PRAGMA_UNROLL
     for (int i = 0; i < cutlass::sizeof_bits<Element>::value / 4; ++i) {
-      FloatType rnd = random_uniform_float<FloatType>(&rng_state);
-      rnd = params.range * rnd;
-      Element meta = MetaArray[(int)rnd];
+      if (i % 8 == 0) {
+        bits = Philox4x32::generate(params.seed, index, uint32_t(i / 8));
+      }
+      uint32_t field = (bits[(i % 8) / 2] >> (16 * (i % 2))) & 0xffff;
+      int rnd = int((field * uint32_t(params.range)) >> 16);
+      Element meta = MetaArray[rnd];
 
       result = (Element)(result | ((Element)(meta << (i * 4))));
     }
@@ -829,7 +757,7 @@ struct RandomSparseMetaFunc {
   }
 };
 
-/// Computes a random Gaussian distribution
+/// Computes a random sparse meta
 template <
   typename Element,               ///< Element type
   typename Layout>                ///< Layout function
@@ -864,7 +792,7 @@ struct TensorFillRandomSparseMetaFunc {
     // Methods
     //
 
-    /// Construction of Gaussian RNG functor.
+    /// Construction of sparse meta RNG functor.
     Params(
       TensorView view_ = TensorView(),
       typename RandomFunc::Params random_ = RandomFunc::Params()
@@ -885,16 +813,15 @@ struct TensorFillRandomSparseMetaFunc {
   // Methods
   //
 
-  /// Device-side initialization of RNG
   CUTLASS_DEVICE
   TensorFillRandomSparseMetaFunc(Params const &params): params(params), random(params.random) {
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at a coordinate
   CUTLASS_DEVICE
   void operator()(TensorCoord const &coord) {
 
-    params.view.at(coord) = random();
+    params.view.at(coord) = random(TensorLinearIndex(coord, params.view.extent()));
   }
 };
 
@@ -913,7 +840,7 @@ void TensorFillRandomSparseMeta(
   cudaStream_t stream = nullptr) {
 
   using RandomFunc = detail::RandomSparseMetaFunc<Element>;
-  using Func = detail::TensorFillRandomUniformFunc<Element, Layout>;
+  using Func = detail::TensorFillRandomSparseMetaFunc<Element, Layout>;
   using Params = typename Func::Params;
 
   typename RandomFunc::Params random(seed, MetaSizeInBits);
@@ -35,9 +35,14 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <vector>
+
 #include "cutlass/complex.h"
 #include "cutlass/numeric_conversion.h"
 #include "cutlass/epilogue/thread/activation.h"
+#include "cutlass/util/host_parallel.h"
+#include "cutlass/util/reference/host/gemm.h"
 
 #include "cute/tensor.hpp"
 
@@ -47,43 +52,6 @@ namespace cutlass::reference::host {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
-namespace detail {
-
-template<class EngineAct, class LayoutAct>
-bool
-is_activation_in_bounds(
-    cute::Tensor<EngineAct, LayoutAct> const& activation,
-    int32_t n_, int32_t d_, int32_t h_, int32_t w_, int32_t c_) {
-  return ((n_ >= 0 && n_ < size<4>(activation)) &&
-          (d_ >= 0 && d_ < size<3>(activation)) &&
-          (h_ >= 0 && h_ < size<2>(activation)) &&
-          (w_ >= 0 && w_ < size<1>(activation)) &&
-          (c_ >= 0 && c_ < size<0>(activation)));
-}
-
-template<class EngineAct, class LayoutAct>
-bool
-is_activation_in_bounds(
-    cute::Tensor<EngineAct, LayoutAct> const& activation,
-    int32_t n_, int32_t h_, int32_t w_, int32_t c_) {
-  return ((n_ >= 0 && n_ < size<3>(activation)) &&
-          (h_ >= 0 && h_ < size<2>(activation)) &&
-          (w_ >= 0 && w_ < size<1>(activation)) &&
-          (c_ >= 0 && c_ < size<0>(activation)));
-}
-
-template<class EngineAct, class LayoutAct>
-bool
-is_activation_in_bounds(
-    cute::Tensor<EngineAct, LayoutAct> const& activation,
-    int32_t n_, int32_t w_, int32_t c_) {
-  return ((n_ >= 0 && n_ < size<2>(activation)) &&
-          (w_ >= 0 && w_ < size<1>(activation)) &&
-          (c_ >= 0 && c_ < size<0>(activation)));
-}
-
-} // namespace detail
-
 template<
   class ElementAcc_,
   class ElementScalar_,
@@ -189,456 +157,463 @@ struct ConvReferenceImpl {
   }
 
 private:
-  // Specialization for 1D fprop kernel
-  void fprop_reference(cute::Int<1> spatial_dims) {
-    int32_t N = size<2>(tensor_d_);
-    int32_t Q = size<1>(tensor_d_);
-    int32_t K = size<0>(tensor_d_);
-    int32_t S = size<1>(tensor_b_);
-    int32_t C = size<0>(tensor_b_);
-
-#if defined(_OPENMP)
-  #pragma omp parallel for collapse(2)
-#endif
-    for (int32_t n = 0; n < N; ++n) {
-      for (int32_t q = 0; q < Q; ++q) {    
-        for (int32_t k = 0; k < K; ++k) {
-          auto accumulator = ElementAcc(0);
-          for (int32_t s = 0; s < S; ++s) {
-            for (int32_t c = 0; c < C; ++c) {
-              int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
-              if (detail::is_activation_in_bounds(tensor_a_, n, w, c)) {
-                accumulator += ElementAcc(tensor_a_(c, w, n) * tensor_b_(c, s, k));
-              }
-            }
-          }
-          ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-            epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-          ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-            epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
-          ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                  scale_converter(beta) * residual_converter(tensor_c_(k, q, n));
-          if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-            output += bias_converter(epi_fusion_params_.tensor_bias[k]);
-          }
-          output = epi_activation(output);
-          tensor_d_(k, q, n) = output_converter(output);
-        }
+
+  // Blocking of the im2col panels. Each output pixel block of fprop and dgrad is one GEMM against
+  // the packed filter, and wgrad runs one GEMM per filter position over kBlockDepth activations at
+  // a time. The host GEMM accumulates each output in increasing depth order, and depth is ordered
+  // as a direct loop nest over (t, r, s, c) for fprop, (k, t, r, s) for dgrad and (n, z, p, q)
+  // for wgrad, so results do not depend on the blocking or on the number of threads.
+  static constexpr int32_t kBlockPixels = 64;
+  static constexpr int32_t kBlockChannels = 64;
+  static constexpr int32_t kBlockDepth = 256;
+
+  using ElementA = typename TensorA::value_type;
+  using ElementB = typename TensorB::value_type;
+
+  /// Filter position paired with the activation or output coordinate it touches along one dim
+  struct Tap {
+    int32_t filter;
+    int32_t coord;
+  };
+
+  using TapList = std::vector<std::vector<Tap>>;
+
+  /// Inner product of the host GEMM. Panels hold operands widened to ElementAcc; narrowing them
+  /// back forms each product in the operand types, as the direct loop nest does.
+  template <class ElementX, class ElementY>
+  struct InnerProduct {
+    ElementAcc operator()(ElementAcc x, ElementAcc y, ElementAcc accum) const {
+      return accum + ElementAcc(ElementX(x) * ElementY(y));
+    }
+  };
+
+  /// Single-precision operands use multiply_add<float>, which selects the SIMD micro-kernel
+  template <class ElementX, class ElementY>
+  using InnerProductOp = cute::conditional_t<
+    cute::is_same_v<ElementX, float> && cute::is_same_v<ElementY, float> && cute::is_same_v<ElementAcc, float>,
+    multiply_add<float>,
+    InnerProduct<ElementX, ElementY>>;
+
+  /// Accumulates accum(rows, cols) += x(rows, depth) * y(depth, cols) on the blocked host GEMM.
+  /// Both operands are row-major with leading dimensions ldx and ldy.
+  template <class ElementX, class ElementY>
+  static void panel_gemm(
+    ElementX* x, int64_t ldx,
+    ElementY* y, int64_t ldy,
+    int32_t rows, int32_t cols, int32_t depth,
+    ElementAcc* accum, int32_t ldm,
+    std::vector<ElementAcc>& panel_x,
+    std::vector<ElementAcc>& panel_y) {
+
+    if (rows <= 0 || cols <= 0 || depth <= 0) {
+      return;
+    }
+    detail::gemm_accumulate_tile<
+      ElementX, layout::RowMajor, ElementY, layout::RowMajor, ElementAcc, InnerProductOp<ElementX, ElementY>>(
+        TensorRef<ElementX, layout::RowMajor>(x, layout::RowMajor(ldx)),
+        TensorRef<ElementY, layout::RowMajor>(y, layout::RowMajor(ldy)),
+        0, rows, 0, cols, 0, depth, std::max(host_gemm_default_config().block_k, 1),
+        accum, ldm, panel_x, panel_y);
+  }
+
+  /// Accesses a tensor by (c, w, h, d, n) regardless of the number of spatial dims
+  template <class Tensor>
+  static decltype(auto) at(Tensor&& tensor, int32_t c, int32_t w, int32_t h, int32_t d, int32_t n) {
+    if constexpr (NumSpatialDims == 1) {
+      return tensor(c, w, n);
+    }
+    else if constexpr (NumSpatialDims == 2) {
+      return tensor(c, w, h, n);
+    }
+    else {
+      return tensor(c, w, h, d, n);
+    }
+  }
+
+  /// Extents of a tensor as (c, w, h, d, n); missing spatial dims have extent 1
+  template <class Tensor>
+  static cute::array<int32_t, 5> extents(Tensor const& tensor) {
+    cute::array<int32_t, 5> result{1, 1, 1, 1, 1};
+    result[0] = int32_t(cute::size<0>(tensor));
+    result[1] = int32_t(cute::size<1>(tensor));
+    if constexpr (NumSpatialDims >= 2) {
+      result[2] = int32_t(cute::size<2>(tensor));
+    }
+    if constexpr (NumSpatialDims >= 3) {
+      result[3] = int32_t(cute::size<3>(tensor));
+    }
+    result[4] = int32_t(cute::size<NumSpatialDims + 1>(tensor));
+    return result;
+  }
+
+  /// Traversal stride, padding and dilation of spatial dim (0 = w, 1 = h, 2 = d)
+  cute::array<int32_t, 3> conv_params(int dim) const {
+    cute::array<int32_t, 3> result{1, 0, 1};
+    if (dim == 0) {
+      result = {cute::get<0>(tstride_), cute::get<0>(padding_), cute::get<0>(dilation_)};
+    }
+    if constexpr (NumSpatialDims >= 2) {
+      if (dim == 1) {
+        result = {cute::get<1>(tstride_), cute::get<1>(padding_), cute::get<1>(dilation_)};
+      }
+    }
+    if constexpr (NumSpatialDims >= 3) {
+      if (dim == 2) {
+        result = {cute::get<2>(tstride_), cute::get<2>(padding_), cute::get<2>(dilation_)};
       }
     }
+    return result;
   }
 
-  // Specialization for 2D fprop kernel
-  void fprop_reference(cute::Int<2> spatial_dims) {
-    int32_t N = size<3>(tensor_d_);
-    int32_t P = size<2>(tensor_d_);
-    int32_t Q = size<1>(tensor_d_);
-    int32_t K = size<0>(tensor_d_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-    int32_t C = size<0>(tensor_b_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(3)
-#endif
-    for (int32_t n = 0; n < N; ++n) {
-      for (int32_t p = 0; p < P; ++p) {
-        for (int32_t q = 0; q < Q; ++q) {
-          for (int32_t k = 0; k < K; ++k) {
-            auto accumulator = ElementAcc(0);
-            for (int32_t r = 0; r < R; ++r) {
-              for (int32_t s = 0; s < S; ++s) {
-                for (int32_t c = 0; c < C; ++c) {
-                  int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
-                  int32_t h =  p * cute::get<1>(tstride_) - cute::get<1>(padding_) + r * cute::get<1>(dilation_);
-                  if (detail::is_activation_in_bounds(tensor_a_, n, h, w, c)) {
-                    accumulator += ElementAcc(tensor_a_(c, w, h, n) * tensor_b_(c, s, r, k));
-                  }
-                }
-              }
-            }
-            ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-              epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-            ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-              epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
-            ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                    scale_converter(beta) * residual_converter(tensor_c_(k, q, p, n));
-            if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-              output += bias_converter(epi_fusion_params_.tensor_bias[k]);
-            }
-            output = epi_activation(output);
-            tensor_d_(k, q, p, n) = output_converter(output);
-          }
+  /// For each output coordinate, the filter positions whose activation coordinate is in bounds
+  TapList forward_taps(int dim, int32_t output_extent, int32_t filter_extent, int32_t activation_extent) const {
+    auto [stride, pad, dilation] = conv_params(dim);
+    TapList taps(output_extent);
+    for (int32_t o = 0; o < output_extent; ++o) {
+      for (int32_t f = 0; f < filter_extent; ++f) {
+        int32_t x = o * stride - pad + f * dilation;
+        if (x >= 0 && x < activation_extent) {
+          taps[o].push_back({f, x});
         }
       }
     }
+    return taps;
   }
 
-  // Specialization for 3D fprop kernel
-  void fprop_reference(cute::Int<3> spatial_dims) {
-    int32_t N = size<4>(tensor_d_);
-    int32_t Z = size<3>(tensor_d_);
-    int32_t P = size<2>(tensor_d_);
-    int32_t Q = size<1>(tensor_d_);
-    int32_t K = size<0>(tensor_d_);
-    int32_t T = size<3>(tensor_b_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-    int32_t C = size<0>(tensor_b_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(3)
-#endif
-    for (int32_t n = 0; n < N; ++n) {
-      for (int32_t z = 0; z < Z; ++z) {
-        for (int32_t p = 0; p < P; ++p) {
-          for (int32_t q = 0; q < Q; ++q) {
-            for (int32_t k = 0; k < K; ++k) {
-              auto accumulator = ElementAcc(0);
-              for (int32_t t = 0; t < T; ++t) {
-                for (int32_t r = 0; r < R; ++r) {
-                  for (int32_t s = 0; s < S; ++s) {
-                    for (int32_t c = 0; c < C; ++c) {
-                      int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
-                      int32_t h =  p * cute::get<1>(tstride_) - cute::get<1>(padding_) + r * cute::get<1>(dilation_);
-                      int32_t d =  z * cute::get<2>(tstride_) - cute::get<2>(padding_) + t * cute::get<2>(dilation_);
-                      if (detail::is_activation_in_bounds(tensor_a_, n, d, h, w, c)) {
-                        accumulator += ElementAcc(tensor_a_(c, w, h, d, n) * tensor_b_(c, s, r, t, k));
-                      }
-                    }
-                  }
-                }
-              }
-              ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-                epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-              ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-                epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
-              ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                      scale_converter(beta) * residual_converter(tensor_c_(k, q, p, z, n));
-              if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-                output += bias_converter(epi_fusion_params_.tensor_bias[k]);
-              }
-              output = epi_activation(output);
-              tensor_d_(k, q, p, z, n) = output_converter(output);
-            }
-          }
+  /// Phase of an activation coordinate under the traversal stride of dgrad
+  int32_t phase(int dim, int32_t x) const {
+    auto [stride, pad, dilation] = conv_params(dim);
+    return ((x + pad) % stride + stride) % stride;
+  }
+
+  /// For each phase, the filter positions the traversal stride accepts. All activation coordinates
+  /// of a phase reach their output coordinates through the same filter positions.
+  std::vector<std::vector<int32_t>> phase_filters(int dim, int32_t filter_extent) const {
+    auto [stride, pad, dilation] = conv_params(dim);
+    std::vector<std::vector<int32_t>> filters(stride);
+    for (int32_t ph = 0; ph < stride; ++ph) {
+      for (int32_t f = 0; f < filter_extent; ++f) {
+        if ((ph - f * dilation) % stride == 0) {
+          filters[ph].push_back(f);
         }
       }
     }
+    return filters;
   }
 
-  // Specialization for 1D dgrad kernel
-  void dgrad_reference(cute::Int<1> spatial_dims) {
-    int32_t N = size<2>(tensor_d_);
-    int32_t W = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-    int32_t K = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-
-#if defined(_OPENMP)
-   #pragma omp parallel for collapse(2)
-#endif
-    for (int32_t n = 0; n < N; ++n) {
-      for (int32_t w = 0; w < W; ++w) {
-        for (int32_t c = 0; c < C; ++c) {
-          auto accumulator = ElementAcc(0);
-          for (int32_t k = 0; k < K; ++k) {
-            for (int32_t s = 0; s < S; ++s) {
-              int32_t q = w + cute::get<0>(padding_) - s * cute::get<0>(dilation_);
+  /// Applies the fused epilogue to one accumulator; channel selects per-channel alpha/beta/bias
+  template <class Coord>
+  void epilogue(ElementAcc accumulator, int32_t channel, Coord const& coord) {
+    ElementScalar alpha = cute::raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
+      epi_fusion_params_.tensor_alpha[channel] : epi_fusion_params_.alpha;
+    ElementScalar beta = cute::raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
+      epi_fusion_params_.tensor_beta[channel] : epi_fusion_params_.beta;
+    ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
+                            scale_converter(beta) * residual_converter(
+                              at(tensor_c_, coord[0], coord[1], coord[2], coord[3], coord[4]));
+    if (cute::raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
+      output += bias_converter(epi_fusion_params_.tensor_bias[channel]);
+    }
+    output = epi_activation(output);
+    at(tensor_d_, coord[0], coord[1], coord[2], coord[3], coord[4]) = output_converter(output);
+  }
 
-              if (q % cute::get<0>(tstride_) == 0) {
-                q /= cute::get<0>(tstride_);
-              } else {
-                continue;
-              }
+  // Fprop: (N * Z * P * Q, K) = im2col(activation)(N * Z * P * Q, T * R * S * C) * filter(T * R * S * C, K)
+  template <int Dims>
+  void fprop_reference(cute::Int<Dims>) {
+    [[maybe_unused]] auto [C, W, H, D, N] = extents(tensor_a_);
+    [[maybe_unused]] auto [K, Q, P, Z, N_out] = extents(tensor_d_);
+    [[maybe_unused]] auto [C_flt, S, R, T, K_flt] = extents(tensor_b_);
 
-              if (detail::is_activation_in_bounds(tensor_a_, n, q, k)) {
-                accumulator += ElementAcc(tensor_a_(k, q, n) * tensor_b_(c, s, k));
-              }
+    auto [stride_w, pad_w, dilation_w] = conv_params(0);
+    auto [stride_h, pad_h, dilation_h] = conv_params(1);
+    auto [stride_d, pad_d, dilation_d] = conv_params(2);
+
+    int32_t const depth = T * R * S * C;
+
+    // Filter as a row-major (depth, K) operand with depth ordered (t, r, s, c)
+    std::vector<ElementB> filter(size_t(depth) * K);
+    for (int32_t k = 0; k < K; ++k) {
+      for (int32_t t = 0; t < T; ++t) {
+        for (int32_t r = 0; r < R; ++r) {
+          for (int32_t s = 0; s < S; ++s) {
+            for (int32_t c = 0; c < C; ++c) {
+              filter[(size_t((t * R + r) * S + s) * C + c) * K + k] = at(tensor_b_, c, s, r, t, k);
             }
           }
-          ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
-            ? epi_fusion_params_.tensor_alpha[c] : epi_fusion_params_.alpha;
-          ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
-            ? epi_fusion_params_.tensor_beta[c] : epi_fusion_params_.beta;
-          ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                  scale_converter(beta) * residual_converter(tensor_c_(c, w, n));
-          if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-            output += bias_converter(epi_fusion_params_.tensor_bias[c]);
-          }
-          output = epi_activation(output);
-          tensor_d_(c, w, n) = output_converter(output);
         }
       }
     }
-  }
 
-  // Specialization for 2D dgrad kernel
-  void dgrad_reference(cute::Int<2> spatial_dims) {
-    int32_t N = size<3>(tensor_d_);
-    int32_t H = size<2>(tensor_d_);
-    int32_t W = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-    int32_t K = size<3>(tensor_b_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(3)
-#endif
-    for (int32_t n = 0; n < N; ++n) {
-      for (int32_t h = 0; h < H; ++h) {
-        for (int32_t w = 0; w < W; ++w) {
-          for (int32_t c = 0; c < C; ++c) {
-            auto accumulator = ElementAcc(0);
-            for (int32_t k = 0; k < K; ++k) {
-              for (int32_t r = 0; r < R; ++r) {
-                for (int32_t s = 0; s < S; ++s) {
-                  int32_t q = w + cute::get<0>(padding_) - s * cute::get<0>(dilation_);
-                  int32_t p = h + cute::get<1>(padding_) - r * cute::get<1>(dilation_);
-
-                  if (q % cute::get<0>(tstride_) == 0) {
-                    q /= cute::get<0>(tstride_);
-                  } else {
-                    continue;
-                  }
+    int64_t const pixels = int64_t(N) * Z * P * Q;
+    int64_t const blocks = (pixels + kBlockPixels - 1) / kBlockPixels;
 
-                  if (p % cute::get<1>(tstride_) == 0) {
-                    p /= cute::get<1>(tstride_);
-                  } else {
-                    continue;
-                  }
+    host_parallel_for(0, blocks, 1, [&](int64_t block_begin, int64_t block_end) {
+
+      std::vector<ElementA> panel(size_t(kBlockPixels) * depth);
+      std::vector<ElementAcc> accum(size_t(kBlockPixels) * K);
+      std::vector<ElementAcc> panel_x;
+      std::vector<ElementAcc> panel_y;
+
+      for (int64_t block = block_begin; block < block_end; ++block) {
+        int64_t const pixel_begin = block * kBlockPixels;
+        int32_t const rows = int32_t(std::min<int64_t>(kBlockPixels, pixels - pixel_begin));
 
-                  if (detail::is_activation_in_bounds(tensor_a_, n, p, q, k)) {
-                    accumulator += ElementAcc(tensor_a_(k, q, p, n) * tensor_b_(c, s, r, k));
+        // Gather the im2col panel: row i holds the activations under the filter at output pixel i,
+        // and zero where the filter overlaps the padding
+        for (int32_t i = 0; i < rows; ++i) {
+          int64_t residue = pixel_begin + i;
+          int32_t q = int32_t(residue % Q); residue /= Q;
+          int32_t p = int32_t(residue % P); residue /= P;
+          int32_t z = int32_t(residue % Z); residue /= Z;
+          int32_t n = int32_t(residue);
+
+          ElementA* row = panel.data() + size_t(i) * depth;
+          for (int32_t t = 0; t < T; ++t) {
+            int32_t x_d = z * stride_d - pad_d + t * dilation_d;
+            for (int32_t r = 0; r < R; ++r) {
+              int32_t x_h = p * stride_h - pad_h + r * dilation_h;
+              for (int32_t s = 0; s < S; ++s) {
+                int32_t x_w = q * stride_w - pad_w + s * dilation_w;
+                ElementA* column = row + size_t((t * R + r) * S + s) * C;
+                if (x_d >= 0 && x_d < D && x_h >= 0 && x_h < H && x_w >= 0 && x_w < W) {
+                  for (int32_t c = 0; c < C; ++c) {
+                    column[c] = at(tensor_a_, c, x_w, x_h, x_d, n);
                   }
                 }
+                else {
+                  std::fill(column, column + C, ElementA(0));
+                }
               }
             }
-            ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
-              ? epi_fusion_params_.tensor_alpha[c] : epi_fusion_params_.alpha;
-            ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
-              ? epi_fusion_params_.tensor_beta[c] : epi_fusion_params_.beta;
-            ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                    scale_converter(beta) * residual_converter(tensor_c_(c, w, h, n));
-            if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-              output += bias_converter(epi_fusion_params_.tensor_bias[c]);
-            }
-            tensor_d_(c, w, h, n) = output_converter(output);
+          }
+        }
+
+        std::fill(accum.begin(), accum.end(), ElementAcc(0));
+        panel_gemm(panel.data(), depth, filter.data(), K, rows, K, depth, accum.data(), K, panel_x, panel_y);
+
+        for (int32_t i = 0; i < rows; ++i) {
+          int64_t residue = pixel_begin + i;
+          int32_t q = int32_t(residue % Q); residue /= Q;
+          int32_t p = int32_t(residue % P); residue /= P;
+          int32_t z = int32_t(residue % Z); residue /= Z;
+          int32_t n = int32_t(residue);
+          for (int32_t k = 0; k < K; ++k) {
+            cute::array<int32_t, 5> coord{k, q, p, z, n};
+            epilogue(accum[size_t(i) * K + k], k, coord);
           }
         }
       }
-    }
+    });
   }
 
-  // Specialization for 3D dgrad kernel
-  void dgrad_reference(cute::Int<3> spatial_dims) {
-    int32_t N = size<4>(tensor_d_);
-    int32_t D = size<3>(tensor_d_);
-    int32_t H = size<2>(tensor_d_);
-    int32_t W = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-    int32_t K = size<4>(tensor_b_);
-    int32_t T = size<3>(tensor_b_);
-    int32_t R = size<2>(tensor_b_);
-    int32_t S = size<1>(tensor_b_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(3)
-#endif
-    for (int32_t n = 0; n < N; ++n) {
-      for (int32_t d = 0; d < D; ++d) {
-        for (int32_t h = 0; h < H; ++h) {
-          for (int32_t w = 0; w < W; ++w) {
-            for (int32_t c = 0; c < C; ++c) {
-              auto accumulator = ElementAcc(0);
-              for (int32_t k = 0; k < K; ++k) {
-                for (int32_t t = 0; t < T; ++t) {
-                  for (int32_t r = 0; r < R; ++r) {
-                    for (int32_t s = 0; s < S; ++s) {
-                      int32_t q = w + cute::get<0>(padding_) - s * cute::get<0>(dilation_);
-                      int32_t p = h + cute::get<1>(padding_) - r * cute::get<1>(dilation_);
-                      int32_t z = d + cute::get<2>(padding_) - t * cute::get<2>(dilation_);
-
-                      if (q % cute::get<0>(tstride_) == 0) {
-                        q /= cute::get<0>(tstride_);
-                      } else {
-                        continue;
-                      }
-
-                      if (p % cute::get<1>(tstride_) == 0) {
-                        p /= cute::get<1>(tstride_);
-                      } else {
-                        continue;
-                      }
-
-                      if (z % cute::get<2>(tstride_) == 0) {
-                        z /= cute::get<2>(tstride_);
-                      } else {
-                        continue;
-                      }
-
-                      if (detail::is_activation_in_bounds(tensor_a_, n, z, p, q, k)) {
-                        accumulator += ElementAcc(tensor_a_(k, q, p, z, n) * tensor_b_(c, s, r, t, k));
-                      }
-                    }
-                  }
-                }
-              }
-              ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data())
-                ? epi_fusion_params_.tensor_alpha[c] : epi_fusion_params_.alpha;
-              ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data())
-                ? epi_fusion_params_.tensor_beta[c] : epi_fusion_params_.beta;
-              ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                      scale_converter(beta) * residual_converter(tensor_c_(c, w, h, d, n));
-              if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-                output += bias_converter(epi_fusion_params_.tensor_bias[c]);
-              }
-              output = epi_activation(output);
-              tensor_d_(c, w, h, d, n) = output_converter(output);
-            }
+  // Dgrad: activation pixels are grouped by phase along each dim. The pixels of one phase share
+  // the filter positions accepted by the traversal stride, so each group is a GEMM
+  //   (pixels, C) = im2col(output gradient)(pixels, K * taps) * filter(K * taps, C)
+  // over those positions only.
+  template <int Dims>
+  void dgrad_reference(cute::Int<Dims>) {
+    [[maybe_unused]] auto [K, Q, P, Z, N_out] = extents(tensor_a_);
+    [[maybe_unused]] auto [C, W, H, D, N] = extents(tensor_d_);
+    [[maybe_unused]] auto [C_flt, S, R, T, K_flt] = extents(tensor_b_);
+
+    auto [stride_w, pad_w, dilation_w] = conv_params(0);
+    auto [stride_h, pad_h, dilation_h] = conv_params(1);
+    auto [stride_d, pad_d, dilation_d] = conv_params(2);
+
+    auto filters_w = phase_filters(0, S);
+    auto filters_h = phase_filters(1, R);
+    auto filters_d = phase_filters(2, T);
+
+    // Filter positions (t, r, s) and the row-major (K * taps, C) filter operand of each phase
+    int32_t const phases = stride_d * stride_h * stride_w;
+    std::vector<std::vector<cute::array<int32_t, 3>>> phase_taps(phases);
+    std::vector<std::vector<ElementB>> phase_filter(phases);
+
+    for (int32_t ph = 0; ph < phases; ++ph) {
+      int32_t ph_w = ph % stride_w;
+      int32_t ph_h = (ph / stride_w) % stride_h;
+      int32_t ph_d = ph / (stride_w * stride_h);
+      for (int32_t t : filters_d[ph_d]) {
+        for (int32_t r : filters_h[ph_h]) {
+          for (int32_t s : filters_w[ph_w]) {
+            phase_taps[ph].push_back({t, r, s});
+          }
+        }
+      }
+      int32_t const taps = int32_t(phase_taps[ph].size());
+      phase_filter[ph].resize(size_t(K) * taps * C);
+      for (int32_t k = 0; k < K; ++k) {
+        for (int32_t j = 0; j < taps; ++j) {
+          auto [t, r, s] = phase_taps[ph][j];
+          for (int32_t c = 0; c < C; ++c) {
+            phase_filter[ph][(size_t(k) * taps + j) * C + c] = at(tensor_b_, c, s, r, t, k);
           }
         }
       }
     }
-  }
 
-  // Specialization for 1D wgrad kernel
-  void wgrad_reference(cute::Int<1> spatial_dims) {
-    int32_t N = size<2>(tensor_a_);
-    int32_t Q = size<1>(tensor_a_);
-    int32_t K = size<0>(tensor_a_);
-    int32_t S = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(2)
-#endif
-    for (int32_t k = 0; k < K; ++k) {
-      ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-        epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-      ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-        epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
-      for (int32_t s = 0; s < S; ++s) {
-        for (int32_t c = 0; c < C; ++c) {
-          auto accumulator = ElementAcc(0);
-          for (int32_t n = 0; n < N; ++n) {
-            for (int32_t q = 0; q < Q; ++q) {
-              int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
-              if (detail::is_activation_in_bounds(tensor_b_, n, w, c)) {
-                accumulator += ElementAcc(tensor_b_(c, w, n) * tensor_a_(k, q, n));
-              }
+    // Work items are blocks of pixels along w with the same (n, d, h) and the same phase along w
+    int64_t const w_per_phase = (W + stride_w - 1) / stride_w;
+    int64_t const w_blocks = (w_per_phase + kBlockPixels - 1) / kBlockPixels;
+    int64_t const work = int64_t(N) * D * H * stride_w * w_blocks;
+
+    host_parallel_for(0, work, 1, [&](int64_t work_begin, int64_t work_end) {
+
+      std::vector<ElementA> panel;
+      std::vector<ElementAcc> accum(size_t(kBlockPixels) * C);
+      std::vector<ElementAcc> panel_x;
+      std::vector<ElementAcc> panel_y;
+      int32_t columns[kBlockPixels];
+
+      for (int64_t idx = work_begin; idx < work_end; ++idx) {
+        int64_t residue = idx;
+        int32_t block = int32_t(residue % w_blocks); residue /= w_blocks;
+        int32_t ph_w = int32_t(residue % stride_w); residue /= stride_w;
+        int32_t h = int32_t(residue % H); residue /= H;
+        int32_t d = int32_t(residue % D); residue /= D;
+        int32_t n = int32_t(residue);
+
+        // Pixels w of this block: (w + pad_w) mod stride_w == ph_w
+        int32_t const w_first = ((ph_w - pad_w) % stride_w + stride_w) % stride_w;
+        int32_t rows = 0;
+        for (int32_t j = block * kBlockPixels; j < (block + 1) * kBlockPixels; ++j) {
+          int64_t w = w_first + int64_t(j) * stride_w;
+          if (w >= W) {
+            break;
+          }
+          columns[rows++] = int32_t(w);
+        }
+        if (rows == 0) {
+          continue;
+        }
+
+        int32_t const ph = (phase(2, d) * stride_h + phase(1, h)) * stride_w + ph_w;
+        auto const& taps = phase_taps[ph];
+        int32_t const depth = K * int32_t(taps.size());
+
+        // Gather the im2col panel of the output gradient, zero where the output coordinate is out of bounds
+        panel.resize(size_t(rows) * depth);
+        for (int32_t i = 0; i < rows; ++i) {
+          ElementA* row = panel.data() + size_t(i) * depth;
+          for (int32_t j = 0; j < int32_t(taps.size()); ++j) {
+            auto [t, r, s] = taps[j];
+            int32_t o_d = (d + pad_d - t * dilation_d) / stride_d;
+            int32_t o_h = (h + pad_h - r * dilation_h) / stride_h;
+            int32_t o_w = (columns[i] + pad_w - s * dilation_w) / stride_w;
+            bool in_bounds = (d + pad_d - t * dilation_d) >= 0 && o_d < Z &&
+                             (h + pad_h - r * dilation_h) >= 0 && o_h < P &&
+                             (columns[i] + pad_w - s * dilation_w) >= 0 && o_w < Q;
+            for (int32_t k = 0; k < K; ++k) {
+              row[size_t(k) * taps.size() + j] = in_bounds ? at(tensor_a_, k, o_w, o_h, o_d, n) : ElementA(0);
             }
           }
-          ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                  scale_converter(beta) * residual_converter(tensor_c_(c, s, k));
-          if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-            output += bias_converter(epi_fusion_params_.tensor_bias[k]);
+        }
+
+        std::fill(accum.begin(), accum.end(), ElementAcc(0));
+        panel_gemm(panel.data(), depth, phase_filter[ph].data(), C, rows, C, depth, accum.data(), C, panel_x, panel_y);
+
+        for (int32_t i = 0; i < rows; ++i) {
+          for (int32_t c = 0; c < C; ++c) {
+            cute::array<int32_t, 5> coord{c, columns[i], h, d, n};
+            epilogue(accum[size_t(i) * C + c], c, coord);
           }
-          output = epi_activation(output);
-          tensor_d_(c, s, k) = output_converter(output);
         }
       }
-    }
+    });
   }
 
-  // Specialization for 2D wgrad kernel
-  void wgrad_reference(cute::Int<2> spatial_dims) {
-    int32_t N = size<3>(tensor_a_);
-    int32_t P = size<2>(tensor_a_);
-    int32_t Q = size<1>(tensor_a_);
-    int32_t K = size<0>(tensor_a_);
-    int32_t R = size<2>(tensor_d_);
-    int32_t S = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(3)
-#endif
-    for (int32_t k = 0; k < K; ++k) {
-      ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-        epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-      ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-        epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
-      for (int32_t r = 0; r < R; ++r) {
-        for (int32_t s = 0; s < S; ++s) {
-          for (int32_t c = 0; c < C; ++c) {
-            auto accumulator = ElementAcc(0);
-            for (int32_t n = 0; n < N; ++n) {
-              for (int32_t p = 0; p < P; ++p) {
-                for (int32_t q = 0; q < Q; ++q) {
-                  int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
-                  int32_t h =  p * cute::get<1>(tstride_) - cute::get<1>(padding_) + r * cute::get<1>(dilation_);
-                  if (detail::is_activation_in_bounds(tensor_b_, n, h, w, c)) {
-                    accumulator += ElementAcc(tensor_b_(c, w, h, n) * tensor_a_(k, q, p, n));
-                  }
-                }
-              }
+  // Wgrad: for each filter position (t, r, s),
+  //   (C, K) = activation(C, N * Z * P * Q) * output gradient(N * Z * P * Q, K)
+  // over the output coordinates whose activation coordinate is in bounds
+  template <int Dims>
+  void wgrad_reference(cute::Int<Dims>) {
+    [[maybe_unused]] auto [K, Q, P, Z, N] = extents(tensor_a_);
+    [[maybe_unused]] auto [C, W, H, D, N_act] = extents(tensor_b_);
+    [[maybe_unused]] auto [C_out, S, R, T, K_out] = extents(tensor_d_);
+
+    TapList taps_w = forward_taps(0, Q, S, W);
+    TapList taps_h = forward_taps(1, P, R, H);
+    TapList taps_d = forward_taps(2, Z, T, D);
+
+    // Invert the tap lists: for each filter position, the (output, activation) coordinate pairs
+    auto by_filter = [](TapList const& taps, int32_t filter_extent) {
+      TapList result(filter_extent);
+      for (int32_t o = 0; o < int32_t(taps.size()); ++o) {
+        for (Tap const& tap : taps[o]) {
+          result[tap.filter].push_back({o, tap.coord});
+        }
+      }
+      return result;
+    };
+
+    TapList pairs_w = by_filter(taps_w, S);
+    TapList pairs_h = by_filter(taps_h, R);
+    TapList pairs_d = by_filter(taps_d, T);
+
+    int64_t const c_blocks = (C + kBlockChannels - 1) / kBlockChannels;
+    int64_t const k_blocks = (K + kBlockChannels - 1) / kBlockChannels;
+    int64_t const work = int64_t(T) * R * S * c_blocks * k_blocks;
+
+    host_parallel_for(0, work, 1, [&](int64_t work_begin, int64_t work_end) {
+
+      std::vector<ElementAcc> accum(size_t(kBlockChannels) * kBlockChannels);
+      std::vector<ElementB> activation(size_t(kBlockChannels) * kBlockDepth);
+      std::vector<ElementA> gradient(size_t(kBlockDepth) * kBlockChannels);
+      std::vector<ElementAcc> panel_x;
+      std::vector<ElementAcc> panel_y;
+
+      for (int64_t idx = work_begin; idx < work_end; ++idx) {
+        int64_t residue = idx;
+        int32_t c0 = int32_t(residue % c_blocks) * kBlockChannels; residue /= c_blocks;
+        int32_t k0 = int32_t(residue % k_blocks) * kBlockChannels; residue /= k_blocks;
+        int32_t s = int32_t(residue % S); residue /= S;
+        int32_t r = int32_t(residue % R); residue /= R;
+        int32_t t = int32_t(residue);
+
+        int32_t const block_c = std::min(kBlockChannels, C - c0);
+        int32_t const block_k = std::min(kBlockChannels, K - k0);
+
+        auto const& list_w = pairs_w[s];
+        auto const& list_h = pairs_h[r];
+        auto const& list_d = pairs_d[t];
+        int64_t const depth = int64_t(N) * list_d.size() * list_h.size() * list_w.size();
+
+        std::fill(accum.begin(), accum.end(), ElementAcc(0));
+
+        // Consecutive slabs of the valid (n, z, p, q) in the order of the direct loop nest
+        for (int64_t depth_begin = 0; depth_begin < depth; depth_begin += kBlockDepth) {
+          int32_t const slab = int32_t(std::min<int64_t>(kBlockDepth, depth - depth_begin));
+
+          for (int32_t j = 0; j < slab; ++j) {
+            int64_t pos = depth_begin + j;
+            Tap const& pair_w = list_w[pos % list_w.size()]; pos /= list_w.size();
+            Tap const& pair_h = list_h[pos % list_h.size()]; pos /= list_h.size();
+            Tap const& pair_d = list_d[pos % list_d.size()]; pos /= list_d.size();
+            int32_t n = int32_t(pos);
+
+            for (int32_t cc = 0; cc < block_c; ++cc) {
+              activation[size_t(cc) * kBlockDepth + j] =
+                at(tensor_b_, c0 + cc, pair_w.coord, pair_h.coord, pair_d.coord, n);
             }
-            ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                    scale_converter(beta) * residual_converter(tensor_c_(c, s, r, k));
-            if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-              output += bias_converter(epi_fusion_params_.tensor_bias[k]);
+            for (int32_t kk = 0; kk < block_k; ++kk) {
+              gradient[size_t(j) * kBlockChannels + kk] =
+                at(tensor_a_, k0 + kk, pair_w.filter, pair_h.filter, pair_d.filter, n);
             }
-            output = epi_activation(output);
-            tensor_d_(c, s, r, k) = output_converter(output);
           }
+
+          panel_gemm(activation.data(), kBlockDepth, gradient.data(), kBlockChannels,
+                     block_c, block_k, slab, accum.data(), kBlockChannels, panel_x, panel_y);
         }
-      }
-    }
-  }
 
-  // Specialization for 3D wgrad kernel
-  void wgrad_reference(cute::Int<3> spatial_dims) {
-    int32_t N = size<4>(tensor_a_);
-    int32_t Z = size<3>(tensor_a_);
-    int32_t P = size<2>(tensor_a_);
-    int32_t Q = size<1>(tensor_a_);
-    int32_t K = size<0>(tensor_a_);
-    int32_t T = size<3>(tensor_d_);
-    int32_t R = size<2>(tensor_d_);
-    int32_t S = size<1>(tensor_d_);
-    int32_t C = size<0>(tensor_d_);
-
-#if defined(_OPENMP)
-    #pragma omp parallel for collapse(3)
-#endif
-    for (int32_t k = 0; k < K; ++k) {
-      ElementScalar alpha = raw_pointer_cast(epi_fusion_params_.tensor_alpha.data()) ?
-        epi_fusion_params_.tensor_alpha[k] : epi_fusion_params_.alpha;
-      ElementScalar beta = raw_pointer_cast(epi_fusion_params_.tensor_beta.data()) ?
-        epi_fusion_params_.tensor_beta[k] : epi_fusion_params_.beta;
-      for (int32_t t = 0; t < T; ++t) {
-        for (int32_t r = 0; r < R; ++r) {
-          for (int32_t s = 0; s < S; ++s) {
-            for (int32_t c = 0; c < C; ++c) {
-              auto accumulator = ElementAcc(0);
-              for (int32_t n = 0; n < N; ++n) {
-                for (int32_t z = 0; z < Z; ++z) {
-                  for (int32_t p = 0; p < P; ++p) {
-                    for (int32_t q = 0; q < Q; ++q) {
-                      int32_t w =  q * cute::get<0>(tstride_) - cute::get<0>(padding_) + s * cute::get<0>(dilation_);
-                      int32_t h =  p * cute::get<1>(tstride_) - cute::get<1>(padding_) + r * cute::get<1>(dilation_);
-                      int32_t d =  z * cute::get<2>(tstride_) - cute::get<2>(padding_) + t * cute::get<2>(dilation_);
-                      if (detail::is_activation_in_bounds(tensor_b_, n, d, h, w, c)) {
-                        accumulator += ElementAcc(tensor_b_(c, w, h, d, n) * tensor_a_(k, q, p, z, n));
-                      }
-                    }
-                  }
-                }
-              }
-              ElementCompute output = scale_converter(alpha) * acc_converter(accumulator) +
-                                      scale_converter(beta) * residual_converter(tensor_c_(c, s, r, t, k));
-              if (raw_pointer_cast(epi_fusion_params_.tensor_bias.data())) {
-                output += bias_converter(epi_fusion_params_.tensor_bias[k]);
-              }
-              output = epi_activation(output);
-              tensor_d_(c, s, r, t, k) = output_converter(output);
-            }
+        for (int32_t cc = 0; cc < block_c; ++cc) {
+          for (int32_t kk = 0; kk < block_k; ++kk) {
+            cute::array<int32_t, 5> coord{c0 + cc, s, r, t, k0 + kk};
+            epilogue(accum[size_t(cc) * kBlockChannels + kk], k0 + kk, coord);
           }
         }
       }
-    }
+    });
   }
 };
 
@@ -31,10 +31,21 @@
  **************************************************************************************************/
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 #include "cutlass/cutlass.h"
 #include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
+#include "cutlass/util/reference/host/tensor_foreach.h"
 #include "cutlass/util/reference/host/tensor_reduce.h"
 #include "cutlass/core_io.h"
 
@@ -42,6 +53,331 @@ namespace cutlass  {
 namespace reference {
 namespace host {
 
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Compensated (Kahan-Babuska-Neumaier) sum
+struct CompensatedSum {
+
+  double sum = 0;
+  double compensation = 0;
+
+  void add(double x) {
+    double t = sum + x;
+    if (std::abs(sum) >= std::abs(x)) {
+      compensation += (sum - t) + x;
+    }
+    else {
+      compensation += (x - t) + sum;
+    }
+    sum = t;
+  }
+
+  void add(CompensatedSum const &other) {
+    add(other.sum);
+    add(other.compensation);
+  }
+
+  double value() const {
+    return sum + compensation;
+  }
+};
+
+/// Real and imaginary parts of an element in double precision
+template <typename Element, typename Enable = void>
+struct ErrorMetricsValue {
+  static bool const kSupported = std::is_constructible<double, Element>::value;
+
+  static double real(Element const &x) { return static_cast<double>(x); }
+  static double imag(Element const &) { return 0; }
+};
+
+template <typename T>
+struct ErrorMetricsValue<complex<T>> {
+  static bool const kSupported = std::is_constructible<double, T>::value;
+
+  static double real(complex<T> const &x) { return static_cast<double>(x.real()); }
+  static double imag(complex<T> const &x) { return static_cast<double>(x.imag()); }
+};
+
+/// Maps floating-point elements to integers ordered like their values, so that the difference of
+/// two mapped values is the distance in units in the last place of Element
+template <typename Element, typename Enable = void>
+struct ErrorMetricsUlp {
+  static bool const kEnabled = false;
+  static int64_t ordered(Element const &) { return 0; }
+};
+
+template <typename Element>
+struct ErrorMetricsUlp<Element, typename std::enable_if<
+  std::is_same<Element, float>::value ||
+  std::is_same<Element, double>::value ||
+  std::is_same<Element, half_t>::value ||
+  std::is_same<Element, bfloat16_t>::value ||
+  std::is_same<Element, float_e4m3_t>::value ||
+  std::is_same<Element, float_e5m2_t>::value>::type> {
+
+  static bool const kEnabled = true;
+  static int const kBits = int(sizeof(Element) * 8);
+
+  using Storage = typename std::conditional<kBits == 64, uint64_t,
+                  typename std::conditional<kBits == 32, uint32_t,
+                  typename std::conditional<kBits == 16, uint16_t, uint8_t>::type>::type>::type;
+
+  static int64_t ordered(Element const &x) {
+    Storage bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    Storage const sign = Storage(Storage(1) << (kBits - 1));
+    int64_t magnitude = int64_t(bits & Storage(~sign));
+    return (bits & sign) ? -magnitude : magnitude;
+  }
+};
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Error metrics of a computed tensor with respect to a reference, gathered in a single pass.
+///
+/// Norms include every element, so non-finite values propagate to them as they do in TensorNorm.
+/// The maximum errors and the ULP histogram only consider pairs of finite elements.
+struct TensorErrorMetrics {
+
+  /// Number of histogram buckets. Bucket 0 counts exact matches, bucket k in [1, kUlpBuckets - 2]
+  /// counts distances in [2^(k-1), 2^k) units in the last place, and the last bucket counts all
+  /// larger distances.
+  static int const kUlpBuckets = 16;
+
+  int64_t element_count = 0;
+
+  /// Sums over all elements, compensated
+  detail::CompensatedSum sum_abs_diff;        ///< sum |computed - reference|
+  detail::CompensatedSum sum_sq_diff;         ///< sum |computed - reference|^2
+  detail::CompensatedSum sum_sq_reference;    ///< sum |reference|^2
+
+  double max_abs_error = 0;                   ///< max |computed - reference|
+  double max_rel_error = 0;                   ///< max |computed - reference| / |reference|, nonzero reference
+
+  int64_t computed_nan_count = 0;
+  int64_t computed_inf_count = 0;
+  int64_t reference_nan_count = 0;
+  int64_t reference_inf_count = 0;
+
+  /// Histogram of distances in units in the last place, populated for floating-point elements
+  std::array<int64_t, kUlpBuckets> ulp_histogram{};
+
+  /// Largest distance in units in the last place
+  int64_t max_ulp_error = 0;
+
+  /// L1 norm of the difference
+  double l1() const { return sum_abs_diff.value(); }
+
+  /// L2 norm of the difference
+  double l2() const { return std::sqrt(sum_sq_diff.value()); }
+
+  /// Infinity norm of the difference
+  double linf() const { return max_abs_error; }
+
+  /// L2 norm of the reference
+  double reference_l2() const { return std::sqrt(sum_sq_reference.value()); }
+
+  /// Relative error ||computed - reference||_2 / ||reference||_2
+  double relative_error() const { return l2() / reference_l2(); }
+
+  /// Histogram bucket of a distance in units in the last place
+  static int ulp_bucket(int64_t ulps) {
+    int bucket = 0;
+    while (ulps > 0 && bucket < kUlpBuckets - 1) {
+      ulps >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  /// Accumulates one pair of elements
+  template <typename Element>
+  void add(Element const &computed, Element const &reference) {
+
+    using Value = detail::ErrorMetricsValue<Element>;
+
+    static_assert(Value::kSupported, "Error metrics require elements convertible to double or complex<T>");
+
+    double c_re = Value::real(computed), c_im = Value::imag(computed);
+    double r_re = Value::real(reference), r_im = Value::imag(reference);
+
+    double d_re = c_re - r_re;
+    double d_im = c_im - r_im;
+    double sq_diff = d_re * d_re + d_im * d_im;
+    double abs_diff = std::sqrt(sq_diff);
+
+    ++element_count;
+    sum_abs_diff.add(abs_diff);
+    sum_sq_diff.add(sq_diff);
+    sum_sq_reference.add(r_re * r_re + r_im * r_im);
+
+    bool computed_nan = std::isnan(c_re) || std::isnan(c_im);
+    bool reference_nan = std::isnan(r_re) || std::isnan(r_im);
+    bool computed_inf = !computed_nan && (std::isinf(c_re) || std::isinf(c_im));
+    bool reference_inf = !reference_nan && (std::isinf(r_re) || std::isinf(r_im));
+
+    computed_nan_count += computed_nan;
+    computed_inf_count += computed_inf;
+    reference_nan_count += reference_nan;
+    reference_inf_count += reference_inf;
+
+    if (computed_nan || computed_inf || reference_nan || reference_inf) {
+      return;
+    }
+
+    max_abs_error = std::max(max_abs_error, abs_diff);
+
+    double reference_magnitude = std::sqrt(r_re * r_re + r_im * r_im);
+    if (reference_magnitude > 0) {
+      max_rel_error = std::max(max_rel_error, abs_diff / reference_magnitude);
+    }
+
+    if constexpr (detail::ErrorMetricsUlp<Element>::kEnabled) {
+      int64_t ulps = detail::ErrorMetricsUlp<Element>::ordered(computed) -
+                     detail::ErrorMetricsUlp<Element>::ordered(reference);
+      ulps = ulps < 0 ? -ulps : ulps;
+
+      // Signed zeros are equal
+      if (abs_diff == 0) {
+        ulps = 0;
+      }
+      max_ulp_error = std::max(max_ulp_error, ulps);
+      ++ulp_histogram[ulp_bucket(ulps)];
+    }
+  }
+
+  /// Combines metrics gathered over disjoint sets of elements
+  void merge(TensorErrorMetrics const &other) {
+    element_count += other.element_count;
+    sum_abs_diff.add(other.sum_abs_diff);
+    sum_sq_diff.add(other.sum_sq_diff);
+    sum_sq_reference.add(other.sum_sq_reference);
+    max_abs_error = std::max(max_abs_error, other.max_abs_error);
+    max_rel_error = std::max(max_rel_error, other.max_rel_error);
+    computed_nan_count += other.computed_nan_count;
+    computed_inf_count += other.computed_inf_count;
+    reference_nan_count += other.reference_nan_count;
+    reference_inf_count += other.reference_inf_count;
+    max_ulp_error = std::max(max_ulp_error, other.max_ulp_error);
+    for (int i = 0; i < kUlpBuckets; ++i) {
+      ulp_histogram[i] += other.ulp_histogram[i];
+    }
+  }
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Number of elements per partial result of the error metric reductions. Depends only on the
+/// element count so that results are reproducible for any number of threads.
+inline int64_t ErrorMetricsGrain(int64_t count) {
+  return std::max<int64_t>(int64_t(1) << 16, (count + 4095) / 4096);
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Accumulates error metrics over a sequence of slabs of a computed and a reference tensor.
+///
+/// Tensors larger than memory are processed by mapping or loading successive slabs and passing
+/// each pair to update(). Each slab is reduced in parallel chunks whose partial results are
+/// combined in order, so the metrics do not depend on the number of host threads.
+class TensorErrorMetricsAccumulator {
+
+  TensorErrorMetrics metrics_;
+
+public:
+
+  /// Accumulates the elements of a pair of tensor views
+  template <typename Element, typename Layout>
+  void update(
+    TensorView<Element, Layout> const &computed,
+    TensorView<Element, Layout> const &reference) {
+
+    if (computed.extent() != reference.extent()) {
+      throw std::runtime_error("Tensor extents must match.");
+    }
+
+    int64_t count = detail::TensorForEachCount(computed.extent());
+    int64_t grain = detail::ErrorMetricsGrain(count);
+    std::vector<TensorErrorMetrics> partials(size_t((count + grain - 1) / grain));
+
+    TensorForEachChunk(execution::ThreadPool(grain), computed.extent(),
+      [&](TensorForEachChunkRange<Layout::kRank> const &chunk) {
+        TensorErrorMetrics &partial = partials[size_t(chunk.index)];
+        chunk.for_each([&](Coord<Layout::kRank> const &coord) {
+          partial.add<Element>(computed.at(coord), reference.at(coord));
+        });
+      });
+
+    for (auto const &partial : partials) {
+      metrics_.merge(partial);
+    }
+  }
+
+  /// Accumulates count elements of a pair of contiguous blocks
+  template <typename Element>
+  void update(
+    Element const *computed,
+    Element const *reference,
+    size_t count) {
+
+    int64_t grain = detail::ErrorMetricsGrain(int64_t(count));
+    std::vector<TensorErrorMetrics> partials(size_t((int64_t(count) + grain - 1) / grain));
+
+    detail::ForEachChunk(execution::ThreadPool(grain), int64_t(count),
+      [&](int64_t chunk, int64_t begin, int64_t end) {
+        TensorErrorMetrics &partial = partials[size_t(chunk)];
+        for (int64_t i = begin; i < end; ++i) {
+          partial.add<Element>(
+            ReferenceFactory<Element>::get(computed, i),
+            ReferenceFactory<Element>::get(reference, i));
+        }
+      });
+
+    for (auto const &partial : partials) {
+      metrics_.merge(partial);
+    }
+  }
+
+  /// Returns the metrics accumulated so far
+  TensorErrorMetrics const &metrics() const {
+    return metrics_;
+  }
+};
+
+/// Computes the error metrics of a computed tensor with respect to a reference in a single pass
+template <typename Element, typename Layout>
+TensorErrorMetrics TensorErrorMetricsReduce(
+  TensorView<Element, Layout> const &computed,
+  TensorView<Element, Layout> const &reference) {
+
+  TensorErrorMetricsAccumulator accumulator;
+  accumulator.update(computed, reference);
+  return accumulator.metrics();
+}
+
+/// Computes the error metrics of a contiguous computed block with respect to a reference
+template <typename Element>
+TensorErrorMetrics BlockErrorMetricsReduce(
+  Element const *computed,
+  Element const *reference,
+  size_t count) {
+
+  TensorErrorMetricsAccumulator accumulator;
+  accumulator.update(computed, reference, count);
+  return accumulator.metrics();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Helper to compute the relative error metric for tensor A_computed  w.r.t. to tensor A_reference
 template <
   typename Element,
@@ -54,8 +390,18 @@ ComputeType TensorRelativeErrorMetric(
   ComputeType identity = ComputeType()
 ) {
 
-  return cutlass::reference::host::TensorNormDiff(view_A_computed, view_B_reference, identity) /
-   cutlass::reference::host::TensorNorm(view_B_reference, identity);
+  if constexpr (std::is_floating_point<ComputeType>::value && detail::ErrorMetricsValue<Element>::kSupported) {
+
+    // Both norms from a single pass over the tensors
+    TensorErrorMetrics metrics = TensorErrorMetricsReduce(view_A_computed, view_B_reference);
+
+    return ComputeType(std::sqrt(double(identity) + metrics.sum_sq_diff.value())) /
+      ComputeType(std::sqrt(double(identity) + metrics.sum_sq_reference.value()));
+  }
+  else {
+    return cutlass::reference::host::TensorNormDiff(view_A_computed, view_B_reference, identity) /
+     cutlass::reference::host::TensorNorm(view_B_reference, identity);
+  }
 }
 
 
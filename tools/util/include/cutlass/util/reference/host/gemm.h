@@ -34,6 +34,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
 #include "cutlass/coord.h"
 #include "cutlass/numeric_types.h"
 #include "cutlass/functional.h"
@@ -43,6 +47,8 @@
 #include "cutlass/gemm/gemm.h"
 #include "cutlass/arch/mma.h"
 #include "cutlass/util/host_tensor.h"
+#include "cutlass/util/host_parallel.h"
+#include "cutlass/util/host_simd.h"
 
 namespace cutlass {
 namespace reference {
@@ -79,8 +85,200 @@ Out cast_if_scalar(In in) {
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Order in which the host reference GEMM accumulates along the K dimension
+enum class HostGemmAccumulation {
+  kSerialK,     ///< each output accumulates k = 0, 1, .., K-1 in order (bit-compatible default)
+  kSplitK       ///< K may be partitioned across threads and the partial sums added afterwards
+};
+
+/// Blocking and threading parameters of the host reference GEMM
+struct HostGemmConfig {
+  int block_m = 64;               ///< rows of the output tile computed by one task
+  int block_n = 256;              ///< columns of the output tile computed by one task
+  int block_k = 128;              ///< depth of the packed A and B panels
+  int threads = 0;                ///< maximum number of threads (0 selects host_thread_count())
+  HostGemmAccumulation accumulation = HostGemmAccumulation::kSerialK;
+};
+
+/// Process-wide configuration used when compute_gemm() is called without an explicit one
+inline HostGemmConfig &host_gemm_default_config() {
+  static HostGemmConfig config;
+  return config;
+}
+
+namespace detail {
+
+/// Packs rows [row_begin, row_end) and columns [col_begin, col_end) of a rank-2 tensor into a
+/// ComputeType panel storing element (r, c) at panel[r * ld_row + c * ld_col].
+///
+/// Contiguous runs of packed row-major or column-major tensors are widened to float with
+/// vectorized conversions; other layouts and types are converted one element at a time.
+template <typename ComputeType, typename Element, typename Layout>
+void gemm_pack_panel(
+  TensorRef<Element, Layout> ref,
+  int row_begin, int row_end,
+  int col_begin, int col_end,
+  ComputeType *panel,
+  int64_t ld_row,
+  int64_t ld_col,
+  std::vector<float> &scratch) {
+
+  int const rows = row_end - row_begin;
+  int const cols = col_end - col_begin;
+
+  constexpr bool kWiden = std::is_same<ComputeType, float>::value && HostSimdWidenable<Element>::value;
+
+  if constexpr (kWiden && std::is_same<Layout, layout::RowMajor>::value) {
+    for (int r = 0; r < rows; ++r) {
+      Element const *src = ref.data() + ref.offset(MatrixCoord(row_begin + r, col_begin));
+      if (ld_col == 1) {
+        host_widen(src, panel + r * ld_row, cols);
+      }
+      else {
+        scratch.resize(cols);
+        host_widen(src, scratch.data(), cols);
+        for (int c = 0; c < cols; ++c) {
+          panel[r * ld_row + c * ld_col] = scratch[c];
+        }
+      }
+    }
+  }
+  else if constexpr (kWiden && std::is_same<Layout, layout::ColumnMajor>::value) {
+    for (int c = 0; c < cols; ++c) {
+      Element const *src = ref.data() + ref.offset(MatrixCoord(row_begin, col_begin + c));
+      if (ld_row == 1) {
+        host_widen(src, panel + c * ld_col, rows);
+      }
+      else {
+        scratch.resize(rows);
+        host_widen(src, scratch.data(), rows);
+        for (int r = 0; r < rows; ++r) {
+          panel[r * ld_row + c * ld_col] = scratch[r];
+        }
+      }
+    }
+  }
+  else {
+    for (int r = 0; r < rows; ++r) {
+      for (int c = 0; c < cols; ++c) {
+        Element x = ref.at(MatrixCoord(row_begin + r, col_begin + c));
+        panel[r * ld_row + c * ld_col] = ComputeType(cast_if_scalar<ComputeType>(x));
+      }
+    }
+  }
+}
+
+/// Accumulates the product of rows [m_begin, m_end) of A and columns [n_begin, n_end) of B over
+/// k in [k_begin, k_end) into a row-major accumulator tile with leading dimension ldm.
+///
+/// Operands are packed into ComputeType panels once per block_k slab. Each accumulator is updated
+/// by InnerProductOp in increasing k order, so the result is bit-identical to an unblocked loop.
+/// Single-precision multiply-add uses the runtime-selected SIMD micro-kernel of host_simd.h.
+template <
+  typename ElementA,
+  typename LayoutA,
+  typename ElementB,
+  typename LayoutB,
+  typename ComputeType,
+  typename InnerProductOp
+>
+void gemm_accumulate_tile(
+  TensorRef<ElementA, LayoutA> tensor_a,
+  TensorRef<ElementB, LayoutB> tensor_b,
+  int m_begin, int m_end,
+  int n_begin, int n_end,
+  int k_begin, int k_end,
+  int block_k,
+  ComputeType *accum,
+  int ldm,
+  std::vector<ComputeType> &panel_a,
+  std::vector<ComputeType> &panel_b) {
+
+  int const tile_m = m_end - m_begin;
+  int const tile_n = n_end - n_begin;
+
+  constexpr bool kSgemm =
+    std::is_same<ComputeType, float>::value &&
+    std::is_same<InnerProductOp, multiply_add<float>>::value;
+
+  InnerProductOp inner_product_op;
+  std::vector<float> scratch;
+
+  for (int k_block = k_begin; k_block < k_end; k_block += block_k) {
+
+    int const tile_k = std::min(block_k, k_end - k_block);
+
+    panel_a.resize(size_t(tile_k) * tile_m);
+    panel_b.resize(size_t(tile_k) * tile_n);
+
+    // Pack A as (tile_k, tile_m) and B as (tile_k, tile_n), both row-major
+    gemm_pack_panel(tensor_a, m_begin, m_end, k_block, k_block + tile_k,
+                    panel_a.data(), 1, tile_m, scratch);
+    gemm_pack_panel(tensor_b, k_block, k_block + tile_k, n_begin, n_end,
+                    panel_b.data(), tile_n, 1, scratch);
+
+    if constexpr (kSgemm) {
+      auto kernel = host_sgemm_kernel();
+      for (int i = 0; i < tile_m; i += 4) {
+        kernel(std::min(4, tile_m - i), tile_k, tile_n, panel_a.data() + i, tile_m,
+               panel_b.data(), accum + size_t(i) * ldm, ldm);
+      }
+      continue;
+    }
+
+    // Four accumulator rows share each B panel row
+    int i = 0;
+    for (; i + 4 <= tile_m; i += 4) {
+      ComputeType *accum_0 = accum + size_t(i + 0) * ldm;
+      ComputeType *accum_1 = accum + size_t(i + 1) * ldm;
+      ComputeType *accum_2 = accum + size_t(i + 2) * ldm;
+      ComputeType *accum_3 = accum + size_t(i + 3) * ldm;
+
+      for (int kk = 0; kk < tile_k; ++kk) {
+        ComputeType const *a_col = panel_a.data() + size_t(kk) * tile_m + i;
+        ComputeType const a_0 = a_col[0];
+        ComputeType const a_1 = a_col[1];
+        ComputeType const a_2 = a_col[2];
+        ComputeType const a_3 = a_col[3];
+        ComputeType const *b_row = panel_b.data() + size_t(kk) * tile_n;
+
+        for (int j = 0; j < tile_n; ++j) {
+          ComputeType const b = b_row[j];
+          accum_0[j] = inner_product_op(a_0, b, accum_0[j]);
+          accum_1[j] = inner_product_op(a_1, b, accum_1[j]);
+          accum_2[j] = inner_product_op(a_2, b, accum_2[j]);
+          accum_3[j] = inner_product_op(a_3, b, accum_3[j]);
+        }
+      }
+    }
+
+    for (; i < tile_m; ++i) {
+      ComputeType *accum_row = accum + size_t(i) * ldm;
+
+      for (int kk = 0; kk < tile_k; ++kk) {
+        ComputeType const a = panel_a[size_t(kk) * tile_m + i];
+        ComputeType const *b_row = panel_b.data() + size_t(kk) * tile_n;
+
+        for (int j = 0; j < tile_n; ++j) {
+          accum_row[j] = inner_product_op(a, b_row[j], accum_row[j]);
+        }
+      }
+    }
+  }
+}
+
+} // namespace detail
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Computes a general matrix product among matrices (tensors of rank=2) pointed to by TensorRef
 /// objects.
+///
+/// The output is partitioned into block_m x block_n tiles computed concurrently on host threads.
+/// With HostGemmAccumulation::kSerialK (the default) the result is bit-identical for any blocking
+/// and thread count. HostGemmAccumulation::kSplitK additionally partitions K when there are fewer
+/// output tiles than threads; partial sums are then combined with operator+. Outputs narrower
+/// than a byte are written by a single thread.
 template <
   typename ElementA,
   typename LayoutA,
@@ -101,7 +299,8 @@ void compute_gemm(
   ScalarType beta,
   TensorRef<ElementC, LayoutC> tensor_c,
   TensorRef<ElementC, LayoutC> tensor_d,
-  ComputeType initial_accum) {
+  ComputeType initial_accum,
+  HostGemmConfig const &config = host_gemm_default_config()) {
 
   static_assert(
     LayoutA::kRank == 2 &&
@@ -114,59 +313,117 @@ void compute_gemm(
   int const N = problem_size.n();
   int const K = problem_size.k();
 
-  // Blocking necessary to speedup reference implementation
-  int const Mblock = 16;
-  int const Nblock = 16;
-
-  ConvertOp convert_op;
-  InnerProductOp inner_product_op;
+  if (M <= 0 || N <= 0) {
+    return;
+  }
 
-  for (int row_block = 0; row_block < M; row_block += Mblock) {
-    for (int col_block = 0; col_block < N; col_block += Nblock) {
+  int const Mblock = std::max(config.block_m, 1);
+  int const Nblock = std::max(config.block_n, 1);
+  int const Kblock = std::max(config.block_k, 1);
+  int const threads = config.threads > 0 ? config.threads : host_thread_count();
 
-      ComputeType accum[Mblock][Nblock];
+  int64_t const tiles_m = (M + Mblock - 1) / Mblock;
+  int64_t const tiles_n = (N + Nblock - 1) / Nblock;
+  int64_t const tiles = tiles_m * tiles_n;
 
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          accum[i][j] = initial_accum;
-        }
+  // Number of K partitions, each covering a whole number of K blocks
+  int64_t split_k = 1;
+  if (config.accumulation == HostGemmAccumulation::kSplitK && tiles < threads) {
+    int64_t k_blocks = (K + Kblock - 1) / Kblock;
+    split_k = std::max<int64_t>(1, std::min<int64_t>(k_blocks, (threads + tiles - 1) / tiles));
+  }
+  int const k_slice = int(((K + split_k - 1) / split_k + Kblock - 1) / Kblock) * Kblock;
+
+  // Sub-byte elements of adjacent tiles may share a byte, which at() updates by read-modify-write.
+  // Their epilogue therefore runs on one thread, after all tiles are accumulated.
+  constexpr bool kSerialEpilogue = sizeof_bits<ElementC>::value < 8;
+
+  auto epilogue = [&](int m_begin, int m_end, int n_begin, int n_end, ComputeType const *accum, int ldm) {
+    ConvertOp convert_op;
+    for (int i = 0; i < m_end - m_begin; ++i) {
+      for (int j = 0; j < n_end - n_begin; ++j) {
+        MatrixCoord coord = MatrixCoord(m_begin + i, n_begin + j);
+        tensor_d.at(coord) = convert_op(
+          alpha * ScalarType(accum[size_t(i) * ldm + j]) +
+          beta * ScalarType(tensor_c.at(coord)));
       }
+    }
+  };
 
-      for (int k_block = 0; k_block < K; ++k_block) {
-        for (int j = 0; j < Nblock; j++) {
-          for (int i = 0; i < Mblock; i++) {
-            int row = row_block + i;
-            int col = col_block + j;
+  if (split_k == 1 && !kSerialEpilogue) {
 
-            if (row < M && col < N) {
-              ElementA a = tensor_a.at(MatrixCoord(row, k_block));
-              ElementB b = tensor_b.at(MatrixCoord(k_block, col));
+    host_parallel_for(0, tiles, 1, [&](int64_t tile_begin, int64_t tile_end) {
 
-              ComputeType compute_a(cast_if_scalar<ComputeType>(a));
-              ComputeType compute_b(cast_if_scalar<ComputeType>(b));
+      std::vector<ComputeType> accum(size_t(Mblock) * Nblock);
+      std::vector<ComputeType> panel_a;
+      std::vector<ComputeType> panel_b;
 
-              accum[i][j] = inner_product_op(compute_a, compute_b, accum[i][j]);
-            }
-          }
-        }
+      for (int64_t tile = tile_begin; tile < tile_end; ++tile) {
+        int m_begin = int(tile / tiles_n) * Mblock;
+        int n_begin = int(tile % tiles_n) * Nblock;
+        int m_end = std::min(M, m_begin + Mblock);
+        int n_end = std::min(N, n_begin + Nblock);
+
+        std::fill(accum.begin(), accum.end(), initial_accum);
+
+        detail::gemm_accumulate_tile<ElementA, LayoutA, ElementB, LayoutB, ComputeType, InnerProductOp>(
+          tensor_a, tensor_b, m_begin, m_end, n_begin, n_end, 0, K, Kblock,
+          accum.data(), Nblock, panel_a, panel_b);
+
+        epilogue(m_begin, m_end, n_begin, n_end, accum.data(), Nblock);
       }
+    }, threads);
 
-      for (int j = 0; j < Nblock; j++) {
-        for (int i = 0; i < Mblock; i++) {
-          int row = row_block + i;
-          int col = col_block + j;
+    return;
+  }
+
+  // Split-K or serial epilogue: each (tile, slice) pair accumulates into its own partial tile
+  size_t const tile_elements = size_t(Mblock) * Nblock;
+  std::vector<ComputeType> partials(size_t(tiles * split_k) * tile_elements);
+
+  host_parallel_for(0, tiles * split_k, 1, [&](int64_t work_begin, int64_t work_end) {
+
+    std::vector<ComputeType> panel_a;
+    std::vector<ComputeType> panel_b;
+
+    for (int64_t work = work_begin; work < work_end; ++work) {
+      int64_t tile = work / split_k;
+      int slice = int(work % split_k);
 
-          MatrixCoord coord = MatrixCoord(row, col);
+      int m_begin = int(tile / tiles_n) * Mblock;
+      int n_begin = int(tile % tiles_n) * Nblock;
+      int m_end = std::min(M, m_begin + Mblock);
+      int n_end = std::min(N, n_begin + Nblock);
+      int k_begin = std::min(K, slice * k_slice);
+      int k_end = std::min(K, k_begin + k_slice);
 
-          if (row < M && col < N) {
-            tensor_d.at(coord) = convert_op(
-              alpha * ScalarType(accum[i][j]) +
-              beta * ScalarType(tensor_c.at(coord)));
-          }
+      ComputeType *accum = partials.data() + size_t(work) * tile_elements;
+      std::fill(accum, accum + tile_elements, slice == 0 ? initial_accum : ComputeType(0));
+
+      detail::gemm_accumulate_tile<ElementA, LayoutA, ElementB, LayoutB, ComputeType, InnerProductOp>(
+        tensor_a, tensor_b, m_begin, m_end, n_begin, n_end, k_begin, k_end, Kblock,
+        accum, Nblock, panel_a, panel_b);
+    }
+  }, threads);
+
+  host_parallel_for(0, tiles, 1, [&](int64_t tile_begin, int64_t tile_end) {
+    for (int64_t tile = tile_begin; tile < tile_end; ++tile) {
+      int m_begin = int(tile / tiles_n) * Mblock;
+      int n_begin = int(tile % tiles_n) * Nblock;
+      int m_end = std::min(M, m_begin + Mblock);
+      int n_end = std::min(N, n_begin + Nblock);
+
+      ComputeType *accum = partials.data() + size_t(tile * split_k) * tile_elements;
+      for (int64_t slice = 1; slice < split_k; ++slice) {
+        ComputeType const *partial = accum + size_t(slice) * tile_elements;
+        for (size_t idx = 0; idx < tile_elements; ++idx) {
+          accum[idx] = accum[idx] + partial[idx];
         }
       }
+
+      epilogue(m_begin, m_end, n_begin, n_end, accum, Nblock);
     }
-  }
+  }, kSerialEpilogue ? 1 : threads);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -192,11 +449,12 @@ void compute_gemm(
   TensorRef<ElementB, LayoutB> tensor_b,
   ScalarType beta,
   TensorRef<ElementC, LayoutC> tensor_c,
-  ComputeType initial_accum) {
+  ComputeType initial_accum,
+  HostGemmConfig const &config = host_gemm_default_config()) {
   compute_gemm<ElementA, LayoutA, ElementB, LayoutB, ElementC, LayoutC,
                ScalarType, ComputeType, InnerProductOp, ConvertOp>(
       problem_size, alpha, tensor_a, tensor_b, beta, tensor_c, tensor_c,
-      initial_accum);
+      initial_accum, config);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
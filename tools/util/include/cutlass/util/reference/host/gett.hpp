@@ -36,9 +36,15 @@
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "cutlass/complex.h"
 #include "cutlass/numeric_conversion.h"
 #include "cutlass/epilogue/thread/activation.h"
+#include "cutlass/util/host_parallel.h"
+#include "cutlass/util/host_simd.h"
 
 #include "cute/tensor.hpp"
 
@@ -143,7 +149,97 @@ struct GettEpilogueParams {
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
+namespace detail {
+
+/// True if the epilogue computes an activation gradient and reduces it into the bias vector (dBias)
+template <class EpilogueParams>
+constexpr bool gett_is_backprop_fusion() {
+  using ActivationFunctor = typename EpilogueParams::ActivationFunctor;
+  using ElementCompute = typename EpilogueParams::ElementCompute;
+  return cute::is_same_v<ActivationFunctor, cutlass::epilogue::thread::dGELU<ElementCompute>> or
+         cute::is_same_v<ActivationFunctor, cutlass::epilogue::thread::dReLU<ElementCompute>>;
+}
+
+} // namespace detail
+
 /// GETT - General Tensor-Tensor contraction reference kernel
+///
+/// The (M, N, L) output is partitioned into kBlockM x kBlockN tiles computed concurrently on host
+/// threads. Each accumulator is updated in increasing k order, so results do not depend on the
+/// tile shape or the number of threads.
+///
+/// A backprop fusion reduces each row of the output into dBias. Tiles store their row sums in a
+/// scratch buffer, which is added to dBias afterwards in the order of a serial (l, m, n) tile loop.
+template <
+  int kBlockM,
+  int kBlockN,
+  class MainloopParams,
+  class EpilogueParams
+>
+void Gett(
+    MainloopParams const& mainloop_params,
+    EpilogueParams const& epilogue_params)
+{
+  int64_t const M = cute::size<0>(mainloop_params.A.layout());
+  int64_t const N = cute::size<0>(mainloop_params.B.layout());
+  int64_t const L = cute::size<2>(mainloop_params.A.layout());
+
+  int64_t const tiles_m = (M + kBlockM - 1) / kBlockM;
+  int64_t const tiles_n = (N + kBlockN - 1) / kBlockN;
+  int64_t const tiles = L * tiles_m * tiles_n;
+
+  using ElementCompute = typename EpilogueParams::ElementCompute;
+
+  bool const reduce_dBias =
+    detail::gett_is_backprop_fusion<EpilogueParams>() && cute::raw_pointer_cast(epilogue_params.Bias.data());
+
+  // Per-tile dBias row sums, kBlockM per tile
+  std::vector<ElementCompute> dBias_partials(reduce_dBias ? size_t(tiles) * kBlockM : 0);
+
+  host_parallel_for(0, tiles, 1, [&](int64_t tile_begin, int64_t tile_end) {
+    struct Accumulators {
+      typename MainloopParams::ElementAccumulator tile[kBlockM][kBlockN];
+    };
+
+    // Heap-allocated so that large tiles do not exhaust worker thread stacks
+    auto acc = std::make_unique<Accumulators>();
+
+    for (int64_t tile = tile_begin; tile < tile_end; ++tile) {
+      int64_t n = (tile % tiles_n) * kBlockN;
+      int64_t m = ((tile / tiles_n) % tiles_m) * kBlockM;
+      int64_t l = tile / (tiles_n * tiles_m);
+
+      gett_mainloop(mainloop_params, m, n, l, acc->tile);
+      gett_epilogue(epilogue_params, m, n, l, acc->tile,
+                    reduce_dBias ? dBias_partials.data() + size_t(tile) * kBlockM : nullptr);
+    }
+  });
+
+  if (reduce_dBias) {
+    NumericConverter<ElementCompute, typename EpilogueParams::VectorBias::value_type> bias_converter;
+    NumericConverter<typename EpilogueParams::VectorBias::value_type, ElementCompute> dBias_converter;
+    plus<ElementCompute> add;
+
+    host_parallel_for(0, tiles_m, 1, [&](int64_t tile_m_begin, int64_t tile_m_end) {
+      for (int64_t tile_m = tile_m_begin; tile_m < tile_m_end; ++tile_m) {
+        int64_t m = tile_m * kBlockM;
+        int const rows = int(cute::min(int64_t(kBlockM), M - m));
+        for (int64_t l = 0; l < L; ++l) {
+          for (int64_t tile_n = 0; tile_n < tiles_n; ++tile_n) {
+            ElementCompute const* partial =
+              dBias_partials.data() + size_t((l * tiles_m + tile_m) * tiles_n + tile_n) * kBlockM;
+            for (int m_b = 0; m_b < rows; ++m_b) {
+              ElementCompute dBias = add(partial[m_b], bias_converter(epilogue_params.Bias(m + m_b)));
+              epilogue_params.Bias(m + m_b) = dBias_converter(dBias);
+            }
+          }
+        }
+      }
+    });
+  }
+}
+
+/// GETT - General Tensor-Tensor contraction reference kernel with 64 x 64 tiles
 template <
   class MainloopParams,
   class EpilogueParams
@@ -152,27 +248,76 @@ void Gett(
     MainloopParams const& mainloop_params,
     EpilogueParams const& epilogue_params)
 {
+  Gett<64, 64>(mainloop_params, epilogue_params);
+}
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Depth of the packed A and B k-slabs
+static constexpr int kGettBlockK = 256;
+
+/// True if a mode of the layout is a single integer extent and stride
+template <class Layout, int Mode>
+constexpr bool gett_is_flat_mode() {
+  return cute::is_integral<cute::remove_cvref_t<decltype(cute::get<Mode>(cute::shape(Layout{})))>>::value &&
+         cute::is_integral<cute::remove_cvref_t<decltype(cute::get<Mode>(cute::stride(Layout{})))>>::value;
+}
+
+/// Packs rows [row, row + rows) and k in [k, k + depth) of a (Row, K, L) tensor into
+/// panel[kk * ld + r], converted to the accumulator type and optionally conjugated.
+///
+/// Layouts whose row and k modes are flat are addressed through the iterator with their strides,
+/// which fold to constants when static. Hierarchical modes use cute tensor indexing.
+template <bool Conjugate, class ElementAccumulator, class Element, class Tensor>
+void gett_pack_panel(
+    Tensor const& tensor,
+    int64_t row, int rows,
+    int64_t k, int depth,
+    int64_t l,
+    ElementAccumulator* panel,
+    int ld)
+{
+  using Layout = cute::remove_cvref_t<decltype(tensor.layout())>;
 
-  static int constexpr kBlockM = 64;
-  static int constexpr kBlockN = 64;
-
-#if defined(_OPENMP)
-  #pragma omp parallel for collapse(3)
-#endif
-  for (int64_t l = 0; l < cute::size<2>(mainloop_params.A.layout()); ++l) {
-    for (int64_t m = 0; m < cute::size<0>(mainloop_params.A.layout()); m += kBlockM) {
-      for (int64_t n = 0; n < cute::size<0>(mainloop_params.B.layout()); n += kBlockN) {
-        typename MainloopParams::ElementAccumulator acc[kBlockM][kBlockN];
-        gett_mainloop(mainloop_params, m, n, l, acc);
-        gett_epilogue(epilogue_params, m, n, l, acc);
+  auto convert = [](auto const& x) {
+    // Perform reference GEMM calculations at the accumulator's precision
+    ElementAccumulator value = static_cast<ElementAccumulator>(Element(x));
+    if constexpr (Conjugate) {
+      value = conj(value);
+    }
+    return value;
+  };
+
+  if constexpr (gett_is_flat_mode<Layout, 0>() && gett_is_flat_mode<Layout, 1>()) {
+    auto const stride_row = cute::get<0>(tensor.stride());
+    auto const stride_k = cute::get<1>(tensor.stride());
+    auto base = tensor.data() + tensor.layout()(row, k, l);
+    for (int kk = 0; kk < depth; ++kk) {
+      for (int r = 0; r < rows; ++r) {
+        panel[kk * ld + r] = convert(base[r * stride_row + kk * stride_k]);
+      }
+    }
+  }
+  else {
+    for (int kk = 0; kk < depth; ++kk) {
+      for (int r = 0; r < rows; ++r) {
+        panel[kk * ld + r] = convert(tensor(row + r, k + kk, l));
       }
     }
   }
 }
 
+} // namespace detail
+
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// GETT - Mainloop
+///
+/// Packs A and B k-slabs once per tile, resolving the conjugation at compile time, then updates
+/// the accumulators in increasing k order. Single-precision accumulation uses the
+/// runtime-selected SIMD micro-kernel of host_simd.h when one is available.
 template <class MainloopParams, class ElementAccumulator, int kBlockM, int kBlockN>
 void gett_mainloop(
     MainloopParams const& mainloop_params,
@@ -191,6 +336,8 @@ void gett_mainloop(
   using RingOp = multiply_add<ElementAccumulator, ElementAccumulator, ElementAccumulator>;
   RingOp fma_op;
 
+  bool const use_sgemm_kernel = host_simd_isa() != HostSimdIsa::kScalar;
+
   // Zero out accumulators
   for (int m_b = 0; m_b < kBlockM; ++m_b) {
     for (int n_b = 0; n_b < kBlockN; ++n_b) {
@@ -198,58 +345,82 @@ void gett_mainloop(
     }
   }
 
-  // Compute on this k-block
-  for (int64_t k = 0; k < cute::size<1>(mainloop_params.A.layout()); ++k) {
-    // Load A
-    ElementAccumulator a_frag[kBlockM];
-    for (int m_b = 0; m_b < kBlockM; ++m_b) {
-      if (m + m_b < cute::size<0>(mainloop_params.A.layout())) {
-        // Perform reference GEMM calculations at the accumulator's precision. Cast A value to accumulator type.
-        a_frag[m_b] = static_cast<ElementAccumulator>(ElementA(mainloop_params.A(m + m_b, k, l)));
-        
-        if (mainloop_params.transform_A == ComplexTransform::kConjugate) {
-          a_frag[m_b] = conj(a_frag[m_b]);
-        }
-      } else {
-        a_frag[m_b] = ElementAccumulator(0); // RingOp::AdditionIdentity
-      }
+  int const tile_m = int(cute::min(int64_t(kBlockM), int64_t(cute::size<0>(mainloop_params.A.layout())) - m));
+  int const tile_n = int(cute::min(int64_t(kBlockN), int64_t(cute::size<0>(mainloop_params.B.layout())) - n));
+  int64_t const K = cute::size<1>(mainloop_params.A.layout());
+
+  if (tile_m <= 0 || tile_n <= 0) {
+    return;
+  }
+
+  std::vector<ElementAccumulator> panel_a(size_t(detail::kGettBlockK) * tile_m);
+  std::vector<ElementAccumulator> panel_b(size_t(detail::kGettBlockK) * tile_n);
+
+  for (int64_t k = 0; k < K; k += detail::kGettBlockK) {
+    int const depth = int(cute::min(int64_t(detail::kGettBlockK), K - k));
+
+    // Load A and B k-slabs
+    if (mainloop_params.transform_A == ComplexTransform::kConjugate) {
+      detail::gett_pack_panel<true, ElementAccumulator, ElementA>(
+        mainloop_params.A, m, tile_m, k, depth, l, panel_a.data(), tile_m);
+    }
+    else {
+      detail::gett_pack_panel<false, ElementAccumulator, ElementA>(
+        mainloop_params.A, m, tile_m, k, depth, l, panel_a.data(), tile_m);
     }
 
-    // Load B
-    ElementAccumulator b_frag[kBlockN];
-    for (int n_b = 0; n_b < kBlockN; ++n_b) {
-      if (n + n_b < cute::size<0>(mainloop_params.B.layout())) {
-        // Perform reference GEMM calculations at the accumulator's precision. Cast A value to accumulator type.
-        b_frag[n_b] = static_cast<ElementAccumulator>(ElementB(mainloop_params.B(n + n_b, k, l)));
+    if (mainloop_params.transform_B == ComplexTransform::kConjugate) {
+      detail::gett_pack_panel<true, ElementAccumulator, ElementB>(
+        mainloop_params.B, n, tile_n, k, depth, l, panel_b.data(), tile_n);
+    }
+    else {
+      detail::gett_pack_panel<false, ElementAccumulator, ElementB>(
+        mainloop_params.B, n, tile_n, k, depth, l, panel_b.data(), tile_n);
+    }
 
-        if (mainloop_params.transform_B == ComplexTransform::kConjugate) {
-          b_frag[n_b] = conj(b_frag[n_b]);
+    // do compute
+    if constexpr (cute::is_same_v<ElementAccumulator, float>) {
+      if (use_sgemm_kernel) {
+        auto kernel = host_sgemm_kernel();
+        for (int m_b = 0; m_b < tile_m; m_b += 4) {
+          kernel(cute::min(4, tile_m - m_b), depth, tile_n, panel_a.data() + m_b, tile_m,
+                 panel_b.data(), &acc[m_b][0], kBlockN);
         }
-      } else {
-        b_frag[n_b] = ElementAccumulator(0); // RingOp::AdditionIdentity
+        continue;
       }
     }
 
-    // do compute
-    for (int m_b = 0; m_b < kBlockM; ++m_b) {
-      for (int n_b = 0; n_b < kBlockN; ++n_b) {
-        acc[m_b][n_b] = fma_op(a_frag[m_b], b_frag[n_b], acc[m_b][n_b]);
+    for (int kk = 0; kk < depth; ++kk) {
+      // Zero-padded to the full tile width so the inner loop has a constant trip count. Columns
+      // beyond tile_n are never stored by the epilogue.
+      ElementAccumulator b[kBlockN] = {};
+      for (int n_b = 0; n_b < tile_n; ++n_b) {
+        b[n_b] = panel_b[size_t(kk) * tile_n + n_b];
+      }
+      for (int m_b = 0; m_b < tile_m; ++m_b) {
+        ElementAccumulator const a = panel_a[size_t(kk) * tile_m + m_b];
+        for (int n_b = 0; n_b < kBlockN; ++n_b) {
+          acc[m_b][n_b] = fma_op(a, b[n_b], acc[m_b][n_b]);
+        }
       }
     }
-
   }
 }
 
 /////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// GETT - Epilogue
+///
+/// A backprop fusion adds the row sums of the tile to dBias in place, unless dBias_partials is
+/// given: the row sums are then stored there, in kBlockM elements, for the caller to reduce.
 template <class EpilogueParams, class ElementAccumulator, int kBlockM, int kBlockN>
 void gett_epilogue(
     EpilogueParams const& epilogue_params,
     int64_t m,
     int64_t n,
     int64_t l,
-    ElementAccumulator (&acc)[kBlockM][kBlockN])
+    ElementAccumulator (&acc)[kBlockM][kBlockN],
+    typename EpilogueParams::ElementCompute* dBias_partials = nullptr)
 {
   static_assert(cute::rank(typename EpilogueParams::LayoutC{}) == 3, "M, K, B");
   static_assert(cute::rank(typename EpilogueParams::LayoutD{}) == 3, "N, K, B");
@@ -281,9 +452,7 @@ void gett_epilogue(
   constexpr bool IsClamp =
       cute::is_same_v<ActivationFunctor, cutlass::epilogue::thread::Clamp<ElementCompute>>;
 
-  constexpr bool IsBackpropFusion =
-      cute::is_same_v<ActivationFunctor, cutlass::epilogue::thread::dGELU<ElementCompute>> or
-      cute::is_same_v<ActivationFunctor, cutlass::epilogue::thread::dReLU<ElementCompute>>;
+  constexpr bool IsBackpropFusion = detail::gett_is_backprop_fusion<EpilogueParams>();
 
   // Input related converter
   NumericConverter<ElementCompute, ElementAccumulator> accumulator_converter;
@@ -340,17 +509,17 @@ void gett_epilogue(
         // Convert every type to ElementCompute first, do compute, convert to output type, write it out
         ElementCompute converted_acc = accumulator_converter(acc[m_b][n_b]);
         // per-row alpha
-        if (raw_pointer_cast(epilogue_params.Valpha.data())) {
+        if (cute::raw_pointer_cast(epilogue_params.Valpha.data())) {
           converted_alpha = scale_converter(epilogue_params.Valpha(m + m_b));
         }
         ElementCompute output = mul(converted_alpha, converted_acc);
 
-        if (raw_pointer_cast(epilogue_params.Bias.data()) && not IsBackpropFusion) {
+        if (cute::raw_pointer_cast(epilogue_params.Bias.data()) && not IsBackpropFusion) {
           ElementCompute converted_bias = bias_converter(epilogue_params.Bias(PerColBias ? n + n_b : m + m_b));
           output = bias_op(output, converted_bias);
         }
 
-        if (raw_pointer_cast(epilogue_params.C.data())) {
+        if (cute::raw_pointer_cast(epilogue_params.C.data())) {
           ElementCompute converted_src = source_converter(epilogue_params.C(m + m_b, n + n_b, l));
           // per-row beta
           if (epilogue_params.Vbeta.data()) {
@@ -361,7 +530,7 @@ void gett_epilogue(
 
         if constexpr (IsBackpropFusion) {
           ElementAux aux_input = ElementAux(0);
-          if (raw_pointer_cast(epilogue_params.Aux.data())) {
+          if (cute::raw_pointer_cast(epilogue_params.Aux.data())) {
             aux_input = epilogue_params.Aux(m + m_b, n + n_b, l);
           }
 
@@ -369,7 +538,7 @@ void gett_epilogue(
           local_dBias = add(local_dBias, output);
         }
         else {
-          if (raw_pointer_cast(epilogue_params.Aux.data())) {
+          if (cute::raw_pointer_cast(epilogue_params.Aux.data())) {
             auto aux_output = output;
             if constexpr (IsScalingAndAmaxAuxOutputNeeded) {
               maximum_absolute_value_reduction<ElementCompute, true> amax_op;
@@ -403,7 +572,10 @@ void gett_epilogue(
     } // n_b
 
     if (m + m_b < cute::size<0>(epilogue_params.D.layout()) && n < cute::size<1>(epilogue_params.D.layout())) {
-      if (raw_pointer_cast(epilogue_params.Bias.data()) && IsBackpropFusion) {
+      if (cute::raw_pointer_cast(epilogue_params.Bias.data()) && IsBackpropFusion && dBias_partials) {
+        dBias_partials[m_b] = local_dBias;
+      }
+      else if (cute::raw_pointer_cast(epilogue_params.Bias.data()) && IsBackpropFusion) {
         ElementCompute converted_dBias = bias_converter(epilogue_params.Bias(m + m_b));
         local_dBias = add(local_dBias, converted_dBias);
         epilogue_params.Bias(m + m_b) = dBias_converter(local_dBias);
@@ -417,10 +589,11 @@ void gett_epilogue(
       }
     }
   }
-#if defined(_OPENMP)
-  #pragma omp critical(Abs_Max_Data_Update)
-#endif
   {
+    // Tiles run concurrently on host threads
+    static std::mutex abs_max_mutex;
+    std::lock_guard<std::mutex> lock(abs_max_mutex);
+
     if constexpr (IsScalingAndAmaxOutputNeeded) {
       if (epilogue_params.abs_max_D) {
         *epilogue_params.abs_max_D = maximum_with_nan_propogation<ElementAccumulator>{}(
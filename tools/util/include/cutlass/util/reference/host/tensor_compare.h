@@ -35,10 +35,20 @@
 #pragma once
 
 // Standard Library includes
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 // Cutlass includes
 #include "cutlass/cutlass.h"
+#include "cutlass/complex.h"
+#include "cutlass/numeric_types.h"
 #include "cutlass/relatively_equal.h"
 #include "cutlass/tensor_view.h"
 #include "cutlass/tensor_view_planar_complex.h"
@@ -144,6 +154,256 @@ struct TensorRelativelyEqualsFunc {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Summary of the differences between two tensors
+template <int Rank>
+struct TensorCompareReport {
+
+  /// Number of elements compared
+  int64_t element_count = 0;
+
+  /// Number of elements failing the comparison
+  int64_t mismatch_count = 0;
+
+  /// True if the extents differ, in which case no elements are compared
+  bool extent_mismatch = false;
+
+  /// Coordinates of the first mismatches in linear order (last rank changing fastest)
+  std::vector<Coord<Rank>> mismatches;
+
+  /// Largest |lhs - rhs| over all elements
+  double max_abs_error = 0;
+
+  /// Largest |lhs - rhs| / (|lhs| + |rhs|) over all elements, as tested by relatively_equal()
+  double max_rel_error = 0;
+
+  /// Returns true if every element passed the comparison
+  bool passed() const {
+    return !extent_mismatch && mismatch_count == 0;
+  }
+};
+
+/// Prints a TensorCompareReport
+template <int Rank>
+std::ostream &operator<<(std::ostream &out, TensorCompareReport<Rank> const &report) {
+
+  if (report.extent_mismatch) {
+    return out << "extents differ";
+  }
+
+  out << report.mismatch_count << " of " << report.element_count << " elements differ"
+      << ", max abs error " << report.max_abs_error
+      << ", max rel error " << report.max_rel_error;
+
+  for (auto const &coord : report.mismatches) {
+    out << "\n  at (";
+    for (int i = 0; i < Rank; ++i) {
+      out << (i ? ", " : "") << coord[i];
+    }
+    out << ")";
+  }
+  return out;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// Linear indices visited by each task of the parallel comparisons
+static int64_t const kTensorCompareGrain = int64_t(1) << 16;
+
+/// Absolute and relative error between two elements. Types without a conversion to double
+/// report zero error.
+template <typename Element, typename Enable = void>
+struct TensorCompareError {
+  static void compute(Element const &, Element const &, double &abs_error, double &rel_error) {
+    abs_error = 0;
+    rel_error = 0;
+  }
+};
+
+template <typename Element>
+struct TensorCompareError<Element, typename std::enable_if<std::is_constructible<double, Element>::value>::type> {
+  static void compute(Element const &lhs, Element const &rhs, double &abs_error, double &rel_error) {
+    double a = static_cast<double>(lhs);
+    double b = static_cast<double>(rhs);
+    abs_error = std::abs(a - b);
+    double magnitude = std::abs(a) + std::abs(b);
+    rel_error = (magnitude > 0) ? abs_error / magnitude : abs_error;
+  }
+};
+
+template <typename T>
+struct TensorCompareError<complex<T>, typename std::enable_if<std::is_constructible<double, T>::value>::type> {
+  static void compute(complex<T> const &lhs, complex<T> const &rhs, double &abs_error, double &rel_error) {
+    double a_re = static_cast<double>(lhs.real()), a_im = static_cast<double>(lhs.imag());
+    double b_re = static_cast<double>(rhs.real()), b_im = static_cast<double>(rhs.imag());
+    abs_error = std::hypot(a_re - b_re, a_im - b_im);
+    double magnitude = std::hypot(a_re, a_im) + std::hypot(b_re, b_im);
+    rel_error = (magnitude > 0) ? abs_error / magnitude : abs_error;
+  }
+};
+
+/// Compares the storage of two dense tensors with identical strides in parallel chunks.
+///
+/// Returns true only if both are bitwise identical and no element is unequal to itself (NaN),
+/// which implies every element compares equal and relatively equal. A false result is
+/// inconclusive and callers fall back to an elementwise comparison.
+template <typename Element, typename Layout>
+bool TensorBitwiseEqualsDense(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs) {
+
+  if constexpr (sizeof_bits<Element>::value < 8 || !std::is_trivially_copyable<Element>::value) {
+    return false;
+  }
+  else {
+    int64_t count = TensorForEachCount(lhs.extent());
+
+    if (!(lhs.stride() == rhs.stride()) || int64_t(lhs.capacity()) != count) {
+      return false;
+    }
+
+    Element const *lhs_ptr = lhs.data();
+    Element const *rhs_ptr = rhs.data();
+    std::atomic<bool> equal(true);
+
+    ForEachChunk(execution::ThreadPool(kTensorCompareGrain), count,
+      [&](int64_t, int64_t begin, int64_t end) {
+
+        if (!equal.load(std::memory_order_relaxed)) {
+          return;
+        }
+        if (std::memcmp(lhs_ptr + begin, rhs_ptr + begin, size_t(end - begin) * sizeof(Element))) {
+          equal.store(false, std::memory_order_relaxed);
+          return;
+        }
+        if constexpr (!std::is_integral<Element>::value) {
+          for (int64_t i = begin; i < end; ++i) {
+            if (!(lhs_ptr[i] == lhs_ptr[i])) {
+              equal.store(false, std::memory_order_relaxed);
+              return;
+            }
+          }
+        }
+      });
+
+    return equal.load();
+  }
+}
+
+/// Returns true if pred(lhs, rhs) holds for every element. Chunks are scanned in parallel and
+/// the scan stops at the first chunk boundary after any element fails.
+template <typename Element, typename Layout, typename Pred>
+bool TensorCompareAll(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Pred const &pred) {
+
+  std::atomic<bool> result(true);
+
+  TensorForEachChunk(execution::ThreadPool(kTensorCompareGrain), lhs.extent(),
+    [&](TensorForEachChunkRange<Layout::kRank> const &chunk) {
+
+      if (!result.load(std::memory_order_relaxed)) {
+        return;
+      }
+
+      bool chunk_result = true;
+      chunk.for_each([&](Coord<Layout::kRank> const &coord) {
+        if (chunk_result && !pred(lhs.at(coord), rhs.at(coord))) {
+          chunk_result = false;
+        }
+      });
+
+      if (!chunk_result) {
+        result.store(false, std::memory_order_relaxed);
+      }
+    });
+
+  return result.load();
+}
+
+/// Scans every element and summarizes where pred(lhs, rhs) fails
+template <typename Element, typename Layout, typename Pred>
+TensorCompareReport<Layout::kRank> TensorCompareReportAll(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Pred const &pred,
+  int max_reported) {
+
+  static int const kRank = Layout::kRank;
+  using LinearCoord = std::pair<int64_t, Coord<kRank>>;
+
+  TensorCompareReport<kRank> report;
+
+  if (lhs.extent() != rhs.extent()) {
+    report.extent_mismatch = true;
+    return report;
+  }
+
+  report.element_count = TensorForEachCount(lhs.extent());
+
+  if (TensorBitwiseEqualsDense(lhs, rhs)) {
+    return report;
+  }
+
+  std::mutex mutex;
+  std::vector<LinearCoord> first_mismatches;
+
+  TensorForEachChunk(execution::ThreadPool(kTensorCompareGrain), lhs.extent(),
+    [&](TensorForEachChunkRange<kRank> const &chunk) {
+
+      int64_t count = 0;
+      int64_t index = chunk.begin;
+      double max_abs_error = 0;
+      double max_rel_error = 0;
+      std::vector<LinearCoord> mismatches;
+
+      chunk.for_each([&](Coord<kRank> const &coord) {
+        Element lhs_ = lhs.at(coord);
+        Element rhs_ = rhs.at(coord);
+
+        double abs_error, rel_error;
+        TensorCompareError<Element>::compute(lhs_, rhs_, abs_error, rel_error);
+        max_abs_error = std::max(max_abs_error, abs_error);
+        max_rel_error = std::max(max_rel_error, rel_error);
+
+        if (!pred(lhs_, rhs_)) {
+          if (int(mismatches.size()) < max_reported) {
+            mismatches.emplace_back(index, coord);
+          }
+          ++count;
+        }
+        ++index;
+      });
+
+      std::lock_guard<std::mutex> lock(mutex);
+
+      report.mismatch_count += count;
+      report.max_abs_error = std::max(report.max_abs_error, max_abs_error);
+      report.max_rel_error = std::max(report.max_rel_error, max_rel_error);
+
+      if (!mismatches.empty()) {
+        std::vector<LinearCoord> merged;
+        std::merge(first_mismatches.begin(), first_mismatches.end(),
+                   mismatches.begin(), mismatches.end(), std::back_inserter(merged),
+                   [](LinearCoord const &a, LinearCoord const &b) { return std::get<0>(a) < std::get<0>(b); });
+        merged.resize(std::min(merged.size(), size_t(max_reported)));
+        first_mismatches.swap(merged);
+      }
+    });
+
+  for (auto const &mismatch : first_mismatches) {
+    report.mismatches.push_back(mismatch.second);
+  }
+
+  return report;
+}
+
+} // namespace detail
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Returns true if two tensor views are equal.
 template <
   typename Element,               ///< Element type
@@ -157,13 +417,28 @@ bool TensorEquals(
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> func(lhs, rhs);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
+  if (detail::TensorBitwiseEqualsDense(lhs, rhs)) {
+    return true;
+  }
 
-  return bool(func);
+  return detail::TensorCompareAll(lhs, rhs, [](Element const &lhs_, Element const &rhs_) {
+    return !(lhs_ != rhs_);
+  });
+}
+
+/// Compares two tensor views for equality and summarizes the differences, recording the
+/// coordinates of at most max_reported mismatches.
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+TensorCompareReport<Layout::kRank> TensorEqualsReport(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  int max_reported = 16) {
+
+  return detail::TensorCompareReportAll(lhs, rhs, [](Element const &lhs_, Element const &rhs_) {
+    return !(lhs_ != rhs_);
+  }, max_reported);
 }
 
 /// Returns true if two tensor views are equal.
@@ -179,31 +454,13 @@ bool TensorEquals(
     return false;
   }
 
-  detail::TensorEqualsFunc<Element, Layout> real_func(
-    {lhs.data(), lhs.layout(), lhs.extent()},
-    {rhs.data(), rhs.layout(), rhs.extent()}
-  );
-
-  TensorForEach(
-    lhs.extent(),
-    real_func
-  );
-
-  if (!bool(real_func)) {
-    return false;
-  }
-
-  detail::TensorEqualsFunc<Element, Layout> imag_func(
-    {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()}, 
-    {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()}
-    );
-
-  TensorForEach(
-    lhs.extent(),
-    imag_func
-  );
-
-  return bool(imag_func);
+  return
+    TensorEquals<Element, Layout>(
+      {lhs.data(), lhs.layout(), lhs.extent()},
+      {rhs.data(), rhs.layout(), rhs.extent()}) &&
+    TensorEquals<Element, Layout>(
+      {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()},
+      {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()});
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -224,13 +481,30 @@ bool TensorRelativelyEquals(
     return false;
   }
 
-  detail::TensorRelativelyEqualsFunc<Element, Layout> func(lhs, rhs, epsilon, nonzero_floor);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
+  if (detail::TensorBitwiseEqualsDense(lhs, rhs)) {
+    return true;
+  }
 
-  return bool(func);
+  return detail::TensorCompareAll(lhs, rhs, [=](Element const &lhs_, Element const &rhs_) {
+    return relatively_equal(lhs_, rhs_, epsilon, nonzero_floor);
+  });
+}
+
+/// Compares two tensor views for relative equality and summarizes the differences, recording
+/// the coordinates of at most max_reported mismatches.
+template <
+  typename Element,               ///< Element type
+  typename Layout>                ///< Layout function
+TensorCompareReport<Layout::kRank> TensorRelativelyEqualsReport(
+  TensorView<Element, Layout> const &lhs,
+  TensorView<Element, Layout> const &rhs,
+  Element epsilon,
+  Element nonzero_floor,
+  int max_reported = 16) {
+
+  return detail::TensorCompareReportAll(lhs, rhs, [=](Element const &lhs_, Element const &rhs_) {
+    return relatively_equal(lhs_, rhs_, epsilon, nonzero_floor);
+  }, max_reported);
 }
 
 /// Returns true if two tensor views are relatively equal.
@@ -248,35 +522,17 @@ bool TensorRelativelyEquals(
     return false;
   }
 
-  detail::TensorRelativelyEqualsFunc<Element, Layout> real_func(
-    {lhs.data(), lhs.layout(), lhs.extent()},
-    {rhs.data(), rhs.layout(), rhs.extent()},
-    epsilon,
-    nonzero_floor
-  );
-
-  TensorForEach(
-    lhs.extent(),
-    real_func
-  );
-
-  if (!bool(real_func)) {
-    return false;
-  }
-
-  detail::TensorEqualsFunc<Element, Layout> imag_func(
-    {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()},
-    {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()},
-    epsilon,
-    nonzero_floor
-  );
-
-  TensorForEach(
-    lhs.extent(),
-    imag_func
-  );
-
-  return bool(imag_func);
+  return
+    TensorRelativelyEquals<Element, Layout>(
+      {lhs.data(), lhs.layout(), lhs.extent()},
+      {rhs.data(), rhs.layout(), rhs.extent()},
+      epsilon,
+      nonzero_floor) &&
+    TensorRelativelyEquals<Element, Layout>(
+      {lhs.data() + lhs.imaginary_stride(), lhs.layout(), lhs.extent()},
+      {rhs.data() + rhs.imaginary_stride(), rhs.layout(), rhs.extent()},
+      epsilon,
+      nonzero_floor);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -290,18 +546,7 @@ bool TensorNotEquals(
   TensorView<Element, Layout> const &lhs,
   TensorView<Element, Layout> const &rhs) {
 
-  // Extents must be identical
-  if (lhs.extent() != rhs.extent()) {
-    return true;
-  }
-
-  detail::TensorEqualsFunc<Element, Layout> func(lhs, rhs);
-  TensorForEach(
-    lhs.extent(),
-    func
-  );
-
-  return !bool(func);
+  return !TensorEquals(lhs, rhs);
 }
 
 /// Returns true if two tensor views are equal.
@@ -53,6 +53,7 @@
 #include "cutlass/blas3.h"
 
 #include "cutlass/util/distribution.h"
+#include "cutlass/util/philox.h"
 #include "tensor_foreach.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -94,6 +95,9 @@ struct TensorFillFunc {
   }
 };
 
+/// Philox draw supplying the Bernoulli sample that decides whether a Gaussian element is nonzero
+static uint32_t const kRandomBernoulliDraw = 2;
+
 /// Returns a pair of values of the Gaussian distribution generated by the Box Muller method 
 struct BoxMullerFunc {
 
@@ -101,18 +105,73 @@ struct BoxMullerFunc {
 
   void operator()(
     double* rnd,                     ///< Size-2 vector to be filled with random values
+    Array<uint32_t, 4> const &bits,  ///< Random bits of one Philox draw
     double  mean = 0,                ///< Mean of the Gaussian distribution
     double  stddev = 1,              ///< Standard deviation of the Gaussian distribution
     double  pi = std::acos(-1)) const {
 
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+    double u1 = Philox4x32::to_uniform_double(bits[0], bits[1]);
+    double u2 = Philox4x32::to_uniform_double(bits[2], bits[3]);
     rnd[0] = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
     rnd[1] = std::sqrt(-2 * std::log(u1)) * std::sin(2 * pi * u2);
     rnd[0] = mean + stddev * rnd[0];
     rnd[1] = mean + stddev * rnd[1];
   }
 };
+
+/// Samples the Bernoulli distribution with success probability pnz percent for an element
+inline bool RandomBernoulli(uint64_t seed, uint64_t index, double pnz) {
+  if (pnz >= 100.0) {
+    return true;
+  }
+  uint32_t bits = Philox4x32::generate(seed, index, kRandomBernoulliDraw)[0];
+  return Philox4x32::to_unit_double(bits) < pnz / 100;
+}
+
+/// Linear index of a coordinate within an extent, with the last rank changing fastest. Random
+/// fills key their generator with this index, so values do not depend on the layout or padding.
+template <int Rank, typename Index, typename LongIndex>
+uint64_t TensorLinearIndex(
+  Coord<Rank, Index, LongIndex> const &coord,
+  Coord<Rank, Index, LongIndex> const &extent) {
+
+  uint64_t index = 0;
+  for (int i = 0; i < Rank; ++i) {
+    index = index * uint64_t(extent[i]) + uint64_t(coord[i]);
+  }
+  return index;
+}
+
+/// Calls func(coord) for each point in a tensor's index space on the host thread pool. Sub-byte
+/// elements are visited serially since neighboring elements may share a byte.
+template <typename Element, typename Func, int Rank>
+void TensorFillForEach(Coord<Rank> extent, Func const &func) {
+  if constexpr (sizeof_bits<Element>::value < 8) {
+    TensorForEach(execution::Sequential(), extent, func);
+  }
+  else {
+    TensorForEach(execution::ThreadPool(), extent, func);
+  }
+}
+
+/// Fills ptr[0, capacity) with func(index) on the host thread pool
+template <typename Element, typename Func>
+void BlockFillForEach(Element *ptr, size_t capacity, Func const &func) {
+
+  auto fill = [&](int64_t, int64_t begin, int64_t end) {
+    for (int64_t i = begin; i < end; ++i) {
+      ReferenceFactory<Element>::get(ptr, i) = func(uint64_t(i));
+    }
+  };
+
+  if constexpr (sizeof_bits<Element>::value < 8) {
+    ForEachChunk(execution::Sequential(), int64_t(capacity), fill);
+  }
+  else {
+    ForEachChunk(execution::ThreadPool(), int64_t(capacity), fill);
+  }
+}
+
 } // namespace detail
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -127,10 +186,7 @@ void TensorFill(
 
   detail::TensorFillFunc<Element, Layout> func(dst, val);
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 /// Fills a tensor with a uniform value
@@ -150,6 +206,7 @@ void TensorFill(
 
 namespace detail {
 
+/// Gaussian random values keyed by (seed, linear index) via the Philox generator
 template <typename Element>
 struct RandomGaussianFunc {
 
@@ -160,6 +217,9 @@ struct RandomGaussianFunc {
   double pi;
   double pnz;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -171,15 +231,20 @@ struct RandomGaussianFunc {
     double pnz_ = 100.0
   ):
     seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_) {
-      std::srand((unsigned)seed);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Element operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
 
     // Box-Muller transform to generate random numbers with Normal distribution
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+    Array<uint32_t, 4> bits = Philox4x32::generate(seed, index);
+    double u1 = Philox4x32::to_uniform_double(bits[0], bits[1]);
+    double u2 = Philox4x32::to_uniform_double(bits[2], bits[3]);
 
     // Compute Gaussian random value
     double rnd = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
@@ -189,10 +254,7 @@ struct RandomGaussianFunc {
     Element result;
 
     // Sample from the Bernoulli distribution, and use the result to sample from the Gaussian
-    std::random_device rnd_device;
-    std::mt19937 bernoulli_rnd(rnd_device());
-    std::bernoulli_distribution bernoulli_dist(pnz / 100);
-    bool bernoulli_result = bernoulli_dist(bernoulli_rnd);
+    bool bernoulli_result = RandomBernoulli(seed, index, pnz);
 
     // Sample from the Gaussian distribution for a nonzero element
     if (bernoulli_result) {
@@ -223,6 +285,9 @@ struct RandomGaussianFunc<complex<Element> > {
   double pi;
   double pnz;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -234,23 +299,24 @@ struct RandomGaussianFunc<complex<Element> > {
     double pnz_ = 100.0
   ):
     seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_) {
-      std::srand((unsigned)seed);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   complex<Element> operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  complex<Element> operator()(uint64_t index) const {
 
     Element reals[2];
 
     double rnd[2];
     detail::BoxMullerFunc func;
-    func(rnd, mean, stddev, pi);
+    func(rnd, Philox4x32::generate(seed, index), mean, stddev, pi);
 
     // Sample from the Bernoulli distribution, and use the result to sample from the Gaussian
-    std::random_device rnd_device;
-    std::mt19937 bernoulli_rnd(rnd_device());
-    std::bernoulli_distribution bernoulli_dist(pnz / 100);
-    bool bernoulli_result = bernoulli_dist(bernoulli_rnd);
+    bool bernoulli_result = RandomBernoulli(seed, index, pnz);
 
     // Sample from the Gaussian distribution for a nonzero element
     if (bernoulli_result) {
@@ -285,6 +351,9 @@ struct RandomGaussianFunc<Quaternion<Element> > {
   double pi;
   double pnz;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -296,25 +365,26 @@ struct RandomGaussianFunc<Quaternion<Element> > {
     double pnz_ = 100.0
   ):
     seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)), pnz(pnz_) {
-      std::srand((unsigned)seed);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Quaternion<Element> operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Quaternion<Element> operator()(uint64_t index) const {
 
     Element reals[4];
 
     double rnd1[2];
     double rnd2[2];
     detail::BoxMullerFunc func;
-    func(rnd1, mean, stddev, pi);
-    func(rnd2, mean, stddev, pi);
+    func(rnd1, Philox4x32::generate(seed, index, 0), mean, stddev, pi);
+    func(rnd2, Philox4x32::generate(seed, index, 1), mean, stddev, pi);
 
     // Sample from the Bernoulli distribution, and use the result to sample from the Gaussian
-    std::random_device rnd_device;
-    std::mt19937 bernoulli_rnd(rnd_device());
-    std::bernoulli_distribution bernoulli_dist(pnz / 100);
-    bool bernoulli_result = bernoulli_dist(bernoulli_rnd);
+    bool bernoulli_result = RandomBernoulli(seed, index, pnz);
 
     // Sample from the Gaussian distribution for a nonzero element
     if (bernoulli_result) {
@@ -375,9 +445,9 @@ struct TensorFillGaussianFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at coord
   void operator()(Coord<Layout::kRank> const &coord) const {
-    view.at(coord) = func();
+    view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
   }
 };
 
@@ -411,17 +481,17 @@ struct TensorFillSymmetricGaussianFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at coord
   void operator()(Coord<Layout::kRank> const &coord) const {
     // Fill half of matrix based on FillMode
     if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kLower &&
         coord[0] >= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         coord[0] <= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
     }
   }
 };
@@ -450,10 +520,7 @@ void TensorFillRandomGaussian(
     random_func
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 /// Fills a tensor with random values with a Gaussian distribution.
@@ -496,10 +563,7 @@ void TensorFillSymmetricRandomGaussian(
     fill_mode
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -521,9 +585,7 @@ void BlockFillRandomGaussian(
 
   detail::RandomGaussianFunc<Element> random_func(seed, mean, stddev, bits, pnz);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ReferenceFactory<Element>::get(ptr, i) = random_func();
-  }
+  detail::BlockFillForEach(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -532,6 +594,7 @@ void BlockFillRandomGaussian(
 
 namespace detail {
 
+/// Uniform random values keyed by (seed, linear index) via the Philox generator
 template <typename Element>
 struct RandomUniformFunc {
 
@@ -542,6 +605,9 @@ struct RandomUniformFunc {
   double min;
   int int_scale;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -553,14 +619,19 @@ struct RandomUniformFunc {
     int int_scale_ = -1
   ):
     seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
     }
 
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Element operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
 
-    double rnd = double(std::rand()) / double(RAND_MAX);
+    Array<uint32_t, 4> bits = Philox4x32::generate(seed, index);
+    double rnd = Philox4x32::to_uniform_double(bits[0], bits[1]);
 
     rnd = min + range * rnd;
 
@@ -590,6 +661,9 @@ struct RandomUniformFunc<complex<Element> > {
   double min;
   int int_scale;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -601,17 +675,23 @@ struct RandomUniformFunc<complex<Element> > {
     int int_scale_ = -1
   ):
     seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
     }
 
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   complex<Element> operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  complex<Element> operator()(uint64_t index) const {
 
     Element reals[2];
 
+    Array<uint32_t, 4> bits = Philox4x32::generate(seed, index);
+
     for (int i = 0; i < 2; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      double rnd = Philox4x32::to_uniform_double(bits[2 * i], bits[2 * i + 1]);
 
       rnd = min + range * rnd;
 
@@ -642,6 +722,9 @@ struct RandomUniformFunc<Quaternion<Element> > {
   double min;
   int int_scale;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -653,17 +736,22 @@ struct RandomUniformFunc<Quaternion<Element> > {
     int int_scale_ = -1
   ):
     seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
     }
 
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Quaternion<Element> operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Quaternion<Element> operator()(uint64_t index) const {
 
     Element reals[4];
 
     for (int i = 0; i < 4; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      Array<uint32_t, 4> bits = Philox4x32::generate(seed, index, uint32_t(i / 2));
+      double rnd = Philox4x32::to_uniform_double(bits[2 * (i % 2)], bits[2 * (i % 2) + 1]);
 
       rnd = min + range * rnd;
 
@@ -711,10 +799,10 @@ struct TensorFillRandomUniformFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at coord
   void operator()(Coord<Layout::kRank> const &coord) const {
 
-    view.at(coord) = func();
+    view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
   }
 };
 
@@ -748,17 +836,17 @@ struct TensorFillSymmetricRandomUniformFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at coord
   void operator()(Coord<Layout::kRank> const &coord) const {
     // Fill half of matrix based on FillMode
     if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kLower &&
         coord[0] >= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         coord[0] <= coord[1]) {
-      view.at(coord) = func();
+      view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
     }
   }
 };
@@ -795,19 +883,19 @@ struct TensorFillPadDiagonalRandomUniformFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at coord
   void operator()(Coord<Layout::kRank> const &coord) const {
     // Fill half of matrix based on FillMode
     if (Layout::kRank == 2 && 
         (fill_mode == cutlass::FillMode::kLower) &&
         (coord[0] >= coord[1]) || 
         ((coord[1] - coord[0]) >= alignment)) {
-      view.at(coord) = func();
+      view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
     } else if (Layout::kRank == 2 && 
         fill_mode == cutlass::FillMode::kUpper &&
         (coord[0] <= coord[1]) ||
         ((coord[0] - coord[1]) >= alignment)) {
-      view.at(coord) = func();
+      view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
     }
   }
 };
@@ -835,10 +923,7 @@ void TensorFillRandomUniform(
     random_func
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 /// Fills a tensor with random values of a uniform random distribution.
@@ -878,10 +963,7 @@ void TensorFillRandomUniform(
     random_func
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -908,10 +990,7 @@ void TensorFillSymmetricRandomUniform(
     fill_mode
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 /// Fills a tensor with random values with a uniform random distribution pads zeros along diagonal
@@ -939,10 +1018,7 @@ void TensorFillPadDiagonalRandomUniform(
     alignment
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -977,9 +1053,7 @@ void BlockFillRandomUniform(
                                           ///  data.                 
   detail::RandomUniformFunc<Element> random_func(seed, max, min, bits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ReferenceFactory<Element>::get(ptr, i) = random_func();
-  }
+  detail::BlockFillForEach(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1370,6 +1444,9 @@ struct RandomSparseMetaFunc {
   int range;
   int MetaSizeInBits;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -1379,7 +1456,6 @@ struct RandomSparseMetaFunc {
     int MetaSizeInBits_ = 2
   ):
     seed(seed_), MetaSizeInBits(MetaSizeInBits_) {
-      std::srand((unsigned)seed);
       if (MetaSizeInBits_ == 2) {
         range = 6;
       }
@@ -1391,8 +1467,13 @@ struct RandomSparseMetaFunc {
       }
     }
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Element operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
     Element FourToTwoMeta[6] = {0x4, 0x8, 0x9, 0xc, 0xd, 0xe};
     Element TwoToOneMeta[2] = {0x4, 0xe};
 
@@ -1400,8 +1481,15 @@ struct RandomSparseMetaFunc {
 
     Element result = 0x0;
 
+    // Each 4b field selects a metadata pattern using 16 random bits
+    Array<uint32_t, 4> bits;
+
     for (int i = 0; i < cutlass::sizeof_bits<Element>::value / 4; ++i) {
-      int rnd = std::rand() % range;
+      if (i % 8 == 0) {
+        bits = Philox4x32::generate(seed, index, uint32_t(i / 8));
+      }
+      uint32_t field = (bits[(i % 8) / 2] >> (16 * (i % 2))) & 0xffff;
+      int rnd = int((field * uint32_t(range)) >> 16);
       Element meta = MetaArray[rnd];
 
       result = (Element)(result | ((Element)(meta << (i * 4))));
@@ -1439,10 +1527,10 @@ struct TensorFillRandomSparseMetaFunc {
 
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the random value of the element at coord
   void operator()(Coord<Layout::kRank> const &coord) const {
 
-    view.at(coord) = func();
+    view.at(coord) = func(TensorLinearIndex(coord, view.extent()));
   }
 };
 
@@ -1466,10 +1554,7 @@ void TensorFillRandomSparseMeta(
     random_func
   );
 
-  TensorForEach(
-    dst.extent(),
-    func
-  );
+  detail::TensorFillForEach<Element>(dst.extent(), func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1486,9 +1571,7 @@ void BlockFillRandomSparseMeta(
 
   detail::RandomSparseMetaFunc<Element> random_func(seed, MetaSizeInBits);
 
-  for (size_t i = 0; i < capacity; ++i) {
-    ptr[i] = random_func();
-  }
+  detail::BlockFillForEach(ptr, capacity, random_func);
 }
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -1503,11 +1586,19 @@ void TensorFillRandomEllIdx(
   uint64_t seed,                                   ///< seed for RNG
   int rows, int ell_cols, int cols) {              ///< dimension of the matrix 
 
-  std::srand((unsigned)seed);
-
+  // Row i draws its j-th random number from the Philox generator keyed by (seed, i), so each
+  // row is independent of the others
   for (int i = 0; i < rows; ++i) {
-    int col_idx = std::rand() % cols;
-   
+    Array<uint32_t, 4> bits;
+    auto random = [&](int j) -> int {
+      if (j % 4 == 0) {
+        bits = Philox4x32::generate(seed, uint64_t(i), uint32_t(j / 4));
+      }
+      return int(bits[j % 4] & 0x7fffffff);
+    };
+
+    int col_idx = random(0) % cols;
+
     for (int j = 0; j < ell_cols; ++j) {
       dst.at({i, j}) = col_idx;
 
@@ -1515,7 +1606,7 @@ void TensorFillRandomEllIdx(
         if (col_idx == (cols - 1)) {
           col_idx = -1;
         } else {
-          col_idx = std::rand() % (cols - col_idx - 1) + col_idx + 1;
+          col_idx = random(j + 1) % (cols - col_idx - 1) + col_idx + 1;
         }
       }
     }
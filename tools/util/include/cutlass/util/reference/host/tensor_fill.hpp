@@ -48,6 +48,7 @@
 #include "cutlass/quaternion.h"
 #include "cutlass/array.h"
 #include "cutlass/numeric_types.h"
+#include "cutlass/util/philox.h"
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
@@ -99,6 +100,9 @@ struct RandomUniformFunc {
   double min;
   int int_scale;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -110,14 +114,19 @@ struct RandomUniformFunc {
     int int_scale_ = -1
   ):
     seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
     }
 
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Element operator()() const {
+    return (*this)(sequence++);
+  }
 
-    double rnd = double(std::rand()) / double(RAND_MAX);
+  /// Compute the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
+
+    Array<uint32_t, 4> bits = Philox4x32::generate(seed, index);
+    double rnd = Philox4x32::to_uniform_double(bits[0], bits[1]);
 
     rnd = min + range * rnd;
 
@@ -148,6 +157,9 @@ struct RandomUniformFunc<complex<Element> > {
   double min;
   int int_scale;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -159,17 +171,23 @@ struct RandomUniformFunc<complex<Element> > {
     int int_scale_ = -1
   ):
     seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
     }
 
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   complex<Element> operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  complex<Element> operator()(uint64_t index) const {
 
     Element reals[2];
 
+    Array<uint32_t, 4> bits = Philox4x32::generate(seed, index);
+
     for (int i = 0; i < 2; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      double rnd = Philox4x32::to_uniform_double(bits[2 * i], bits[2 * i + 1]);
 
       rnd = min + range * rnd;
 
@@ -200,6 +218,9 @@ struct RandomUniformFunc<Quaternion<Element> > {
   double min;
   int int_scale;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -211,17 +232,22 @@ struct RandomUniformFunc<Quaternion<Element> > {
     int int_scale_ = -1
   ):
     seed(seed_), range(max - min_), min(min_), int_scale(int_scale_) {
-      std::srand((unsigned)seed);
     }
 
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Quaternion<Element> operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Quaternion<Element> operator()(uint64_t index) const {
 
     Element reals[4];
 
     for (int i = 0; i < 4; ++i) {
-      double rnd = double(std::rand()) / double(RAND_MAX);
+      Array<uint32_t, 4> bits = Philox4x32::generate(seed, index, uint32_t(i / 2));
+      double rnd = Philox4x32::to_uniform_double(bits[2 * (i % 2)], bits[2 * (i % 2) + 1]);
 
       rnd = min + range * rnd;
 
@@ -259,7 +285,7 @@ void TensorFillRandomUniform(
   detail::RandomUniformFunc<typename Tensor::value_type> random_func(seed, max, min, bits);
 
   for (int64_t idx = 0; idx < cute::size(dst); ++idx) {
-    dst(idx) = random_func();
+    dst(idx) = random_func(uint64_t(idx));
   }
 }
 
@@ -279,7 +305,7 @@ void BlockFillRandomUniform(
   detail::RandomUniformFunc<Element> random_func(seed, max, min, bits);
 
   for (size_t i = 0; i < capacity; ++i) {
-    ptr[i] = random_func();
+    ptr[i] = random_func(uint64_t(i));
   }
 }
 
@@ -300,6 +326,9 @@ struct RandomGaussianFunc {
   int int_scale;
   double pi;
 
+  /// Index of the next value returned by operator()()
+  mutable uint64_t sequence = 0;
+
   //
   // Methods
   //
@@ -310,15 +339,20 @@ struct RandomGaussianFunc {
     int int_scale_ = -1
   ):
     seed(seed_), mean(mean_), stddev(stddev_), int_scale(int_scale_), pi(std::acos(-1)) {
-      std::srand((unsigned)seed);
   }
 
-  /// Compute random value and update RNG state
+  /// Compute the next random value in sequence
   Element operator()() const {
+    return (*this)(sequence++);
+  }
+
+  /// Compute the random value of the element at a linear index
+  Element operator()(uint64_t index) const {
 
     // Box-Muller transform to generate random numbers with Normal distribution
-    double u1 = double(std::rand()) / double(RAND_MAX);
-    double u2 = double(std::rand()) / double(RAND_MAX);
+    Array<uint32_t, 4> bits = Philox4x32::generate(seed, index);
+    double u1 = Philox4x32::to_uniform_double(bits[0], bits[1]);
+    double u2 = Philox4x32::to_uniform_double(bits[2], bits[3]);
 
     // Compute Gaussian random value
     double rnd = std::sqrt(-2 * std::log(u1)) * std::cos(2 * pi * u2);
@@ -359,7 +393,7 @@ void TensorFillRandomGaussian(
   detail::RandomGaussianFunc<typename Tensor::value_type> random_func(seed, mean, stddev, bits);
 
   for (int64_t idx = 0; idx < cute::size(dst); ++idx) {
-    dst(idx) = random_func();
+    dst(idx) = random_func(uint64_t(idx));
   }
 }
 
@@ -380,7 +414,7 @@ void BlockFillRandomGaussian(
   detail::RandomGaussianFunc<Element> random_func(seed, mean, stddev, bits);
 
   for (size_t i = 0; i < capacity; ++i) {
-    ptr[i] = random_func();
+    ptr[i] = random_func(uint64_t(i));
   }
 }
 
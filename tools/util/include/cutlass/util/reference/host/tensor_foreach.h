@@ -30,8 +30,14 @@
  **************************************************************************************************/
 #pragma once
 
+#include <cstdint>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
+
 #include "cutlass/cutlass.h"
+#include "cutlass/coord.h"
+#include "cutlass/util/host_parallel.h"
 
 namespace cutlass  {
 namespace reference {
@@ -39,9 +45,124 @@ namespace host {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// Execution policies selecting how the host for-each routines traverse an index space.
+///
+/// Parallel policies partition the linear index space (last rank changing fastest) into
+/// contiguous chunks, so the outermost ranks are split first. Functors passed to the parallel
+/// overloads of TensorForEach must tolerate concurrent calls on distinct coordinates; functors
+/// with mutable state should use TensorForEachChunk and create their state per chunk.
+namespace execution {
+
+/// Visits every point in order on the calling thread
+struct Sequential { };
+
+/// Distributes chunks of grain points dynamically across the host thread pool
+struct ThreadPool {
+
+  /// Points per chunk. Zero selects a grain from the extent and the number of host threads.
+  int64_t grain;
+
+  /// Upper bound on participating threads. Zero uses all host threads.
+  int max_threads;
+
+  explicit ThreadPool(int64_t grain_ = 0, int max_threads_ = 0):
+    grain(grain_), max_threads(max_threads_) { }
+};
+
+/// Splits the index space into a fixed number of contiguous, near-equal chunks
+struct ChunkedStatic {
+
+  /// Number of chunks. Zero selects one chunk per host thread.
+  int chunks;
+
+  explicit ChunkedStatic(int chunks_ = 0): chunks(chunks_) { }
+};
+
+} // namespace execution
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
 /// Defines several helpers
 namespace detail {
 
+/// Calls chunk_func(chunk_index, begin, end) for each chunk of [0, count) under a policy
+template <typename ChunkFunc>
+void ForEachChunk(execution::Sequential const &, int64_t count, ChunkFunc &&chunk_func) {
+  if (count > 0) {
+    chunk_func(int64_t(0), int64_t(0), count);
+  }
+}
+
+template <typename ChunkFunc>
+void ForEachChunk(execution::ThreadPool const &policy, int64_t count, ChunkFunc &&chunk_func) {
+
+  int64_t grain = policy.grain > 0 ? policy.grain : host_parallel_grain(count, 1024);
+  int64_t chunks = (count + grain - 1) / grain;
+
+  host_parallel_for(0, chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+      chunk_func(chunk, chunk * grain, std::min(count, (chunk + 1) * grain));
+    }
+  }, policy.max_threads);
+}
+
+template <typename ChunkFunc>
+void ForEachChunk(execution::ChunkedStatic const &policy, int64_t count, ChunkFunc &&chunk_func) {
+
+  int64_t chunks = policy.chunks > 0 ? policy.chunks : host_thread_count();
+  chunks = std::max<int64_t>(1, std::min(chunks, count));
+
+  host_parallel_for(0, chunks, 1, [&](int64_t chunk_begin, int64_t chunk_end) {
+    for (int64_t chunk = chunk_begin; chunk < chunk_end; ++chunk) {
+      chunk_func(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+    }
+  });
+}
+
+/// Number of points in an extent
+template <int Rank, typename Index, typename LongIndex>
+int64_t TensorForEachCount(Coord<Rank, Index, LongIndex> const &extent) {
+  int64_t count = 1;
+  for (int i = 0; i < Rank; ++i) {
+    count *= int64_t(extent[i]);
+  }
+  return count;
+}
+
+/// Calls func(coord) for linear indices [begin, end) of an extent, last rank changing fastest
+template <typename Func, int Rank, typename Index, typename LongIndex>
+void TensorForEachRange(
+  Coord<Rank, Index, LongIndex> const &extent,
+  int64_t begin,
+  int64_t end,
+  Func &func) {
+
+  Coord<Rank, Index, LongIndex> coord;
+  int64_t remainder = begin;
+  for (int i = Rank - 1; i >= 0; --i) {
+    coord[i] = Index(remainder % extent[i]);
+    remainder /= extent[i];
+  }
+
+  for (int64_t index = begin; index < end; ++index) {
+    func(coord);
+
+    for (int i = Rank - 1; i >= 0; --i) {
+      if (++coord[i] < extent[i]) {
+        break;
+      }
+      coord[i] = 0;
+    }
+  }
+}
+
+/// True if Func supplies a value for an explicit linear index via func(uint64_t)
+template <typename Func, typename = void>
+struct IsIndexedGenerator : std::false_type { };
+
+template <typename Func>
+struct IsIndexedGenerator<Func, decltype((void)std::declval<Func const &>()(uint64_t(0)))> : std::true_type { };
+
 /// Helper to perform for-each operation
 template <typename Func, int Rank, int RankRemaining>
 struct TensorForEachHelper {
@@ -106,6 +227,67 @@ void TensorForEachLambda(Coord<Rank> extent, Func func) {
   detail::TensorForEachHelper<Func, Rank, Rank - 1>(func, extent, coord);
 }
 
+/// Iterates over the index space of a tensor under an execution policy
+template <
+  typename Policy,        ///< execution policy from namespace execution
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEach(Policy const &policy, Coord<Rank> extent, Func & func) {
+  detail::ForEachChunk(policy, detail::TensorForEachCount(extent),
+    [&](int64_t, int64_t begin, int64_t end) {
+      detail::TensorForEachRange(extent, begin, end, func);
+    });
+}
+
+/// Iterates over the index space of a tensor under an execution policy and calls a C++ lambda
+template <
+  typename Policy,        ///< execution policy from namespace execution
+  typename Func,          ///< function applied to each point in a tensor's index space
+  int Rank>               ///< rank of index space
+void TensorForEachLambda(Policy const &policy, Coord<Rank> extent, Func func) {
+  TensorForEach(policy, extent, func);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Contiguous range of a tensor's linear index space assigned to one task
+template <int Rank>
+struct TensorForEachChunkRange {
+
+  /// Extent of the index space
+  Coord<Rank> extent;
+
+  /// Position of this chunk among all chunks of the traversal
+  int64_t index;
+
+  /// Linear indices [begin, end) covered by this chunk
+  int64_t begin;
+  int64_t end;
+
+  /// Calls func(coord) for every point of the chunk in order
+  template <typename Func>
+  void for_each(Func &&func) const {
+    detail::TensorForEachRange(extent, begin, end, func);
+  }
+};
+
+/// Calls chunk_func(TensorForEachChunkRange<Rank> const &) once per chunk of a tensor's index
+/// space. Stateful work such as random number generation or reductions creates its state inside
+/// chunk_func and may key per-chunk partial results by the chunk index. Chunk boundaries depend
+/// on the thread count unless the policy fixes them (ThreadPool with a nonzero grain, or
+/// ChunkedStatic with a nonzero chunk count).
+template <
+  typename Policy,        ///< execution policy from namespace execution
+  typename ChunkFunc,     ///< function applied to each chunk
+  int Rank>               ///< rank of index space
+void TensorForEachChunk(Policy const &policy, Coord<Rank> extent, ChunkFunc && chunk_func) {
+  detail::ForEachChunk(policy, detail::TensorForEachCount(extent),
+    [&](int64_t chunk, int64_t begin, int64_t end) {
+      TensorForEachChunkRange<Rank> range{extent, chunk, begin, end};
+      chunk_func(range);
+    });
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 template <typename Element, typename Func>
@@ -123,6 +305,29 @@ struct BlockForEach {
       ptr[index] = func();
     }    
   }
+
+  /// Performs the operation under an execution policy. Functors providing func(uint64_t index)
+  /// are evaluated at each element's offset. Otherwise each chunk constructs its own functor from
+  /// params and calls func() in order, so the values depend on the chunk boundaries.
+  template <typename Policy>
+  BlockForEach(
+    Policy const &policy,
+    Element *ptr, 
+    size_t capacity,
+    typename Func::Params params = typename Func::Params()) {
+
+    detail::ForEachChunk(policy, int64_t(capacity), [&](int64_t, int64_t begin, int64_t end) {
+      Func func(params);
+      for (int64_t index = begin; index < end; ++index) {
+        if constexpr (detail::IsIndexedGenerator<Func>::value) {
+          ptr[index] = func(uint64_t(index));
+        }
+        else {
+          ptr[index] = func();
+        }
+      }
+    });
+  }
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include "cutlass/cutlass.h"
 #include "cutlass/complex.h"
 #include "cutlass/tensor_ref.h"
+#include "cutlass/numeric_conversion.h"
 
 #include "cutlass/util/reference/detail/linear_to_coordinate.h"
 #include "cutlass/core_io.h"
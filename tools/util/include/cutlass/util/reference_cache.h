@@ -0,0 +1,614 @@
+/***************************************************************************************************
+ * Copyright (c) 2017 - 2024 NVIDIA CORPORATION & AFFILIATES. All rights reserved.
+ * SPDX-License-Identifier: BSD-3-Clause
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice, this
+ * list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ **************************************************************************************************/
+/*! \file
+    \brief Content-addressed, disk-backed cache of host reference results.
+
+    Unit test testbeds recompute the same host reference (GEMM, GETT or convolution) for every
+    kernel variant that targets a given problem. ReferenceCache memoizes those results on disk,
+    keyed by a 128-bit hash of the reference inputs and configuration, so that one reference
+    computation serves every kernel, test binary and process sharing the cache directory.
+
+    Each entry is a single file named by its key. The file holds a fixed-size header followed by
+    the concatenated output buffers, which are mapped read-only with mmap() where available.
+    Entries are written to a temporary file and renamed into place, so concurrent writers never
+    expose a partially written entry, and every payload carries a checksum that is validated
+    before use.
+
+    The cache is disabled unless a directory is given, either explicitly or through the
+    CUTLASS_REFERENCE_CACHE_DIR environment variable. Entries record kReferenceCacheVersion and
+    entries of any other version are ignored; increment it whenever a change to a host reference
+    alters its numerical results.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CUTLASS_REFERENCE_CACHE_MMAP 1
+#else
+#define CUTLASS_REFERENCE_CACHE_MMAP 0
+#endif
+
+#include "cutlass/cutlass.h"
+#include "cutlass/numeric_types.h"
+
+namespace cutlass {
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Version of the host reference implementations recorded in every cache entry
+static uint32_t const kReferenceCacheVersion = 1;
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// 128-bit cache key
+struct ReferenceCacheKey {
+
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+
+  bool operator==(ReferenceCacheKey const &rhs) const {
+    return hi == rhs.hi && lo == rhs.lo;
+  }
+
+  bool operator!=(ReferenceCacheKey const &rhs) const {
+    return !(*this == rhs);
+  }
+
+  /// Returns the key as 32 hexadecimal digits
+  std::string str() const {
+    char buffer[33];
+    std::snprintf(buffer, sizeof(buffer), "%016llx%016llx",
+      static_cast<unsigned long long>(hi), static_cast<unsigned long long>(lo));
+    return std::string(buffer);
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Streaming 128-bit non-cryptographic hash used to form cache keys and payload checksums.
+///
+/// Two independent 64-bit lanes consume the input eight bytes at a time. Every update is prefixed
+/// with its length, so concatenations of different fields never collide trivially.
+class ReferenceCacheHasher {
+public:
+
+  static uint64_t const kPrime0 = 0x9E3779B97F4A7C15ull;
+  static uint64_t const kPrime1 = 0xC2B2AE3D27D4EB4Full;
+
+private:
+
+  uint64_t lane0_;
+  uint64_t lane1_;
+  uint64_t length_ = 0;
+
+  static uint64_t rotl(uint64_t x, int r) {
+    return (x << r) | (x >> (64 - r));
+  }
+
+  static uint64_t fmix(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xFF51AFD7ED558CCDull;
+    x ^= x >> 33;
+    x *= 0xC4CEB9FE1A85EC53ull;
+    x ^= x >> 33;
+    return x;
+  }
+
+  void mix(uint64_t word) {
+    lane0_ = rotl(lane0_ ^ (word * kPrime1), 31) * kPrime0;
+    lane1_ = rotl(lane1_ + (word ^ kPrime0), 27) * kPrime1 + lane0_;
+  }
+
+public:
+
+  explicit ReferenceCacheHasher(uint64_t seed = 0):
+    lane0_(seed ^ kPrime0), lane1_(~seed ^ kPrime1) { }
+
+  /// Hashes an array of bytes
+  ReferenceCacheHasher &update(void const *data, size_t bytes) {
+    uint8_t const *ptr = static_cast<uint8_t const *>(data);
+
+    mix(uint64_t(bytes));
+
+    size_t idx = 0;
+    for (; idx + 8 <= bytes; idx += 8) {
+      uint64_t word;
+      std::memcpy(&word, ptr + idx, 8);
+      mix(word);
+    }
+    if (idx < bytes) {
+      uint64_t word = 0;
+      std::memcpy(&word, ptr + idx, bytes - idx);
+      mix(word);
+    }
+
+    length_ += bytes;
+    return *this;
+  }
+
+  /// Hashes a string
+  ReferenceCacheHasher &update(std::string const &str) {
+    return update(str.data(), str.size());
+  }
+
+  /// Hashes a string literal
+  ReferenceCacheHasher &update(char const *str) {
+    return update(str, std::strlen(str));
+  }
+
+  /// Hashes the object representation of a trivially copyable value
+  template <typename T>
+  ReferenceCacheHasher &update_value(T const &value) {
+    static_assert(std::is_trivially_copyable<T>::value, "update_value() requires a trivially copyable type");
+    return update(&value, sizeof(T));
+  }
+
+  /// Hashes the implementation-defined name of a type
+  template <typename T>
+  ReferenceCacheHasher &update_type() {
+    return update(typeid(T).name());
+  }
+
+  /// Hashes the storage of a contiguous block of elements
+  template <typename Element>
+  ReferenceCacheHasher &update_block(Element const *ptr, size_t count) {
+    return update(ptr, (count * sizeof_bits<Element>::value + 7) / 8);
+  }
+
+  /// Returns the digest of everything hashed so far
+  ReferenceCacheKey digest() const {
+    uint64_t h0 = lane0_ ^ length_;
+    uint64_t h1 = lane1_ ^ rotl(length_, 32);
+    h0 += h1;
+    h1 += h0;
+    h0 = fmix(h0);
+    h1 = fmix(h1);
+    h0 += h1;
+    h1 += h0;
+
+    ReferenceCacheKey key;
+    key.hi = h0;
+    key.lo = h1;
+    return key;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Host buffer stored in or restored from a cache entry
+struct ReferenceCacheBuffer {
+
+  void *data = nullptr;
+  size_t bytes = 0;
+
+  ReferenceCacheBuffer() { }
+
+  ReferenceCacheBuffer(void *data_, size_t bytes_): data(data_), bytes(bytes_) { }
+
+  /// Describes the storage of a contiguous block of elements
+  template <typename Element>
+  static ReferenceCacheBuffer block(Element *ptr, size_t count) {
+    return ReferenceCacheBuffer(ptr, (count * sizeof_bits<Element>::value + 7) / 8);
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+/// On-disk header of a cache entry
+struct ReferenceCacheFileHeader {
+
+  static int const kMaxBuffers = 8;
+
+  /// Payload offset, chosen so that the payload starts on a cache line boundary
+  static size_t const kPayloadOffset = 256;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t buffer_count;
+  uint64_t key_hi;
+  uint64_t key_lo;
+  uint64_t payload_bytes;
+  uint64_t checksum_hi;
+  uint64_t checksum_lo;
+  uint64_t buffer_bytes[kMaxBuffers];
+
+  static char const *magic_string() {
+    return "CUTLREF1";
+  }
+};
+
+static_assert(sizeof(ReferenceCacheFileHeader) <= ReferenceCacheFileHeader::kPayloadOffset,
+  "Cache entry header exceeds the payload offset");
+
+} // namespace detail
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Read-only view of a cache entry. The file is memory-mapped where supported and read into
+/// host memory otherwise.
+class ReferenceCacheEntry {
+private:
+
+  void const *mapping_ = nullptr;
+  size_t mapping_bytes_ = 0;
+  std::vector<uint8_t> storage_;
+
+  detail::ReferenceCacheFileHeader header_ = {};
+  bool valid_ = false;
+
+  void release() {
+#if CUTLASS_REFERENCE_CACHE_MMAP
+    if (mapping_) {
+      munmap(const_cast<void *>(mapping_), mapping_bytes_);
+    }
+#endif
+    mapping_ = nullptr;
+    mapping_bytes_ = 0;
+    storage_.clear();
+    valid_ = false;
+  }
+
+  uint8_t const *file_data() const {
+    return mapping_ ? static_cast<uint8_t const *>(mapping_) : storage_.data();
+  }
+
+  size_t file_bytes() const {
+    return mapping_ ? mapping_bytes_ : storage_.size();
+  }
+
+  /// Validates the header and payload checksum against the expected key
+  bool validate(ReferenceCacheKey const &key) {
+    using Header = detail::ReferenceCacheFileHeader;
+
+    if (file_bytes() < Header::kPayloadOffset) {
+      return false;
+    }
+
+    std::memcpy(&header_, file_data(), sizeof(Header));
+
+    if (std::memcmp(header_.magic, Header::magic_string(), sizeof(header_.magic)) ||
+        header_.version != kReferenceCacheVersion ||
+        header_.key_hi != key.hi ||
+        header_.key_lo != key.lo ||
+        header_.buffer_count > uint32_t(Header::kMaxBuffers) ||
+        header_.payload_bytes != file_bytes() - Header::kPayloadOffset) {
+      return false;
+    }
+
+    uint64_t total = 0;
+    for (uint32_t idx = 0; idx < header_.buffer_count; ++idx) {
+      total += header_.buffer_bytes[idx];
+    }
+    if (total != header_.payload_bytes) {
+      return false;
+    }
+
+    ReferenceCacheHasher hasher;
+    for (uint32_t idx = 0; idx < header_.buffer_count; ++idx) {
+      hasher.update(buffer(int(idx)), buffer_bytes(int(idx)));
+    }
+    ReferenceCacheKey checksum = hasher.digest();
+    return checksum.hi == header_.checksum_hi && checksum.lo == header_.checksum_lo;
+  }
+
+public:
+
+  ReferenceCacheEntry() { }
+
+  /// Opens the entry stored at path and validates it against key
+  ReferenceCacheEntry(std::string const &path, ReferenceCacheKey const &key) {
+
+#if CUTLASS_REFERENCE_CACHE_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return;
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+      void *ptr = ::mmap(nullptr, size_t(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+      if (ptr != MAP_FAILED) {
+        mapping_ = ptr;
+        mapping_bytes_ = size_t(info.st_size);
+      }
+    }
+    ::close(fd);
+
+    if (!mapping_) {
+      return;
+    }
+#else
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.good()) {
+      return;
+    }
+    std::streamoff bytes = file.tellg();
+    if (bytes <= 0) {
+      return;
+    }
+    storage_.resize(size_t(bytes));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char *>(storage_.data()), bytes)) {
+      storage_.clear();
+      return;
+    }
+#endif
+
+    valid_ = validate(key);
+    if (!valid_) {
+      release();
+    }
+  }
+
+  ReferenceCacheEntry(ReferenceCacheEntry const &) = delete;
+  ReferenceCacheEntry &operator=(ReferenceCacheEntry const &) = delete;
+
+  ReferenceCacheEntry(ReferenceCacheEntry &&rhs) noexcept {
+    *this = std::move(rhs);
+  }
+
+  ReferenceCacheEntry &operator=(ReferenceCacheEntry &&rhs) noexcept {
+    if (this != &rhs) {
+      release();
+      mapping_ = rhs.mapping_;
+      mapping_bytes_ = rhs.mapping_bytes_;
+      storage_ = std::move(rhs.storage_);
+      header_ = rhs.header_;
+      valid_ = rhs.valid_;
+      rhs.mapping_ = nullptr;
+      rhs.mapping_bytes_ = 0;
+      rhs.valid_ = false;
+    }
+    return *this;
+  }
+
+  ~ReferenceCacheEntry() {
+    release();
+  }
+
+  /// True if the entry exists and passed validation
+  bool valid() const {
+    return valid_;
+  }
+
+  explicit operator bool() const {
+    return valid_;
+  }
+
+  /// Number of buffers stored in the entry
+  int buffer_count() const {
+    return valid_ ? int(header_.buffer_count) : 0;
+  }
+
+  /// Size of a stored buffer in bytes
+  size_t buffer_bytes(int idx) const {
+    return size_t(header_.buffer_bytes[idx]);
+  }
+
+  /// Pointer to the beginning of a stored buffer
+  void const *buffer(int idx) const {
+    size_t offset = 0;
+    for (int i = 0; i < idx; ++i) {
+      offset += size_t(header_.buffer_bytes[i]);
+    }
+    return static_cast<uint8_t const *>(payload()) + offset;
+  }
+
+  /// Pointer to the concatenated buffers
+  void const *payload() const {
+    return file_data() + detail::ReferenceCacheFileHeader::kPayloadOffset;
+  }
+
+  /// Size of the concatenated buffers in bytes
+  size_t payload_bytes() const {
+    return size_t(header_.payload_bytes);
+  }
+
+  /// Copies the stored buffers into outputs. Returns false if their number or sizes differ.
+  bool copy_to(std::vector<ReferenceCacheBuffer> const &outputs) const {
+    if (!valid_ || outputs.size() != size_t(header_.buffer_count)) {
+      return false;
+    }
+    for (int idx = 0; idx < buffer_count(); ++idx) {
+      if (outputs[idx].bytes != buffer_bytes(idx)) {
+        return false;
+      }
+    }
+    for (int idx = 0; idx < buffer_count(); ++idx) {
+      if (outputs[idx].bytes) {
+        std::memcpy(outputs[idx].data, buffer(idx), outputs[idx].bytes);
+      }
+    }
+    return true;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// Directory of content-addressed reference results shared across tests and processes
+class ReferenceCache {
+private:
+
+  std::string directory_;
+
+public:
+
+  /// Constructs a cache rooted at directory. An empty directory disables the cache.
+  explicit ReferenceCache(std::string directory = std::string()): directory_(std::move(directory)) {
+    while (directory_.size() > 1 && directory_.back() == '/') {
+      directory_.pop_back();
+    }
+  }
+
+  /// Returns the process-wide cache configured by CUTLASS_REFERENCE_CACHE_DIR
+  static ReferenceCache &global() {
+    static ReferenceCache cache([] {
+      char const *env = std::getenv("CUTLASS_REFERENCE_CACHE_DIR");
+      return std::string(env ? env : "");
+    }());
+    return cache;
+  }
+
+  /// True if results are looked up and stored
+  bool enabled() const {
+    return !directory_.empty();
+  }
+
+  std::string const &directory() const {
+    return directory_;
+  }
+
+  /// Path of the file holding the entry for key
+  std::string path(ReferenceCacheKey const &key) const {
+    return directory_ + "/" + key.str() + ".ref";
+  }
+
+  /// Opens the entry for key. The returned entry is invalid on a miss or a corrupt file.
+  ReferenceCacheEntry find(ReferenceCacheKey const &key) const {
+    if (!enabled()) {
+      return ReferenceCacheEntry();
+    }
+    return ReferenceCacheEntry(path(key), key);
+  }
+
+  /// Stores buffers under key. Returns false if the entry could not be written.
+  bool store(ReferenceCacheKey const &key, std::vector<ReferenceCacheBuffer> const &buffers) const {
+    using Header = detail::ReferenceCacheFileHeader;
+
+    if (!enabled() || buffers.size() > size_t(Header::kMaxBuffers)) {
+      return false;
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, Header::magic_string(), sizeof(header.magic));
+    header.version = kReferenceCacheVersion;
+    header.buffer_count = uint32_t(buffers.size());
+    header.key_hi = key.hi;
+    header.key_lo = key.lo;
+
+    ReferenceCacheHasher checksum;
+    for (size_t idx = 0; idx < buffers.size(); ++idx) {
+      header.buffer_bytes[idx] = buffers[idx].bytes;
+      header.payload_bytes += buffers[idx].bytes;
+      checksum.update(buffers[idx].data, buffers[idx].bytes);
+    }
+    ReferenceCacheKey digest = checksum.digest();
+    header.checksum_hi = digest.hi;
+    header.checksum_lo = digest.lo;
+
+    static std::atomic<uint64_t> sequence{0};
+    std::string final_path = path(key);
+    std::string temp_path = final_path + "." + std::to_string(uint64_t(
+#if CUTLASS_REFERENCE_CACHE_MMAP
+      ::getpid()
+#else
+      0
+#endif
+      )) + "." + std::to_string(sequence.fetch_add(1)) + ".tmp";
+
+    {
+      std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+      if (!file.good()) {
+        return false;
+      }
+
+      char padding[Header::kPayloadOffset] = {};
+      std::memcpy(padding, &header, sizeof(header));
+      file.write(padding, Header::kPayloadOffset);
+      for (auto const &buffer : buffers) {
+        file.write(static_cast<char const *>(buffer.data), std::streamsize(buffer.bytes));
+      }
+
+      if (!file.good()) {
+        file.close();
+        std::remove(temp_path.c_str());
+        return false;
+      }
+    }
+
+    // Another process may have published the same entry first; either copy is equivalent.
+    if (std::rename(temp_path.c_str(), final_path.c_str()) != 0) {
+      std::remove(temp_path.c_str());
+      return find(key).valid();
+    }
+    return true;
+  }
+
+  /// Restores outputs from the entry for key if present. Otherwise invokes compute(), which must
+  /// write the reference result into outputs, and stores the outputs under key.
+  ///
+  /// Returns true if the result was restored from the cache.
+  template <typename Compute>
+  bool load_or_compute(
+    ReferenceCacheKey const &key,
+    std::vector<ReferenceCacheBuffer> const &outputs,
+    Compute &&compute) const {
+
+    if (enabled()) {
+      ReferenceCacheEntry entry = find(key);
+      if (entry.copy_to(outputs)) {
+        return true;
+      }
+    }
+
+    compute();
+
+    if (enabled()) {
+      store(key, outputs);
+    }
+    return false;
+  }
+};
+
+/////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace cutlass
+
+/////////////////////////////////////////////////////////////////////////////////////////////////